@@ -0,0 +1,116 @@
+/**
+ * \file
+ * \brief BasicTask class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_BASICTASK_HPP_
+#define INCLUDE_DISTORTOS_BASICTASK_HPP_
+
+#include "estd/IntrusiveList.hpp"
+
+namespace distortos
+{
+
+class BasicTaskRunner;
+
+/**
+ * \brief BasicTask class is an abstract interface for basic tasks
+ *
+ * Basic task is a function which runs to completion on the stack of the BasicTaskRunner to which it is assigned. It
+ * has no stack of its own, so it must not block. Basic tasks may be activated from thread context, from interrupt
+ * context or from software timers. Basic tasks assigned to the same runner are executed one by one, in the order of
+ * activation.
+ *
+ * \ingroup threads
+ */
+
+class BasicTask
+{
+	friend class BasicTaskRunner;
+
+public:
+
+	/**
+	 * \brief BasicTask's constructor
+	 *
+	 * \param [in] basicTaskRunner is a reference to BasicTaskRunner which will execute this basic task
+	 */
+
+	constexpr explicit BasicTask(BasicTaskRunner& basicTaskRunner) :
+			node{},
+			basicTaskRunner_{basicTaskRunner}
+	{
+
+	}
+
+	/**
+	 * \brief BasicTask's destructor
+	 *
+	 * Pending activation of basic task is cancelled.
+	 */
+
+	virtual ~BasicTask();
+
+	/**
+	 * \brief Activates the basic task.
+	 *
+	 * Basic task is appended to the list of activated basic tasks of associated BasicTaskRunner. It is allowed to
+	 * activate basic task from its own run() function.
+	 *
+	 * \note This function may be called from interrupt context.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBUSY - basic task is already activated and waits for execution;
+	 * - error codes returned by Semaphore::post();
+	 */
+
+	int activate();
+
+	/**
+	 * \brief Cancels pending activation of the basic task.
+	 *
+	 * \note This function may be called from interrupt context.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EALREADY - basic task is not activated;
+	 */
+
+	int cancel();
+
+	/**
+	 * \return true if the basic task is activated and waits for execution, false otherwise
+	 */
+
+	bool isActivated() const;
+
+	BasicTask(const BasicTask&) = delete;
+	BasicTask(BasicTask&&) = default;
+	const BasicTask& operator=(const BasicTask&) = delete;
+	BasicTask& operator=(BasicTask&&) = delete;
+
+	/// node for intrusive list of activated basic tasks
+	estd::IntrusiveListNode node;
+
+private:
+
+	/**
+	 * \brief "Run" function of basic task
+	 *
+	 * This should be overridden by derived classes. It is executed by associated BasicTaskRunner and must not block.
+	 */
+
+	virtual void run() = 0;
+
+	/// reference to BasicTaskRunner which executes this basic task
+	BasicTaskRunner& basicTaskRunner_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_BASICTASK_HPP_
@@ -0,0 +1,86 @@
+/**
+ * \file
+ * \brief BasicTaskRunner class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_BASICTASKRUNNER_HPP_
+#define INCLUDE_DISTORTOS_BASICTASKRUNNER_HPP_
+
+#include "distortos/BasicTask.hpp"
+#include "distortos/Semaphore.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief BasicTaskRunner class executes activated basic tasks on a single shared stack
+ *
+ * Each BasicTaskRunner is meant to be used by one thread - BasicTaskRunner::run() is the function of this thread. All
+ * basic tasks assigned to the runner are executed with the priority of this thread and share its stack, so many
+ * run-to-completion handlers can be served with a single stack per priority level. Basic tasks are executed in the
+ * order of activation, each one runs to completion before the next one is started.
+ *
+ * \ingroup threads
+ */
+
+class BasicTaskRunner
+{
+	friend class BasicTask;
+
+public:
+
+	/**
+	 * \brief BasicTaskRunner's constructor
+	 */
+
+	constexpr BasicTaskRunner() :
+			activatedList_{},
+			semaphore_{0}
+	{
+
+	}
+
+	/**
+	 * \brief BasicTaskRunner's destructor
+	 *
+	 * Pending activations of all basic tasks assigned to this runner are cancelled.
+	 */
+
+	~BasicTaskRunner();
+
+	/**
+	 * \brief Main loop of basic task runner.
+	 *
+	 * Waits for activated basic tasks and executes them one by one. This function never returns.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 */
+
+	void run();
+
+	BasicTaskRunner(const BasicTaskRunner&) = delete;
+	BasicTaskRunner(BasicTaskRunner&&) = delete;
+	const BasicTaskRunner& operator=(const BasicTaskRunner&) = delete;
+	BasicTaskRunner& operator=(BasicTaskRunner&&) = delete;
+
+private:
+
+	/// type of intrusive list with activated basic tasks
+	using ActivatedList = estd::IntrusiveList<BasicTask, &BasicTask::node>;
+
+	/// list of activated basic tasks, in the order of activation
+	ActivatedList activatedList_;
+
+	/// semaphore with value equal to the number of activations which were not executed yet
+	Semaphore semaphore_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_BASICTASKRUNNER_HPP_
@@ -0,0 +1,73 @@
+/**
+ * \file
+ * \brief getDeferredProcedureCallRunner() and makeDeferredProcedureCall() header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEFERREDPROCEDURECALL_HPP_
+#define INCLUDE_DISTORTOS_DEFERREDPROCEDURECALL_HPP_
+
+#include "distortos/distortosConfiguration.h"
+
+#ifdef DISTORTOS_DEFERRED_PROCEDURE_CALLS_ENABLE
+
+#include "distortos/StaticBasicTask.hpp"
+
+namespace distortos
+{
+
+/// \addtogroup threads
+/// \{
+
+/// priority of thread which executes deferred procedure calls
+constexpr uint8_t deferredProcedureCallPriority {UINT8_MAX};
+
+/**
+ * \brief Gets BasicTaskRunner which executes deferred procedure calls.
+ *
+ * This runner is served by a kernel thread with highest possible priority, so all activated deferred procedure calls
+ * are executed - with interrupts enabled - right after the last interrupt handler returns, before any other thread is
+ * resumed.
+ *
+ * \return reference to BasicTaskRunner which executes deferred procedure calls
+ */
+
+BasicTaskRunner& getDeferredProcedureCallRunner();
+
+/**
+ * \brief Helper factory function to make deferred procedure call with deduced template arguments
+ *
+ * Deferred procedure call is a StaticBasicTask assigned to the runner returned by getDeferredProcedureCallRunner().
+ * Typical use is to create it once (e.g. as a member of driver object) and activate it from interrupt handler with
+ * BasicTask::activate().
+ *
+ * \warning Objects with static storage duration created with this function must not be constructed before low-level
+ * initializers are executed.
+ *
+ * \tparam Function is the function that will be executed
+ * \tparam Args are the arguments for function
+ *
+ * \param [in] function is a function that will be executed by deferred procedure call thread after each activation
+ * \param [in] args are arguments for function
+ *
+ * \return StaticBasicTask object with deduced template arguments
+ */
+
+template<typename Function, typename... Args>
+StaticBasicTask<Function, Args...> makeDeferredProcedureCall(Function&& function, Args&&... args)
+{
+	return {getDeferredProcedureCallRunner(), std::forward<Function>(function), std::forward<Args>(args)...};
+}
+
+/// \}
+
+}	// namespace distortos
+
+#endif	// def DISTORTOS_DEFERRED_PROCEDURE_CALLS_ENABLE
+
+#endif	// INCLUDE_DISTORTOS_DEFERREDPROCEDURECALL_HPP_
@@ -154,6 +154,12 @@ public:
 
 #endif	// DISTORTOS_SIGNALS_ENABLE == 1
 
+	/**
+	 * \return preemption threshold of thread
+	 */
+
+	uint8_t getPreemptionThreshold() const override;
+
 	/**
 	 * \return priority of thread
 	 */
@@ -228,6 +234,22 @@ public:
 
 #endif	// DISTORTOS_SIGNALS_ENABLE == 1
 
+	/**
+	 * \brief Changes preemption threshold of thread.
+	 *
+	 * While the thread is running, only threads with priority higher than its preemption threshold may preempt it. The
+	 * threshold stays in effect when the thread is preempted and is deactivated when the thread blocks. Preemption
+	 * threshold lower than or equal to priority of the thread has no effect. Default value is 0.
+	 *
+	 * If the thread is currently running or its preemption threshold is in effect, then the new value is applied
+	 * immediately and context switch may be requested. Otherwise the new value will be applied when the thread is
+	 * switched to.
+	 *
+	 * \param [in] preemptionThreshold is the new preemption threshold of thread
+	 */
+
+	void setPreemptionThreshold(uint8_t preemptionThreshold) override;
+
 	/**
 	 * \brief Changes priority of thread.
 	 *
@@ -0,0 +1,92 @@
+/**
+ * \file
+ * \brief StaticBasicTask class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_STATICBASICTASK_HPP_
+#define INCLUDE_DISTORTOS_STATICBASICTASK_HPP_
+
+#include "distortos/BasicTask.hpp"
+
+#include <functional>
+
+namespace distortos
+{
+
+/**
+ * \brief StaticBasicTask class is a templated interface for basic task
+ *
+ * \tparam Function is the function that will be executed
+ * \tparam Args are the arguments for function
+ *
+ * \ingroup threads
+ */
+
+template<typename Function, typename... Args>
+class StaticBasicTask : public BasicTask
+{
+public:
+
+	/**
+	 * \brief StaticBasicTask's constructor
+	 *
+	 * \param [in] basicTaskRunner is a reference to BasicTaskRunner which will execute this basic task
+	 * \param [in] function is a function that will be executed by \a basicTaskRunner after each activation
+	 * \param [in] args are arguments for function
+	 */
+
+	StaticBasicTask(BasicTaskRunner& basicTaskRunner, Function&& function, Args&&... args) :
+			BasicTask{basicTaskRunner},
+			boundFunction_{std::bind(std::forward<Function>(function), std::forward<Args>(args)...)}
+	{
+
+	}
+
+private:
+
+	/**
+	 * \brief "Run" function of basic task
+	 *
+	 * Executes bound function object.
+	 */
+
+	void run() override
+	{
+		boundFunction_();
+	}
+
+	/// bound function object
+	decltype(std::bind(std::declval<Function>(), std::declval<Args>()...)) boundFunction_;
+};
+
+/**
+ * \brief Helper factory function to make StaticBasicTask object with deduced template arguments
+ *
+ * \tparam Function is the function that will be executed
+ * \tparam Args are the arguments for function
+ *
+ * \param [in] basicTaskRunner is a reference to BasicTaskRunner which will execute this basic task
+ * \param [in] function is a function that will be executed by \a basicTaskRunner after each activation
+ * \param [in] args are arguments for function
+ *
+ * \return StaticBasicTask object with deduced template arguments
+ *
+ * \ingroup threads
+ */
+
+template<typename Function, typename... Args>
+StaticBasicTask<Function, Args...> makeStaticBasicTask(BasicTaskRunner& basicTaskRunner, Function&& function,
+		Args&&... args)
+{
+	return {basicTaskRunner, std::forward<Function>(function), std::forward<Args>(args)...};
+}
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_STATICBASICTASK_HPP_
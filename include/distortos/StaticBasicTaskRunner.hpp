@@ -0,0 +1,77 @@
+/**
+ * \file
+ * \brief StaticBasicTaskRunner class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_STATICBASICTASKRUNNER_HPP_
+#define INCLUDE_DISTORTOS_STATICBASICTASKRUNNER_HPP_
+
+#include "distortos/BasicTaskRunner.hpp"
+#include "distortos/StaticThread.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief StaticBasicTaskRunner class is a BasicTaskRunner with its own thread and statically allocated stack
+ *
+ * \tparam StackSize is the size of stack shared by all basic tasks executed by this runner, bytes
+ *
+ * \ingroup threads
+ */
+
+template<size_t StackSize>
+class StaticBasicTaskRunner : public BasicTaskRunner
+{
+public:
+
+	/**
+	 * \brief StaticBasicTaskRunner's constructor
+	 *
+	 * \param [in] priority is the priority at which all assigned basic tasks will be executed, 0 - lowest,
+	 * UINT8_MAX - highest
+	 */
+
+	explicit StaticBasicTaskRunner(const uint8_t priority) :
+			BasicTaskRunner{},
+			thread_{priority, SchedulingPolicy::fifo, &BasicTaskRunner::run, static_cast<BasicTaskRunner*>(this)}
+	{
+
+	}
+
+	/**
+	 * \return reference to internal thread object
+	 */
+
+	Thread& getThread()
+	{
+		return thread_;
+	}
+
+	/**
+	 * \brief Starts the thread of basic task runner.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by StaticThread::start();
+	 */
+
+	int start()
+	{
+		return thread_.start();
+	}
+
+private:
+
+	/// internal thread object which executes BasicTaskRunner::run()
+	StaticThread<StackSize, false, 0, 0, void (BasicTaskRunner::*)(), BasicTaskRunner*> thread_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_STATICBASICTASKRUNNER_HPP_
@@ -84,6 +84,14 @@ uint8_t getEffectivePriority();
 
 ThreadIdentifier getIdentifier();
 
+/**
+ * \warning This function must not be called from interrupt context!
+ *
+ * \return preemption threshold of calling (current) thread
+ */
+
+uint8_t getPreemptionThreshold();
+
 /**
  * \warning This function must not be called from interrupt context!
  *
@@ -114,6 +122,18 @@ size_t getStackHighWaterMark();
 
 size_t getStackSize();
 
+/**
+ * \brief Changes preemption threshold of calling (current) thread.
+ *
+ * While the thread is running, only threads with priority higher than its preemption threshold may preempt it.
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \param [in] preemptionThreshold is the new preemption threshold for thread
+ */
+
+void setPreemptionThreshold(uint8_t preemptionThreshold);
+
 /**
  * \brief Changes priority of calling (current) thread.
  *
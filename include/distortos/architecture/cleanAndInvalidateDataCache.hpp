@@ -0,0 +1,42 @@
+/**
+ * \file
+ * \brief cleanAndInvalidateDataCache() declaration
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_ARCHITECTURE_CLEANANDINVALIDATEDATACACHE_HPP_
+#define INCLUDE_DISTORTOS_ARCHITECTURE_CLEANANDINVALIDATEDATACACHE_HPP_
+
+#include <cstddef>
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/**
+ * \brief Architecture-specific cleaning and invalidation of data cache.
+ *
+ * Writes back and then discards all data cache lines which overlap given memory region. This must be used before a bus
+ * master other than the core (e.g. DMA) writes to memory which may be cached, so that no dirty cache line gets evicted
+ * over the data written by that bus master.
+ *
+ * If the architecture has no data cache or if data cache is disabled, this function does nothing.
+ *
+ * \param [in] address is the address of memory region
+ * \param [in] size is the size of memory region, bytes
+ */
+
+void cleanAndInvalidateDataCache(void* address, size_t size);
+
+}	// namespace architecture
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_ARCHITECTURE_CLEANANDINVALIDATEDATACACHE_HPP_
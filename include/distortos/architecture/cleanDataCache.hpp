@@ -0,0 +1,42 @@
+/**
+ * \file
+ * \brief cleanDataCache() declaration
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_ARCHITECTURE_CLEANDATACACHE_HPP_
+#define INCLUDE_DISTORTOS_ARCHITECTURE_CLEANDATACACHE_HPP_
+
+#include <cstddef>
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/**
+ * \brief Architecture-specific cleaning of data cache.
+ *
+ * Writes back all dirty data cache lines which overlap given memory region, so that the contents of memory match the
+ * contents of data cache. This must be used before a bus master other than the core (e.g. DMA) reads from memory which
+ * may have been modified by the core.
+ *
+ * If the architecture has no data cache or if data cache is disabled, this function does nothing.
+ *
+ * \param [in] address is the address of memory region
+ * \param [in] size is the size of memory region, bytes
+ */
+
+void cleanDataCache(const void* address, size_t size);
+
+}	// namespace architecture
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_ARCHITECTURE_CLEANDATACACHE_HPP_
@@ -0,0 +1,45 @@
+/**
+ * \file
+ * \brief invalidateDataCache() declaration
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_ARCHITECTURE_INVALIDATEDATACACHE_HPP_
+#define INCLUDE_DISTORTOS_ARCHITECTURE_INVALIDATEDATACACHE_HPP_
+
+#include <cstddef>
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/**
+ * \brief Architecture-specific invalidation of data cache.
+ *
+ * Discards all data cache lines which overlap given memory region, so that subsequent reads are served from memory.
+ * This must be used after a bus master other than the core (e.g. DMA) writes to memory which may be cached.
+ *
+ * \warning Dirty data cache lines are discarded without being written back, so any modifications made by the core to
+ * data which shares a cache line with given memory region are lost. Memory region should therefore be aligned to the
+ * size of data cache line (both its address and its size).
+ *
+ * If the architecture has no data cache or if data cache is disabled, this function does nothing.
+ *
+ * \param [in] address is the address of memory region
+ * \param [in] size is the size of memory region, bytes
+ */
+
+void invalidateDataCache(void* address, size_t size);
+
+}	// namespace architecture
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_ARCHITECTURE_INVALIDATEDATACACHE_HPP_
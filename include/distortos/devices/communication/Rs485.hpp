@@ -2,7 +2,7 @@
  * \file
  * \brief Rs485 class header
  *
- * \author Copyright (C) 2016 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ * \author Copyright (C) 2016-2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -25,6 +25,10 @@ class OutputPin;
 /**
  * \brief Rs485 class is a RS-485 variant of serial port with an interface similar to standard files.
  *
+ * RS-485 driver is controlled either by the low-level UART driver in hardware (if it is requested and supported) or
+ * with an output pin toggled from "transmit start" and "transmit complete" events. Hardware control makes line
+ * turnaround independent from interrupt latency.
+ *
  * \ingroup devices
  */
 
@@ -44,13 +48,26 @@ public:
 	 * to 2
 	 * \param [in] driverEnablePin is a reference to output pin used to control the state of RS-485 driver
 	 * \param [in] driverEnabledState is the state of \a driverEnablePin in which RS-485 driver is enabled
+	 * \param [in] hardwareDriverEnable selects whether hardware control of RS-485 driver should be used if \a uart
+	 * supports it (true) or not (false), default - false; when hardware control is used, "driver enable" output of
+	 * \a uart must be connected to RS-485 driver and \a driverEnablePin is not used
+	 * \param [in] assertionTime is the time between assertion of "driver enable" output and the beginning of start bit
+	 * of first transmitted character, used only with hardware control of RS-485 driver, 1/16 of bit period, default - 0
+	 * \param [in] deassertionTime is the time between the end of stop bit of last transmitted character and deassertion
+	 * of "driver enable" output, used only with hardware control of RS-485 driver, 1/16 of bit period, default - 0
 	 */
 
 	constexpr Rs485(UartLowLevel& uart, void* const readBuffer, const size_t readBufferSize, void* const writeBuffer,
-			const size_t writeBufferSize, OutputPin& driverEnablePin, const bool driverEnabledState) :
+			const size_t writeBufferSize, OutputPin& driverEnablePin, const bool driverEnabledState,
+			const bool hardwareDriverEnable = {}, const uint8_t assertionTime = {},
+			const uint8_t deassertionTime = {}) :
 					SerialPort{uart, readBuffer, readBufferSize, writeBuffer, writeBufferSize},
 					driverEnablePin_{driverEnablePin},
-					driverEnabledState_{driverEnabledState}
+					driverEnableAssertionTime_{assertionTime},
+					driverEnableDeassertionTime_{deassertionTime},
+					driverEnabledState_{driverEnabledState},
+					hardwareDriverEnable_{hardwareDriverEnable},
+					hardwareDriverEnableActive_{}
 	{
 
 	}
@@ -65,6 +82,29 @@ public:
 
 	~Rs485();
 
+	/**
+	 * \brief Opens Rs485.
+	 *
+	 * If hardware control of RS-485 driver was requested, it is configured in low-level UART driver before it is
+	 * started. If low-level UART driver doesn't support it, \a driverEnablePin is used instead.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] baudRate is the desired baud rate, bps
+	 * \param [in] characterLength selects character length, bits
+	 * \param [in] parity selects parity
+	 * \param [in] _2StopBits selects whether 1 (false) or 2 (true) stop bits are used
+	 * \param [in] hardwareFlowControl selects whether hardware flow control is disabled (false) or enabled (true);
+	 * default - disabled (false)
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by UartLowLevel::configureHardwareDriverEnable() (except EBADF and ENOTSUP);
+	 * - error codes returned by SerialPort::open();
+	 */
+
+	int open(uint32_t baudRate, uint8_t characterLength, UartParity parity, bool _2StopBits,
+			bool hardwareFlowControl = {}) override;
+
 protected:
 
 	/**
@@ -72,7 +112,7 @@ protected:
 	 *
 	 * Called by low-level UART driver when the transmission is physically finished.
 	 *
-	 * Disables RS-485 driver and calls SerialPort::transmitCompleteEvent().
+	 * Disables RS-485 driver (if it is not controlled in hardware) and calls SerialPort::transmitCompleteEvent().
 	 */
 
 	void transmitCompleteEvent() override;
@@ -82,7 +122,7 @@ protected:
 	 *
 	 * Called by low-level UART driver when new transmission starts.
 	 *
-	 * Enables RS-485 driver and calls SerialPort::transmitStartEvent().
+	 * Enables RS-485 driver (if it is not controlled in hardware) and calls SerialPort::transmitStartEvent().
 	 */
 
 	void transmitStartEvent() override;
@@ -100,8 +140,20 @@ private:
 	/// reference to output pin used to control the state of RS-485 driver
 	OutputPin& driverEnablePin_;
 
-	/// state of \a driverEnablePin_ in which RS-485 driver is enabled
+	/// time between assertion of "driver enable" output and the beginning of start bit, 1/16 of bit period
+	uint8_t driverEnableAssertionTime_;
+
+	/// time between the end of stop bit and deassertion of "driver enable" output, 1/16 of bit period
+	uint8_t driverEnableDeassertionTime_;
+
+	/// state of RS-485 driver control signal in which RS-485 driver is enabled
 	bool driverEnabledState_;
+
+	/// selects whether hardware control of RS-485 driver should be used if low-level UART driver supports it
+	bool hardwareDriverEnable_;
+
+	/// tells whether RS-485 driver is controlled in hardware by low-level UART driver (true) or not (false)
+	volatile bool hardwareDriverEnableActive_;
 };
 
 }	// namespace devices
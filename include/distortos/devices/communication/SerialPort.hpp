@@ -32,6 +32,10 @@ class UartLowLevel;
 /**
  * \brief SerialPort class is a serial port with an interface similar to standard files.
  *
+ * Reception runs continuously while the device is opened - low-level driver writes received data directly to internal
+ * read buffer. Apart from read(), which copies that data to user's buffer, peek() and consume() can be used to access
+ * received data in place, without any copying.
+ *
  * \ingroup devices
  */
 
@@ -108,6 +112,24 @@ public:
 
 	int close();
 
+	/**
+	 * \brief Consumes data previously accessed with peek().
+	 *
+	 * Consumed data is removed from internal read buffer, so the space it occupied can be used for reception again.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] size is the number of bytes that will be consumed, must be less than or equal to the size of block
+	 * returned by last call to peek(), must be even if selected character length is greater than 8 bits
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a size is invalid;
+	 * - error codes returned by UartLowLevel::startRead();
+	 */
+
+	int consume(size_t size);
+
 	/**
 	 * \brief Opens SerialPort.
 	 *
@@ -131,9 +153,38 @@ public:
 	 * - error codes returned by UartLowLevel::startRead();
 	 */
 
-	int open(uint32_t baudRate, uint8_t characterLength, UartParity parity, bool _2StopBits,
+	virtual int open(uint32_t baudRate, uint8_t characterLength, UartParity parity, bool _2StopBits,
 			bool hardwareFlowControl = {});
 
+	/**
+	 * \brief Provides direct access to data received by SerialPort.
+	 *
+	 * This function will block until at least \a minSize bytes are available in internal read buffer. When \a minSize
+	 * is 0, then the function will not block at all. Returned block is the first contiguous block of received data - it
+	 * may be shorter than \a minSize if available data wraps around the end of internal read buffer. The data remains
+	 * in the buffer until it is consumed with consume(), after which peek() may be called again to get the next block.
+	 *
+	 * Only one thread should use peek() and consume() at a time and this must not be mixed with read().
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] minSize is the minimum amount of data available in internal read buffer, bytes, clamped to the size
+	 * of this buffer, default - 1
+	 * \param [in] timePoint is a pointer to the time point at which the wait will be terminated without \a minSize
+	 * bytes being available, nullptr to wait indefinitely, default - nullptr
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and first contiguous block (as a pair with
+	 * pointer and size) of received data (valid even when error code is returned); error codes:
+	 * - EAGAIN - no data is available without blocking and non-blocking operation was requested (\a minSize is 0);
+	 * - EBADF - the device is not opened;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - required amount of data was not received before the specified timeout expired;
+	 * - error codes returned by UartLowLevel::startRead();
+	 */
+
+	std::pair<int, std::pair<const void*, size_t>> peek(size_t minSize = 1,
+			const TickClock::time_point* timePoint = nullptr);
+
 	/**
 	 * \brief Reads data from SerialPort.
 	 *
@@ -167,6 +218,117 @@ public:
 	std::pair<int, size_t> read(void* buffer, size_t size, size_t minSize = 1,
 			const TickClock::time_point* timePoint = nullptr);
 
+	/**
+	 * \brief Wrapper for peek() with relative timeout
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without \a minSize bytes being
+	 * available
+	 * \param [in] minSize is the minimum amount of data available in internal read buffer, bytes, clamped to the size
+	 * of this buffer, default - 1
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and first contiguous block (as a pair with
+	 * pointer and size) of received data (valid even when error code is returned); error codes:
+	 * - EAGAIN - no data is available without blocking and non-blocking operation was requested (\a minSize is 0);
+	 * - EBADF - the device is not opened;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - required amount of data was not received before the specified timeout expired;
+	 * - error codes returned by UartLowLevel::startRead();
+	 */
+
+	std::pair<int, std::pair<const void*, size_t>> tryPeekFor(const TickClock::duration duration,
+			const size_t minSize = 1)
+	{
+		return tryPeekUntil(TickClock::now() + duration, minSize);
+	}
+
+	/**
+	 * \brief Wrapper for peek() with relative timeout
+	 *
+	 * Template variant of tryPeekFor(TickClock::duration, size_t)
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without \a minSize bytes being
+	 * available
+	 * \param [in] minSize is the minimum amount of data available in internal read buffer, bytes, clamped to the size
+	 * of this buffer, default - 1
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and first contiguous block (as a pair with
+	 * pointer and size) of received data (valid even when error code is returned); error codes:
+	 * - EAGAIN - no data is available without blocking and non-blocking operation was requested (\a minSize is 0);
+	 * - EBADF - the device is not opened;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - required amount of data was not received before the specified timeout expired;
+	 * - error codes returned by UartLowLevel::startRead();
+	 */
+
+	template<typename Rep, typename Period>
+	std::pair<int, std::pair<const void*, size_t>> tryPeekFor(const std::chrono::duration<Rep, Period> duration,
+			const size_t minSize = 1)
+	{
+		return tryPeekFor(std::chrono::duration_cast<TickClock::duration>(duration), minSize);
+	}
+
+	/**
+	 * \brief Wrapper for peek() with absolute timeout
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without \a minSize bytes being
+	 * available
+	 * \param [in] minSize is the minimum amount of data available in internal read buffer, bytes, clamped to the size
+	 * of this buffer, default - 1
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and first contiguous block (as a pair with
+	 * pointer and size) of received data (valid even when error code is returned); error codes:
+	 * - EAGAIN - no data is available without blocking and non-blocking operation was requested (\a minSize is 0);
+	 * - EBADF - the device is not opened;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - required amount of data was not received before the specified timeout expired;
+	 * - error codes returned by UartLowLevel::startRead();
+	 */
+
+	std::pair<int, std::pair<const void*, size_t>> tryPeekUntil(const TickClock::time_point timePoint,
+			const size_t minSize = 1)
+	{
+		return peek(minSize, &timePoint);
+	}
+
+	/**
+	 * \brief Wrapper for peek() with absolute timeout
+	 *
+	 * Template variant of tryPeekUntil(TickClock::time_point, size_t)
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without \a minSize bytes being
+	 * available
+	 * \param [in] minSize is the minimum amount of data available in internal read buffer, bytes, clamped to the size
+	 * of this buffer, default - 1
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and first contiguous block (as a pair with
+	 * pointer and size) of received data (valid even when error code is returned); error codes:
+	 * - EAGAIN - no data is available without blocking and non-blocking operation was requested (\a minSize is 0);
+	 * - EBADF - the device is not opened;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - required amount of data was not received before the specified timeout expired;
+	 * - error codes returned by UartLowLevel::startRead();
+	 */
+
+	template<typename Duration>
+	std::pair<int, std::pair<const void*, size_t>> tryPeekUntil(
+			const std::chrono::time_point<TickClock, Duration> timePoint, const size_t minSize = 1)
+	{
+		return tryPeekUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint), minSize);
+	}
+
 	/**
 	 * \brief Wrapper for read() with relative timeout
 	 *
@@ -438,6 +600,15 @@ public:
 
 protected:
 
+	/**
+	 * \return reference to low-level implementation of UartLowLevel interface
+	 */
+
+	UartLowLevel& getUart() const
+	{
+		return uart_;
+	}
+
 	/**
 	 * \brief "Read complete" event
 	 *
@@ -585,6 +756,24 @@ private:
 
 	size_t stopWriteWrapper();
 
+	/**
+	 * \brief Waits until internal raw circular buffer for read operations contains required amount of data.
+	 *
+	 * The current read operation is shortly stopped and restarted to make all received data available in the buffer.
+	 *
+	 * \param [in] minSize is the minimum amount of data in internal raw circular buffer for read operations, bytes,
+	 * must be less than or equal to the capacity of this buffer
+	 * \param [in] timePoint is a pointer to the time point at which the wait will be terminated without \a minSize
+	 * bytes being available, nullptr to wait indefinitely
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - required amount of data was not received before the specified timeout expired;
+	 * - error codes returned by UartLowLevel::startRead();
+	 */
+
+	int waitForReadBuffer(size_t minSize, const TickClock::time_point* timePoint);
+
 	/**
 	 * \brief Implementation of basic write() functionality
 	 *
@@ -13,7 +13,7 @@
 #define INCLUDE_DISTORTOS_DEVICES_COMMUNICATION_SPIMASTER_HPP_
 
 #include "distortos/devices/communication/SpiMasterBase.hpp"
-#include "distortos/devices/communication/SpiMasterTransfersRange.hpp"
+#include "distortos/devices/communication/SpiMasterTransaction.hpp"
 #include "distortos/devices/communication/SpiMode.hpp"
 
 #include "distortos/Mutex.hpp"
@@ -31,6 +31,14 @@ class SpiMasterLowLevel;
 /**
  * \brief SpiMaster class is a driver for SPI master.
  *
+ * Apart from synchronous transactions executed via SpiMasterHandle, SpiMaster supports asynchronous transactions
+ * submitted with submitTransaction(). These are queued and chained from interrupt context - each one is started as
+ * soon as the previous one is finished. Locking SpiMaster waits for currently executed asynchronous transaction and
+ * suspends the queue until the last unlock, so asynchronous transactions never interleave with synchronous ones.
+ *
+ * Leading transfers of a transaction which fit together in internal staging buffer are merged into a single transfer
+ * of low-level driver, so typical "command + address + data" transactions need fewer transfer setups and interrupts.
+ *
  * \ingroup devices
  */
 
@@ -47,11 +55,22 @@ public:
 	 */
 
 	constexpr explicit SpiMaster(SpiMasterLowLevel& spiMaster) :
+			stagingBuffer_{},
 			mutex_{Mutex::Type::recursive, Mutex::Protocol::priorityInheritance},
+			transactionList_{},
 			transfersRange_{},
 			semaphore_{},
+			transaction_{},
 			spiMaster_{spiMaster},
+			clockFrequency_{},
+			dummyData_{},
+			lockCount_{},
+			mode_{},
 			openCount_{},
+			stagedTransfers_{},
+			wordLength_{8},
+			configured_{},
+			lsbFirst_{},
 			success_{}
 	{
 
@@ -65,14 +84,46 @@ public:
 
 	~SpiMaster() override;
 
+	/**
+	 * \brief Submits asynchronous transaction.
+	 *
+	 * The transaction is appended to the queue of pending transactions. It is started immediately if SPI master is idle
+	 * and not locked, otherwise it is started right after all previously submitted transactions are finished (from
+	 * interrupt context) or after SPI master is unlocked. Configuration of SPI master and slave select pin are handled
+	 * by SpiMaster for each asynchronous transaction.
+	 *
+	 * \note This function may be called from interrupt context.
+	 *
+	 * \warning If SPI master is locked by current thread, the transaction will not be started before the last unlock,
+	 * so waiting for its completion while holding the lock results in a deadlock.
+	 *
+	 * \pre Device is opened and stays opened until \a transaction is finished.
+	 *
+	 * \param [in] transaction is a reference to transaction that will be submitted
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - EBUSY - \a transaction is already pending;
+	 * - EINVAL - range of transfers of \a transaction is empty;
+	 */
+
+	int submitTransaction(SpiMasterTransaction& transaction);
+
 private:
 
+	/// size of staging buffer used for merging of transfers, bytes
+	constexpr static size_t stagingBufferSize {32};
+
+	/// type of intrusive list with pending asynchronous transactions
+	using TransactionList = estd::IntrusiveList<SpiMasterTransaction, &SpiMasterTransaction::node>;
+
 	/**
 	 * \brief Closes SPI master.
 	 *
 	 * Does nothing if any user still has this device opened. Otherwise low-level driver is stopped.
 	 *
 	 * \pre Device is opened.
+	 * \pre If this is the last close, there are no pending asynchronous transactions.
 	 */
 
 	void close();
@@ -80,6 +131,8 @@ private:
 	/**
 	 * \brief Configures parameters of SPI master.
 	 *
+	 * Low-level SPI master driver is reconfigured only if any parameter differs from currently configured value.
+	 *
 	 * \pre Device is opened.
 	 * \pre \a clockFrequency and \a wordLength are valid for associated low-level implementation of SpiMasterLowLevel
 	 * interface.
@@ -91,8 +144,7 @@ private:
 	 * \param [in] dummyData is the dummy data that will be sent if write buffer of transfer is nullptr
 	 */
 
-	void configure(SpiMode mode, uint32_t clockFrequency, uint8_t wordLength, bool lsbFirst,
-			uint32_t dummyData) const;
+	void configure(SpiMode mode, uint32_t clockFrequency, uint8_t wordLength, bool lsbFirst, uint32_t dummyData);
 
 	/**
 	 * \brief Executes series of transfers as a single atomic transaction.
@@ -112,9 +164,26 @@ private:
 
 	int executeTransaction(SpiMasterTransfersRange transfersRange);
 
+	/**
+	 * \brief Finishes currently executed asynchronous transaction.
+	 *
+	 * Slave select pin of the transaction is deasserted, next asynchronous transaction is started (if SPI master is not
+	 * locked) and SpiMasterTransaction::transactionCompleteEvent() is executed.
+	 *
+	 * \note This function must be called from interrupt context or with interrupts masked.
+	 *
+	 * \param [in] success tells whether the transaction was successful (true) or not (false)
+	 */
+
+	void finishTransaction(bool success);
+
 	/**
 	 * \brief Locks SPI master for exclusive use by current thread.
 	 *
+	 * First lock waits until currently executed asynchronous transaction (if any) is finished and suspends starting of
+	 * the next ones. Note that configuration of SPI master may be changed by asynchronous transactions executed while
+	 * SPI master was not locked.
+	 *
 	 * \note Locks are recursive.
 	 *
 	 * \warning This function must not be called from interrupt context!
@@ -147,13 +216,55 @@ private:
 
 	int open();
 
+	/**
+	 * \brief Starts next asynchronous transaction.
+	 *
+	 * If SPI master is locked, only the thread waiting in lock() for the end of asynchronous transaction is notified.
+	 * Otherwise the first transaction from the queue (if any) is started.
+	 *
+	 * \note This function must be called from interrupt context or with interrupts masked.
+	 *
+	 * \pre No asynchronous transaction is executed.
+	 */
+
+	void startNextTransaction();
+
+	/**
+	 * \brief Starts next transfer from the currently handled transaction.
+	 *
+	 * If at least two leading transfers fit in staging buffer, their write data (or dummy data) is gathered there and
+	 * they are executed as a single transfer of low-level driver. Received data is scattered to read buffers of these
+	 * transfers in transferCompleteEvent().
+	 *
+	 * \note This function must be called from interrupt context or with interrupts masked (or when no transfer can
+	 * complete concurrently).
+	 *
+	 * \pre Currently handled transaction has at least one transfer left.
+	 */
+
+	void startNextTransfer();
+
+	/**
+	 * \brief Starts asynchronous transaction.
+	 *
+	 * SPI master is configured, slave select pin is asserted and the first transfer of the transaction is started.
+	 *
+	 * \note This function must be called from interrupt context or with interrupts masked.
+	 *
+	 * \pre No transaction is executed.
+	 *
+	 * \param [in] transaction is a reference to transaction that will be started
+	 */
+
+	void startTransaction(SpiMasterTransaction& transaction);
+
 	/**
 	 * \brief "Transfer complete" event
 	 *
 	 * Called by low-level SPI master driver when the transfer is physically finished.
 	 *
 	 * Handles the next transfer from the currently handled transaction. If there are no more transfers, waiting thread
-	 * is notified about completion of transaction.
+	 * is notified about completion of synchronous transaction or asynchronous transaction is finished.
 	 *
 	 * \param [in] success tells whether the transfer was successful (true) or not (false)
 	 */
@@ -172,21 +283,54 @@ private:
 
 	void unlock();
 
+	/// staging buffer used for merging of transfers, aligned so that it doesn't share cache lines with other data
+	alignas(stagingBufferSize) uint8_t stagingBuffer_[stagingBufferSize];
+
 	/// mutex used to serialize access to this object
 	Mutex mutex_;
 
+	/// list of pending asynchronous transactions which were not started yet, in the order of submission
+	TransactionList transactionList_;
+
 	/// range of transfers that are part of currently handled transaction
 	SpiMasterTransfersRange transfersRange_;
 
 	/// pointer to semaphore used to notify waiting thread about completion of transaction
 	Semaphore* volatile semaphore_;
 
+	/// pointer to currently executed asynchronous transaction, nullptr if none
+	SpiMasterTransaction* volatile transaction_;
+
 	/// reference to low-level implementation of SpiMasterLowLevel interface
 	SpiMasterLowLevel& spiMaster_;
 
+	/// clock frequency, Hz, copy of currently configured value
+	uint32_t clockFrequency_;
+
+	/// dummy data that will be sent if write buffer of transfer is nullptr, copy of currently configured value
+	uint32_t dummyData_;
+
+	/// number of recursive locks of this device
+	uint16_t lockCount_;
+
+	/// SPI mode, copy of currently configured value
+	SpiMode mode_;
+
 	/// number of times this device was opened but not yet closed
 	uint8_t openCount_;
 
+	/// number of transfers merged in staging buffer in currently executed transfer, 0 if transfer is not merged
+	uint8_t stagedTransfers_;
+
+	/// word length, bits, copy of currently configured value
+	uint8_t wordLength_;
+
+	/// tells whether low-level SPI master driver was configured since it was started (true) or not (false)
+	bool configured_;
+
+	/// selects whether MSB (false) or LSB (true) is transmitted first, copy of currently configured value
+	bool lsbFirst_;
+
 	/// tells whether the transaction was successful (true) or not (false)
 	volatile bool success_;
 };
@@ -0,0 +1,177 @@
+/**
+ * \file
+ * \brief SpiMasterTransaction class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_COMMUNICATION_SPIMASTERTRANSACTION_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_COMMUNICATION_SPIMASTERTRANSACTION_HPP_
+
+#include "distortos/devices/communication/SpiMasterTransfersRange.hpp"
+#include "distortos/devices/communication/SpiMode.hpp"
+
+#include "estd/IntrusiveList.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+class Semaphore;
+
+namespace devices
+{
+
+class OutputPin;
+class SpiMaster;
+
+/**
+ * \brief SpiMasterTransaction class is a single asynchronous transaction of SpiMaster.
+ *
+ * Transaction contains the range of transfers, configuration of SPI master which should be used for these transfers
+ * and optional slave select pin, which is asserted for the duration of the transaction. Transaction is submitted with
+ * SpiMaster::submitTransaction() and executed in the order of submission, chained directly from interrupt context, so
+ * the bus doesn't idle between transactions of different devices.
+ *
+ * When the transaction is finished, transactionCompleteEvent() is executed from interrupt context. Default
+ * implementation posts the semaphore passed to the constructor (if any), derived classes may override it to implement
+ * completion callbacks.
+ *
+ * \warning Transaction object, its range of transfers and all buffers used by these transfers must remain valid until
+ * the transaction is finished.
+ *
+ * \ingroup devices
+ */
+
+class SpiMasterTransaction
+{
+	friend class SpiMaster;
+
+public:
+
+	/**
+	 * \brief SpiMasterTransaction's constructor
+	 *
+	 * \param [in] transfersRange is the range of transfers that will be executed, must have at least one transfer
+	 * \param [in] slaveSelectPin is a pointer to slave select pin which will be asserted for the duration of the
+	 * transaction, nullptr to disable slave select handling
+	 * \param [in] mode is the desired SPI mode
+	 * \param [in] clockFrequency is the desired clock frequency, Hz
+	 * \param [in] wordLength selects word length, bits
+	 * \param [in] lsbFirst selects whether MSB (false) or LSB (true) is transmitted first
+	 * \param [in] dummyData is the dummy data that will be sent if write buffer of transfer is nullptr
+	 * \param [in] semaphore is a pointer to semaphore which will be posted when the transaction is finished, nullptr
+	 * to disable, default - nullptr
+	 */
+
+	constexpr SpiMasterTransaction(const SpiMasterTransfersRange transfersRange, OutputPin* const slaveSelectPin,
+			const SpiMode mode, const uint32_t clockFrequency, const uint8_t wordLength, const bool lsbFirst,
+			const uint32_t dummyData, Semaphore* const semaphore = {}) :
+					node{},
+					transfersRange_{transfersRange},
+					slaveSelectPin_{slaveSelectPin},
+					semaphore_{semaphore},
+					clockFrequency_{clockFrequency},
+					dummyData_{dummyData},
+					ret_{},
+					mode_{mode},
+					wordLength_{wordLength},
+					lsbFirst_{lsbFirst},
+					pending_{}
+	{
+
+	}
+
+	/**
+	 * \brief SpiMasterTransaction's destructor
+	 *
+	 * \pre Transaction is not pending.
+	 */
+
+	virtual ~SpiMasterTransaction();
+
+	/**
+	 * \return result of the transaction (0 on success, error code otherwise), EINPROGRESS if the transaction is
+	 * pending; error codes:
+	 * - EIO - failure detected by low-level SPI master driver;
+	 */
+
+	int getResult() const
+	{
+		return pending_ == true ? EINPROGRESS : ret_;
+	}
+
+	/**
+	 * \return true if the transaction was submitted and is not finished yet, false otherwise
+	 */
+
+	bool isPending() const
+	{
+		return pending_;
+	}
+
+	SpiMasterTransaction(const SpiMasterTransaction&) = delete;
+	SpiMasterTransaction(SpiMasterTransaction&&) = delete;
+	const SpiMasterTransaction& operator=(const SpiMasterTransaction&) = delete;
+	SpiMasterTransaction& operator=(SpiMasterTransaction&&) = delete;
+
+	/// node for intrusive list of pending transactions
+	estd::IntrusiveListNode node;
+
+private:
+
+	/**
+	 * \brief "Transaction complete" event
+	 *
+	 * Called by SpiMaster from interrupt context when the transaction is finished. Next transaction from the queue is
+	 * already started when this function is called. The transaction is still pending during this call - it stops being
+	 * pending after this function returns, so it must not be submitted again from here.
+	 *
+	 * Default implementation posts the semaphore passed to the constructor (if any).
+	 *
+	 * \param [in] ret is the result of the transaction (0 on success, error code otherwise)
+	 */
+
+	virtual void transactionCompleteEvent(int ret);
+
+	/// range of transfers that will be executed
+	SpiMasterTransfersRange transfersRange_;
+
+	/// pointer to slave select pin, nullptr if slave select handling is disabled
+	OutputPin* slaveSelectPin_;
+
+	/// pointer to semaphore which will be posted when the transaction is finished, nullptr if disabled
+	Semaphore* semaphore_;
+
+	/// desired clock frequency, Hz
+	uint32_t clockFrequency_;
+
+	/// dummy data that will be sent if write buffer of transfer is nullptr
+	uint32_t dummyData_;
+
+	/// result of the last execution of the transaction (0 on success, error code otherwise)
+	volatile int ret_;
+
+	/// desired SPI mode
+	SpiMode mode_;
+
+	/// word length, bits
+	uint8_t wordLength_;
+
+	/// selects whether MSB (false) or LSB (true) is transmitted first
+	bool lsbFirst_;
+
+	/// tells whether the transaction was submitted and is not finished yet (true) or not (false)
+	volatile bool pending_;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_COMMUNICATION_SPIMASTERTRANSACTION_HPP_
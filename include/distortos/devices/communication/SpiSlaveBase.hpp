@@ -0,0 +1,69 @@
+/**
+ * \file
+ * \brief SpiSlaveBase class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_COMMUNICATION_SPISLAVEBASE_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_COMMUNICATION_SPISLAVEBASE_HPP_
+
+#include <cstddef>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/**
+ * \brief SpiSlaveBase class is an interface with callbacks for low-level SPI slave driver, which can serve as a base
+ * for high-level SPI slave drivers.
+ *
+ * \ingroup devices
+ */
+
+class SpiSlaveBase
+{
+public:
+
+	/**
+	 * \brief SpiSlaveBase's destructor
+	 */
+
+	virtual ~SpiSlaveBase() = default;
+
+	/**
+	 * \brief "Frame complete" event
+	 *
+	 * Called by low-level SPI slave driver each time half of circular buffers was transferred. Transfer of the other
+	 * half is already in progress when this function is called.
+	 *
+	 * \param [in] readFrame is a pointer to received data, it is valid until the same half of read buffer is filled
+	 * again
+	 * \param [out] writeFrame is a pointer to transmitted half of write buffer, which may be filled with data that will
+	 * be sent next time, nullptr if write buffer is not used
+	 * \param [in] size is the size of frame (half of the size of circular buffers), bytes
+	 */
+
+	virtual void frameCompleteEvent(const void* readFrame, void* writeFrame, size_t size) = 0;
+
+	/**
+	 * \brief "Transfer error" event
+	 *
+	 * Called by low-level SPI slave driver when transfer error is detected. Transfers are stopped, low-level SPI slave
+	 * driver must be stopped and started again to resume them.
+	 */
+
+	virtual void transferErrorEvent() = 0;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_COMMUNICATION_SPISLAVEBASE_HPP_
@@ -0,0 +1,86 @@
+/**
+ * \file
+ * \brief SpiSlaveLowLevel class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_COMMUNICATION_SPISLAVELOWLEVEL_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_COMMUNICATION_SPISLAVELOWLEVEL_HPP_
+
+#include "distortos/devices/communication/SpiMode.hpp"
+
+#include <cstddef>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+class SpiSlaveBase;
+
+/**
+ * \brief SpiSlaveLowLevel class is an interface for low-level SPI slave driver.
+ *
+ * Low-level SPI slave driver transfers data continuously using circular read and write buffers, so that the
+ * peripheral is never left without buffer space when SPI master clocks the bus. Each half of these buffers is a single
+ * frame, which is passed to SpiSlaveBase::frameCompleteEvent() without copying.
+ *
+ * \ingroup devices
+ */
+
+class SpiSlaveLowLevel
+{
+public:
+
+	/**
+	 * \brief SpiSlaveLowLevel's destructor
+	 *
+	 * \pre Driver is stopped.
+	 */
+
+	virtual ~SpiSlaveLowLevel() = default;
+
+	/**
+	 * \brief Starts low-level SPI slave driver.
+	 *
+	 * This function returns immediately. Each time half of circular buffers is transferred,
+	 * SpiSlaveBase::frameCompleteEvent() will be executed. When transfer error is detected,
+	 * SpiSlaveBase::transferErrorEvent() will be executed.
+	 *
+	 * \param [in] spiSlaveBase is a reference to SpiSlaveBase object that will be associated with this one
+	 * \param [out] readBuffer is the circular buffer to which received data will be written
+	 * \param [in] writeBuffer is the circular buffer with data that will be transmitted, nullptr to send dummy data
+	 * \param [in] size is the size of \a readBuffer and \a writeBuffer, bytes, must be divisible by two frames
+	 * \param [in] mode is the desired SPI mode
+	 * \param [in] wordLength selects word length, bits
+	 * \param [in] lsbFirst selects whether MSB (false) or LSB (true) is transmitted first
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the driver is not stopped;
+	 * - EINVAL - \a readBuffer, \a size and/or \a wordLength are invalid;
+	 */
+
+	virtual int start(SpiSlaveBase& spiSlaveBase, void* readBuffer, void* writeBuffer, size_t size, SpiMode mode,
+			uint8_t wordLength, bool lsbFirst) = 0;
+
+	/**
+	 * \brief Stops low-level SPI slave driver.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the driver is not started;
+	 */
+
+	virtual int stop() = 0;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_COMMUNICATION_SPISLAVELOWLEVEL_HPP_
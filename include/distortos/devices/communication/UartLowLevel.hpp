@@ -16,6 +16,7 @@
 
 #include <utility>
 
+#include <cerrno>
 #include <cstddef>
 
 namespace distortos
@@ -42,6 +43,37 @@ public:
 
 	virtual ~UartLowLevel() = default;
 
+	/**
+	 * \brief Configures hardware control of RS-485 driver.
+	 *
+	 * When hardware control is enabled, "driver enable" output of UART is asserted by hardware for the duration of each
+	 * transmission. New configuration is used by next call to start().
+	 *
+	 * Default implementation returns ENOTSUP.
+	 *
+	 * \param [in] enable selects whether hardware control of RS-485 driver is enabled (true) or disabled (false)
+	 * \param [in] driverEnabledState is the state of "driver enable" output in which RS-485 driver is enabled
+	 * \param [in] assertionTime is the time between assertion of "driver enable" output and the beginning of start bit
+	 * of first transmitted character, 1/16 of bit period, [0; 31]
+	 * \param [in] deassertionTime is the time between the end of stop bit of last transmitted character and deassertion
+	 * of "driver enable" output, 1/16 of bit period, [0; 31]
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the driver is not stopped;
+	 * - EINVAL - \a assertionTime and/or \a deassertionTime are invalid;
+	 * - ENOTSUP - hardware control of RS-485 driver is not supported;
+	 */
+
+	virtual int configureHardwareDriverEnable(const bool enable, const bool driverEnabledState,
+			const uint8_t assertionTime, const uint8_t deassertionTime)
+	{
+		(void)enable;
+		(void)driverEnabledState;
+		(void)assertionTime;
+		(void)deassertionTime;
+		return ENOTSUP;
+	}
+
 	/**
 	 * \brief Starts low-level UART driver.
 	 *
@@ -0,0 +1,301 @@
+/**
+ * \file
+ * \brief AsynchronousBlockDevice class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_MEMORY_ASYNCHRONOUSBLOCKDEVICE_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_MEMORY_ASYNCHRONOUSBLOCKDEVICE_HPP_
+
+#include "distortos/devices/memory/BlockDevice.hpp"
+
+#include "distortos/Mutex.hpp"
+#include "distortos/Semaphore.hpp"
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/**
+ * \brief AsynchronousBlockDevice class is a thread-backed asynchronous wrapper for BlockDevice.
+ *
+ * Requests submitted with submitRequest() are queued and executed - one by one, in the order of submission - by a
+ * worker thread, which executes run() (or calls executeNextRequest() in a loop). This way the thread which submitted
+ * the request may do other work (e.g. prepare the data for next request) while the associated block device is busy.
+ * "Request complete" events are executed from the context of the worker thread.
+ *
+ * All other functions are forwarded directly to the associated block device, which serializes them with the requests
+ * executed by the worker thread.
+ *
+ * Locking with lock() uses a separate mutex, it is not forwarded to the associated block device - this way a thread
+ * which locked this object (e.g. a wrapper like BufferingBlockDevice, which locks the device for the duration of each
+ * operation) may wait for completion of its requests without blocking the worker thread.
+ *
+ * \ingroup devices
+ */
+
+class AsynchronousBlockDevice : public BlockDevice
+{
+public:
+
+	/**
+	 * \brief AsynchronousBlockDevice's constructor
+	 *
+	 * \param [in] blockDevice is a reference to associated block device
+	 */
+
+	constexpr explicit AsynchronousBlockDevice(BlockDevice& blockDevice) :
+			requestList_{},
+			mutex_{Mutex::Type::recursive, Mutex::Protocol::priorityInheritance},
+			semaphore_{0},
+			blockDevice_{blockDevice}
+	{
+
+	}
+
+	/**
+	 * \brief AsynchronousBlockDevice's destructor
+	 *
+	 * \pre Device is closed.
+	 * \pre No request is pending.
+	 */
+
+	~AsynchronousBlockDevice() override;
+
+	/**
+	 * \brief Closes device.
+	 *
+	 * \note Even if error code is returned, the device must not be used from the context which opened it (until it is
+	 * successfully opened again).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre No request submitted by the context which opened the device is pending.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::close();
+	 */
+
+	int close() override;
+
+	/**
+	 * \brief Discards blocks on a device.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of range that will be discarded, must be a multiple of block size
+	 * \param [in] size is the size of discarded range, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::discard();
+	 */
+
+	int discard(uint64_t address, uint64_t size) override;
+
+	/**
+	 * \brief Erases blocks on a device.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of range that will be erased, must be a multiple of block size
+	 * \param [in] size is the size of erased range, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::erase();
+	 */
+
+	int erase(uint64_t address, uint64_t size) override;
+
+	/**
+	 * \brief Executes next submitted request.
+	 *
+	 * Waits until there is at least one pending request which is not executed yet, then executes the oldest one with
+	 * BlockDevice::read() or BlockDevice::write() of associated block device and finishes it.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \note This function should be called only by the worker thread.
+	 */
+
+	void executeNextRequest();
+
+	/**
+	 * \return block size, bytes
+	 */
+
+	size_t getBlockSize() const override;
+
+	/**
+	 * \return size of block device, bytes
+	 */
+
+	uint64_t getSize() const override;
+
+	/**
+	 * \brief Locks the device for exclusive use by current thread.
+	 *
+	 * When the object is locked, any call to any member function from other thread will be blocked until the object is
+	 * unlocked. Locking is optional, but may be useful when more than one transaction must be done atomically.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre The number of recursive locks of device is less than 65535.
+	 *
+	 * \post Device is locked.
+	 */
+
+	void lock() override;
+
+	/**
+	 * \brief Opens device.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre The number of times the device is opened is less than 255.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::open();
+	 */
+
+	int open() override;
+
+	/**
+	 * \brief Reads data from a device.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a buffer and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of data that will be read, must be a multiple of block size
+	 * \param [out] buffer is the buffer into which the data will be read, must be valid
+	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::read();
+	 */
+
+	int read(uint64_t address, void* buffer, size_t size) override;
+
+	/**
+	 * \brief Executes submitted requests.
+	 *
+	 * This function never returns, it should be used as the function of worker thread, for example:
+	 *
+	 * \code
+	 * auto workerThread = distortos::makeAndStartStaticThread<1024>(1, &AsynchronousBlockDevice::run,
+	 * 		std::ref(asynchronousBlockDevice));
+	 * \endcode
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 */
+
+	void run();
+
+	/**
+	 * \brief Submits asynchronous read or write request.
+	 *
+	 * The request is appended to the queue of pending requests and this function returns immediately.
+	 *
+	 * \note This function may be called from interrupt context.
+	 *
+	 * \pre Device is opened and stays opened until \a request is finished.
+	 * \pre Address, buffer and size of \a request are valid - just like for read() or write().
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] request is a reference to request that will be submitted
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBUSY - \a request is already pending;
+	 */
+
+	int submitRequest(BlockDeviceRequest& request) override;
+
+	/**
+	 * \brief Synchronizes state of a device, ensuring all cached writes are finished.
+	 *
+	 * \note Requests which are pending are not affected by this function.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::synchronize();
+	 */
+
+	int synchronize() override;
+
+	/**
+	 * \brief Unlocks the device which was previously locked by current thread.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre This function is called by the thread that locked the device.
+	 */
+
+	void unlock() override;
+
+	/**
+	 * \brief Writes data to a device.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a buffer and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of data that will be written, must be a multiple of block size
+	 * \param [in] buffer is the buffer with data that will be written, must be valid
+	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::write();
+	 */
+
+	int write(uint64_t address, const void* buffer, size_t size) override;
+
+private:
+
+	/// type of intrusive list with pending requests
+	using RequestList = estd::IntrusiveList<BlockDeviceRequest, &BlockDeviceRequest::node>;
+
+	/// list of pending requests which are not executed yet
+	RequestList requestList_;
+
+	/// mutex used to serialize access to this object, requests executed by the worker thread don't use it
+	Mutex mutex_;
+
+	/// semaphore with the number of pending requests which are not executed yet
+	Semaphore semaphore_;
+
+	/// reference to associated block device
+	BlockDevice& blockDevice_;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_MEMORY_ASYNCHRONOUSBLOCKDEVICE_HPP_
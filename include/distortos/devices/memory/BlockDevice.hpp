@@ -12,8 +12,7 @@
 #ifndef INCLUDE_DISTORTOS_DEVICES_MEMORY_BLOCKDEVICE_HPP_
 #define INCLUDE_DISTORTOS_DEVICES_MEMORY_BLOCKDEVICE_HPP_
 
-#include <cstddef>
-#include <cstdint>
+#include "distortos/devices/memory/BlockDeviceRequest.hpp"
 
 namespace distortos
 {
@@ -52,6 +51,28 @@ public:
 
 	virtual int close() = 0;
 
+	/**
+	 * \brief Discards blocks on a device.
+	 *
+	 * This is a hint for the device that contents of selected range are no longer needed (e.g. because the file system
+	 * freed it), so the device can use this information for internal management of its media. After discard the
+	 * contents of selected range are undefined. Default implementation does nothing.
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of range that will be discarded, must be a multiple of block size
+	 * \param [in] size is the size of discarded range, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise
+	 */
+
+	virtual int discard(uint64_t, uint64_t)
+	{
+		return {};
+	}
+
 	/**
 	 * \brief Erases blocks on a device.
 	 *
@@ -122,6 +143,36 @@ public:
 
 	virtual int read(uint64_t address, void* buffer, size_t size) = 0;
 
+	/**
+	 * \brief Submits asynchronous read or write request.
+	 *
+	 * Default implementation executes the request synchronously - with read() or write() - in the context of the
+	 * caller, so the request is already finished when this function returns. Devices which can overlap execution of
+	 * requests with the work of the caller override this function.
+	 *
+	 * \pre Device is opened and stays opened until \a request is finished.
+	 * \pre Address, buffer and size of \a request are valid - just like for read() or write().
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] request is a reference to request that will be submitted
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBUSY - \a request is already pending;
+	 */
+
+	virtual int submitRequest(BlockDeviceRequest& request)
+	{
+		if (request.isPending() == true)
+			return EBUSY;
+
+		beginRequest(request);
+		const auto ret = request.isWriteRequest() == false ?
+				read(request.getAddress(), request.getReadBuffer(), request.getSize()) :
+				write(request.getAddress(), request.getWriteBuffer(), request.getSize());
+		finishRequest(request, ret);
+		return 0;
+	}
+
 	/**
 	 * \brief Synchronizes state of a device, ensuring all cached writes are finished.
 	 *
@@ -163,6 +214,40 @@ public:
 	BlockDevice() = default;
 	BlockDevice(const BlockDevice&) = delete;
 	BlockDevice& operator=(const BlockDevice&) = delete;
+
+protected:
+
+	/**
+	 * \brief Marks request as pending.
+	 *
+	 * \pre \a request is not pending.
+	 *
+	 * \param [in] request is a reference to request which is submitted
+	 */
+
+	static void beginRequest(BlockDeviceRequest& request)
+	{
+		request.ret_ = {};
+		request.pending_ = true;
+	}
+
+	/**
+	 * \brief Finishes request and executes its "request complete" event.
+	 *
+	 * The event is the last access of \a request, so the request may be submitted again or destroyed from there.
+	 *
+	 * \pre \a request is pending.
+	 *
+	 * \param [in] request is a reference to request which is finished
+	 * \param [in] ret is the result of the request (0 on success, error code otherwise)
+	 */
+
+	static void finishRequest(BlockDeviceRequest& request, const int ret)
+	{
+		request.ret_ = ret;
+		request.pending_ = false;
+		request.requestCompleteEvent(ret);
+	}
 };
 
 }	// namespace devices
@@ -0,0 +1,254 @@
+/**
+ * \file
+ * \brief BlockDeviceRequest class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_MEMORY_BLOCKDEVICEREQUEST_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_MEMORY_BLOCKDEVICEREQUEST_HPP_
+
+#include "estd/IntrusiveList.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+namespace distortos
+{
+
+class Semaphore;
+
+namespace devices
+{
+
+class BlockDevice;
+
+/**
+ * \brief BlockDeviceRequest class is a single asynchronous read or write request of BlockDevice.
+ *
+ * Request is submitted with BlockDevice::submitRequest(). When the request is finished, requestCompleteEvent() is
+ * executed - from interrupt or thread context, depending on the device which executes the request. Default
+ * implementation posts the semaphore passed to the constructor (if any), derived classes may override it to implement
+ * completion callbacks.
+ *
+ * Queue depth is determined by the number of request objects submitted by the caller - submitting the next request
+ * before the previous one is finished lets the device start it without any idle time in between.
+ *
+ * \warning Request object and its buffer must remain valid until the request is finished.
+ *
+ * \ingroup devices
+ */
+
+class BlockDeviceRequest
+{
+	friend class BlockDevice;
+
+public:
+
+	/**
+	 * \brief BlockDeviceRequest's constructor for read request
+	 *
+	 * \param [in] address is the address of data that will be read, must be a multiple of block size
+	 * \param [out] readBuffer is the buffer into which the data will be read, must be valid
+	 * \param [in] size is the size of \a readBuffer, bytes, must be a multiple of block size
+	 * \param [in] semaphore is a pointer to semaphore which will be posted when the request is finished, nullptr to
+	 * disable, default - nullptr
+	 */
+
+	constexpr BlockDeviceRequest(const uint64_t address, void* const readBuffer, const size_t size,
+			Semaphore* const semaphore = {}) :
+					node{},
+					address_{address},
+					readBuffer_{readBuffer},
+					size_{size},
+					semaphore_{semaphore},
+					ret_{},
+					writeRequest_{},
+					pending_{}
+	{
+
+	}
+
+	/**
+	 * \brief BlockDeviceRequest's constructor for write request
+	 *
+	 * \param [in] address is the address of data that will be written, must be a multiple of block size
+	 * \param [in] writeBuffer is the buffer with data that will be written, must be valid
+	 * \param [in] size is the size of \a writeBuffer, bytes, must be a multiple of block size
+	 * \param [in] semaphore is a pointer to semaphore which will be posted when the request is finished, nullptr to
+	 * disable, default - nullptr
+	 */
+
+	constexpr BlockDeviceRequest(const uint64_t address, const void* const writeBuffer, const size_t size,
+			Semaphore* const semaphore = {}) :
+					node{},
+					address_{address},
+					writeBuffer_{writeBuffer},
+					size_{size},
+					semaphore_{semaphore},
+					ret_{},
+					writeRequest_{true},
+					pending_{}
+	{
+
+	}
+
+	/**
+	 * \brief BlockDeviceRequest's destructor
+	 *
+	 * \pre Request is not pending.
+	 */
+
+	virtual ~BlockDeviceRequest();
+
+	/**
+	 * \return address of data that will be read or written
+	 */
+
+	uint64_t getAddress() const
+	{
+		return address_;
+	}
+
+	/**
+	 * \return buffer into which the data will be read, valid only if isWriteRequest() returns false
+	 */
+
+	void* getReadBuffer() const
+	{
+		return readBuffer_;
+	}
+
+	/**
+	 * \return result of the request (0 on success, error code otherwise), EINPROGRESS if the request is pending; error
+	 * codes:
+	 * - error codes returned by BlockDevice::read() or BlockDevice::write();
+	 */
+
+	int getResult() const
+	{
+		return pending_ == true ? EINPROGRESS : ret_;
+	}
+
+	/**
+	 * \return size of read or written data, bytes
+	 */
+
+	size_t getSize() const
+	{
+		return size_;
+	}
+
+	/**
+	 * \return buffer with data that will be written, valid only if isWriteRequest() returns true
+	 */
+
+	const void* getWriteBuffer() const
+	{
+		return writeBuffer_;
+	}
+
+	/**
+	 * \return true if the request was submitted and is not finished yet, false otherwise
+	 */
+
+	bool isPending() const
+	{
+		return pending_;
+	}
+
+	/**
+	 * \return true if this is a write request, false if this is a read request
+	 */
+
+	bool isWriteRequest() const
+	{
+		return writeRequest_;
+	}
+
+	/**
+	 * \brief Changes the object into read request.
+	 *
+	 * \pre Request is not pending.
+	 *
+	 * \param [in] address is the address of data that will be read, must be a multiple of block size
+	 * \param [out] readBuffer is the buffer into which the data will be read, must be valid
+	 * \param [in] size is the size of \a readBuffer, bytes, must be a multiple of block size
+	 */
+
+	void setReadRequest(uint64_t address, void* readBuffer, size_t size);
+
+	/**
+	 * \brief Changes the object into write request.
+	 *
+	 * \pre Request is not pending.
+	 *
+	 * \param [in] address is the address of data that will be written, must be a multiple of block size
+	 * \param [in] writeBuffer is the buffer with data that will be written, must be valid
+	 * \param [in] size is the size of \a writeBuffer, bytes, must be a multiple of block size
+	 */
+
+	void setWriteRequest(uint64_t address, const void* writeBuffer, size_t size);
+
+	BlockDeviceRequest(const BlockDeviceRequest&) = delete;
+	BlockDeviceRequest(BlockDeviceRequest&&) = delete;
+	const BlockDeviceRequest& operator=(const BlockDeviceRequest&) = delete;
+	BlockDeviceRequest& operator=(BlockDeviceRequest&&) = delete;
+
+	/// node for intrusive list of pending requests
+	estd::IntrusiveListNode node;
+
+private:
+
+	/**
+	 * \brief "Request complete" event
+	 *
+	 * Called by the device when the request is finished. The request is not pending any more during this call and this
+	 * is the last access of the request by the device - it may be submitted again from here and it may be destroyed as
+	 * soon as this function is done with it (e.g. right after the semaphore is posted).
+	 *
+	 * Default implementation posts the semaphore passed to the constructor (if any).
+	 *
+	 * \param [in] ret is the result of the request (0 on success, error code otherwise)
+	 */
+
+	virtual void requestCompleteEvent(int ret);
+
+	/// address of data that will be read or written
+	uint64_t address_;
+
+	union
+	{
+		/// buffer into which the data will be read, valid only if \a writeRequest_ is false
+		void* readBuffer_;
+
+		/// buffer with data that will be written, valid only if \a writeRequest_ is true
+		const void* writeBuffer_;
+	};
+
+	/// size of \a readBuffer_ or \a writeBuffer_, bytes
+	size_t size_;
+
+	/// pointer to semaphore which will be posted when the request is finished, nullptr if disabled
+	Semaphore* semaphore_;
+
+	/// result of the last execution of the request (0 on success, error code otherwise)
+	volatile int ret_;
+
+	/// selects whether this is a read (false) or write (true) request
+	bool writeRequest_;
+
+	/// tells whether the request was submitted and is not finished yet (true) or not (false)
+	volatile bool pending_;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_MEMORY_BLOCKDEVICEREQUEST_HPP_
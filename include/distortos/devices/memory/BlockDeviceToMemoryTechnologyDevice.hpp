@@ -26,6 +26,10 @@ class BlockDevice;
  * \brief BlockDeviceToMemoryTechnologyDevice class is a wrapper for BlockDevice which implements MemoryTechnologyDevice
  * interface by buffering erase operations.
  *
+ * Erase operations are forwarded to the block device as BlockDevice::discard(), as block devices don't need to be
+ * erased before being written - this way the block device is informed about blocks which are no longer used, which is
+ * all it needs.
+ *
  * \ingroup devices
  */
 
@@ -70,7 +74,7 @@ public:
 	 *
 	 * \return 0 on success, error code otherwise:
 	 * - error codes returned by BlockDevice::close();
-	 * - error codes returned by BlockDevice::erase();
+	 * - error codes returned by BlockDevice::discard();
 	 */
 
 	int close() override;
@@ -88,7 +92,7 @@ public:
 	 * \param [in] size is the size of erased range, bytes, must be a multiple of erase block size
 	 *
 	 * \return 0 on success, error code otherwise:
-	 * - error codes returned by BlockDevice::erase();
+	 * - error codes returned by BlockDevice::discard();
 	 */
 
 	int erase(uint64_t address, uint64_t size) override;
@@ -163,7 +167,7 @@ public:
 	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of program block size
 	 *
 	 * \return 0 on success, error code otherwise:
-	 * - error codes returned by BlockDevice::erase();
+	 * - error codes returned by BlockDevice::discard();
 	 * - error codes returned by BlockDevice::write();
 	 */
 
@@ -183,7 +187,7 @@ public:
 	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of read block size
 	 *
 	 * \return 0 on success, error code otherwise:
-	 * - error codes returned by BlockDevice::erase();
+	 * - error codes returned by BlockDevice::discard();
 	 * - error codes returned by BlockDevice::read();
 	 */
 
@@ -197,7 +201,7 @@ public:
 	 * \pre Device is opened.
 	 *
 	 * \return 0 on success, error code otherwise:
-	 * - error codes returned by BlockDevice::erase();
+	 * - error codes returned by BlockDevice::discard();
 	 * - error codes returned by BlockDevice::synchronize();
 	 */
 
@@ -14,6 +14,8 @@
 
 #include "distortos/devices/memory/BlockDevice.hpp"
 
+#include "distortos/Semaphore.hpp"
+
 namespace distortos
 {
 
@@ -21,6 +23,7 @@ namespace devices
 {
 
 class BlockDevice;
+class MemcpyEngine;
 
 /**
  * \brief BufferingBlockDevice class is a buffering wrapper for BlockDevice.
@@ -32,6 +35,23 @@ class BlockDevice;
  *
  * Another use for this class is as a proxy between a file system and a block device which requires specific alignment.
  *
+ * Optional read-ahead buffer enables prefetching for sequential reads. When a read continues right after the end of
+ * read buffer, the following window - with the size of read buffer - is requested with BlockDevice::submitRequest().
+ * When the reader gets there, the buffers are swapped and the next window is requested, so with a block device which
+ * executes requests asynchronously (e.g. AsynchronousBlockDevice) the transfer overlaps with the work of the reader.
+ *
+ * Optional flush buffer enables write-back mode. Instead of writing the contents of write buffer synchronously, the
+ * buffers are swapped and the data is written with BlockDevice::submitRequest(), while the writer continues to fill
+ * the other buffer. With AsynchronousBlockDevice its worker thread becomes a dedicated flush thread, so the latency of
+ * writes seen by the application is decoupled from programming time of the device. Adjacent writes are still coalesced
+ * in write buffer, so the flushes are large multi-block writes. Errors of asynchronous writes are reported by the next
+ * operation which has to wait for the flush - write(), erase(), synchronize() or close() - and the data is kept in
+ * flush buffer, so that it can be written again. synchronize() is a barrier - it returns after all buffered data was
+ * written.
+ *
+ * Copies of data between buffers may be delegated to optional MemcpyEngine (e.g. DMA-based one), so that they don't use
+ * CPU cycles which other threads could use.
+ *
  * \ingroup devices
  */
 
@@ -49,19 +69,61 @@ public:
 	 * \param [in] writeBuffer is a pointer to buffer for writes, its address must be aligned to
 	 * `DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT` bytes
 	 * \param [in] writeBufferSize is the size of \a writeBuffer, bytes, must be a multiple of \a blockDevice block size
+	 * \param [in] memcpyEngine is a pointer to MemcpyEngine used for copies of data, nullptr to use `memcpy()`,
+	 * default - nullptr
 	 */
 
 	constexpr explicit BufferingBlockDevice(BlockDevice& blockDevice, void* const readBuffer,
-			const size_t readBufferSize, void* const writeBuffer, const size_t writeBufferSize) :
+			const size_t readBufferSize, void* const writeBuffer, const size_t writeBufferSize,
+			MemcpyEngine* const memcpyEngine = {}) :
+					BufferingBlockDevice{blockDevice, readBuffer, nullptr, readBufferSize, writeBuffer, nullptr,
+							writeBufferSize, memcpyEngine}
+	{
+
+	}
+
+	/**
+	 * \brief BufferingBlockDevice's constructor with read-ahead and write-back
+	 *
+	 * \param [in] blockDevice is a reference to associated block device
+	 * \param [in] readBuffer is a pointer to buffer for reads, its address must be aligned to
+	 * `DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT` bytes
+	 * \param [in] readAheadBuffer is a pointer to buffer for read-ahead, its address must be aligned to
+	 * `DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT` bytes and its size must be equal to \a readBufferSize, nullptr to
+	 * disable read-ahead
+	 * \param [in] readBufferSize is the size of \a readBuffer, bytes, must be a multiple of \a blockDevice block size
+	 * \param [in] writeBuffer is a pointer to buffer for writes, its address must be aligned to
+	 * `DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT` bytes
+	 * \param [in] flushBuffer is a pointer to buffer for write-back, its address must be aligned to
+	 * `DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT` bytes and its size must be equal to \a writeBufferSize, nullptr to
+	 * disable write-back
+	 * \param [in] writeBufferSize is the size of \a writeBuffer, bytes, must be a multiple of \a blockDevice block size
+	 * \param [in] memcpyEngine is a pointer to MemcpyEngine used for copies of data, nullptr to use `memcpy()`,
+	 * default - nullptr
+	 */
+
+	constexpr BufferingBlockDevice(BlockDevice& blockDevice, void* const readBuffer, void* const readAheadBuffer,
+			const size_t readBufferSize, void* const writeBuffer, void* const flushBuffer, const size_t writeBufferSize,
+			MemcpyEngine* const memcpyEngine = {}) :
+					flushSemaphore_{0},
+					readAheadSemaphore_{0},
+					flushRequest_{0, static_cast<const void*>(nullptr), 0, &flushSemaphore_},
+					readAheadRequest_{0, static_cast<void*>(nullptr), 0, &readAheadSemaphore_},
 					readBufferAddress_{},
 					writeBufferAddress_{},
 					blockDevice_{blockDevice},
+					memcpyEngine_{memcpyEngine},
+					flushBuffer_{flushBuffer},
+					readAheadBuffer_{readAheadBuffer},
 					readBuffer_{readBuffer},
 					readBufferSize_{readBufferSize},
 					writeBuffer_{writeBuffer},
 					writeBufferSize_{writeBufferSize},
+					flushBufferValidSize_{},
 					writeBufferValidSize_{},
 					openCount_{},
+					flushSubmitted_{},
+					readAheadSubmitted_{},
 					readBufferValid_{}
 	{
 
@@ -86,12 +148,32 @@ public:
 	 * \pre Device is opened.
 	 *
 	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by finishFlush();
 	 * - error codes returned by flushWriteBuffer();
 	 * - error codes returned by BlockDevice::close();
 	 */
 
 	int close() override;
 
+	/**
+	 * \brief Discards blocks on a device.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of range that will be discarded, must be a multiple of block size
+	 * \param [in] size is the size of discarded range, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by invalidateRange();
+	 * - error codes returned by BlockDevice::discard();
+	 */
+
+	int discard(uint64_t address, uint64_t size) override;
+
 	/**
 	 * \brief Erases blocks on a device.
 	 *
@@ -105,7 +187,7 @@ public:
 	 * \param [in] size is the size of erased range, bytes, must be a multiple of block size
 	 *
 	 * \return 0 on success, error code otherwise:
-	 * - error codes returned by flushWriteBuffer(size_t);
+	 * - error codes returned by invalidateRange();
 	 * - error codes returned by BlockDevice::erase();
 	 */
 
@@ -146,8 +228,8 @@ public:
 	 * \warning This function must not be called from interrupt context!
 	 *
 	 * \pre The number of times the device is opened is less than 255.
-	 * \pre Addresses of associated read and write buffers are aligned to `DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT`
-	 * bytes.
+	 * \pre Addresses of associated read, read-ahead (if any), write and flush (if any) buffers are aligned to
+	 * `DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT` bytes.
 	 * \pre Sizes of associated read and write buffers are non-zero multiples of associated block device's block size.
 	 *
 	 * \return 0 on success, error code otherwise:
@@ -183,6 +265,7 @@ public:
 	 * \pre Device is opened.
 	 *
 	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by finishFlush();
 	 * - error codes returned by flushWriteBuffer();
 	 * - error codes returned by BlockDevice::synchronize();
 	 */
@@ -222,6 +305,56 @@ public:
 
 private:
 
+	/**
+	 * \brief Copies data between buffers.
+	 *
+	 * Associated MemcpyEngine is used if available, `memcpy()` is used otherwise (also as a fallback when the engine
+	 * fails).
+	 *
+	 * \param [out] destination is a pointer to destination buffer
+	 * \param [in] source is a pointer to source buffer
+	 * \param [in] size is the number of bytes to copy
+	 */
+
+	void copy(void* destination, const void* source, size_t size) const;
+
+	/**
+	 * \brief Drops read-ahead window if it intersects with given range.
+	 *
+	 * Used when the contents of the range are changed on the associated block device. If the read-ahead request was
+	 * submitted and its window intersects with the range, the request is finished with finishReadAhead() and its data
+	 * is discarded.
+	 *
+	 * \param [in] address is the address of range
+	 * \param [in] size is the size of range, bytes
+	 */
+
+	void dropReadAhead(uint64_t address, uint64_t size);
+
+	/**
+	 * \brief Makes sure that data in flush buffer was written.
+	 *
+	 * If the flush request was submitted, waits until it is finished and collects its result. If the data was not
+	 * written (earlier asynchronous write or its submission failed), it is written synchronously with
+	 * BlockDevice::write(). On success flush buffer is empty.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::write();
+	 */
+
+	int finishFlush();
+
+	/**
+	 * \brief Waits until submitted read-ahead request is finished and collects its result.
+	 *
+	 * \pre Read-ahead request was submitted and its result was not collected yet.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::read();
+	 */
+
+	int finishReadAhead();
+
 	/**
 	 * \brief Flushes whole write buffer to the associated block device.
 	 *
@@ -237,14 +370,34 @@ private:
 	/**
 	 * \brief Flushes write buffer to the associated block device.
 	 *
+	 * In write-back mode the data is moved to flush buffer and written asynchronously, so it may not be written yet
+	 * when this function returns - use finishFlush() to wait for it.
+	 *
 	 * \param [in] size is the max amount of data that will be flushed, bytes, must be a multiple of block size
 	 *
 	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by finishFlush();
 	 * - error codes returned by BlockDevice::write();
 	 */
 
 	int flushWriteBuffer(size_t size);
 
+	/**
+	 * \brief Invalidates selected range in all buffers.
+	 *
+	 * Used before the range is erased or discarded. Data from the range is dropped from buffers, waiting for the data
+	 * which is written in the background if needed.
+	 *
+	 * \param [in] address is the address of invalidated range, must be a multiple of block size
+	 * \param [in] size is the size of invalidated range, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by finishFlush();
+	 * - error codes returned by flushWriteBuffer(size_t);
+	 */
+
+	int invalidateRange(uint64_t address, uint64_t size);
+
 	/**
 	 * \brief Implementation of read()
 	 *
@@ -257,11 +410,38 @@ private:
 	 * \param [in] deviceSize is the size of block device, bytes
 	 *
 	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by finishFlush();
 	 * - error codes returned by BlockDevice::read();
 	 */
 
 	int readImplementation(uint64_t address, void* buffer, size_t size, uint64_t deviceSize);
 
+	/**
+	 * \brief Submits read-ahead request for the window which directly follows read buffer.
+	 *
+	 * Nothing is done if read-ahead is disabled or if the window would extend beyond device size. Errors of submission
+	 * are ignored - read-ahead is just an optimization.
+	 *
+	 * \pre Read buffer holds valid data.
+	 * \pre Read-ahead request is not submitted.
+	 *
+	 * \param [in] deviceSize is the size of block device, bytes
+	 */
+
+	void startReadAhead(uint64_t deviceSize);
+
+	/// semaphore posted when flush request is finished
+	Semaphore flushSemaphore_;
+
+	/// semaphore posted when read-ahead request is finished
+	Semaphore readAheadSemaphore_;
+
+	/// request used for write-back of flush buffer
+	BlockDeviceRequest flushRequest_;
+
+	/// request used for read-ahead
+	BlockDeviceRequest readAheadRequest_;
+
 	/// address of data in read buffer
 	uint64_t readBufferAddress_;
 
@@ -271,6 +451,15 @@ private:
 	/// reference to associated block device
 	BlockDevice& blockDevice_;
 
+	/// pointer to MemcpyEngine used for copies of data, nullptr to use `memcpy()`
+	MemcpyEngine* memcpyEngine_;
+
+	/// pointer to buffer for write-back, nullptr if write-back is disabled
+	void* flushBuffer_;
+
+	/// pointer to buffer for read-ahead, nullptr if read-ahead is disabled
+	void* readAheadBuffer_;
+
 	/// pointer to buffer for reads
 	void* readBuffer_;
 
@@ -283,12 +472,21 @@ private:
 	/// size of \a writeBuffer_, bytes
 	size_t writeBufferSize_;
 
+	/// amount of data in flush buffer which was not written yet, bytes, address of data is kept in \a flushRequest_
+	size_t flushBufferValidSize_;
+
 	/// amount of data pending to be written in write buffer, bytes
 	size_t writeBufferValidSize_;
 
 	/// number of times this device was opened but not yet closed
 	uint8_t openCount_;
 
+	/// true if flush request was submitted and its result was not collected yet, false otherwise
+	bool flushSubmitted_;
+
+	/// true if read-ahead request was submitted and its result was not collected yet, false otherwise
+	bool readAheadSubmitted_;
+
 	/// true if read buffer holds valid data, false otherwise
 	bool readBufferValid_;
 };
@@ -0,0 +1,464 @@
+/**
+ * \file
+ * \brief CachingBlockDevice class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_MEMORY_CACHINGBLOCKDEVICE_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_MEMORY_CACHINGBLOCKDEVICE_HPP_
+
+#include "distortos/devices/memory/BlockDevice.hpp"
+
+#include <utility>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+class MemcpyEngine;
+
+/**
+ * \brief CachingBlockDevice class is a caching wrapper for BlockDevice.
+ *
+ * Unlike BufferingBlockDevice - which has exactly one read buffer and one write buffer - this class has a cache with
+ * several independent block-sized entries, replaced in LRU order. This works much better for file system workloads
+ * which alternate between a few distant areas of the device (e.g. FAT, directory blocks and file data). Writes are
+ * cached too - modified entries are written back to the associated block device when they are evicted, on
+ * synchronize() and on the last close().
+ *
+ * Regions of the device which should stay in cache (e.g. FAT and root directory sectors) may be pinned with pin().
+ * Entries with blocks from pinned regions are evicted only when all entries hold blocks from pinned regions.
+ *
+ * Runs of at least two consecutive blocks which are not in cache bypass it, as long as the buffer of the operation is
+ * aligned to `DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT` bytes - large transfers of file data don't evict useful entries
+ * and are executed as single operations of the associated block device. All other blocks pass through the cache, so
+ * this class may also be used as a proxy between a file system and a block device which requires specific alignment.
+ *
+ * Copies of data between buffers may be delegated to optional MemcpyEngine (e.g. DMA-based one), so that they don't use
+ * CPU cycles which other threads could use.
+ *
+ * \ingroup devices
+ */
+
+class CachingBlockDevice : public BlockDevice
+{
+public:
+
+	/// single entry of cache, its contents are managed by CachingBlockDevice
+	struct Entry
+	{
+		/// address of block held by this entry
+		uint64_t address;
+
+		/// value of use counter at the last access of this entry
+		uint32_t lastUse;
+
+		/// tells whether this entry holds valid block (true) or not (false)
+		bool valid;
+
+		/// tells whether block held by this entry was modified and must be written back (true) or not (false)
+		bool dirty;
+	};
+
+	/// max number of pinned regions
+	constexpr static size_t maxPinnedRegions {4};
+
+	/**
+	 * \brief CachingBlockDevice's constructor
+	 *
+	 * \param [in] blockDevice is a reference to associated block device
+	 * \param [in] buffer is a pointer to buffer for cached blocks, its address must be aligned to
+	 * `DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT` bytes and its size must be equal to \a entriesCount multiplied by
+	 * \a blockDevice block size
+	 * \param [in] entries is a pointer to array of entries of cache
+	 * \param [in] entriesCount is the number of elements in \a entries array, must be greater than 0
+	 * \param [in] memcpyEngine is a pointer to MemcpyEngine used for copies of data, nullptr to use `memcpy()`,
+	 * default - nullptr
+	 */
+
+	constexpr CachingBlockDevice(BlockDevice& blockDevice, void* const buffer, Entry* const entries,
+			const size_t entriesCount, MemcpyEngine* const memcpyEngine = {}) :
+					pinnedRegions_{},
+					blockDevice_{blockDevice},
+					memcpyEngine_{memcpyEngine},
+					buffer_{buffer},
+					entries_{entries},
+					entriesCount_{entriesCount},
+					blockSize_{},
+					useCounter_{},
+					openCount_{}
+	{
+
+	}
+
+	/**
+	 * \brief CachingBlockDevice's destructor
+	 *
+	 * \pre Device is closed.
+	 */
+
+	~CachingBlockDevice() override;
+
+	/**
+	 * \brief Closes device.
+	 *
+	 * \note Even if error code is returned, the device must not be used from the context which opened it (until it is
+	 * successfully opened again).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by flush();
+	 * - error codes returned by BlockDevice::close();
+	 */
+
+	int close() override;
+
+	/**
+	 * \brief Discards blocks on a device.
+	 *
+	 * Entries with discarded blocks are dropped from cache, even if they were modified.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of range that will be discarded, must be a multiple of block size
+	 * \param [in] size is the size of discarded range, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::discard();
+	 */
+
+	int discard(uint64_t address, uint64_t size) override;
+
+	/**
+	 * \brief Erases blocks on a device.
+	 *
+	 * Entries with erased blocks are dropped from cache, even if they were modified.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of range that will be erased, must be a multiple of block size
+	 * \param [in] size is the size of erased range, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::erase();
+	 */
+
+	int erase(uint64_t address, uint64_t size) override;
+
+	/**
+	 * \return block size, bytes
+	 */
+
+	size_t getBlockSize() const override;
+
+	/**
+	 * \return size of block device, bytes
+	 */
+
+	uint64_t getSize() const override;
+
+	/**
+	 * \brief Locks the device for exclusive use by current thread.
+	 *
+	 * When the object is locked, any call to any member function from other thread will be blocked until the object is
+	 * unlocked. Locking is optional, but may be useful when more than one transaction must be done atomically.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre The number of recursive locks of device is less than 65535.
+	 *
+	 * \post Device is locked.
+	 */
+
+	void lock() override;
+
+	/**
+	 * \brief Opens device.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre The number of times the device is opened is less than 255.
+	 * \pre Address of associated buffer is aligned to `DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT` bytes.
+	 * \pre Number of entries is greater than 0.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::open();
+	 */
+
+	int open() override;
+
+	/**
+	 * \brief Pins a region of device in cache.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] address is the address of pinned region, must be a multiple of block size
+	 * \param [in] size is the size of pinned region, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOSPC - all maxPinnedRegions regions are already pinned;
+	 */
+
+	int pin(uint64_t address, uint64_t size);
+
+	/**
+	 * \brief Reads data from a device.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a buffer and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of data that will be read, must be a multiple of block size
+	 * \param [out] buffer is the buffer into which the data will be read, must be valid
+	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by loadEntry();
+	 * - error codes returned by BlockDevice::read();
+	 */
+
+	int read(uint64_t address, void* buffer, size_t size) override;
+
+	/**
+	 * \brief Synchronizes state of a device, ensuring all cached writes are finished.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by flush();
+	 * - error codes returned by BlockDevice::synchronize();
+	 */
+
+	int synchronize() override;
+
+	/**
+	 * \brief Unlocks the device which was previously locked by current thread.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre This function is called by the thread that locked the device.
+	 */
+
+	void unlock() override;
+
+	/**
+	 * \brief Unpins a region of device which was previously pinned with pin().
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] address is the address of pinned region
+	 * \param [in] size is the size of pinned region, bytes
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - region with given address and size is not pinned;
+	 */
+
+	int unpin(uint64_t address, uint64_t size);
+
+	/**
+	 * \brief Writes data to a device.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a buffer and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of data that will be written, must be a multiple of block size
+	 * \param [in] buffer is the buffer with data that will be written, must be valid
+	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by allocateEntry();
+	 * - error codes returned by BlockDevice::write();
+	 */
+
+	int write(uint64_t address, const void* buffer, size_t size) override;
+
+private:
+
+	/// region of device pinned in cache
+	struct PinnedRegion
+	{
+		/// address of region
+		uint64_t address;
+
+		/// size of region, bytes, 0 if this element is not used
+		uint64_t size;
+	};
+
+	/**
+	 * \brief Allocates entry for block.
+	 *
+	 * Invalid entry is used if available. Otherwise least recently used entry is evicted - entries with blocks from
+	 * pinned regions are evicted only if all entries hold such blocks. Evicted entry is written back if it was
+	 * modified.
+	 *
+	 * \param [in] address is the address of block for which the entry will be allocated
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to allocated entry, which is not
+	 * valid yet; error codes:
+	 * - error codes returned by writeBack();
+	 */
+
+	std::pair<int, Entry*> allocateEntry(uint64_t address);
+
+	/**
+	 * \brief Copies data between buffers.
+	 *
+	 * Associated MemcpyEngine is used if available, `memcpy()` is used otherwise (also as a fallback when the engine
+	 * fails).
+	 *
+	 * \param [out] destination is a pointer to destination buffer
+	 * \param [in] source is a pointer to source buffer
+	 * \param [in] size is the number of bytes to copy
+	 */
+
+	void copy(void* destination, const void* source, size_t size) const;
+
+	/**
+	 * \brief Drops entries with blocks from selected range, even if they were modified.
+	 *
+	 * \param [in] address is the address of dropped range
+	 * \param [in] size is the size of dropped range, bytes
+	 */
+
+	void dropEntries(uint64_t address, uint64_t size);
+
+	/**
+	 * \param [in] address is the address of block
+	 *
+	 * \return pointer to valid entry which holds block with given address, nullptr if this block is not cached
+	 */
+
+	Entry* findEntry(uint64_t address) const;
+
+	/**
+	 * \brief Writes back all modified entries, in the order of their addresses.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by writeBack();
+	 */
+
+	int flush();
+
+	/**
+	 * \param [in] entry is a reference to entry
+	 *
+	 * \return pointer to buffer of \a entry
+	 */
+
+	void* getEntryBuffer(const Entry& entry) const;
+
+	/**
+	 * \param [in] address is the address of first block
+	 * \param [in] maxBlocks is the max number of checked blocks
+	 *
+	 * \return number of consecutive blocks - starting from the one with given address - which are not cached, at most
+	 * \a maxBlocks
+	 */
+
+	size_t getUncachedBlocks(uint64_t address, size_t maxBlocks) const;
+
+	/**
+	 * \param [in] address is the address of block
+	 *
+	 * \return true if block with given address is in one of pinned regions, false otherwise
+	 */
+
+	bool isPinned(uint64_t address) const;
+
+	/**
+	 * \brief Loads block into cache.
+	 *
+	 * \param [in] address is the address of block which will be loaded
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to valid entry with loaded block;
+	 * error codes:
+	 * - error codes returned by allocateEntry();
+	 * - error codes returned by BlockDevice::read();
+	 */
+
+	std::pair<int, Entry*> loadEntry(uint64_t address);
+
+	/**
+	 * \brief Marks entry as most recently used.
+	 *
+	 * \param [in] entry is a reference to entry
+	 */
+
+	void touch(Entry& entry)
+	{
+		entry.lastUse = ++useCounter_;
+	}
+
+	/**
+	 * \brief Writes back entry if it was modified.
+	 *
+	 * \param [in] entry is a reference to entry
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::write();
+	 */
+
+	int writeBack(Entry& entry);
+
+	/// array with pinned regions
+	PinnedRegion pinnedRegions_[maxPinnedRegions];
+
+	/// reference to associated block device
+	BlockDevice& blockDevice_;
+
+	/// pointer to MemcpyEngine used for copies of data, nullptr to use `memcpy()`
+	MemcpyEngine* memcpyEngine_;
+
+	/// pointer to buffer for cached blocks
+	void* buffer_;
+
+	/// pointer to array of entries of cache
+	Entry* entries_;
+
+	/// number of elements in \a entries_ array
+	size_t entriesCount_;
+
+	/// block size of associated block device, bytes, valid only when the device is opened
+	size_t blockSize_;
+
+	/// counter incremented on each access of entry, used for LRU replacement
+	uint32_t useCounter_;
+
+	/// number of times this device was opened but not yet closed
+	uint8_t openCount_;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_MEMORY_CACHINGBLOCKDEVICE_HPP_
@@ -0,0 +1,66 @@
+/**
+ * \file
+ * \brief MemcpyEngine class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_MEMORY_MEMCPYENGINE_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_MEMORY_MEMCPYENGINE_HPP_
+
+#include <cstddef>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/**
+ * \brief MemcpyEngine class is an interface for engines which copy blocks of memory, possibly without involving the
+ * CPU (e.g. with DMA).
+ *
+ * Components which copy large blocks of memory may be associated with an object implementing this interface, so that
+ * these copies no longer use CPU cycles which other threads could use.
+ *
+ * \ingroup devices
+ */
+
+class MemcpyEngine
+{
+public:
+
+	/**
+	 * \brief MemcpyEngine's destructor
+	 */
+
+	virtual ~MemcpyEngine() = default;
+
+	/**
+	 * \brief Copies block of memory, just like `memcpy()`.
+	 *
+	 * This function blocks until the copy is finished.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre \a destination and \a source regions don't overlap.
+	 *
+	 * \param [out] destination is a pointer to destination buffer
+	 * \param [in] source is a pointer to source buffer
+	 * \param [in] size is the number of bytes to copy
+	 *
+	 * \return 0 on success, error code otherwise
+	 */
+
+	virtual int copy(void* destination, const void* source, size_t size) = 0;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_MEMORY_MEMCPYENGINE_HPP_
@@ -15,6 +15,7 @@
 #include "distortos/devices/communication/SpiMode.hpp"
 
 #include "distortos/devices/memory/MemoryTechnologyDevice.hpp"
+#include "distortos/devices/memory/SerialFlashDiscoverableParameters.hpp"
 
 #include "distortos/Mutex.hpp"
 
@@ -35,72 +36,21 @@ class SpiMaster;
  * \ingroup devices
  */
 
-class QspiNorFlashSpiBased : public MemoryTechnologyDevice
+class QspiNorFlashSpiBased : public MemoryTechnologyDevice, private SerialFlashDiscoverableParameters::CommandExecutor
 {
 public:
 
-	/// flags with supported addressing modes
-	enum class AddressFlags : uint8_t
-	{
-		/// 3-byte addressing
-		_3 = 1 << 0,
-		/// 4-byte addressing
-		_4 = 1 << 1,
-	};
-
-	/// flags with supported software reset sequences
-	enum class SoftwareResetFlags : uint8_t
-	{
-		// drive 0xf on all 4 data wires for 8 clocks
-		highState8Clocks = 1 << 0,
-		// drive 0xf on all 4 data wires for 10 clocks if device is operating in 4-byte addressing mode
-		highState10Clocks4ByteAddressingMode = 1 << 1,
-		// drive 0xf on all 4 data wires for 16 clocks
-		highState16Clocks = 1 << 2,
-		// issue instruction 0xf0
-		_0xf0 = 1 << 3,
-		// issue instruction 0x66 ("reset enable"), then issue instruction 0x99 ("reset"), the sequence may be issued on
-		/// 1, 2, 4 or 8 wires, depending on the device operating mode
-		_0x66_0x99 = 1 << 4,
-		// exit from 0-4-4 mode is required prior to other reset sequences above if the device may be operating in this
-		/// mode
-		exit_0_4_4_Required = 1 << 5,
-	};
-
-	/// basic flash parameters
-	struct BasicFlashParameters
-	{
-		constexpr static uint8_t maxEraseTypes {4};
-
-		/// size of flash, bytes
-		uint64_t size;
-		/// sizes of each erase type, bytes
-		size_t eraseSizes[maxEraseTypes];
-		/// maximum erase time of each erase type, milliseconds
-		uint32_t maximumEraseTimesMs[maxEraseTypes];
-		/// size of page, bytes
-		uint16_t pageSize;
-		/// flags with supported addressing modes
-		AddressFlags addressFlags;
-		/// instructions of each erase type
-		uint8_t eraseInstructions[maxEraseTypes];
-		/// flags with supported software reset sequences
-		SoftwareResetFlags softwareResetFlags;
-	};
-
-	/// currently selected sector map
-	struct SectorMap
-	{
-		/// max number of supported regions in sector map
-		constexpr static uint8_t maxRegionCount {2};
+	/// import SerialFlashDiscoverableParameters::AddressFlags
+	using AddressFlags = SerialFlashDiscoverableParameters::AddressFlags;
+
+	/// import SerialFlashDiscoverableParameters::BasicFlashParameters
+	using BasicFlashParameters = SerialFlashDiscoverableParameters::BasicFlashParameters;
+
+	/// import SerialFlashDiscoverableParameters::SectorMap
+	using SectorMap = SerialFlashDiscoverableParameters::SectorMap;
 
-		/// size of each region, bytes
-		uint64_t sizes[maxRegionCount];
-		/// erase types supported by each region
-		uint8_t eraseTypes[maxRegionCount];
-		/// number of regions
-		uint8_t regionCount;
-	};
+	/// import SerialFlashDiscoverableParameters::SoftwareResetFlags
+	using SoftwareResetFlags = SerialFlashDiscoverableParameters::SoftwareResetFlags;
 
 	/**
 	 * \brief QspiNorFlashSpiBased's constructor
@@ -114,14 +64,12 @@ public:
 
 	constexpr QspiNorFlashSpiBased(SpiMaster& spiMaster, OutputPin& slaveSelectPin, const bool mode3 = {},
 			const uint32_t clockFrequency = 10000000) :
-					basicFlashParameters_{},
 					busyDeadline_{},
 					mutex_{Mutex::Type::recursive, Mutex::Protocol::priorityInheritance},
-					sectorMap_{},
+					serialFlashDiscoverableParameters_{},
 					clockFrequency_{clockFrequency},
 					slaveSelectPin_{slaveSelectPin},
 					spiMaster_{spiMaster},
-					commonEraseIndex_{},
 					mode_{mode3 == false ? SpiMode::_0 : SpiMode::_3},
 					openCount_{}
 	{
@@ -155,6 +103,10 @@ public:
 	/**
 	 * \brief Erases blocks on QSPI NOR flash.
 	 *
+	 * Each part of the range is erased with the largest erase type which is supported in its region of sector map and
+	 * which fits the alignment and size of this part. Whole device is erased with chip erase command, if its maximum
+	 * erase time is known.
+	 *
 	 * \warning This function must not be called from interrupt context!
 	 *
 	 * \pre Device is opened.
@@ -165,9 +117,7 @@ public:
 	 * \param [in] size is the size of erased range, bytes, must be a multiple of erase block size
 	 *
 	 * \return 0 on success, error code otherwise:
-	 * - error codes returned by executeCommand();
-	 * - error codes returned by executeWren();
-	 * - error codes returned by waitWhileWriteInProgress();
+	 * - error codes returned by executeErase();
 	 */
 
 	int erase(uint64_t address, uint64_t size) override;
@@ -303,6 +253,59 @@ private:
 
 	void deinitialize();
 
+	/**
+	 * \brief Executes generic command.
+	 *
+	 * \pre \a addressLength is 0, 3 or 4.
+	 *
+	 * \param [in] instruction is the instruction for this command
+	 * \param [in] address is the address for the command
+	 * \param [in] addressLength is the length of address for the command, bytes
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by SpiMasterHandle::executeTransaction();
+	 */
+
+	int executeCommand(uint8_t instruction, uint32_t address, size_t addressLength) override;
+
+	/**
+	 * \brief Executes single erase command.
+	 *
+	 * \param [in] instruction is the erase instruction
+	 * \param [in] address is the address for the erase instruction
+	 * \param [in] addressLength is the length of address for the erase instruction, bytes
+	 * \param [in] maximumEraseTime is the maximum time of executed erase
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by executeCommand();
+	 * - error codes returned by executeWren();
+	 * - error codes returned by waitWhileWriteInProgress();
+	 */
+
+	int executeErase(uint8_t instruction, uint64_t address, uint8_t addressLength,
+			TickClock::duration maximumEraseTime);
+
+	/**
+	 * \brief Executes read command.
+	 *
+	 * \pre \a addressLength is 0, 3 or 4.
+	 * \pre \a dummyCycles is a multiple of 8.
+	 * \pre \a dummyCycles is less than or equal to 32.
+	 *
+	 * \param [in] instruction is the instruction for this command
+	 * \param [in] address is the address for the command
+	 * \param [in] addressLength is the length of address for the command, bytes
+	 * \param [in] dummyCycles is the number of dummy cycles sent before reading of data
+	 * \param [out] buffer is the buffer for data that will be read
+	 * \param [in] size is the size of \a buffer
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by SpiMasterHandle::executeTransaction();
+	 */
+
+	int executeReadCommand(uint8_t instruction, uint32_t address, size_t addressLength, size_t dummyCycles,
+			void* buffer, size_t size) override;
+
 	/**
 	 * \brief Handles manufacturer- and device-specific fixups.
 	 *
@@ -319,32 +322,19 @@ private:
 	 * \brief Initializes QSPI NOR flash.
 	 *
 	 * \return 0 on success, error code otherwise:
-	 * - ENOTSUP - detected erase types are not supported by this implementation;
 	 * - error codes returned by handleFixups();
-	 * - error codes returned by parseSfdp();
+	 * - error codes returned by SerialFlashDiscoverableParameters::parse();
 	 */
 
 	int initialize();
 
-	/**
-	 * \brief Parses SFDP.
-	 *
-	 * \return 0 on success, error code otherwise:
-	 * - ENOTSUP - SFDP is invalid and cannot be parsed;
-	 * - ENOTSUP - parameter contained in SFDP is not supported by this implementation;
-	 * - ETIMEDOUT - timed-out while waiting for QSPI NOR flash to respond after software reset;
-	 * - error codes returned by executeCommand();
-	 * - error codes returned by readParameterHeaders();
-	 * - error codes returned by readSfdpHeader();
-	 * - error codes returned by parseBasicFlashParameterTable();
-	 * - error codes returned by parseSectorMapTable();
-	 */
-
-	int parseSfdp();
-
 	/**
 	 * \brief Waits while any write operation is currently in progress.
 	 *
+	 * Status register is polled continuously (yielding between reads) for the first two ticks, so that a typical page
+	 * program is detected as finished without tick-granular delay. After that the thread sleeps for one tick between
+	 * reads.
+	 *
 	 * \param [in] timePoint is the time point at which the wait will be terminated
 	 *
 	 * \return 0 on success, error code otherwise:
@@ -354,17 +344,14 @@ private:
 
 	int waitWhileWriteInProgress(TickClock::time_point timePoint);
 
-	/// basic flash parameters
-	BasicFlashParameters basicFlashParameters_;
-
 	/// current deadline of waiting while write operation is in progress
 	TickClock::time_point busyDeadline_;
 
 	/// mutex used to serialize access to this object
 	Mutex mutex_;
 
-	/// currently selected sector map
-	SectorMap sectorMap_;
+	/// parsed SFDP of QSPI NOR flash
+	SerialFlashDiscoverableParameters serialFlashDiscoverableParameters_;
 
 	/// desired clock frequency of QSPI NOR flash, Hz
 	uint32_t clockFrequency_;
@@ -375,9 +362,6 @@ private:
 	/// reference to SPI master to which this QSPI NOR flash is connected
 	SpiMaster& spiMaster_;
 
-	/// index of largest erase type supported by each block of QSPI NOR flash
-	uint8_t commonEraseIndex_;
-
 	/// SPI mode used by QSPI NOR flash
 	SpiMode mode_;
 
@@ -30,6 +30,10 @@ class SdMmcCardLowLevel;
  *
  * This class supports SD version 2.0 cards only.
  *
+ * If max allowed clock frequency is above 25 MHz, the card is switched to high speed mode with CMD6 (SWITCH_FUNC) and
+ * clocked at up to 50 MHz. If the card doesn't support high speed mode or the switch fails, default speed mode is
+ * used.
+ *
  * \ingroup devices
  */
 
@@ -45,7 +49,8 @@ public:
 	 *
 	 * \param [in] sdMmcCard is a reference to low-level implementation of SdMmcCardLowLevel interface
 	 * \param [in] _4BitBusMode selects whether 1-bit (false) or 4-bit (true) bus mode will be used, default - true
-	 * \param [in] maxClockFrequency is the max allowed clock frequency of SD card, Hz, default - 25 MHz
+	 * \param [in] maxClockFrequency is the max allowed clock frequency of SD card, Hz, values above 25 MHz enable high
+	 * speed mode, default - 25 MHz
 	 */
 
 	constexpr explicit SdCard(SdMmcCardLowLevel& sdMmcCard, const bool _4BitBusMode = true,
@@ -62,6 +67,8 @@ public:
 					writeTimeoutMs_{},
 					_4BitBusMode_{_4BitBusMode},
 					blockAddressing_{},
+					discardSupport_{},
+					transferState_{},
 					openCount_{}
 	{
 
@@ -93,6 +100,26 @@ public:
 
 	int close() override;
 
+	/**
+	 * \brief Discards blocks on a SD card.
+	 *
+	 * Uses ERASE command with "discard" argument. If the card doesn't support discard operation, nothing is done.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of range that will be discarded, must be a multiple of block size
+	 * \param [in] size is the size of discarded range, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by eraseImplementation();
+	 */
+
+	int discard(uint64_t address, uint64_t size) override;
+
 	/**
 	 * \brief Erases blocks on a SD card.
 	 *
@@ -106,11 +133,7 @@ public:
 	 * \param [in] size is the size of erased range, bytes, must be a multiple of block size
 	 *
 	 * \return 0 on success, error code otherwise:
-	 * - EIO - error during communication with SD card;
-	 * - error codes returned by executeCmd32();
-	 * - error codes returned by executeCmd33();
-	 * - error codes returned by executeCmd38();
-	 * - error codes returned by waitForTransferState();
+	 * - error codes returned by eraseImplementation();
 	 */
 
 	int erase(uint64_t address, uint64_t size) override;
@@ -235,6 +258,23 @@ private:
 
 	void deinitialize();
 
+	/**
+	 * \brief Implementation of discard() and erase()
+	 *
+	 * \param [in] address is the address of range that will be erased, must be a multiple of block size
+	 * \param [in] size is the size of erased range, bytes, must be a multiple of block size
+	 * \param [in] discard selects whether the range will be erased (false) or discarded (true)
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EIO - error during communication with SD card;
+	 * - error codes returned by executeCmd32();
+	 * - error codes returned by executeCmd33();
+	 * - error codes returned by executeCmd38();
+	 * - error codes returned by waitForTransferState();
+	 */
+
+	int eraseImplementation(uint64_t address, uint64_t size, bool discard);
+
 	/**
 	 * \brief Initializes SD card.
 	 *
@@ -255,6 +295,18 @@ private:
 
 	int initialize();
 
+	/**
+	 * \brief Waits until card goes back to transfer (tran) state.
+	 *
+	 * Card is not polled with CMD13 at all if it is already known to be in transfer (tran) state - this knowledge is
+	 * consumed by this call, as the state of the card is unknown after the operation which follows it.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by waitForTransferState();
+	 */
+
+	int waitWhileBusy();
+
 	/// current deadline of waiting while card is busy
 	TickClock::time_point busyDeadline_;
 
@@ -291,6 +343,12 @@ private:
 	/// selects whether card uses byte (false) or block (true) addressing
 	bool blockAddressing_;
 
+	/// tells whether card supports discard operation (true) or not (false)
+	bool discardSupport_;
+
+	/// tells whether card is known to be in transfer (tran) state (true) or not (false)
+	bool transferState_;
+
 	/// number of times this device was opened but not yet closed
 	uint8_t openCount_;
 };
@@ -60,6 +60,7 @@ public:
 					readTimeoutMs_{},
 					writeTimeoutMs_{},
 					blockAddressing_{},
+					discardSupport_{},
 					openCount_{}
 	{
 
@@ -88,6 +89,26 @@ public:
 
 	int close() override;
 
+	/**
+	 * \brief Discards blocks on a SD card connected via SPI.
+	 *
+	 * Uses ERASE command with "discard" argument. If the card doesn't support discard operation, nothing is done.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of range that will be discarded, must be a multiple of block size
+	 * \param [in] size is the size of discarded range, bytes, must be a multiple of block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by eraseImplementation();
+	 */
+
+	int discard(uint64_t address, uint64_t size) override;
+
 	/**
 	 * \brief Erases blocks on a SD card connected via SPI.
 	 *
@@ -101,9 +122,7 @@ public:
 	 * \param [in] size is the size of erased range, bytes, must be a multiple of block size
 	 *
 	 * \return 0 on success, error code otherwise:
-	 * - error codes returned by executeCmd32();
-	 * - error codes returned by executeCmd33();
-	 * - error codes returned by executeCmd38();
+	 * - error codes returned by eraseImplementation();
 	 */
 
 	int erase(uint64_t address, uint64_t size) override;
@@ -229,6 +248,21 @@ private:
 
 	void deinitialize();
 
+	/**
+	 * \brief Implementation of discard() and erase()
+	 *
+	 * \param [in] address is the address of range that will be erased, must be a multiple of block size
+	 * \param [in] size is the size of erased range, bytes, must be a multiple of block size
+	 * \param [in] discard selects whether the range will be erased (false) or discarded (true)
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by executeCmd32();
+	 * - error codes returned by executeCmd33();
+	 * - error codes returned by executeCmd38();
+	 */
+
+	int eraseImplementation(uint64_t address, uint64_t size, bool discard);
+
 	/**
 	 * \brief Initializes SD card connected via SPI.
 	 *
@@ -279,6 +313,9 @@ private:
 	/// selects whether card uses byte (false) or block (true) addressing
 	bool blockAddressing_;
 
+	/// tells whether card supports discard operation (true) or not (false)
+	bool discardSupport_;
+
 	/// number of times this device was opened but not yet closed
 	uint8_t openCount_;
 };
@@ -357,7 +357,9 @@ public:
 	 *
 	 * This function returns immediately. When the transaction is physically finished (either command, its argument,
 	 * response and associated transfer were sent/received or an error was detected),
-	 * SdMmcCardBase::transactionCompleteEvent() will be executed.
+	 * SdMmcCardBase::transactionCompleteEvent() will be executed. Transaction with write transfer is finished only
+	 * after the card stops signalling busy on DAT0 line after the last block, so
+	 * SdMmcCardBase::transactionCompleteEvent() is also the "busy end" event for the written data.
 	 *
 	 * \pre Driver is started.
 	 * \pre No transaction is in progress.
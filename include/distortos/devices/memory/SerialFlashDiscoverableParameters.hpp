@@ -0,0 +1,303 @@
+/**
+ * \file
+ * \brief SerialFlashDiscoverableParameters class header
+ *
+ * \author Copyright (C) 2020 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_MEMORY_SERIALFLASHDISCOVERABLEPARAMETERS_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_MEMORY_SERIALFLASHDISCOVERABLEPARAMETERS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/**
+ * \brief SerialFlashDiscoverableParameters class is a parser of SFDP from JESD216 standard.
+ *
+ * The parser doesn't depend on the way the flash is connected - all commands it needs are executed with an object
+ * implementing CommandExecutor interface, so it can be shared by drivers of QSPI NOR flash connected via SPI and via
+ * dedicated QSPI peripherals.
+ *
+ * \ingroup devices
+ */
+
+class SerialFlashDiscoverableParameters
+{
+public:
+
+	/// flags with supported addressing modes
+	enum class AddressFlags : uint8_t
+	{
+		/// 3-byte addressing
+		_3 = 1 << 0,
+		/// 4-byte addressing
+		_4 = 1 << 1,
+	};
+
+	/// requirements for enabling quad mode (values of Quad Enable Requirements bit field)
+	enum class QuadEnableRequirements : uint8_t
+	{
+		/// device doesn't have Quad Enable bit
+		none,
+		/// Quad Enable is bit 1 of status register 2, written with instruction 0x01 with 2 data bytes, writing 1 data
+		/// byte clears status register 2
+		statusRegister2Bit1WriteClears,
+		/// Quad Enable is bit 6 of status register 1, written with instruction 0x01 with 1 data byte
+		statusRegister1Bit6,
+		/// Quad Enable is bit 7 of status register 2, read with instruction 0x3f, written with instruction 0x3e
+		statusRegister2Bit7,
+		/// Quad Enable is bit 1 of status register 2, written with instruction 0x01 with 2 data bytes
+		statusRegister2Bit1,
+		/// Quad Enable is bit 1 of status register 2, read with instruction 0x35, written with instruction 0x01 with
+		/// 2 data bytes
+		statusRegister2Bit1Read0x35,
+		/// Quad Enable is bit 1 of status register 2, read with instruction 0x35, written with instruction 0x31
+		statusRegister2Bit1Write0x31,
+		/// requirements are unknown
+		unknown,
+	};
+
+	/// flags with supported software reset sequences
+	enum class SoftwareResetFlags : uint8_t
+	{
+		// drive 0xf on all 4 data wires for 8 clocks
+		highState8Clocks = 1 << 0,
+		// drive 0xf on all 4 data wires for 10 clocks if device is operating in 4-byte addressing mode
+		highState10Clocks4ByteAddressingMode = 1 << 1,
+		// drive 0xf on all 4 data wires for 16 clocks
+		highState16Clocks = 1 << 2,
+		// issue instruction 0xf0
+		_0xf0 = 1 << 3,
+		// issue instruction 0x66 ("reset enable"), then issue instruction 0x99 ("reset"), the sequence may be issued on
+		/// 1, 2, 4 or 8 wires, depending on the device operating mode
+		_0x66_0x99 = 1 << 4,
+		// exit from 0-4-4 mode is required prior to other reset sequences above if the device may be operating in this
+		/// mode
+		exit_0_4_4_Required = 1 << 5,
+	};
+
+	/// parameters of fast read instruction
+	struct FastReadParameters
+	{
+		/// instruction, 0 if this fast read is not supported
+		uint8_t instruction;
+		/// number of dummy (wait state) clocks
+		uint8_t dummyCycles;
+		/// number of mode clocks
+		uint8_t modeCycles;
+	};
+
+	/// basic flash parameters
+	struct BasicFlashParameters
+	{
+		constexpr static uint8_t maxEraseTypes {4};
+
+		/// size of flash, bytes
+		uint64_t size;
+		/// sizes of each erase type, bytes
+		size_t eraseSizes[maxEraseTypes];
+		/// maximum erase time of each erase type, milliseconds
+		uint32_t maximumEraseTimesMs[maxEraseTypes];
+		/// maximum chip erase time, milliseconds, 0 if unknown
+		uint32_t maximumChipEraseTimeMs;
+		/// size of page, bytes
+		uint16_t pageSize;
+		/// parameters of 1-1-4 fast read
+		FastReadParameters fastRead114;
+		/// parameters of 1-4-4 fast read
+		FastReadParameters fastRead144;
+		/// flags with supported addressing modes
+		AddressFlags addressFlags;
+		/// instructions of each erase type
+		uint8_t eraseInstructions[maxEraseTypes];
+		/// requirements for enabling quad mode
+		QuadEnableRequirements quadEnableRequirements;
+		/// flags with supported software reset sequences
+		SoftwareResetFlags softwareResetFlags;
+	};
+
+	/// currently selected sector map
+	struct SectorMap
+	{
+		/// max number of supported regions in sector map
+		constexpr static uint8_t maxRegionCount {2};
+
+		/// size of each region, bytes
+		uint64_t sizes[maxRegionCount];
+		/// erase types supported by each region
+		uint8_t eraseTypes[maxRegionCount];
+		/// number of regions
+		uint8_t regionCount;
+	};
+
+	/**
+	 * \brief CommandExecutor class is an interface used by SerialFlashDiscoverableParameters to execute commands.
+	 *
+	 * All commands are executed in 1-1-1 mode.
+	 */
+
+	class CommandExecutor
+	{
+	public:
+
+		/**
+		 * \brief Executes generic command.
+		 *
+		 * \pre \a addressLength is 0, 3 or 4.
+		 *
+		 * \param [in] instruction is the instruction for this command
+		 * \param [in] address is the address for the command
+		 * \param [in] addressLength is the length of address for the command, bytes
+		 *
+		 * \return 0 on success, error code otherwise
+		 */
+
+		virtual int executeCommand(uint8_t instruction, uint32_t address, size_t addressLength) = 0;
+
+		/**
+		 * \brief Executes read command.
+		 *
+		 * \pre \a addressLength is 0, 3 or 4.
+		 * \pre \a dummyCycles is a multiple of 8.
+		 * \pre \a dummyCycles is less than or equal to 32.
+		 *
+		 * \param [in] instruction is the instruction for this command
+		 * \param [in] address is the address for the command
+		 * \param [in] addressLength is the length of address for the command, bytes
+		 * \param [in] dummyCycles is the number of dummy cycles sent before reading of data
+		 * \param [out] buffer is the buffer for data that will be read
+		 * \param [in] size is the size of \a buffer
+		 *
+		 * \return 0 on success, error code otherwise
+		 */
+
+		virtual int executeReadCommand(uint8_t instruction, uint32_t address, size_t addressLength,
+				size_t dummyCycles, void* buffer, size_t size) = 0;
+
+	protected:
+
+		/**
+		 * \brief CommandExecutor's destructor
+		 */
+
+		~CommandExecutor() = default;
+	};
+
+	/**
+	 * \brief SerialFlashDiscoverableParameters's constructor
+	 */
+
+	constexpr SerialFlashDiscoverableParameters() :
+			basicFlashParameters_{},
+			sectorMap_{},
+			commonEraseIndex_{}
+	{
+
+	}
+
+	/**
+	 * \brief Clears all parameters.
+	 */
+
+	void clear();
+
+	/**
+	 * \return reference to basic flash parameters
+	 */
+
+	BasicFlashParameters& getBasicFlashParameters()
+	{
+		return basicFlashParameters_;
+	}
+
+	/**
+	 * \return const reference to basic flash parameters
+	 */
+
+	const BasicFlashParameters& getBasicFlashParameters() const
+	{
+		return basicFlashParameters_;
+	}
+
+	/**
+	 * \return index of largest erase type supported by each block of flash
+	 */
+
+	uint8_t getCommonEraseIndex() const
+	{
+		return commonEraseIndex_;
+	}
+
+	/**
+	 * \return erase block size, bytes
+	 */
+
+	size_t getEraseBlockSize() const;
+
+	/**
+	 * \return const reference to currently selected sector map
+	 */
+
+	const SectorMap& getSectorMap() const
+	{
+		return sectorMap_;
+	}
+
+	/**
+	 * \brief Parses SFDP.
+	 *
+	 * After reading of basic flash parameters, flash is reset with one of supported software reset sequences. Sector
+	 * map is parsed after the flash responds again.
+	 *
+	 * \param [in] commandExecutor is a reference to object used to execute commands
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOTSUP - SFDP is invalid and cannot be parsed;
+	 * - ENOTSUP - parameter contained in SFDP is not supported by this implementation;
+	 * - ENOTSUP - detected erase types are not supported by this implementation;
+	 * - ETIMEDOUT - timed-out while waiting for flash to respond after software reset;
+	 * - error codes returned by CommandExecutor::executeCommand();
+	 * - error codes returned by CommandExecutor::executeReadCommand();
+	 */
+
+	int parse(CommandExecutor& commandExecutor);
+
+	/**
+	 * \brief Selects erase type for the beginning of the range.
+	 *
+	 * \param [in] address is the address of range, must be a multiple of erase block size
+	 * \param [in] size is the size of range, bytes, must be a multiple of erase block size
+	 *
+	 * \return index of the largest erase type which is supported in the region of sector map containing \a address,
+	 * for which \a address is aligned and which doesn't exceed the range and the region
+	 */
+
+	uint8_t selectEraseType(uint64_t address, uint64_t size) const;
+
+private:
+
+	/// basic flash parameters
+	BasicFlashParameters basicFlashParameters_;
+
+	/// currently selected sector map
+	SectorMap sectorMap_;
+
+	/// index of largest erase type supported by each block of flash
+	uint8_t commonEraseIndex_;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_MEMORY_SERIALFLASHDISCOVERABLEPARAMETERS_HPP_
@@ -460,6 +460,9 @@ private:
 	/**
 	 * \brief Waits while any write operation is currently in progress.
 	 *
+	 * Status register is polled continuously (yielding between reads) for the first two ticks, so that a typical write
+	 * is detected as finished without tick-granular delay. After that the thread sleeps for one tick between reads.
+	 *
 	 * \return 0 on success, error code otherwise:
 	 * - error codes returned by isWriteInProgress();
 	 * - error codes returned by ThisThread::sleepFor();
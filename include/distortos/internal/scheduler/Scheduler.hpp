@@ -266,6 +266,20 @@ public:
 
 	void unblock(ThreadList::iterator iterator, UnblockReason unblockReason = UnblockReason::unblockRequest);
 
+	/**
+	 * \brief Unblocks all threads from provided container, transferring them to "runnable" container.
+	 *
+	 * Effect is the same as calling unblock() for each thread from \a container (starting from the first one), but both
+	 * containers are traversed only once and the decision about context switch is made only once, after all threads
+	 * are unblocked.
+	 *
+	 * \param [in] container is a reference to container with threads that will be unblocked, it is empty when this
+	 * function returns
+	 * \param [in] unblockReason is the reason of unblocking of the threads, default - UnblockReason::unblockRequest
+	 */
+
+	void unblockAll(ThreadList& container, UnblockReason unblockReason = UnblockReason::unblockRequest);
+
 	/**
 	 * \brief Yields time slot of the scheduler to next thread.
 	 */
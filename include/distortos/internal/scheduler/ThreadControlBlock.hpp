@@ -79,9 +79,10 @@ public:
 	/**
 	 * \brief Block hook function of thread
 	 *
-	 * Saves pointer to UnblockFunctor.
+	 * Saves pointer to UnblockFunctor and deactivates preemption threshold of the thread.
 	 *
-	 * \attention This function should be called only by Scheduler::blockInternal().
+	 * \attention This function should be called only by Scheduler::blockInternal(), before the thread is moved to the
+	 * new list.
 	 *
 	 * \param [in] unblockFunctor is a pointer to UnblockFunctor which will be executed in unblockHook()
 	 */
@@ -89,6 +90,7 @@ public:
 	void blockHook(const UnblockFunctor* const unblockFunctor)
 	{
 		unblockFunctor_ = unblockFunctor;
+		activePreemptionThreshold_ = {};
 	}
 
 	/**
@@ -127,6 +129,15 @@ public:
 		return roundRobinQuantum_;
 	}
 
+	/**
+	 * \return preemption threshold of the thread
+	 */
+
+	uint8_t getPreemptionThreshold() const
+	{
+		return preemptionThreshold_;
+	}
+
 	/**
 	 * \return scheduling policy of the thread
 	 */
@@ -210,6 +221,18 @@ public:
 
 	void setPriority(uint8_t priority, bool alwaysBehind = {});
 
+	/**
+	 * \brief Changes preemption threshold of thread.
+	 *
+	 * If the thread is currently running or its preemption threshold is in effect, then the new value is applied
+	 * immediately - the position in the thread list is adjusted and context switch may be requested. Otherwise the new
+	 * value will be applied when the thread is switched to.
+	 *
+	 * \param [in] preemptionThreshold is the new preemption threshold of the thread
+	 */
+
+	void setPreemptionThreshold(uint8_t preemptionThreshold);
+
 	/**
 	 * \param [in] priorityInheritanceMutexControlBlock is a pointer to MutexControlBlock (with priorityInheritance
 	 * protocol) that blocks this thread
@@ -238,7 +261,9 @@ public:
 	/**
 	 * \brief Hook function called when context is switched to this thread.
 	 *
-	 * Sets global _impure_ptr (from newlib) to thread's \a reent_ member variable.
+	 * Sets global _impure_ptr (from newlib) to thread's \a reent_ member variable and activates preemption threshold of
+	 * the thread. The thread is at the head of "runnable" list, so raising its effective priority doesn't change the
+	 * order of the list.
 	 *
 	 * \attention This function should be called only by Scheduler::switchContext().
 	 */
@@ -246,6 +271,7 @@ public:
 	void switchedToHook()
 	{
 		_impure_ptr = &reent_;
+		activePreemptionThreshold_ = preemptionThreshold_;
 	}
 
 	/**
@@ -335,6 +361,9 @@ private:
 	/// scheduling policy of the thread
 	SchedulingPolicy schedulingPolicy_;
 
+	/// preemption threshold of the thread, only threads with higher priority may preempt this thread when it runs
+	uint8_t preemptionThreshold_;
+
 	/// current state of object
 	ThreadState state_;
 };
@@ -41,18 +41,19 @@ public:
 			threadListNode{},
 			threadGroupNode{},
 			priority_{priority},
-			boostedPriority_{}
+			boostedPriority_{},
+			activePreemptionThreshold_{}
 	{
 
 	}
 
 	/**
-	 * \return effective priority of thread
+	 * \return effective priority of thread, which includes its boosted priority and its active preemption threshold
 	 */
 
 	uint8_t getEffectivePriority() const
 	{
-		return std::max(priority_, boostedPriority_);
+		return std::max(std::max(priority_, boostedPriority_), activePreemptionThreshold_);
 	}
 
 	/**
@@ -77,6 +78,9 @@ protected:
 
 	/// thread's boosted priority, 0 - no boosting
 	uint8_t boostedPriority_;
+
+	/// thread's active preemption threshold, 0 - preemption threshold is not in effect
+	uint8_t activePreemptionThreshold_;
 };
 
 }	// namespace internal
@@ -223,6 +223,28 @@ public:
 		return UnsortedIntrusiveList::insert(implementation_.findInsertPosition(newElement), newElement);
 	}
 
+	/**
+	 * \brief Transfers all elements from another sorted list to this one, keeping it sorted.
+	 *
+	 * Both lists are traversed only once. Elements from \a other are linked after equivalent elements from this list
+	 * and their relative order is preserved, so the result is the same as if each element of \a other was spliced to
+	 * this list with splice().
+	 *
+	 * \param [in] other is a reference to SortedIntrusiveList from which all elements will be transferred, it must be
+	 * sorted with the same criteria as this list
+	 */
+
+	void merge(SortedIntrusiveList& other)
+	{
+		auto position = begin();
+		while (other.empty() == false)
+		{
+			const auto splicedElement = other.begin();
+			position = implementation_.findInsertPosition(position, *splicedElement);
+			UnsortedIntrusiveList::splice(position, splicedElement);
+		}
+	}
+
 	/**
 	 * \brief Unlinks the last element from the list.
 	 */
@@ -350,7 +372,22 @@ private:
 
 		iterator findInsertPosition(const_reference newElement)
 		{
-			return std::find_if(intrusiveList.begin(), intrusiveList.end(),
+			return findInsertPosition(intrusiveList.begin(), newElement);
+		}
+
+		/**
+		 * \brief Finds insert position that satisfies sorting criteria, starting from given position.
+		 *
+		 * \param [in] first is an iterator of the element from which the search will be started
+		 * \param [in] newElement is a const reference to new element that is going to be inserted/spliced
+		 *
+		 * \return iterator (not before \a first) for which Compare's function call operator of dereferenced value and
+		 * \a newElement returns true.
+		 */
+
+		iterator findInsertPosition(const iterator first, const_reference newElement)
+		{
+			return std::find_if(first, intrusiveList.end(),
 					[this, &newElement](const_reference& element) -> bool
 					{
 						return this->Compare::operator()(element, newElement);
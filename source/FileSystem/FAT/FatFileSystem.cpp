@@ -36,6 +36,26 @@ namespace
 | local functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
+/**
+ * \brief Wrapper for BlockDevice::discard()
+ *
+ * \param [in] device is a pointer to uFAT device struct
+ * \param [in] block is the index of first block that will be discarded
+ * \param [in] blocksCount is the number of blocks to discard
+ *
+ * \return 0 on success, -1 otherwise
+ */
+
+int ufatBlockDeviceDiscard(const ufat_device* const device, const ufat_block_t block, const ufat_block_t blocksCount)
+{
+	assert(device != nullptr);
+	auto& blockDevice = reinterpret_cast<const FatFileSystem::UfatDevice*>(device)->blockDevice;
+	const auto blockSize = 1u << device->log2_block_size;
+	const auto ret = blockDevice.discard(static_cast<uint64_t>(block) * blockSize,
+			static_cast<uint64_t>(blocksCount) * blockSize);
+	return ret == 0 ? 0 : -1;
+}
+
 /**
  * \brief Wrapper for BlockDevice::read()
  *
@@ -115,6 +135,7 @@ int FatFileSystem::format()
 	device_.device.log2_block_size = blockSizeLog2;
 	device_.device.read = ufatBlockDeviceRead;
 	device_.device.write = ufatBlockDeviceWrite;
+	device_.device.discard = ufatBlockDeviceDiscard;
 
 	const auto blocksCount = blocksCount_ != 0 ? blocksCount_ : device_.blockDevice.getSize() / blockSize;
 
@@ -240,6 +261,7 @@ int FatFileSystem::mount()
 	device_.device.log2_block_size = blockSizeLog2;
 	device_.device.read = ufatBlockDeviceRead;
 	device_.device.write = ufatBlockDeviceWrite;
+	device_.device.discard = ufatBlockDeviceDiscard;
 
 	fileSystem_ = {};
 	const auto ret = ufat_open(&fileSystem_, &device_.device);
@@ -128,6 +128,7 @@ static int file_device_open(struct file_device *dev, const char *fname,
 	dev->base.log2_block_size = log2_bs;
 	dev->base.read = file_device_read;
 	dev->base.write = file_device_write;
+	dev->base.discard = NULL;
 	dev->is_read_only = 0;
 
 	if (create) {
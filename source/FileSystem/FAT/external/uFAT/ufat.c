@@ -595,8 +595,31 @@ int ufat_write_fat(struct ufat *uf, ufat_cluster_t index,
 	return 0;
 }
 
+static int discard_clusters(struct ufat *uf, ufat_cluster_t start,
+			    ufat_cluster_t count)
+{
+	int err;
+
+	/* The FAT must be updated on the device before the clusters are
+	 * discarded, otherwise an interrupted operation could leave a chain
+	 * pointing to discarded data.
+	 */
+	err = ufat_sync(uf);
+	if (err < 0)
+		return err;
+
+	if (uf->dev->discard(uf->dev, cluster_to_block(&uf->bpb, start),
+			     count << uf->bpb.log2_blocks_per_cluster) < 0)
+		return -UFAT_ERR_IO;
+
+	return 0;
+}
+
 int ufat_free_chain(struct ufat *uf, ufat_cluster_t c)
 {
+	ufat_cluster_t run_start = 0;
+	ufat_cluster_t run_length = 0;
+
 	while (UFAT_CLUSTER_IS_PTR(c)) {
 		ufat_cluster_t next;
 		int i = ufat_read_fat(uf, c, &next);
@@ -608,9 +631,29 @@ int ufat_free_chain(struct ufat *uf, ufat_cluster_t c)
 		if (i < 0)
 			return i;
 
+		/* Contiguous clusters are discarded with a single request. */
+		if (uf->dev->discard) {
+			if (run_length && c == run_start + run_length) {
+				run_length++;
+			} else {
+				if (run_length) {
+					i = discard_clusters(uf, run_start,
+							     run_length);
+					if (i < 0)
+						return i;
+				}
+
+				run_start = c;
+				run_length = 1;
+			}
+		}
+
 		c = next;
 	}
 
+	if (run_length)
+		return discard_clusters(uf, run_start, run_length);
+
 	return 0;
 }
 
@@ -66,6 +66,13 @@ struct ufat_device {
 	 */
 	int		(*write)(const struct ufat_device *dev, ufat_block_t start,
 				ufat_block_t count, const void *buffer);
+	/**
+	 * Pointer to function used to inform block device that blocks are
+	 * no longer used, so their contents may be discarded. Optional, may
+	 * be NULL. Should return 0 on success or -1 if an error occurs.
+	 */
+	int		(*discard)(const struct ufat_device *dev,
+				   ufat_block_t start, ufat_block_t count);
 };
 
 /* Cache parameters. The more cache is used, the fewer filesystem reads/writes
@@ -0,0 +1,45 @@
+/**
+ * \file
+ * \brief cleanAndInvalidateDataCache() implementation for ARMv6-M and ARMv7-M
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/architecture/cleanAndInvalidateDataCache.hpp"
+
+#include "distortos/chip/CMSIS-proxy.h"
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void cleanAndInvalidateDataCache(void* const address, const size_t size)
+{
+#if defined(__DCACHE_PRESENT) && __DCACHE_PRESENT == 1
+
+	if ((SCB->CCR & SCB_CCR_DC_Msk) == 0 || size == 0)
+		return;
+
+	SCB_CleanInvalidateDCache_by_Addr(static_cast<uint32_t*>(address), size);
+
+#else	// !defined(__DCACHE_PRESENT) || __DCACHE_PRESENT != 1
+
+	static_cast<void>(address);	// suppress warning
+	static_cast<void>(size);	// suppress warning
+
+#endif	// !defined(__DCACHE_PRESENT) || __DCACHE_PRESENT != 1
+}
+
+}	// namespace architecture
+
+}	// namespace distortos
@@ -13,10 +13,13 @@ target_include_directories(distortos PUBLIC
 
 target_sources(distortos PRIVATE
 		${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-architectureLowLevelInitializer.cpp
+		${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-cleanAndInvalidateDataCache.cpp
+		${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-cleanDataCache.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-disableInterruptMasking.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-enableInterruptMasking.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-getMainStack.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-initializeStack.cpp
+		${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-invalidateDataCache.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-isInInterruptContext.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-PendSV_Handler.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-requestContextSwitch.cpp
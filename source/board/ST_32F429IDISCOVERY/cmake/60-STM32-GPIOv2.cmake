@@ -73,4 +73,20 @@ distortosSetConfiguration(BOOLEAN
 		HELP "Enable GPIOH."
 		OUTPUT_NAME DISTORTOS_CHIP_GPIOH_ENABLE)
 
+distortosSetConfiguration(BOOLEAN
+		distortos_Peripherals_EXTI
+		OFF
+		HELP "Enable EXTI interrupts used by chip::ExtiInputPin."
+		NO_OUTPUT)
+
+if(distortos_Peripherals_EXTI)
+	set(ARCHITECTURE_NVIC_EXTI0_ENABLE ON)
+	set(ARCHITECTURE_NVIC_EXTI1_ENABLE ON)
+	set(ARCHITECTURE_NVIC_EXTI2_ENABLE ON)
+	set(ARCHITECTURE_NVIC_EXTI3_ENABLE ON)
+	set(ARCHITECTURE_NVIC_EXTI4_ENABLE ON)
+	set(ARCHITECTURE_NVIC_EXTI9_5_ENABLE ON)
+	set(ARCHITECTURE_NVIC_EXTI15_10_ENABLE ON)
+endif(distortos_Peripherals_EXTI)
+
 include("${CMAKE_CURRENT_SOURCE_DIR}/source/chip/STM32/peripherals/GPIOv2/distortos-sources.cmake")
@@ -24,6 +24,7 @@ namespace chip
 {
 
 class ChipUartLowLevel;
+class UartLowLevelDmaBased;
 
 /*---------------------------------------------------------------------------------------------------------------------+
 | global objects
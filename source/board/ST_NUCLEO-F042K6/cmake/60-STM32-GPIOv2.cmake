@@ -38,4 +38,16 @@ distortosSetConfiguration(BOOLEAN
 		HELP "Enable GPIOF."
 		OUTPUT_NAME DISTORTOS_CHIP_GPIOF_ENABLE)
 
+distortosSetConfiguration(BOOLEAN
+		distortos_Peripherals_EXTI
+		OFF
+		HELP "Enable EXTI interrupts used by chip::ExtiInputPin."
+		NO_OUTPUT)
+
+if(distortos_Peripherals_EXTI)
+	set(ARCHITECTURE_NVIC_EXTI0_1_ENABLE ON)
+	set(ARCHITECTURE_NVIC_EXTI2_3_ENABLE ON)
+	set(ARCHITECTURE_NVIC_EXTI4_15_ENABLE ON)
+endif(distortos_Peripherals_EXTI)
+
 include("${CMAKE_CURRENT_SOURCE_DIR}/source/chip/STM32/peripherals/GPIOv2/distortos-sources.cmake")
@@ -30,6 +30,35 @@ namespace
 | local functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
+#ifdef DISTORTOS_CHIP_SRAM2_NON_CACHEABLE_ENABLE
+
+/**
+ * \brief Configures SRAM2 as normal, shareable, non-cacheable memory with MPU.
+ *
+ * MPU region 0 is used. Default memory map is used for all other regions.
+ */
+
+void configureSram2NonCacheable()
+{
+	constexpr uint32_t sram2Size {16 * 1024};
+	static_assert(SRAM2_BASE % sram2Size == 0, "SRAM2 is not aligned to its size!");
+
+	__DMB();
+	MPU->RNR = 0;
+	MPU->RBAR = SRAM2_BASE;
+	MPU->RASR = 1 << MPU_RASR_XN_Pos |	// instruction fetches disabled
+			3 << MPU_RASR_AP_Pos |		// full access
+			1 << MPU_RASR_TEX_Pos |		// normal, non-cacheable (TEX = 1, C = 0, B = 0)
+			1 << MPU_RASR_S_Pos |		// shareable
+			13 << MPU_RASR_SIZE_Pos |		// 2 ^ (13 + 1) = 16 kB
+			MPU_RASR_ENABLE_Msk;
+	MPU->CTRL = MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk;
+	__DSB();
+	__ISB();
+}
+
+#endif	// def DISTORTOS_CHIP_SRAM2_NON_CACHEABLE_ENABLE
+
 /**
  * \brief Low-level chip initializer for STM32F7
  *
@@ -50,6 +79,18 @@ void chipLowLevelInitializer()
 	disableArtAccelerator();
 #endif	// !def DISTORTOS_CHIP_FLASH_ART_ACCELERATOR_ENABLE
 
+#ifdef DISTORTOS_CHIP_INSTRUCTION_CACHE_ENABLE
+	SCB_EnableICache();
+#endif	// def DISTORTOS_CHIP_INSTRUCTION_CACHE_ENABLE
+
+#ifdef DISTORTOS_CHIP_SRAM2_NON_CACHEABLE_ENABLE
+	configureSram2NonCacheable();
+#endif	// def DISTORTOS_CHIP_SRAM2_NON_CACHEABLE_ENABLE
+
+#ifdef DISTORTOS_CHIP_DATA_CACHE_ENABLE
+	SCB_EnableDCache();
+#endif	// def DISTORTOS_CHIP_DATA_CACHE_ENABLE
+
 #ifdef DISTORTOS_CHIP_STANDARD_CLOCK_CONFIGURATION_ENABLE
 
 	RCC->APB1ENR |= RCC_APB1ENR_PWREN;
@@ -475,6 +475,39 @@ distortosSetConfiguration(BOOLEAN
 		HELP "Enable flash ART accelerator in FLASH->ACR register."
 		OUTPUT_NAME DISTORTOS_CHIP_FLASH_ART_ACCELERATOR_ENABLE)
 
+distortosSetConfiguration(BOOLEAN
+		distortos_Memory_02_Instruction_cache
+		ON
+		HELP "Enable L1 instruction cache of Cortex-M7 core."
+		OUTPUT_NAME DISTORTOS_CHIP_INSTRUCTION_CACHE_ENABLE)
+
+distortosSetConfiguration(BOOLEAN
+		distortos_Memory_03_Data_cache
+		OFF
+		HELP "Enable L1 data cache of Cortex-M7 core.
+
+		All DMA-based drivers perform required cache maintenance (clean before transfers from memory, invalidate after
+		transfers to memory), so required alignment of buffers used by these drivers is increased to the size of cache line
+		(32 bytes)."
+		OUTPUT_NAME DISTORTOS_CHIP_DATA_CACHE_ENABLE)
+
+if(distortos_Memory_03_Data_cache)
+
+	list(APPEND DISTORTOS_SDMMCCARD_BUFFER_ALIGNMENTS 32)
+	list(APPEND DISTORTOS_SPIMASTER_BUFFER_ALIGNMENTS 32)
+	list(APPEND DISTORTOS_UART_BUFFER_ALIGNMENTS 32)
+
+	distortosSetConfiguration(BOOLEAN
+			distortos_Memory_04_Non_cacheable_SRAM2
+			OFF
+			HELP "Configure SRAM2 as non-cacheable memory with MPU.
+
+			SRAM2 (16 kB) is configured as normal, shareable, non-cacheable memory region. DMA buffers placed there never
+			need cache maintenance. Remaining memory uses default memory map of the core."
+			OUTPUT_NAME DISTORTOS_CHIP_SRAM2_NON_CACHEABLE_ENABLE)
+
+endif(distortos_Memory_03_Data_cache)
+
 target_include_directories(distortos PUBLIC
 		${CMAKE_CURRENT_LIST_DIR}/../include
 		${CMAKE_CURRENT_LIST_DIR}/include
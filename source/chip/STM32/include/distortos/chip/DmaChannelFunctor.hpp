@@ -36,10 +36,19 @@ public:
 
 	virtual ~DmaChannelFunctor() = default;
 
+	/**
+	 * \brief "Half transfer" event
+	 *
+	 * Called by low-level DMA channel driver when half of configured number of transactions were executed.
+	 */
+
+	virtual void halfTransferEvent() = 0;
+
 	/**
 	 * \brief "Transfer complete" event
 	 *
-	 * Called by low-level DMA channel driver when the transfer is physically finished.
+	 * Called by low-level DMA channel driver when the transfer is physically finished. In circular or double-buffer
+	 * mode this is called each time configured number of transactions were executed.
 	 */
 
 	virtual void transferCompleteEvent() = 0;
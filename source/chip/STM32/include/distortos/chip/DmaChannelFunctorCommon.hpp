@@ -30,6 +30,19 @@ class DmaChannelFunctorCommon : public DmaChannelFunctor
 {
 public:
 
+	/**
+	 * \brief "Half transfer" event
+	 *
+	 * Called by low-level DMA channel driver when half of configured number of transactions were executed.
+	 *
+	 * Empty default implementation - does nothing.
+	 */
+
+	void halfTransferEvent() override
+	{
+
+	}
+
 	/**
 	 * \brief "Transfer complete" event
 	 *
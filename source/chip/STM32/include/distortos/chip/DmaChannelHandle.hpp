@@ -54,6 +54,23 @@ public:
 		assert(channel_ == nullptr);
 	}
 
+#ifdef DISTORTOS_CHIP_STM32_DMAV2
+
+	/**
+	 * \pre Driver is reserved with this handle.
+	 * \pre Transfer in double-buffer mode is in progress.
+	 *
+	 * \return index of memory buffer which is currently used by the transfer, 0 (M0AR) or 1 (M1AR)
+	 */
+
+	uint8_t getCurrentMemory() const
+	{
+		assert(channel_ != nullptr);
+		return channel_->getCurrentMemory();
+	}
+
+#endif	// def DISTORTOS_CHIP_STM32_DMAV2
+
 	/**
 	 * \pre Driver is reserved with this handle.
 	 *
@@ -110,6 +127,29 @@ public:
 		return {};
 	}
 
+#ifdef DISTORTOS_CHIP_STM32_DMAV2
+
+	/**
+	 * \brief Sets address of memory buffer which is not currently used by the transfer in double-buffer mode.
+	 *
+	 * \pre Driver is reserved with this handle.
+	 * \pre Transfer in double-buffer mode is in progress.
+	 * \pre \a memory is not the index returned by getCurrentMemory().
+	 * \pre \a memoryAddress is valid.
+	 *
+	 * \param [in] memory is the index of memory buffer which will be modified, 0 (M0AR) or 1 (M1AR)
+	 * \param [in] memoryAddress is the new memory address, must be divisible by configured memory data size
+	 * multiplied by configured memory burst size
+	 */
+
+	void setMemoryAddress(const uint8_t memory, const uintptr_t memoryAddress) const
+	{
+		assert(channel_ != nullptr);
+		channel_->setMemoryAddress(memory, memoryAddress);
+	}
+
+#endif	// def DISTORTOS_CHIP_STM32_DMAV2
+
 	/**
 	 * \brief Configures and starts asynchronous transfer.
 	 *
@@ -138,6 +178,41 @@ public:
 		channel_->startTransfer(memoryAddress, peripheralAddress, transactions, flags);
 	}
 
+#ifdef DISTORTOS_CHIP_STM32_DMAV2
+
+	/**
+	 * \brief Configures and starts asynchronous transfer in double-buffer mode.
+	 *
+	 * This function returns immediately. The transfer is executed with memory buffers used alternately and is never
+	 * finished on its own - it must be stopped explicitly with stopTransfer().
+	 *
+	 * \pre Driver is reserved with this handle.
+	 * \pre \a memoryAddress0 and \a memoryAddress1 and \a peripheralAddress and \a transactions and \a flags are
+	 * valid.
+	 * \pre Memory data size multiplied by memory burst size is less than or equal to 16.
+	 * \pre No transfer is in progress.
+	 *
+	 * \post Transfer is in progress.
+	 *
+	 * \param [in] memoryAddress0 is the address of first memory buffer (M0AR), must be divisible by configured
+	 * memory data size multiplied by configured memory burst size
+	 * \param [in] memoryAddress1 is the address of second memory buffer (M1AR), must be divisible by configured
+	 * memory data size multiplied by configured memory burst size
+	 * \param [in] peripheralAddress is the peripheral address, must be divisible by peripheral data size multiplied
+	 * by configured peripheral burst size
+	 * \param [in] transactions is the number of transactions for each memory buffer, [1; 65535]
+	 * \param [in] flags are configuration flags, DmaChannelFlags::circularModeEnable is implied
+	 */
+
+	void startTransfer(const uintptr_t memoryAddress0, const uintptr_t memoryAddress1,
+			const uintptr_t peripheralAddress, const size_t transactions, const Flags flags) const
+	{
+		assert(channel_ != nullptr);
+		channel_->startTransfer(memoryAddress0, memoryAddress1, peripheralAddress, transactions, flags);
+	}
+
+#endif	// def DISTORTOS_CHIP_STM32_DMAV2
+
 	/**
 	 * \brief Stops transfer.
 	 *
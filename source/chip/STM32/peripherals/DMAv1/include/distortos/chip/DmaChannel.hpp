@@ -36,11 +36,21 @@ enum class DmaChannelFlags : uint16_t
 	/// "transfer complete" interrupt is enabled
 	transferCompleteInterruptEnable = 1 << 1,
 
+	/// "half transfer" interrupt is disabled
+	halfTransferInterruptDisable = 0 << 2,
+	/// "half transfer" interrupt is enabled
+	halfTransferInterruptEnable = 1 << 2,
+
 	/// transfer from peripheral to memory
 	peripheralToMemory = 0 << 4,
 	/// transfer from memory to peripheral
 	memoryToPeripheral = 1 << 4,
 
+	/// circular mode is disabled - transfer is finished after configured number of transactions
+	circularModeDisable = 0 << 5,
+	/// circular mode is enabled - transfer is automatically restarted after configured number of transactions
+	circularModeEnable = 1 << 5,
+
 	/// peripheral address is fixed
 	peripheralFixed = 0 << 6,
 	/// peripheral address is incremented after each transaction
@@ -111,6 +121,10 @@ class DmaPeripheral;
 /**
  * \brief DmaChannel class is a low-level DMA channel driver for DMAv1 in STM32.
  *
+ * Apart from one-shot transfers, the driver supports circular mode (selected with DmaChannelFlags::circularModeEnable),
+ * in which the transfer never stops on its own - DmaChannelFunctor::halfTransferEvent() and
+ * DmaChannelFunctor::transferCompleteEvent() are executed each time half or whole of the buffer is done.
+ *
  * \ingroup devices
  */
 
@@ -198,6 +212,10 @@ private:
 	 * This function returns immediately. When the transfer is physically finished (either expected number of
 	 * transactions were executed or an error was detected), one of DmaChannelFunctor functions will be executed.
 	 *
+	 * In circular mode the transfer is never finished on its own - each time configured number of transactions is
+	 * executed, the transfer is restarted from the beginning of memory region. The transfer must be stopped explicitly
+	 * with stopTransfer().
+	 *
 	 * \pre Driver is reserved.
 	 * \pre \a memoryAddress and \a peripheralAddress and \a transactions and \a flags are valid.
 	 * \pre No transfer is in progress.
@@ -15,8 +15,17 @@
 #include "distortos/chip/STM32-DMAv2-DmaChannelPeripheral.hpp"
 #include "distortos/chip/STM32-DMAv2-DmaPeripheral.hpp"
 
+#include "distortos/distortosConfiguration.h"
 #include "distortos/InterruptMaskingLock.hpp"
 
+#ifdef DISTORTOS_CHIP_DATA_CACHE_ENABLE
+
+#include "distortos/architecture/cleanAndInvalidateDataCache.hpp"
+#include "distortos/architecture/cleanDataCache.hpp"
+#include "distortos/architecture/invalidateDataCache.hpp"
+
+#endif	// def DISTORTOS_CHIP_DATA_CACHE_ENABLE
+
 #include <array>
 
 namespace distortos
@@ -28,6 +37,11 @@ namespace chip
 namespace
 {
 
+static_assert(static_cast<uint32_t>(DmaChannel::Flags::halfTransferInterruptDisable) == 0,
+		"DmaChannel::Flags::halfTransferInterruptDisable doesn't match expected value of DMA_SxCR_HTIE field!");
+static_assert(static_cast<uint32_t>(DmaChannel::Flags::halfTransferInterruptEnable) == DMA_SxCR_HTIE,
+		"DmaChannel::Flags::halfTransferInterruptEnable doesn't match expected value of DMA_SxCR_HTIE field!");
+
 static_assert(static_cast<uint32_t>(DmaChannel::Flags::transferCompleteInterruptDisable) == 0,
 		"DmaChannel::Flags::transferCompleteInterruptDisable doesn't match expected value of DMA_SxCR_TCIE field!");
 static_assert(static_cast<uint32_t>(DmaChannel::Flags::transferCompleteInterruptEnable) == DMA_SxCR_TCIE,
@@ -42,6 +56,13 @@ static_assert(static_cast<uint32_t>(DmaChannel::Flags::peripheralToMemory) == 0,
 		"DmaChannel::Flags::peripheralToMemory doesn't match expected value of DMA_SxCR_DIR field!");
 static_assert(static_cast<uint32_t>(DmaChannel::Flags::memoryToPeripheral) == DMA_SxCR_DIR_0,
 		"DmaChannel::Flags::memoryToPeripheral doesn't match expected value of DMA_SxCR_DIR field!");
+static_assert(static_cast<uint32_t>(DmaChannel::Flags::memoryToMemory) == DMA_SxCR_DIR_1,
+		"DmaChannel::Flags::memoryToMemory doesn't match expected value of DMA_SxCR_DIR field!");
+
+static_assert(static_cast<uint32_t>(DmaChannel::Flags::circularModeDisable) == 0,
+		"DmaChannel::Flags::circularModeDisable doesn't match expected value of DMA_SxCR_CIRC field!");
+static_assert(static_cast<uint32_t>(DmaChannel::Flags::circularModeEnable) == DMA_SxCR_CIRC,
+		"DmaChannel::Flags::circularModeEnable doesn't match expected value of DMA_SxCR_CIRC field!");
 
 static_assert(static_cast<uint32_t>(DmaChannel::Flags::peripheralFixed) == 0,
 		"DmaChannel::Flags::peripheralFixed doesn't match expected value of DMA_SxCR_PINC field!");
@@ -118,6 +139,32 @@ uint8_t getChannelShift(const uint8_t channelId)
 	return channelShifts[channelId % channelShifts.size()];
 }
 
+#ifdef DISTORTOS_CHIP_DATA_CACHE_ENABLE
+
+/**
+ * \brief Invalidates part of memory region which was just completed by transfer in circular or double-buffer mode.
+ *
+ * \param [in] dmaChannelPeripheral is a reference to raw DMA channel peripheral
+ * \param [in] cr is the value of CR register read in interrupt handler
+ * \param [in] size is the size of single memory region, bytes
+ * \param [in] halfTransfer selects whether first half of current memory region (true) or second half of completed
+ * memory region (false) will be invalidated
+ */
+
+void invalidateCompletedMemory(const DmaChannelPeripheral& dmaChannelPeripheral, const uint32_t cr, const size_t size,
+		const bool halfTransfer)
+{
+	// in double-buffer mode CT bit is already toggled when "transfer complete" event is handled
+	const auto currentMemory1 = (cr & DMA_SxCR_CT) != 0;
+	const auto memory1 = (cr & DMA_SxCR_DBM) != 0 && currentMemory1 == halfTransfer;
+	const auto memoryAddress = memory1 == false ? dmaChannelPeripheral.readM0ar() : dmaChannelPeripheral.readM1ar();
+	const auto halfSize = size / 2;
+	architecture::invalidateDataCache(reinterpret_cast<void*>(memoryAddress + (halfTransfer == true ? 0 : halfSize)),
+			halfTransfer == true ? halfSize : size - halfSize);
+}
+
+#endif	// def DISTORTOS_CHIP_DATA_CACHE_ENABLE
+
 /**
  * \brief Modifies current value of CR register.
  *
@@ -192,20 +239,40 @@ void DmaChannel::interruptHandler()
 
 	const auto channelId = dmaChannelPeripheral_.getChannelId();
 	const auto channelShift = getChannelShift(channelId);
+	const auto htFlag = DMA_LISR_HTIF0 << channelShift;
 	const auto tcFlag = DMA_LISR_TCIF0 << channelShift;
 	const auto teFlag = DMA_LISR_TEIF0 << channelShift;
-	const auto flags = readIsr(dmaPeripheral_, channelId) & (tcFlag | teFlag);
+	const auto flags = readIsr(dmaPeripheral_, channelId) & (htFlag | tcFlag | teFlag);
 	if (flags == 0)
 		return;
 
-	const auto enabledFlags = flags & (dmaChannelPeripheral_.readCr() << (channelShift + 1));
+	const auto cr = dmaChannelPeripheral_.readCr();
+	const auto enabledFlags = flags & (cr << (channelShift + 1));
 	if (enabledFlags == 0)
 		return;
 
 	writeIfcr(dmaPeripheral_, channelId, enabledFlags);
 
+#ifdef DISTORTOS_CHIP_DATA_CACHE_ENABLE
+	const auto invalidate = invalidateSize_ != 0 && (cr & (DMA_SxCR_CIRC | DMA_SxCR_DBM)) != 0;
+#endif	// def DISTORTOS_CHIP_DATA_CACHE_ENABLE
+
+	if ((enabledFlags & htFlag) != 0)
+	{
+#ifdef DISTORTOS_CHIP_DATA_CACHE_ENABLE
+		if (invalidate == true)
+			invalidateCompletedMemory(dmaChannelPeripheral_, cr, invalidateSize_, true);
+#endif	// def DISTORTOS_CHIP_DATA_CACHE_ENABLE
+		functor_->halfTransferEvent();
+	}
 	if ((enabledFlags & tcFlag) != 0)
+	{
+#ifdef DISTORTOS_CHIP_DATA_CACHE_ENABLE
+		if (invalidate == true)
+			invalidateCompletedMemory(dmaChannelPeripheral_, cr, invalidateSize_, false);
+#endif	// def DISTORTOS_CHIP_DATA_CACHE_ENABLE
 		functor_->transferCompleteEvent();
+	}
 	if ((enabledFlags & teFlag) != 0)
 		functor_->transferErrorEvent(getTransactionsLeft());
 }
@@ -214,6 +281,12 @@ void DmaChannel::interruptHandler()
 | private functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
+uint8_t DmaChannel::getCurrentMemory() const
+{
+	assert(functor_ != nullptr);
+	return (dmaChannelPeripheral_.readCr() & DMA_SxCR_CT) != 0;
+}
+
 size_t DmaChannel::getTransactionsLeft() const
 {
 	return dmaChannelPeripheral_.readNdtr();
@@ -240,8 +313,71 @@ int DmaChannel::reserve(const uint8_t request, DmaChannelFunctor& functor)
 	return {};
 }
 
+void DmaChannel::setMemoryAddress(const uint8_t memory, const uintptr_t memoryAddress)
+{
+	assert(functor_ != nullptr);
+	assert(memory <= 1);
+
+	const auto cr = dmaChannelPeripheral_.readCr();
+	assert((cr & (DMA_SxCR_DBM | DMA_SxCR_EN)) == (DMA_SxCR_DBM | DMA_SxCR_EN));
+	assert(((cr & DMA_SxCR_CT) != 0) != (memory != 0));
+
+#ifdef DISTORTOS_CHIP_DATA_CACHE_ENABLE
+
+	if (cleanSize_ != 0)
+		architecture::cleanDataCache(reinterpret_cast<void*>(memoryAddress), cleanSize_);
+	if (invalidateSize_ != 0)
+		architecture::cleanAndInvalidateDataCache(reinterpret_cast<void*>(memoryAddress), invalidateSize_);
+
+#endif	// def DISTORTOS_CHIP_DATA_CACHE_ENABLE
+
+	if (memory == 0)
+		dmaChannelPeripheral_.writeM0ar(memoryAddress);
+	else
+		dmaChannelPeripheral_.writeM1ar(memoryAddress);
+}
+
 void DmaChannel::startTransfer(const uintptr_t memoryAddress, const uintptr_t peripheralAddress,
-		const size_t transactions, const Flags flags) const
+		const size_t transactions, const Flags flags)
+{
+	startTransferImplementation(memoryAddress, {}, peripheralAddress, transactions, flags, false);
+}
+
+void DmaChannel::startTransfer(const uintptr_t memoryAddress0, const uintptr_t memoryAddress1,
+		const uintptr_t peripheralAddress, const size_t transactions, const Flags flags)
+{
+	startTransferImplementation(memoryAddress0, memoryAddress1, peripheralAddress, transactions, flags, true);
+}
+
+void DmaChannel::stopTransfer()
+{
+	assert(functor_ != nullptr);
+
+	modifyCr(dmaChannelPeripheral_.readCr(), dmaChannelPeripheral_,
+			DMA_SxCR_TCIE | DMA_SxCR_HTIE | DMA_SxCR_TEIE | DMA_SxCR_DMEIE | DMA_SxCR_EN, {});
+	while ((dmaChannelPeripheral_.readCr() & DMA_SxCR_EN) != 0);
+	const auto channelId = dmaChannelPeripheral_.getChannelId();
+	constexpr uint32_t allFlags {DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 |
+			DMA_LIFCR_CFEIF0};
+	writeIfcr(dmaPeripheral_, channelId, allFlags << getChannelShift(channelId));
+
+#ifdef DISTORTOS_CHIP_DATA_CACHE_ENABLE
+
+	if (invalidateSize_ != 0)
+	{
+		architecture::invalidateDataCache(reinterpret_cast<void*>(dmaChannelPeripheral_.readM0ar()), invalidateSize_);
+		if ((dmaChannelPeripheral_.readCr() & DMA_SxCR_DBM) != 0)
+			architecture::invalidateDataCache(reinterpret_cast<void*>(dmaChannelPeripheral_.readM1ar()),
+					invalidateSize_);
+		invalidateSize_ = {};
+	}
+	cleanSize_ = {};
+
+#endif	// def DISTORTOS_CHIP_DATA_CACHE_ENABLE
+}
+
+void DmaChannel::startTransferImplementation(const uintptr_t memoryAddress0, const uintptr_t memoryAddress1,
+		const uintptr_t peripheralAddress, const size_t transactions, const Flags flags, const bool doubleBuffer)
 {
 	assert(functor_ != nullptr);
 
@@ -276,35 +412,62 @@ void DmaChannel::startTransfer(const uintptr_t memoryAddress, const uintptr_t pe
 			peripheralBurstSizeFlags == Flags::peripheralBurstSize4 ? 4 :
 			peripheralBurstSizeFlags == Flags::peripheralBurstSize8 ? 8 : 16;
 
-	assert(memoryAddress % (memoryDataSize * memoryBurstSize) == 0 &&
+	assert(memoryAddress0 % (memoryDataSize * memoryBurstSize) == 0 &&
+			(doubleBuffer == false || memoryAddress1 % (memoryDataSize * memoryBurstSize) == 0) &&
 			peripheralAddress % (peripheralDataSize * peripheralBurstSize) == 0);
 
 	assert(transactions != 0 && transactions <= UINT16_MAX);
 	assert((dmaChannelPeripheral_.readCr() & tcieHtieTeieDmeieEnFlags) == 0);
+	assert((flags & Flags::memoryToMemory) != Flags::memoryToMemory ||
+			(doubleBuffer == false && (flags & Flags::circularModeEnable) != Flags::circularModeEnable));
+
+#ifdef DISTORTOS_CHIP_DATA_CACHE_ENABLE
+
+	{
+		const auto memoryIncrement = (flags & Flags::memoryIncrement) == Flags::memoryIncrement;
+		const size_t size = memoryIncrement == true ? transactions * peripheralDataSize : memoryDataSize;
+		if ((flags & Flags::memoryToPeripheral) == Flags::memoryToPeripheral)
+		{
+			architecture::cleanDataCache(reinterpret_cast<void*>(memoryAddress0), size);
+			if (doubleBuffer == true)
+				architecture::cleanDataCache(reinterpret_cast<void*>(memoryAddress1), size);
+			cleanSize_ = size;
+			invalidateSize_ = {};
+		}
+		else
+		{
+			architecture::cleanAndInvalidateDataCache(reinterpret_cast<void*>(memoryAddress0), size);
+			if (doubleBuffer == true)
+				architecture::cleanAndInvalidateDataCache(reinterpret_cast<void*>(memoryAddress1), size);
+			cleanSize_ = {};
+			// contents of memory which is not incremented are irrelevant, so invalidation of possibly shared cache
+			// line after the transfer would do more harm than good
+			invalidateSize_ = memoryIncrement == true ? size : 0;
+		}
+
+		if ((flags & Flags::memoryToMemory) == Flags::memoryToMemory)
+		{
+			const auto peripheralIncrement = (flags & Flags::peripheralIncrement) == Flags::peripheralIncrement;
+			architecture::cleanDataCache(reinterpret_cast<void*>(peripheralAddress),
+					peripheralIncrement == true ? transactions * peripheralDataSize : peripheralDataSize);
+		}
+	}
+
+#endif	// def DISTORTOS_CHIP_DATA_CACHE_ENABLE
 
 	dmaChannelPeripheral_.writeNdtr(transactions);
 	dmaChannelPeripheral_.writePar(peripheralAddress);
-	dmaChannelPeripheral_.writeM0ar(memoryAddress);
+	dmaChannelPeripheral_.writeM0ar(memoryAddress0);
+	if (doubleBuffer == true)
+		dmaChannelPeripheral_.writeM1ar(memoryAddress1);
 	dmaChannelPeripheral_.writeFcr(DMA_SxFCR_DMDIS | DMA_SxFCR_FTH);
 	dmaChannelPeripheral_.writeCr(request_ << DMA_SxCR_CHSEL_Pos |
 			static_cast<uint32_t>(flags) |
+			(doubleBuffer == true ? DMA_SxCR_DBM : 0) |
 			DMA_SxCR_TEIE |
 			DMA_SxCR_EN);
 }
 
-void DmaChannel::stopTransfer() const
-{
-	assert(functor_ != nullptr);
-
-	modifyCr(dmaChannelPeripheral_.readCr(), dmaChannelPeripheral_,
-			DMA_SxCR_TCIE | DMA_SxCR_HTIE | DMA_SxCR_TEIE | DMA_SxCR_DMEIE | DMA_SxCR_EN, {});
-	while ((dmaChannelPeripheral_.readCr() & DMA_SxCR_EN) != 0);
-	const auto channelId = dmaChannelPeripheral_.getChannelId();
-	constexpr uint32_t allFlags {DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 |
-			DMA_LIFCR_CFEIF0};
-	writeIfcr(dmaPeripheral_, channelId, allFlags << getChannelShift(channelId));
-}
-
 }	// namespace chip
 
 }	// namespace distortos
@@ -0,0 +1,181 @@
+/**
+ * \file
+ * \brief DmaMemcpy class implementation for DMAv2 in STM32
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/chip/DmaMemcpy.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/Semaphore.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <cerrno>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace chip
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+DmaMemcpy::~DmaMemcpy()
+{
+	assert(busy_ == false);
+}
+
+int DmaMemcpy::copy(void* const destination, const void* const source, const size_t size)
+{
+	if (size < threshold_)
+	{
+		memcpy(destination, source, size);
+		return 0;
+	}
+
+	{
+		const auto ret = startCopy(destination, source, size);
+		if (ret == EBUSY)	// DMA is busy - don't wait for it
+		{
+			memcpy(destination, source, size);
+			return 0;
+		}
+		if (ret != 0)
+			return ret;
+	}
+
+	return waitForCompletion();
+}
+
+int DmaMemcpy::startCopy(void* const destination, const void* const source, const size_t size)
+{
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+
+		if (busy_ == true)
+			return EBUSY;
+
+		busy_ = true;
+	}
+
+	ret_ = {};
+	done_ = {};
+	transactions_ = {};
+
+	if (size < threshold_ || size == 0)
+	{
+		memcpy(destination, source, size);
+		done_ = true;
+		return 0;
+	}
+
+	{
+		const auto ret = dmaChannelHandle_.reserve(dmaChannel_, {}, *this);
+		if (ret != 0)
+		{
+			busy_ = false;
+			return ret;
+		}
+	}
+
+	destination_ = reinterpret_cast<uintptr_t>(destination);
+	source_ = reinterpret_cast<uintptr_t>(source);
+	size_ = size;
+	const auto alignment = destination_ | source_ | size_;
+	dataSize_ = alignment % 4 == 0 ? 4 : alignment % 2 == 0 ? 2 : 1;
+	startTransfer();
+	return 0;
+}
+
+int DmaMemcpy::waitForCompletion()
+{
+	assert(busy_ == true);
+
+	Semaphore semaphore {0};
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+
+		if (done_ == false)
+			semaphore_ = &semaphore;
+	}
+
+	if (semaphore_ != nullptr)
+	{
+		while (semaphore.wait() != 0);
+		semaphore_ = {};
+	}
+
+	if (transactions_ != 0)	// DMA was used?
+		dmaChannelHandle_.release();
+
+	const auto ret = ret_;
+	transactions_ = {};
+	busy_ = false;
+	return ret;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void DmaMemcpy::finish(const int ret)
+{
+	ret_ = ret;
+	done_ = true;
+	const auto semaphore = semaphore_;
+	if (semaphore != nullptr)
+		semaphore->post();
+}
+
+void DmaMemcpy::startTransfer()
+{
+	assert(size_ != 0);
+
+	transactions_ = std::min<size_t>(size_ / dataSize_, std::numeric_limits<decltype(transactions_)>::max());
+	dmaChannelHandle_.startTransfer(destination_, source_, transactions_,
+			(dataSize_ == 4 ? DmaChannel::Flags::dataSize4 :
+			dataSize_ == 2 ? DmaChannel::Flags::dataSize2 : DmaChannel::Flags::dataSize1) |
+			DmaChannel::Flags::transferCompleteInterruptEnable | DmaChannel::Flags::memoryToMemory |
+			DmaChannel::Flags::peripheralIncrement | DmaChannel::Flags::memoryIncrement |
+			DmaChannel::Flags::lowPriority);
+}
+
+void DmaMemcpy::transferCompleteEvent()
+{
+	dmaChannelHandle_.stopTransfer();
+
+	const size_t chunk = transactions_ * dataSize_;
+	destination_ += chunk;
+	source_ += chunk;
+	size_ -= chunk;
+
+	if (size_ != 0)
+	{
+		startTransfer();
+		return;
+	}
+
+	finish(0);
+}
+
+void DmaMemcpy::transferErrorEvent(size_t)
+{
+	dmaChannelHandle_.stopTransfer();
+	finish(EIO);
+}
+
+}	// namespace chip
+
+}	// namespace distortos
@@ -31,6 +31,11 @@ namespace chip
 /// DMA transfer configuration flags
 enum class DmaChannelFlags : uint32_t
 {
+	/// "half transfer" interrupt is disabled
+	halfTransferInterruptDisable = 0 << 3,
+	/// "half transfer" interrupt is enabled
+	halfTransferInterruptEnable = 1 << 3,
+
 	/// "transfer complete" interrupt is disabled
 	transferCompleteInterruptDisable = 0 << 4,
 	/// "transfer complete" interrupt is enabled
@@ -45,6 +50,13 @@ enum class DmaChannelFlags : uint32_t
 	peripheralToMemory = 0 << 6,
 	/// transfer from memory to peripheral
 	memoryToPeripheral = 1 << 6,
+	/// transfer from memory (peripheral address) to memory (memory address), available only for streams of DMA2
+	memoryToMemory = 2 << 6,
+
+	/// circular mode is disabled - transfer is finished after configured number of transactions
+	circularModeDisable = 0 << 8,
+	/// circular mode is enabled - transfer is automatically restarted after configured number of transactions
+	circularModeEnable = 1 << 8,
 
 	/// peripheral address is fixed
 	peripheralFixed = 0 << 9,
@@ -143,6 +155,11 @@ class DmaPeripheral;
 /**
  * \brief DmaChannel class is a low-level DMA channel driver for DMAv2 in STM32.
  *
+ * Apart from one-shot transfers, the driver supports circular mode (selected with DmaChannelFlags::circularModeEnable)
+ * and double-buffer mode (selected by starting the transfer with two memory addresses), in which the transfer never
+ * stops on its own - DmaChannelFunctor::halfTransferEvent() and DmaChannelFunctor::transferCompleteEvent() are executed
+ * each time half or whole of the buffer is done.
+ *
  * \ingroup devices
  */
 
@@ -166,6 +183,8 @@ public:
 			dmaPeripheral_{dmaPeripheral},
 			dmaChannelPeripheral_{dmaChannelPeripheral},
 			functor_{},
+			cleanSize_{},
+			invalidateSize_{},
 			request_{}
 	{
 
@@ -194,6 +213,15 @@ public:
 
 private:
 
+	/**
+	 * \pre Driver is reserved.
+	 * \pre Transfer in double-buffer mode is in progress.
+	 *
+	 * \return index of memory buffer which is currently used by the transfer, 0 (M0AR) or 1 (M1AR)
+	 */
+
+	uint8_t getCurrentMemory() const;
+
 	/**
 	 * \return number of transactions left
 	 */
@@ -225,14 +253,47 @@ private:
 
 	int reserve(uint8_t request, DmaChannelFunctor& functor);
 
+	/**
+	 * \brief Sets address of memory buffer which is not currently used by the transfer in double-buffer mode.
+	 *
+	 * This function should be called from DmaChannelFunctor::transferCompleteEvent() to replace the buffer that was
+	 * just completed, before the transfer switches back to it.
+	 *
+	 * If data cache is enabled, new memory region is cleaned (and invalidated for peripheral-to-memory transfers) just
+	 * like in startTransfer().
+	 *
+	 * \pre Driver is reserved.
+	 * \pre Transfer in double-buffer mode is in progress.
+	 * \pre \a memory is not the index returned by getCurrentMemory().
+	 * \pre \a memoryAddress is valid.
+	 *
+	 * \param [in] memory is the index of memory buffer which will be modified, 0 (M0AR) or 1 (M1AR)
+	 * \param [in] memoryAddress is the new memory address, must be divisible by configured memory data size multiplied
+	 * by configured memory burst size
+	 */
+
+	void setMemoryAddress(uint8_t memory, uintptr_t memoryAddress);
+
 	/**
 	 * \brief Configures and starts asynchronous transfer.
 	 *
 	 * This function returns immediately. When the transfer is physically finished (either expected number of
 	 * transactions were executed or an error was detected), one of DmaChannelFunctor functions will be executed.
 	 *
+	 * In circular mode the transfer is never finished on its own - each time configured number of transactions is
+	 * executed, the transfer is restarted from the beginning of memory region. The transfer must be stopped explicitly
+	 * with stopTransfer().
+	 *
+	 * If data cache is enabled, memory region is cleaned before the transfer is started. For peripheral-to-memory
+	 * transfers with incremented memory address, that region is also invalidated by stopTransfer() (and in circular
+	 * mode - each half of it is invalidated before DmaChannelFunctor::halfTransferEvent() and
+	 * DmaChannelFunctor::transferCompleteEvent() are executed), so it should be aligned to the size of cache line. In
+	 * memory-to-memory transfers memory region is handled just like in peripheral-to-memory transfers and source
+	 * region (at peripheral address) is cleaned.
+	 *
 	 * \pre Driver is reserved.
 	 * \pre \a memoryAddress and \a peripheralAddress and \a transactions and \a flags are valid.
+	 * \pre Circular mode is not used with memory-to-memory transfers.
 	 * \pre Memory data size multiplied by memory burst size is less than or equal to 16.
 	 * \pre No transfer is in progress.
 	 *
@@ -246,7 +307,40 @@ private:
 	 * \param [in] flags are configuration flags
 	 */
 
-	void startTransfer(uintptr_t memoryAddress, uintptr_t peripheralAddress, size_t transactions, Flags flags) const;
+	void startTransfer(uintptr_t memoryAddress, uintptr_t peripheralAddress, size_t transactions, Flags flags);
+
+	/**
+	 * \brief Configures and starts asynchronous transfer in double-buffer mode.
+	 *
+	 * This function returns immediately. The transfer is executed with memory buffers used alternately and is never
+	 * finished on its own - each time configured number of transactions is executed, the buffers are swapped by
+	 * hardware and DmaChannelFunctor::transferCompleteEvent() is executed (if enabled with
+	 * DmaChannelFlags::transferCompleteInterruptEnable). The transfer must be stopped explicitly with stopTransfer().
+	 *
+	 * If data cache is enabled, both memory regions are cleaned before the transfer is started. For
+	 * peripheral-to-memory transfers with incremented memory address, completed parts of these regions are also
+	 * invalidated before DmaChannelFunctor::halfTransferEvent() and DmaChannelFunctor::transferCompleteEvent() are
+	 * executed, so both regions should be aligned to the size of cache line.
+	 *
+	 * \pre Driver is reserved.
+	 * \pre \a memoryAddress0 and \a memoryAddress1 and \a peripheralAddress and \a transactions and \a flags are valid.
+	 * \pre Memory data size multiplied by memory burst size is less than or equal to 16.
+	 * \pre No transfer is in progress.
+	 *
+	 * \post Transfer is in progress.
+	 *
+	 * \param [in] memoryAddress0 is the address of first memory buffer (M0AR), must be divisible by configured memory
+	 * data size multiplied by configured memory burst size
+	 * \param [in] memoryAddress1 is the address of second memory buffer (M1AR), must be divisible by configured memory
+	 * data size multiplied by configured memory burst size
+	 * \param [in] peripheralAddress is the peripheral address, must be divisible by peripheral data size multiplied by
+	 * configured peripheral burst size
+	 * \param [in] transactions is the number of transactions for each memory buffer, [1; 65535]
+	 * \param [in] flags are configuration flags, DmaChannelFlags::circularModeEnable is implied
+	 */
+
+	void startTransfer(uintptr_t memoryAddress0, uintptr_t memoryAddress1, uintptr_t peripheralAddress,
+			size_t transactions, Flags flags);
 
 	/**
 	 * \brief Stops transfer.
@@ -259,7 +353,21 @@ private:
 	 * \post No transfer is in progress.
 	 */
 
-	void stopTransfer() const;
+	void stopTransfer();
+
+	/**
+	 * \brief Configures and starts asynchronous transfer in single-buffer or double-buffer mode.
+	 *
+	 * \param [in] memoryAddress0 is the address of first memory buffer (M0AR)
+	 * \param [in] memoryAddress1 is the address of second memory buffer (M1AR), ignored if \a doubleBuffer is false
+	 * \param [in] peripheralAddress is the peripheral address
+	 * \param [in] transactions is the number of transactions
+	 * \param [in] flags are configuration flags
+	 * \param [in] doubleBuffer selects whether single-buffer (false) or double-buffer (true) mode is used
+	 */
+
+	void startTransferImplementation(uintptr_t memoryAddress0, uintptr_t memoryAddress1, uintptr_t peripheralAddress,
+			size_t transactions, Flags flags, bool doubleBuffer);
 
 	/// reference to raw DMA peripheral
 	const DmaPeripheral& dmaPeripheral_;
@@ -270,6 +378,14 @@ private:
 	/// pointer to DmaChannelFunctor object associated with this one
 	DmaChannelFunctor* functor_;
 
+	/// size of memory region which must be cleaned in data cache when memory buffer of memory-to-peripheral transfer is
+	/// changed with setMemoryAddress(), bytes
+	size_t cleanSize_;
+
+	/// size of memory region which must be invalidated from data cache when peripheral-to-memory transfer is stopped,
+	/// bytes
+	size_t invalidateSize_;
+
 	/// request identifier with which this object is associated
 	uint8_t request_;
 };
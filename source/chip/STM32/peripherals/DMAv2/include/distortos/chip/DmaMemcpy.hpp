@@ -0,0 +1,220 @@
+/**
+ * \file
+ * \brief DmaMemcpy class header for DMAv2 in STM32
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SOURCE_CHIP_STM32_PERIPHERALS_DMAV2_INCLUDE_DISTORTOS_CHIP_DMAMEMCPY_HPP_
+#define SOURCE_CHIP_STM32_PERIPHERALS_DMAV2_INCLUDE_DISTORTOS_CHIP_DMAMEMCPY_HPP_
+
+#include "distortos/chip/DmaChannelFunctorCommon.hpp"
+#include "distortos/chip/DmaChannelHandle.hpp"
+
+#include "distortos/devices/memory/MemcpyEngine.hpp"
+
+namespace distortos
+{
+
+class Semaphore;
+
+namespace chip
+{
+
+/**
+ * \brief DmaMemcpy class is a memory-to-memory copy engine for DMAv2 in STM32.
+ *
+ * Copies are executed by a DMA stream in memory-to-memory mode, so the CPU is free to do other work. Copies which are
+ * smaller than the configured threshold (for which the setup of DMA would take longer than the copy itself) and copies
+ * requested when DMA stream is already busy are done by the CPU with `memcpy()`.
+ *
+ * \note Only streams of DMA2 can perform memory-to-memory transfers.
+ *
+ * \warning If data cache is enabled, destination buffer should be aligned to the size of cache line and its size
+ * should be a multiple of the size of cache line - it is invalidated after the copy.
+ *
+ * \ingroup devices
+ */
+
+class DmaMemcpy : public devices::MemcpyEngine, private DmaChannelFunctorCommon
+{
+public:
+
+	/// default value of threshold below which copies are done by the CPU, bytes
+	constexpr static size_t defaultThreshold {256};
+
+	/**
+	 * \brief DmaMemcpy's constructor
+	 *
+	 * \param [in] dmaChannel is a reference to DMA channel (stream of DMA2) used for copies
+	 * \param [in] threshold is the size of copy below which `memcpy()` is used instead of DMA, bytes, default -
+	 * defaultThreshold
+	 */
+
+	constexpr explicit DmaMemcpy(DmaChannel& dmaChannel, const size_t threshold = defaultThreshold) :
+			dmaChannel_{dmaChannel},
+			dmaChannelHandle_{},
+			semaphore_{},
+			destination_{},
+			source_{},
+			size_{},
+			threshold_{threshold},
+			ret_{},
+			transactions_{},
+			dataSize_{},
+			busy_{},
+			done_{}
+	{
+
+	}
+
+	/**
+	 * \brief DmaMemcpy's destructor
+	 *
+	 * \pre No copy is in progress.
+	 */
+
+	~DmaMemcpy() override;
+
+	/**
+	 * \brief Copies block of memory, just like `memcpy()`.
+	 *
+	 * This function blocks until the copy is finished. If \a size is less than the threshold or another copy is in
+	 * progress, `memcpy()` is used.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre \a destination and \a source regions don't overlap.
+	 *
+	 * \param [out] destination is a pointer to destination buffer
+	 * \param [in] source is a pointer to source buffer
+	 * \param [in] size is the number of bytes to copy
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by startCopy();
+	 * - error codes returned by waitForCompletion();
+	 */
+
+	int copy(void* destination, const void* source, size_t size) override;
+
+	/**
+	 * \brief Starts asynchronous copy of block of memory.
+	 *
+	 * This function returns immediately (if \a size is less than the threshold, `memcpy()` is executed before
+	 * returning). The copy must be completed with waitForCompletion() by the same context.
+	 *
+	 * \pre \a destination and \a source regions don't overlap.
+	 *
+	 * \param [out] destination is a pointer to destination buffer
+	 * \param [in] source is a pointer to source buffer
+	 * \param [in] size is the number of bytes to copy
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBUSY - another copy is in progress;
+	 * - error codes returned by DmaChannelHandle::reserve();
+	 */
+
+	int startCopy(void* destination, const void* source, size_t size);
+
+	/**
+	 * \brief Waits for completion of copy started with startCopy().
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Copy was successfully started with startCopy() and was not completed with waitForCompletion() yet.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EIO - transfer error detected by DMA;
+	 */
+
+	int waitForCompletion();
+
+	DmaMemcpy(const DmaMemcpy&) = delete;
+	DmaMemcpy(DmaMemcpy&&) = delete;
+	const DmaMemcpy& operator=(const DmaMemcpy&) = delete;
+	DmaMemcpy& operator=(DmaMemcpy&&) = delete;
+
+private:
+
+	/**
+	 * \brief Finishes the copy and notifies waiting thread.
+	 *
+	 * \param [in] ret is the result of the copy (0 on success, error code otherwise)
+	 */
+
+	void finish(int ret);
+
+	/**
+	 * \brief Starts DMA transfer for next chunk of the copy.
+	 *
+	 * \pre At least one byte is left to copy.
+	 */
+
+	void startTransfer();
+
+	/**
+	 * \brief "Transfer complete" event
+	 *
+	 * Called by low-level DMA channel driver when the transfer is physically finished.
+	 *
+	 * Starts transfer of next chunk or finishes the copy if all bytes were copied.
+	 */
+
+	void transferCompleteEvent() override;
+
+	/**
+	 * \brief "Transfer error" event
+	 *
+	 * Called by low-level DMA channel driver when transfer error is detected.
+	 *
+	 * \param [in] transactionsLeft is the number of transactions left
+	 */
+
+	void transferErrorEvent(size_t transactionsLeft) override;
+
+	/// reference to DMA channel used for copies
+	DmaChannel& dmaChannel_;
+
+	/// handle of DMA channel used for copies
+	DmaChannelHandle dmaChannelHandle_;
+
+	/// pointer to semaphore used to notify waiting thread about completion of copy
+	Semaphore* volatile semaphore_;
+
+	/// address of destination of next chunk
+	uintptr_t destination_;
+
+	/// address of source of next chunk
+	uintptr_t source_;
+
+	/// number of bytes left to copy, including current chunk
+	size_t size_;
+
+	/// size of copy below which `memcpy()` is used instead of DMA, bytes
+	size_t threshold_;
+
+	/// result of the copy (0 on success, error code otherwise)
+	volatile int ret_;
+
+	/// number of transactions in current chunk, 0 if DMA is not used for the copy
+	uint16_t transactions_;
+
+	/// size of single transaction, bytes, {1, 2, 4}
+	uint8_t dataSize_;
+
+	/// tells whether copy was started with startCopy() and not completed with waitForCompletion() (true) or not (false)
+	bool busy_;
+
+	/// tells whether the copy is finished (true) or not (false)
+	volatile bool done_;
+};
+
+}	// namespace chip
+
+}	// namespace distortos
+
+#endif	// SOURCE_CHIP_STM32_PERIPHERALS_DMAV2_INCLUDE_DISTORTOS_CHIP_DMAMEMCPY_HPP_
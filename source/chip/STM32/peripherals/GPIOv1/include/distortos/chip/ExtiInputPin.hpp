@@ -0,0 +1,228 @@
+/**
+ * \file
+ * \brief ExtiInputPin class header for GPIOv1 in STM32
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SOURCE_CHIP_STM32_PERIPHERALS_GPIOV1_INCLUDE_DISTORTOS_CHIP_EXTIINPUTPIN_HPP_
+#define SOURCE_CHIP_STM32_PERIPHERALS_GPIOV1_INCLUDE_DISTORTOS_CHIP_EXTIINPUTPIN_HPP_
+
+#include "distortos/chip/InputPin.hpp"
+
+#include "distortos/Semaphore.hpp"
+
+namespace distortos
+{
+
+namespace chip
+{
+
+/**
+ * \brief ExtiInputPin class is a single input pin of GPIOv1 in STM32 with edge detection done by EXTI.
+ *
+ * Selected edges of the pin are detected by EXTI line with the same number as the pin, so at most one pin with given
+ * number (e.g. only one of PA3, PB3, PC3, ...) may be enabled at a time. Detected edge is latched - if no thread is
+ * waiting for it, next call to waitForEdge() (or its variants) returns immediately. For each detected edge edgeEvent()
+ * is executed from interrupt context.
+ *
+ * \note EXTI interrupts must be enabled in configuration (distortos_Peripherals_EXTI), otherwise no edge will ever be
+ * reported.
+ *
+ * \ingroup devices
+ */
+
+class ExtiInputPin : public InputPin
+{
+public:
+
+	/// edge of the pin which is detected
+	enum class Edge : uint8_t
+	{
+		/// rising edge - transition from false to true
+		rising = 1 << 0,
+		/// falling edge - transition from true to false
+		falling = 1 << 1,
+		/// both rising and falling edges
+		both = rising | falling,
+	};
+
+	/**
+	 * \brief ExtiInputPin's constructor
+	 *
+	 * \param [in] pin is the identifier of pin
+	 * \param [in] edge selects the edge which is detected, edges refer to the state returned by get(), so they are
+	 * swapped when the pin is inverted
+	 * \param [in] pull is the desired pull-up/pull-down configuration of pin, default - PinPull::none
+	 * \param [in] inverted selects whether the pin is inverted (true) - get() returns true when GPIO state is low and
+	 * false when GPIO state is high - or not (false), default - false, not inverted
+	 */
+
+	ExtiInputPin(Pin pin, Edge edge, PinPull pull = {}, bool inverted = {});
+
+	/**
+	 * \brief ExtiInputPin's destructor
+	 *
+	 * Disables edge detection if it is enabled.
+	 */
+
+	~ExtiInputPin() override;
+
+	/**
+	 * \brief Disables edge detection.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - edge detection is not enabled;
+	 */
+
+	int disable();
+
+	/**
+	 * \brief Enables edge detection.
+	 *
+	 * Any edge latched before this call is discarded.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - edge detection is already enabled;
+	 * - EBUSY - EXTI line is already used by another pin;
+	 */
+
+	int enable();
+
+	/**
+	 * \brief Waits for edge of the pin for given duration of time.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - edge detection is not enabled;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - no edge was detected before the specified timeout expired;
+	 */
+
+	int tryWaitForEdgeFor(TickClock::duration duration);
+
+	/**
+	 * \brief Waits for edge of the pin for given duration of time.
+	 *
+	 * Template variant of tryWaitForEdgeFor(TickClock::duration duration).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - edge detection is not enabled;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - no edge was detected before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	int tryWaitForEdgeFor(const std::chrono::duration<Rep, Period> duration)
+	{
+		return tryWaitForEdgeFor(std::chrono::duration_cast<TickClock::duration>(duration));
+	}
+
+	/**
+	 * \brief Waits for edge of the pin until given time point.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - edge detection is not enabled;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - no edge was detected before the specified timeout expired;
+	 */
+
+	int tryWaitForEdgeUntil(TickClock::time_point timePoint);
+
+	/**
+	 * \brief Waits for edge of the pin until given time point.
+	 *
+	 * Template variant of tryWaitForEdgeUntil(TickClock::time_point timePoint).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - edge detection is not enabled;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - no edge was detected before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	int tryWaitForEdgeUntil(const std::chrono::time_point<TickClock, Duration> timePoint)
+	{
+		return tryWaitForEdgeUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
+	}
+
+	/**
+	 * \brief Waits for edge of the pin.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - edge detection is not enabled;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 */
+
+	int waitForEdge();
+
+	/**
+	 * \brief Interrupt handler for range of EXTI lines
+	 *
+	 * \note this must not be called by user code
+	 *
+	 * \param [in] firstLine is the first EXTI line handled by the interrupt
+	 * \param [in] lastLine is the last EXTI line handled by the interrupt
+	 */
+
+	static void interruptHandler(uint8_t firstLine, uint8_t lastLine);
+
+	ExtiInputPin(const ExtiInputPin&) = delete;
+	ExtiInputPin(ExtiInputPin&&) = delete;
+	const ExtiInputPin& operator=(const ExtiInputPin&) = delete;
+	ExtiInputPin& operator=(ExtiInputPin&&) = delete;
+
+private:
+
+	/**
+	 * \brief "Edge" event
+	 *
+	 * Called from interrupt context when selected edge of the pin is detected, after the thread waiting for the edge
+	 * was notified.
+	 *
+	 * Default implementation does nothing, derived classes may override it to implement edge callbacks.
+	 */
+
+	virtual void edgeEvent();
+
+	/// semaphore used to latch detected edge and to notify waiting thread
+	Semaphore semaphore_;
+
+	/// edge which is detected
+	Edge edge_;
+
+	/// tells whether edge detection is enabled (true) or not (false)
+	bool enabled_;
+};
+
+}	// namespace chip
+
+}	// namespace distortos
+
+#endif	// SOURCE_CHIP_STM32_PERIPHERALS_GPIOV1_INCLUDE_DISTORTOS_CHIP_EXTIINPUTPIN_HPP_
@@ -51,6 +51,15 @@ public:
 
 protected:
 
+	/**
+	 * \return identifier of pin
+	 */
+
+	Pin getPin() const
+	{
+		return pin_;
+	}
+
 	/**
 	 * \return true if inverted mode is enabled, false otherwise
 	 */
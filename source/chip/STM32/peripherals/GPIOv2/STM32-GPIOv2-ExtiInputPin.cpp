@@ -0,0 +1,314 @@
+/**
+ * \file
+ * \brief ExtiInputPin class implementation for GPIOv2 in STM32
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/chip/ExtiInputPin.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/InterruptMaskingLock.hpp"
+
+#if defined(EXTI_IMR1_IM0)
+#define EXTI_IMR_REGISTER						EXTI->IMR1
+#define EXTI_RTSR_REGISTER						EXTI->RTSR1
+#define EXTI_FTSR_REGISTER						EXTI->FTSR1
+#define EXTI_PR_REGISTER						EXTI->PR1
+#else	// !defined(EXTI_IMR1_IM0)
+#define EXTI_IMR_REGISTER						EXTI->IMR
+#define EXTI_RTSR_REGISTER						EXTI->RTSR
+#define EXTI_FTSR_REGISTER						EXTI->FTSR
+#define EXTI_PR_REGISTER						EXTI->PR
+#endif	// !defined(EXTI_IMR1_IM0)
+
+namespace distortos
+{
+
+namespace chip
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of EXTI lines connected to GPIOs
+constexpr uint8_t extiLines {16};
+
+/// array with pointers to ExtiInputPin objects which use EXTI lines, nullptr if EXTI line is free
+ExtiInputPin* extiInputPins[extiLines];
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+ExtiInputPin::ExtiInputPin(const Pin pin, const Edge edge, const PinPull pull, const bool inverted) :
+		InputPin{pin, pull, inverted},
+		semaphore_{0, 1},
+		edge_{edge},
+		enabled_{}
+{
+
+}
+
+ExtiInputPin::~ExtiInputPin()
+{
+	if (enabled_ == true)
+		disable();
+}
+
+int ExtiInputPin::disable()
+{
+	if (enabled_ == false)
+		return EBADF;
+
+	const auto pinNumber = decodePin(getPin()).second;
+	const uint32_t mask = 1 << pinNumber;
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+
+		EXTI_IMR_REGISTER &= ~mask;
+		EXTI_RTSR_REGISTER &= ~mask;
+		EXTI_FTSR_REGISTER &= ~mask;
+		EXTI_PR_REGISTER = mask;
+		extiInputPins[pinNumber] = {};
+	}
+
+	enabled_ = false;
+	return 0;
+}
+
+int ExtiInputPin::enable()
+{
+	if (enabled_ == true)
+		return EBADF;
+
+	const auto decodedPin = decodePin(getPin());
+	const auto portIndex = (reinterpret_cast<uintptr_t>(decodedPin.first) - GPIOA_BASE) / (GPIOB_BASE - GPIOA_BASE);
+	const auto pinNumber = decodedPin.second;
+	const uint32_t mask = 1 << pinNumber;
+	// edges refer to the state returned by get(), so they are swapped for inverted pin
+	const auto risingEdge = getInvertedMode() == false ? Edge::rising : Edge::falling;
+	const auto fallingEdge = getInvertedMode() == false ? Edge::falling : Edge::rising;
+	const auto rising = (static_cast<uint8_t>(edge_) & static_cast<uint8_t>(risingEdge)) != 0;
+	const auto falling = (static_cast<uint8_t>(edge_) & static_cast<uint8_t>(fallingEdge)) != 0;
+	auto& exticr = SYSCFG->EXTICR[pinNumber / 4];
+	const auto exticrShift = (pinNumber % 4) * 4;
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+
+		if (extiInputPins[pinNumber] != nullptr)
+			return EBUSY;
+
+		extiInputPins[pinNumber] = this;
+
+		RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+		exticr = (exticr & ~(0xf << exticrShift)) | portIndex << exticrShift;
+		EXTI_RTSR_REGISTER = rising == true ? EXTI_RTSR_REGISTER | mask : EXTI_RTSR_REGISTER & ~mask;
+		EXTI_FTSR_REGISTER = falling == true ? EXTI_FTSR_REGISTER | mask : EXTI_FTSR_REGISTER & ~mask;
+		EXTI_PR_REGISTER = mask;
+		while (semaphore_.tryWait() == 0);
+		EXTI_IMR_REGISTER |= mask;
+	}
+
+	enabled_ = true;
+	return 0;
+}
+
+int ExtiInputPin::tryWaitForEdgeFor(const TickClock::duration duration)
+{
+	if (enabled_ == false)
+		return EBADF;
+
+	return semaphore_.tryWaitFor(duration);
+}
+
+int ExtiInputPin::tryWaitForEdgeUntil(const TickClock::time_point timePoint)
+{
+	if (enabled_ == false)
+		return EBADF;
+
+	return semaphore_.tryWaitUntil(timePoint);
+}
+
+int ExtiInputPin::waitForEdge()
+{
+	if (enabled_ == false)
+		return EBADF;
+
+	return semaphore_.wait();
+}
+
+void ExtiInputPin::interruptHandler(const uint8_t firstLine, const uint8_t lastLine)
+{
+	const uint32_t lines = ((1u << (lastLine + 1)) - 1) & ~((1u << firstLine) - 1);
+	const uint32_t pending = EXTI_PR_REGISTER & EXTI_IMR_REGISTER & lines;
+	EXTI_PR_REGISTER = pending;
+
+	for (auto line = firstLine; line <= lastLine; ++line)
+		if ((pending & 1 << line) != 0)
+		{
+			const auto extiInputPin = extiInputPins[line];
+			assert(extiInputPin != nullptr);
+			extiInputPin->semaphore_.post();
+			extiInputPin->edgeEvent();
+		}
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void ExtiInputPin::edgeEvent()
+{
+
+}
+
+}	// namespace chip
+
+}	// namespace distortos
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+#ifdef DISTORTOS_ARCHITECTURE_NVIC_EXTI0_ENABLE
+
+/**
+ * \brief EXTI0 interrupt handler
+ */
+
+extern "C" void EXTI0_IRQHandler()
+{
+	distortos::chip::ExtiInputPin::interruptHandler(0, 0);
+}
+
+#endif	// def DISTORTOS_ARCHITECTURE_NVIC_EXTI0_ENABLE
+
+#ifdef DISTORTOS_ARCHITECTURE_NVIC_EXTI1_ENABLE
+
+/**
+ * \brief EXTI1 interrupt handler
+ */
+
+extern "C" void EXTI1_IRQHandler()
+{
+	distortos::chip::ExtiInputPin::interruptHandler(1, 1);
+}
+
+#endif	// def DISTORTOS_ARCHITECTURE_NVIC_EXTI1_ENABLE
+
+#ifdef DISTORTOS_ARCHITECTURE_NVIC_EXTI2_ENABLE
+
+/**
+ * \brief EXTI2 interrupt handler
+ */
+
+extern "C" void EXTI2_IRQHandler()
+{
+	distortos::chip::ExtiInputPin::interruptHandler(2, 2);
+}
+
+#endif	// def DISTORTOS_ARCHITECTURE_NVIC_EXTI2_ENABLE
+
+#ifdef DISTORTOS_ARCHITECTURE_NVIC_EXTI3_ENABLE
+
+/**
+ * \brief EXTI3 interrupt handler
+ */
+
+extern "C" void EXTI3_IRQHandler()
+{
+	distortos::chip::ExtiInputPin::interruptHandler(3, 3);
+}
+
+#endif	// def DISTORTOS_ARCHITECTURE_NVIC_EXTI3_ENABLE
+
+#ifdef DISTORTOS_ARCHITECTURE_NVIC_EXTI4_ENABLE
+
+/**
+ * \brief EXTI4 interrupt handler
+ */
+
+extern "C" void EXTI4_IRQHandler()
+{
+	distortos::chip::ExtiInputPin::interruptHandler(4, 4);
+}
+
+#endif	// def DISTORTOS_ARCHITECTURE_NVIC_EXTI4_ENABLE
+
+#ifdef DISTORTOS_ARCHITECTURE_NVIC_EXTI9_5_ENABLE
+
+/**
+ * \brief EXTI9_5 interrupt handler
+ */
+
+extern "C" void EXTI9_5_IRQHandler()
+{
+	distortos::chip::ExtiInputPin::interruptHandler(5, 9);
+}
+
+#endif	// def DISTORTOS_ARCHITECTURE_NVIC_EXTI9_5_ENABLE
+
+#ifdef DISTORTOS_ARCHITECTURE_NVIC_EXTI15_10_ENABLE
+
+/**
+ * \brief EXTI15_10 interrupt handler
+ */
+
+extern "C" void EXTI15_10_IRQHandler()
+{
+	distortos::chip::ExtiInputPin::interruptHandler(10, 15);
+}
+
+#endif	// def DISTORTOS_ARCHITECTURE_NVIC_EXTI15_10_ENABLE
+
+#ifdef DISTORTOS_ARCHITECTURE_NVIC_EXTI0_1_ENABLE
+
+/**
+ * \brief EXTI0_1 interrupt handler
+ */
+
+extern "C" void EXTI0_1_IRQHandler()
+{
+	distortos::chip::ExtiInputPin::interruptHandler(0, 1);
+}
+
+#endif	// def DISTORTOS_ARCHITECTURE_NVIC_EXTI0_1_ENABLE
+
+#ifdef DISTORTOS_ARCHITECTURE_NVIC_EXTI2_3_ENABLE
+
+/**
+ * \brief EXTI2_3 interrupt handler
+ */
+
+extern "C" void EXTI2_3_IRQHandler()
+{
+	distortos::chip::ExtiInputPin::interruptHandler(2, 3);
+}
+
+#endif	// def DISTORTOS_ARCHITECTURE_NVIC_EXTI2_3_ENABLE
+
+#ifdef DISTORTOS_ARCHITECTURE_NVIC_EXTI4_15_ENABLE
+
+/**
+ * \brief EXTI4_15 interrupt handler
+ */
+
+extern "C" void EXTI4_15_IRQHandler()
+{
+	distortos::chip::ExtiInputPin::interruptHandler(4, 15);
+}
+
+#endif	// def DISTORTOS_ARCHITECTURE_NVIC_EXTI4_15_ENABLE
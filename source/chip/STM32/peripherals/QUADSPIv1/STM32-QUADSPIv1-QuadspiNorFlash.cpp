@@ -0,0 +1,741 @@
+/**
+ * \file
+ * \brief QuadspiNorFlash class implementation for QUADSPIv1 in STM32
+ *
+ * \author Copyright (C) 2020 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/chip/QuadspiNorFlash.hpp"
+
+#include "distortos/chip/STM32-QUADSPIv1-QuadspiPeripheral.hpp"
+
+#include "distortos/assert.h"
+
+#include "estd/log2u.hpp"
+#include "estd/ScopeGuard.hpp"
+
+#include <mutex>
+
+#include <climits>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace chip
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of lines used in each phase of the command, values match IMODE, ADMODE, ABMODE and DMODE fields of CCR
+enum class Lines : uint8_t
+{
+	/// phase is skipped
+	none,
+	/// single line
+	single,
+	/// two lines
+	dual,
+	/// four lines
+	quad,
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// maximum number of dummy cycles which can be configured in CCR
+constexpr uint8_t maxDummyCycles {QUADSPI_CCR_DCYC >> QUADSPI_CCR_DCYC_Pos};
+
+/// maximum size of single transaction, bytes, limited by the max number of DMA transactions
+constexpr size_t maxTransactionSize {UINT16_MAX};
+
+/// maximum time of write of status register, which is not described in SFDP
+constexpr std::chrono::milliseconds maxWriteStatusRegisterTime {800};
+
+/// mask with all interrupt enable bits of CR which may be used by transactions
+constexpr uint32_t transactionInterruptsMask {QUADSPI_CR_SMIE | QUADSPI_CR_TCIE | QUADSPI_CR_TEIE};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Makes value of CCR register (except functional mode) for a command with single-line instruction.
+ *
+ * \pre \a addressLength is 0, 3 or 4.
+ * \pre \a alternateLength is less than or equal to 4.
+ * \pre \a dummyCycles is less than or equal to 31.
+ *
+ * \param [in] instruction is the instruction for this command
+ * \param [in] addressLines is the number of lines used for address
+ * \param [in] addressLength is the length of address for the command, bytes
+ * \param [in] alternateLines is the number of lines used for alternate bytes
+ * \param [in] alternateLength is the number of alternate bytes
+ * \param [in] dummyCycles is the number of dummy cycles
+ * \param [in] dataLines is the number of lines used for data
+ *
+ * \return value of CCR register (except functional mode) for the command
+ */
+
+uint32_t makeCcr(const uint8_t instruction, const Lines addressLines, const size_t addressLength,
+		const Lines alternateLines, const size_t alternateLength, const size_t dummyCycles, const Lines dataLines)
+{
+	assert(addressLength == 0 || addressLength == 3 || addressLength == 4);
+	assert((addressLines == Lines::none) == (addressLength == 0));
+	assert(alternateLength <= sizeof(uint32_t));
+	assert((alternateLines == Lines::none) == (alternateLength == 0));
+	assert(dummyCycles <= maxDummyCycles);
+
+	return static_cast<uint32_t>(dataLines) << QUADSPI_CCR_DMODE_Pos |
+			dummyCycles << QUADSPI_CCR_DCYC_Pos |
+			(alternateLength != 0 ? alternateLength - 1 : 0) << QUADSPI_CCR_ABSIZE_Pos |
+			static_cast<uint32_t>(alternateLines) << QUADSPI_CCR_ABMODE_Pos |
+			(addressLength != 0 ? addressLength - 1 : 0) << QUADSPI_CCR_ADSIZE_Pos |
+			static_cast<uint32_t>(addressLines) << QUADSPI_CCR_ADMODE_Pos |
+			static_cast<uint32_t>(Lines::single) << QUADSPI_CCR_IMODE_Pos |
+			instruction << QUADSPI_CCR_INSTRUCTION_Pos;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+QuadspiNorFlash::~QuadspiNorFlash()
+{
+	assert(openCount_ == 0);
+}
+
+int QuadspiNorFlash::close()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	assert(openCount_ != 0);
+
+	int ret {};
+	if (openCount_ == 1)	// last close?
+	{
+		disableMemoryMappedMode();
+		ret = waitWhileWriteInProgress(busyDeadline_);
+		deinitialize();
+	}
+
+	--openCount_;
+	return ret;
+}
+
+void QuadspiNorFlash::disableMemoryMappedMode()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	assert(openCount_ != 0);
+
+	if (memoryMapped_ == false)
+		return;
+
+	abort();
+	memoryMapped_ = {};
+}
+
+int QuadspiNorFlash::enableMemoryMappedMode()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	assert(openCount_ != 0);
+
+	if (memoryMapped_ == true)
+		return {};
+
+	{
+		const auto ret = waitWhileWriteInProgress(busyDeadline_);
+		if (ret != 0)
+			return ret;
+	}
+
+	while ((quadspiPeripheral_.readSr() & QUADSPI_SR_BUSY) != 0);
+
+	quadspiPeripheral_.writeCcr(readCcr_ | QUADSPI_CCR_FMODE_0 | QUADSPI_CCR_FMODE_1);
+	memoryMapped_ = true;
+	return {};
+}
+
+int QuadspiNorFlash::erase(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	assert(openCount_ != 0);
+	assert(memoryMapped_ == false);
+	const auto eraseBlockSize = getEraseBlockSize();
+	assert(address % eraseBlockSize == 0 && size % eraseBlockSize == 0);
+
+	const auto& basicFlashParameters = serialFlashDiscoverableParameters_.getBasicFlashParameters();
+	assert(address + size <= basicFlashParameters.size);
+
+	if (size == 0)
+		return {};
+
+	if (address == 0 && size == basicFlashParameters.size && basicFlashParameters.maximumChipEraseTimeMs != 0)
+		return executeErase(0xc7, {}, {}, std::chrono::milliseconds{basicFlashParameters.maximumChipEraseTimeMs});
+
+	uint64_t erased {};
+	while (erased < size)
+	{
+		const auto eraseIndex = serialFlashDiscoverableParameters_.selectEraseType(address + erased, size - erased);
+		const auto ret = executeErase(basicFlashParameters.eraseInstructions[eraseIndex], address + erased, 3,
+				std::chrono::milliseconds{basicFlashParameters.maximumEraseTimesMs[eraseIndex]});
+		if (ret != 0)
+			return ret;
+
+		erased += basicFlashParameters.eraseSizes[eraseIndex];
+	}
+
+	return {};
+}
+
+size_t QuadspiNorFlash::getEraseBlockSize() const
+{
+	return serialFlashDiscoverableParameters_.getEraseBlockSize();
+}
+
+const void* QuadspiNorFlash::getMemoryMappedAddress() const
+{
+	return reinterpret_cast<const void*>(quadspiPeripheral_.getMemoryMappedBase());
+}
+
+size_t QuadspiNorFlash::getProgramBlockSize() const
+{
+	return 1;
+}
+
+size_t QuadspiNorFlash::getReadBlockSize() const
+{
+	return 1;
+}
+
+uint64_t QuadspiNorFlash::getSize() const
+{
+	return serialFlashDiscoverableParameters_.getBasicFlashParameters().size;
+}
+
+void QuadspiNorFlash::interruptHandler()
+{
+	const auto sr = quadspiPeripheral_.readSr();
+	const auto cr = quadspiPeripheral_.readCr();
+
+	if ((sr & QUADSPI_SR_TEF) != 0 && (cr & QUADSPI_CR_TEIE) != 0)
+	{
+		quadspiPeripheral_.writeFcr(QUADSPI_FCR_CTEF);
+		finishTransaction(EIO);
+	}
+	else if ((sr & QUADSPI_SR_TCF) != 0 && (cr & QUADSPI_CR_TCIE) != 0)
+	{
+		quadspiPeripheral_.writeFcr(QUADSPI_FCR_CTCF);
+		finishTransaction({});
+	}
+	else if ((sr & QUADSPI_SR_SMF) != 0 && (cr & QUADSPI_CR_SMIE) != 0)
+	{
+		quadspiPeripheral_.writeFcr(QUADSPI_FCR_CSMF);
+		finishTransaction({});
+	}
+}
+
+void QuadspiNorFlash::lock()
+{
+	const auto ret = mutex_.lock();
+	assert(ret == 0);
+}
+
+int QuadspiNorFlash::open()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	assert(openCount_ < std::numeric_limits<decltype(openCount_)>::max());
+
+	if (openCount_ == 0)	// first open?
+	{
+		const auto ret = dmaChannelHandle_.reserve(dmaChannel_, dmaRequest_, dmaChannelFunctor_);
+		if (ret != 0)
+			return ret;
+	}
+
+	++openCount_;
+
+	if (openCount_ > 1)
+		return {};
+
+	auto closeScopeGuard = estd::makeScopeGuard(
+			[this]()
+			{
+				deinitialize();
+				openCount_ = {};
+			});
+
+	{
+		const auto ret = initialize();
+		if (ret != 0)
+			return ret;
+	}
+
+	closeScopeGuard.release();
+	return {};
+}
+
+int QuadspiNorFlash::program(const uint64_t address, const void* const buffer, const size_t size)
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	assert(openCount_ != 0);
+	assert(memoryMapped_ == false);
+	assert(buffer != nullptr);
+
+	const auto& basicFlashParameters = serialFlashDiscoverableParameters_.getBasicFlashParameters();
+	assert(address + size <= basicFlashParameters.size);
+
+	if (size == 0)
+		return {};
+
+	const auto pageSize = basicFlashParameters.pageSize;
+	size_t bytesWritten {};
+	const auto bufferUint8 = static_cast<const uint8_t*>(buffer);
+	while (bytesWritten < size)
+	{
+		{
+			const auto ret = waitWhileWriteInProgress(busyDeadline_);
+			if (ret != 0)
+				return ret;
+		}
+
+		const decltype(pageSize) pageOffset = (address + bytesWritten) & (pageSize - 1);	// page size is always 2^N
+		const auto chunk = std::min<decltype(size)>(pageSize - pageOffset, size - bytesWritten);
+		{
+			const auto ret = executeWriteEnabledCommand(0x02, address + bytesWritten, 3, bufferUint8 + bytesWritten,
+					chunk);
+			if (ret != 0)
+				return ret;
+		}
+
+		// ~66 ms is the absolute maximum page program time which can be represented in SFDP
+		busyDeadline_ = TickClock::now() + std::chrono::milliseconds{66};
+		bytesWritten += chunk;
+	}
+
+	return {};
+}
+
+int QuadspiNorFlash::read(const uint64_t address, void* const buffer, const size_t size)
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	assert(openCount_ != 0);
+	assert(buffer != nullptr);
+
+	assert(address + size <= serialFlashDiscoverableParameters_.getBasicFlashParameters().size);
+
+	if (size == 0)
+		return {};
+
+	if (memoryMapped_ == true)
+	{
+		memcpy(buffer, static_cast<const uint8_t*>(getMemoryMappedAddress()) + address, size);
+		return {};
+	}
+
+	{
+		const auto ret = waitWhileWriteInProgress(busyDeadline_);
+		if (ret != 0)
+			return ret;
+	}
+
+	size_t bytesRead {};
+	const auto bufferUint8 = static_cast<uint8_t*>(buffer);
+	while (bytesRead < size)
+	{
+		const auto chunk = std::min(maxTransactionSize, size - bytesRead);
+		const auto ret = executeTransaction(readCcr_, address + bytesRead, nullptr, bufferUint8 + bytesRead, chunk);
+		if (ret != 0)
+			return ret;
+
+		bytesRead += chunk;
+	}
+
+	return {};
+}
+
+int QuadspiNorFlash::synchronize()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	assert(openCount_ != 0);
+
+	if (memoryMapped_ == true)
+		return {};
+
+	return waitWhileWriteInProgress(busyDeadline_);
+}
+
+void QuadspiNorFlash::unlock()
+{
+	const auto ret = mutex_.unlock();
+	assert(ret == 0);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void QuadspiNorFlash::abort()
+{
+	quadspiPeripheral_.writeCr(quadspiPeripheral_.readCr() | QUADSPI_CR_ABORT);
+	while ((quadspiPeripheral_.readCr() & QUADSPI_CR_ABORT) != 0);
+}
+
+void QuadspiNorFlash::deinitialize()
+{
+	quadspiPeripheral_.writeCr({});
+	quadspiPeripheral_.writeDcr({});
+	dmaChannelHandle_.release();
+
+	busyDeadline_ = {};
+	readCcr_ = {};
+	memoryMapped_ = {};
+	serialFlashDiscoverableParameters_.clear();
+}
+
+int QuadspiNorFlash::enableQuadMode()
+{
+	using QuadEnableRequirements = devices::SerialFlashDiscoverableParameters::QuadEnableRequirements;
+
+	const auto quadEnableRequirements =
+			serialFlashDiscoverableParameters_.getBasicFlashParameters().quadEnableRequirements;
+	if (quadEnableRequirements == QuadEnableRequirements::none)
+		return {};
+	if (quadEnableRequirements == QuadEnableRequirements::unknown)
+		return ENOTSUP;
+
+	// status register 1 and status register 2
+	uint8_t registers[2] {};
+	uint8_t readInstructions[2] {};
+	uint8_t writeInstruction {0x01};
+	size_t writeIndex {};
+	size_t writeSize {sizeof(registers)};
+	size_t quadEnableIndex {1};
+	uint8_t quadEnableMask {1 << 1};
+
+	if (quadEnableRequirements == QuadEnableRequirements::statusRegister1Bit6)
+	{
+		readInstructions[0] = 0x05;
+		writeSize = 1;
+		quadEnableIndex = 0;
+		quadEnableMask = 1 << 6;
+	}
+	else if (quadEnableRequirements == QuadEnableRequirements::statusRegister2Bit7)
+	{
+		readInstructions[1] = 0x3f;
+		writeInstruction = 0x3e;
+		writeIndex = 1;
+		writeSize = 1;
+		quadEnableMask = 1 << 7;
+	}
+	else if (quadEnableRequirements == QuadEnableRequirements::statusRegister2Bit1Write0x31)
+	{
+		readInstructions[1] = 0x35;
+		writeInstruction = 0x31;
+		writeIndex = 1;
+		writeSize = 1;
+	}
+	else	// status register 2 bit 1, written together with status register 1
+	{
+		readInstructions[0] = 0x05;
+		if (quadEnableRequirements == QuadEnableRequirements::statusRegister2Bit1Read0x35)
+			readInstructions[1] = 0x35;
+	}
+
+	for (size_t i {}; i < sizeof(registers); ++i)
+		if (readInstructions[i] != 0)
+		{
+			const auto ret = executeReadCommand(readInstructions[i], {}, {}, {}, &registers[i], sizeof(registers[i]));
+			if (ret != 0)
+				return ret;
+		}
+
+	// if register with Quad Enable bit cannot be read, its other bits are assumed to be 0
+	if (readInstructions[quadEnableIndex] != 0 && (registers[quadEnableIndex] & quadEnableMask) != 0)
+		return {};
+
+	registers[quadEnableIndex] |= quadEnableMask;
+
+	{
+		const auto ret = executeWriteEnabledCommand(writeInstruction, {}, {}, &registers[writeIndex], writeSize);
+		if (ret != 0)
+			return ret;
+	}
+
+	return waitWhileWriteInProgress(TickClock::now() + maxWriteStatusRegisterTime);
+}
+
+int QuadspiNorFlash::executeCommand(const uint8_t instruction, const uint32_t address, const size_t addressLength)
+{
+	const auto addressLines = addressLength != 0 ? Lines::single : Lines::none;
+	return executeTransaction(makeCcr(instruction, addressLines, addressLength, {}, {}, {}, {}), address, nullptr,
+			nullptr, {});
+}
+
+int QuadspiNorFlash::executeErase(const uint8_t instruction, const uint64_t address, const uint8_t addressLength,
+		const TickClock::duration maximumEraseTime)
+{
+	{
+		const auto ret = waitWhileWriteInProgress(busyDeadline_);
+		if (ret != 0)
+			return ret;
+	}
+	{
+		const auto ret = executeWriteEnabledCommand(instruction, address, addressLength, nullptr, {});
+		if (ret != 0)
+			return ret;
+	}
+
+	busyDeadline_ = TickClock::now() + maximumEraseTime;
+	return {};
+}
+
+int QuadspiNorFlash::executeReadCommand(const uint8_t instruction, const uint32_t address, const size_t addressLength,
+		const size_t dummyCycles, void* const buffer, const size_t size)
+{
+	const auto addressLines = addressLength != 0 ? Lines::single : Lines::none;
+	const auto dataLines = size != 0 ? Lines::single : Lines::none;
+	return executeTransaction(makeCcr(instruction, addressLines, addressLength, {}, {}, dummyCycles, dataLines),
+			address, nullptr, buffer, size);
+}
+
+int QuadspiNorFlash::executeTransaction(const uint32_t ccr, const uint32_t address, const void* const writeBuffer,
+		void* const readBuffer, const size_t size)
+{
+	assert(memoryMapped_ == false);
+	assert(((ccr & QUADSPI_CCR_DMODE) != 0) == (size != 0));
+	assert((size != 0) == (writeBuffer != nullptr || readBuffer != nullptr));
+	assert(writeBuffer == nullptr || readBuffer == nullptr);
+	assert(size <= maxTransactionSize);
+
+	while ((quadspiPeripheral_.readSr() & QUADSPI_SR_BUSY) != 0);
+
+	quadspiPeripheral_.writeFcr(QUADSPI_FCR_CTOF | QUADSPI_FCR_CSMF | QUADSPI_FCR_CTCF | QUADSPI_FCR_CTEF);
+
+	const auto readTransfer = readBuffer != nullptr;
+	if (size != 0)
+	{
+		quadspiPeripheral_.writeDlr(size - 1);
+
+		const auto memoryAddress = reinterpret_cast<uintptr_t>(readTransfer == true ? readBuffer : writeBuffer);
+		// "transfer complete" of read transfer is signaled by DMA, of write transfer - by QUADSPI
+		const auto directionFlags = readTransfer == true ?
+				DmaChannel::Flags::transferCompleteInterruptEnable | DmaChannel::Flags::peripheralToMemory :
+				DmaChannel::Flags::transferCompleteInterruptDisable | DmaChannel::Flags::memoryToPeripheral;
+		dmaChannelHandle_.startTransfer(memoryAddress, quadspiPeripheral_.getDrAddress(), size,
+				directionFlags |
+				DmaChannel::Flags::peripheralFixed |
+				DmaChannel::Flags::memoryIncrement |
+				DmaChannel::Flags::veryHighPriority |
+				DmaChannel::Flags::dataSize1);
+	}
+
+	quadspiPeripheral_.writeCr(quadspiPeripheral_.readCr() | (size != 0) << QUADSPI_CR_DMAEN_Pos |
+			(readTransfer == false) << QUADSPI_CR_TCIE_Pos | QUADSPI_CR_TEIE);
+	quadspiPeripheral_.writeCcr(ccr | readTransfer << QUADSPI_CCR_FMODE_Pos);
+	if ((ccr & QUADSPI_CCR_ADMODE) != 0)
+		quadspiPeripheral_.writeAr(address);
+
+	while (semaphore_.wait() != 0);
+
+	const auto ret = ret_;
+	if (ret != 0)
+		abort();
+
+	return ret;
+}
+
+int QuadspiNorFlash::executeWriteCommand(const uint8_t instruction, const uint32_t address, const size_t addressLength,
+		const void* const buffer, const size_t size)
+{
+	const auto addressLines = addressLength != 0 ? Lines::single : Lines::none;
+	const auto dataLines = size != 0 ? Lines::single : Lines::none;
+	return executeTransaction(makeCcr(instruction, addressLines, addressLength, {}, {}, {}, dataLines), address,
+			buffer, nullptr, size);
+}
+
+int QuadspiNorFlash::executeWriteEnabledCommand(const uint8_t instruction, const uint32_t address,
+		const size_t addressLength, const void* const buffer, const size_t size)
+{
+	{
+		const auto ret = executeCommand(0x06, {}, {});
+		if (ret != 0)
+			return ret;
+	}
+
+	return executeWriteCommand(instruction, address, addressLength, buffer, size);
+}
+
+void QuadspiNorFlash::finishTransaction(const int ret)
+{
+	const auto cr = quadspiPeripheral_.readCr();
+	if ((cr & transactionInterruptsMask) == 0)	// transaction already finished?
+		return;
+
+	quadspiPeripheral_.writeCr(cr & ~(transactionInterruptsMask | QUADSPI_CR_DMAEN));
+	if ((cr & QUADSPI_CR_DMAEN) != 0)
+		dmaChannelHandle_.stopTransfer();
+
+	ret_ = ret;
+	const auto semaphoreRet = semaphore_.post();
+	assert(semaphoreRet == 0);
+}
+
+int QuadspiNorFlash::initialize()
+{
+	const auto peripheralFrequency = quadspiPeripheral_.getPeripheralFrequency();
+	assert(clockFrequency_ != 0);
+	const auto prescaler = (peripheralFrequency + clockFrequency_ - 1) / clockFrequency_ - 1;
+	assert(prescaler <= QUADSPI_CR_PRESCALER >> QUADSPI_CR_PRESCALER_Pos);
+	const auto frequency = peripheralFrequency / (prescaler + 1);
+
+	{
+		// chip select must stay high for at least 50 ns between commands
+		constexpr uint32_t chipSelectHighFrequency {20000000};
+		const auto chipSelectHighCycles = std::min<uint32_t>((frequency + chipSelectHighFrequency - 1) /
+				chipSelectHighFrequency, (QUADSPI_DCR_CSHT >> QUADSPI_DCR_CSHT_Pos) + 1);
+		// size is not known yet, so the whole address space is allowed
+		quadspiPeripheral_.writeDcr(QUADSPI_DCR_FSIZE | (chipSelectHighCycles - 1) << QUADSPI_DCR_CSHT_Pos);
+	}
+
+	// mode bits which never enable "continuous read" mode
+	quadspiPeripheral_.writeAbr(UINT32_MAX);
+	// automatic status polling checks Write in Progress (WIP) bit of status register 1 every ~10 us
+	quadspiPeripheral_.writePsmkr(1);
+	quadspiPeripheral_.writePsmar(0);
+	quadspiPeripheral_.writePir(std::min<uint32_t>(frequency / 100000, QUADSPI_PIR_INTERVAL));
+	quadspiPeripheral_.writeCr(prescaler << QUADSPI_CR_PRESCALER_Pos | flash2_ << QUADSPI_CR_FSEL_Pos |
+			QUADSPI_CR_SSHIFT | QUADSPI_CR_EN);
+
+	{
+		const auto ret = serialFlashDiscoverableParameters_.parse(*this);
+		if (ret != 0)
+			return ret;
+	}
+
+	{
+		while ((quadspiPeripheral_.readSr() & QUADSPI_SR_BUSY) != 0);
+
+		const auto fsize = estd::log2u(serialFlashDiscoverableParameters_.getBasicFlashParameters().size) - 1;
+		quadspiPeripheral_.writeDcr((quadspiPeripheral_.readDcr() & ~QUADSPI_DCR_FSIZE) |
+				fsize << QUADSPI_DCR_FSIZE_Pos);
+	}
+
+	return selectReadCommand();
+}
+
+int QuadspiNorFlash::selectReadCommand()
+{
+	readCcr_ = makeCcr(0x0b, Lines::single, 3, {}, {}, 8, Lines::single);
+
+	const auto& basicFlashParameters = serialFlashDiscoverableParameters_.getBasicFlashParameters();
+	const auto fastRead144 = basicFlashParameters.fastRead144.instruction != 0;
+	if (fastRead144 == false && basicFlashParameters.fastRead114.instruction == 0)
+		return {};
+
+	{
+		const auto ret = enableQuadMode();
+		if (ret == ENOTSUP)	// quad mode cannot be enabled, use 1-1-1 fast read
+			return {};
+		if (ret != 0)
+			return ret;
+	}
+
+	const auto& fastRead = fastRead144 == true ? basicFlashParameters.fastRead144 : basicFlashParameters.fastRead114;
+	const auto addressLines = fastRead144 == true ? Lines::quad : Lines::single;
+	const size_t addressLinesCount = fastRead144 == true ? 4 : 1;
+	const size_t modeBits = fastRead.modeCycles * addressLinesCount;
+	// mode bits are sent as alternate bytes if possible, otherwise mode clocks are treated as dummy clocks
+	const auto alternateLength = modeBits % CHAR_BIT == 0 ? modeBits / CHAR_BIT : 0;
+	const auto alternateLines = alternateLength != 0 ? addressLines : Lines::none;
+	const auto dummyCycles = fastRead.dummyCycles + (alternateLength == 0 ? fastRead.modeCycles : 0);
+	if (alternateLength > sizeof(uint32_t) || dummyCycles > maxDummyCycles)	// use 1-1-1 fast read
+		return {};
+
+	readCcr_ = makeCcr(fastRead.instruction, addressLines, 3, alternateLines, alternateLength, dummyCycles,
+			Lines::quad);
+	return {};
+}
+
+void QuadspiNorFlash::transferCompleteEventHandler()
+{
+	finishTransaction({});
+}
+
+void QuadspiNorFlash::transferErrorEventHandler(size_t)
+{
+	finishTransaction(EIO);
+}
+
+int QuadspiNorFlash::waitWhileWriteInProgress(const TickClock::time_point timePoint)
+{
+	{
+		uint8_t statusRegister1;
+		const auto ret = executeReadCommand(0x05, {}, {}, {}, &statusRegister1, sizeof(statusRegister1));
+		if (ret != 0)
+			return ret;
+		if ((statusRegister1 & 1) == 0)	// Write in Progress (WIP) bit cleared?
+			return {};
+		if (timePoint <= TickClock::now())
+			return ETIMEDOUT;
+	}
+
+	while ((quadspiPeripheral_.readSr() & QUADSPI_SR_BUSY) != 0);
+
+	quadspiPeripheral_.writeFcr(QUADSPI_FCR_CTOF | QUADSPI_FCR_CSMF | QUADSPI_FCR_CTCF | QUADSPI_FCR_CTEF);
+	quadspiPeripheral_.writeDlr(0);
+	quadspiPeripheral_.writeCr(quadspiPeripheral_.readCr() | QUADSPI_CR_APMS | QUADSPI_CR_SMIE | QUADSPI_CR_TEIE);
+	quadspiPeripheral_.writeCcr(makeCcr(0x05, {}, {}, {}, {}, {}, Lines::single) | QUADSPI_CCR_FMODE_1);
+
+	auto ret = semaphore_.tryWaitUntil(timePoint);
+	if (ret != 0)
+	{
+		quadspiPeripheral_.writeCr(quadspiPeripheral_.readCr() & ~transactionInterruptsMask);
+		// status match may have been detected just after the timeout
+		ret = semaphore_.tryWait() == 0 ? 0 : ETIMEDOUT;
+	}
+	if (ret == 0)
+		ret = ret_;
+	if (ret != 0)
+		abort();
+
+	quadspiPeripheral_.writeCr(quadspiPeripheral_.readCr() & ~QUADSPI_CR_APMS);
+	return ret;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| QuadspiNorFlash::DmaChannelFunctor public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void QuadspiNorFlash::DmaChannelFunctor::transferCompleteEvent()
+{
+	owner_.transferCompleteEventHandler();
+}
+
+void QuadspiNorFlash::DmaChannelFunctor::transferErrorEvent(const size_t transactionsLeft)
+{
+	owner_.transferErrorEventHandler(transactionsLeft);
+}
+
+}	// namespace chip
+
+}	// namespace distortos
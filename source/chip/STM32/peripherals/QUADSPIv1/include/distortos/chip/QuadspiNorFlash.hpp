@@ -0,0 +1,585 @@
+/**
+ * \file
+ * \brief QuadspiNorFlash class header for QUADSPIv1 in STM32
+ *
+ * \author Copyright (C) 2020 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SOURCE_CHIP_STM32_PERIPHERALS_QUADSPIV1_INCLUDE_DISTORTOS_CHIP_QUADSPINORFLASH_HPP_
+#define SOURCE_CHIP_STM32_PERIPHERALS_QUADSPIV1_INCLUDE_DISTORTOS_CHIP_QUADSPINORFLASH_HPP_
+
+#include "distortos/chip/DmaChannelFunctorCommon.hpp"
+#include "distortos/chip/DmaChannelHandle.hpp"
+
+#include "distortos/devices/memory/MemoryTechnologyDevice.hpp"
+#include "distortos/devices/memory/SerialFlashDiscoverableParameters.hpp"
+
+#include "distortos/Mutex.hpp"
+#include "distortos/Semaphore.hpp"
+
+namespace distortos
+{
+
+namespace chip
+{
+
+class QuadspiPeripheral;
+
+/**
+ * \brief QuadspiNorFlash class is a QSPI NOR flash connected to QUADSPIv1 in STM32.
+ *
+ * This class supports chips which implement SFDP from JESD216 standard. Reads use 1-4-4 or 1-1-4 fast read (if
+ * supported by the chip and if its quad mode can be enabled) with data transferred by DMA, all other commands use
+ * 1-1-1 mode. Waiting for completion of program and erase operations is done with automatic status polling mode of
+ * QUADSPI.
+ *
+ * The chip may also be switched to memory-mapped mode, in which it can be read by the core (e.g. to execute code
+ * directly from the chip) just like internal memory. read() works in both modes, but erase() and program() require
+ * the memory-mapped mode to be disabled.
+ *
+ * \ingroup devices
+ */
+
+class QuadspiNorFlash : public devices::MemoryTechnologyDevice,
+		private devices::SerialFlashDiscoverableParameters::CommandExecutor
+{
+public:
+
+	/**
+	 * \brief QuadspiNorFlash's constructor
+	 *
+	 * \param [in] quadspiPeripheral is a reference to raw QUADSPI peripheral
+	 * \param [in] dmaChannel is a reference to DMA channel used for transfers
+	 * \param [in] dmaRequest is the request identifier for DMA channel used for transfers
+	 * \param [in] clockFrequency is the desired clock frequency of QSPI NOR flash, Hz, default - 50 MHz
+	 * \param [in] flash2 selects whether the chip is connected to FLASH 1 (false) or FLASH 2 (true) pins of QUADSPI,
+	 * default - FLASH 1 (false)
+	 */
+
+	constexpr QuadspiNorFlash(const QuadspiPeripheral& quadspiPeripheral, DmaChannel& dmaChannel,
+			const uint8_t dmaRequest, const uint32_t clockFrequency = 50000000, const bool flash2 = {}) :
+					busyDeadline_{},
+					dmaChannel_{dmaChannel},
+					dmaChannelFunctor_{*this},
+					dmaChannelHandle_{},
+					mutex_{Mutex::Type::recursive, Mutex::Protocol::priorityInheritance},
+					semaphore_{0},
+					serialFlashDiscoverableParameters_{},
+					quadspiPeripheral_{quadspiPeripheral},
+					clockFrequency_{clockFrequency},
+					readCcr_{},
+					ret_{},
+					dmaRequest_{dmaRequest},
+					flash2_{flash2},
+					memoryMapped_{},
+					openCount_{}
+	{
+
+	}
+
+	/**
+	 * \brief QuadspiNorFlash's destructor
+	 *
+	 * \pre Device is closed.
+	 */
+
+	~QuadspiNorFlash() override;
+
+	/**
+	 * \brief Closes QSPI NOR flash.
+	 *
+	 * If this is the last close, memory-mapped mode is disabled.
+	 *
+	 * \note Even if error code is returned, the device must not be used from the context which opened it (until it is
+	 * successfully opened again).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by waitWhileWriteInProgress();
+	 */
+
+	int close() override;
+
+	/**
+	 * \brief Disables memory-mapped mode.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 *
+	 * \post Memory-mapped mode is disabled.
+	 */
+
+	void disableMemoryMappedMode();
+
+	/**
+	 * \brief Enables memory-mapped mode.
+	 *
+	 * In this mode the contents of QSPI NOR flash are available for the core in the memory-mapped region of QUADSPI,
+	 * starting at getMemoryMappedAddress().
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 *
+	 * \post Memory-mapped mode is enabled.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by waitWhileWriteInProgress();
+	 */
+
+	int enableMemoryMappedMode();
+
+	/**
+	 * \brief Erases blocks on QSPI NOR flash.
+	 *
+	 * Each part of the range is erased with the largest erase type which is supported in its region of sector map and
+	 * which fits the alignment and size of this part. Whole device is erased with chip erase command, if its maximum
+	 * erase time is known.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre Memory-mapped mode is disabled.
+	 * \pre \a address and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of range that will be erased, must be a multiple of erase block size
+	 * \param [in] size is the size of erased range, bytes, must be a multiple of erase block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by executeErase();
+	 */
+
+	int erase(uint64_t address, uint64_t size) override;
+
+	/**
+	 * \return erase block size, bytes
+	 */
+
+	size_t getEraseBlockSize() const override;
+
+	/**
+	 * \return address of QSPI NOR flash in memory-mapped region of QUADSPI, valid only when memory-mapped mode is
+	 * enabled
+	 */
+
+	const void* getMemoryMappedAddress() const;
+
+	/**
+	 * \return program block size, bytes
+	 */
+
+	size_t getProgramBlockSize() const override;
+
+	/**
+	 * \return read block size, bytes
+	 */
+
+	size_t getReadBlockSize() const override;
+
+	/**
+	 * \return size of QSPI NOR flash, bytes
+	 */
+
+	uint64_t getSize() const override;
+
+	/**
+	 * \brief Interrupt handler
+	 *
+	 * \note this must not be called by user code
+	 */
+
+	void interruptHandler();
+
+	/**
+	 * \brief Locks QSPI NOR flash for exclusive use by current thread.
+	 *
+	 * When the object is locked, any call to any member function from other thread will be blocked until the object is
+	 * unlocked. Locking is optional, but may be useful when more than one transaction must be done atomically.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre The number of recursive locks of device is less than 65535.
+	 *
+	 * \post Device is locked.
+	 */
+
+	void lock() override;
+
+	/**
+	 * \brief Opens QSPI NOR flash.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre The number of times the device is opened is less than 255.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by DmaChannelHandle::reserve();
+	 * - error codes returned by initialize();
+	 */
+
+	int open() override;
+
+	/**
+	 * \brief Programs data to QSPI NOR flash.
+	 *
+	 * Selected range of blocks must have been erased prior to being programmed.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre Memory-mapped mode is disabled.
+	 * \pre \a address and \a buffer and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of data that will be programmed
+	 * \param [in] buffer is the buffer with data that will be programmed, must be valid
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by executeTransaction();
+	 * - error codes returned by waitWhileWriteInProgress();
+	 */
+
+	int program(uint64_t address, const void* buffer, size_t size) override;
+
+	/**
+	 * \brief Reads data from QSPI NOR flash.
+	 *
+	 * If memory-mapped mode is enabled, data is copied from memory-mapped region of QUADSPI.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 * \pre \a address and \a buffer and \a size are valid.
+	 * \pre Selected range is within address space of device.
+	 *
+	 * \param [in] address is the address of data that will be read
+	 * \param [out] buffer is the buffer into which the data will be read, must be valid
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by executeTransaction();
+	 * - error codes returned by waitWhileWriteInProgress();
+	 */
+
+	int read(uint64_t address, void* buffer, size_t size) override;
+
+	/**
+	 * \brief Synchronizes state of QSPI NOR flash, ensuring all cached writes are finished.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre Device is opened.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by waitWhileWriteInProgress();
+	 */
+
+	int synchronize() override;
+
+	/**
+	 * \brief Unlocks QSPI NOR flash which was previously locked by current thread.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \pre This function is called by the thread that locked the device.
+	 */
+
+	void unlock() override;
+
+private:
+
+	/// DmaChannelFunctor class is a DmaChannelFunctorCommon for DMA channel used for transfers
+	class DmaChannelFunctor : public DmaChannelFunctorCommon
+	{
+	public:
+
+		/**
+		 * \brief DmaChannelFunctor's constructor
+		 *
+		 * \param [in] owner is a reference to owner QuadspiNorFlash object
+		 */
+
+		constexpr explicit DmaChannelFunctor(QuadspiNorFlash& owner) :
+				owner_{owner}
+		{
+
+		}
+
+		/**
+		 * \brief "Transfer complete" event
+		 *
+		 * Called by low-level DMA channel driver when the transfer is physically finished.
+		 */
+
+		void transferCompleteEvent() override;
+
+		/**
+		 * \brief "Transfer error" event
+		 *
+		 * Called by low-level DMA channel driver when transfer error is detected.
+		 *
+		 * \param [in] transactionsLeft is the number of transactions left
+		 */
+
+		void transferErrorEvent(size_t transactionsLeft) override;
+
+	private:
+
+		/// reference to owner QuadspiNorFlash object
+		QuadspiNorFlash& owner_;
+	};
+
+	/**
+	 * \brief Aborts current operation of QUADSPI and waits until the abort is finished.
+	 */
+
+	void abort();
+
+	/**
+	 * \brief Deinitializes QSPI NOR flash and QUADSPI.
+	 */
+
+	void deinitialize();
+
+	/**
+	 * \brief Enables quad mode of QSPI NOR flash, according to its Quad Enable Requirements.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOTSUP - Quad Enable Requirements are unknown;
+	 * - error codes returned by executeCommand();
+	 * - error codes returned by executeReadCommand();
+	 * - error codes returned by executeTransaction();
+	 * - error codes returned by waitWhileWriteInProgress();
+	 */
+
+	int enableQuadMode();
+
+	/**
+	 * \brief Executes generic command.
+	 *
+	 * \pre \a addressLength is 0, 3 or 4.
+	 *
+	 * \param [in] instruction is the instruction for this command
+	 * \param [in] address is the address for the command
+	 * \param [in] addressLength is the length of address for the command, bytes
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by executeTransaction();
+	 */
+
+	int executeCommand(uint8_t instruction, uint32_t address, size_t addressLength) override;
+
+	/**
+	 * \brief Executes single erase command.
+	 *
+	 * \param [in] instruction is the erase instruction
+	 * \param [in] address is the address for the erase instruction
+	 * \param [in] addressLength is the length of address for the erase instruction, bytes
+	 * \param [in] maximumEraseTime is the maximum time of executed erase
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by executeCommand();
+	 * - error codes returned by waitWhileWriteInProgress();
+	 */
+
+	int executeErase(uint8_t instruction, uint64_t address, uint8_t addressLength,
+			TickClock::duration maximumEraseTime);
+
+	/**
+	 * \brief Executes read command.
+	 *
+	 * \pre \a addressLength is 0, 3 or 4.
+	 * \pre \a dummyCycles is less than or equal to 31.
+	 *
+	 * \param [in] instruction is the instruction for this command
+	 * \param [in] address is the address for the command
+	 * \param [in] addressLength is the length of address for the command, bytes
+	 * \param [in] dummyCycles is the number of dummy cycles sent before reading of data
+	 * \param [out] buffer is the buffer for data that will be read
+	 * \param [in] size is the size of \a buffer
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by executeTransaction();
+	 */
+
+	int executeReadCommand(uint8_t instruction, uint32_t address, size_t addressLength, size_t dummyCycles,
+			void* buffer, size_t size) override;
+
+	/**
+	 * \brief Executes single transaction in indirect mode of QUADSPI.
+	 *
+	 * Data - if any - is transferred by DMA.
+	 *
+	 * \pre Memory-mapped mode is disabled.
+	 * \pre Data mode in \a ccr is set if and only if \a size is not 0.
+	 * \pre \a size is less than or equal to 65535.
+	 *
+	 * \param [in] ccr is the value of CCR register (except functional mode) for the transaction
+	 * \param [in] address is the address for the transaction, ignored if address mode in \a ccr is not set
+	 * \param [in] writeBuffer is the buffer with data that will be written, nullptr for read transactions
+	 * \param [out] readBuffer is the buffer for data that will be read, nullptr for write transactions
+	 * \param [in] size is the size of \a writeBuffer or \a readBuffer, bytes
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EIO - transfer error detected by QUADSPI or DMA;
+	 */
+
+	int executeTransaction(uint32_t ccr, uint32_t address, const void* writeBuffer, void* readBuffer, size_t size);
+
+	/**
+	 * \brief Executes write command.
+	 *
+	 * \pre \a addressLength is 0, 3 or 4.
+	 *
+	 * \param [in] instruction is the instruction for this command
+	 * \param [in] address is the address for the command
+	 * \param [in] addressLength is the length of address for the command, bytes
+	 * \param [in] buffer is the buffer with data that will be written
+	 * \param [in] size is the size of \a buffer
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by executeTransaction();
+	 */
+
+	int executeWriteCommand(uint8_t instruction, uint32_t address, size_t addressLength, const void* buffer,
+			size_t size);
+
+	/**
+	 * \brief Executes write command preceded by WREN command.
+	 *
+	 * \pre \a addressLength is 0, 3 or 4.
+	 *
+	 * \param [in] instruction is the instruction for this command
+	 * \param [in] address is the address for the command
+	 * \param [in] addressLength is the length of address for the command, bytes
+	 * \param [in] buffer is the buffer with data that will be written, nullptr if command has no data
+	 * \param [in] size is the size of \a buffer
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by executeCommand();
+	 * - error codes returned by executeWriteCommand();
+	 */
+
+	int executeWriteEnabledCommand(uint8_t instruction, uint32_t address, size_t addressLength, const void* buffer,
+			size_t size);
+
+	/**
+	 * \brief Finishes the transaction and notifies waiting thread.
+	 *
+	 * \param [in] ret is the result of the transaction (0 on success, error code otherwise)
+	 */
+
+	void finishTransaction(int ret);
+
+	/**
+	 * \brief Initializes QSPI NOR flash.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by SerialFlashDiscoverableParameters::parse();
+	 */
+
+	int initialize();
+
+	/**
+	 * \brief Selects the fastest supported read command, enabling quad mode of QSPI NOR flash if needed.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by enableQuadMode();
+	 */
+
+	int selectReadCommand();
+
+	/**
+	 * \brief "Transfer complete" event handler
+	 */
+
+	void transferCompleteEventHandler();
+
+	/**
+	 * \brief "Transfer error" event handler
+	 *
+	 * \param [in] transactionsLeft is the number of transactions left
+	 */
+
+	void transferErrorEventHandler(size_t transactionsLeft);
+
+	/**
+	 * \brief Waits while any write operation is currently in progress.
+	 *
+	 * If the write operation is in progress, status register is polled by QUADSPI in automatic status polling mode.
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EIO - transfer error detected by QUADSPI;
+	 * - ETIMEDOUT - write operation was not finished before the specified timeout expired;
+	 * - error codes returned by executeReadCommand();
+	 */
+
+	int waitWhileWriteInProgress(TickClock::time_point timePoint);
+
+	/// current deadline of waiting while write operation is in progress
+	TickClock::time_point busyDeadline_;
+
+	/// reference to DMA channel used for transfers
+	DmaChannel& dmaChannel_;
+
+	/// functor for DMA channel used for transfers
+	DmaChannelFunctor dmaChannelFunctor_;
+
+	/// handle of DMA channel used for transfers
+	DmaChannelHandle dmaChannelHandle_;
+
+	/// mutex used to serialize access to this object
+	Mutex mutex_;
+
+	/// semaphore used to notify waiting thread about completion of transaction
+	Semaphore semaphore_;
+
+	/// parsed SFDP of QSPI NOR flash
+	devices::SerialFlashDiscoverableParameters serialFlashDiscoverableParameters_;
+
+	/// reference to raw QUADSPI peripheral
+	const QuadspiPeripheral& quadspiPeripheral_;
+
+	/// desired clock frequency of QSPI NOR flash, Hz
+	uint32_t clockFrequency_;
+
+	/// value of CCR register (except functional mode) for read command
+	uint32_t readCcr_;
+
+	/// result of the transaction (0 on success, error code otherwise)
+	volatile int ret_;
+
+	/// request identifier for DMA channel used for transfers
+	uint8_t dmaRequest_;
+
+	/// selects whether the chip is connected to FLASH 1 (false) or FLASH 2 (true) pins of QUADSPI
+	bool flash2_;
+
+	/// true if memory-mapped mode is enabled, false otherwise
+	bool memoryMapped_;
+
+	/// number of times this device was opened but not yet closed
+	uint8_t openCount_;
+};
+
+}	// namespace chip
+
+}	// namespace distortos
+
+#endif	// SOURCE_CHIP_STM32_PERIPHERALS_QUADSPIV1_INCLUDE_DISTORTOS_CHIP_QUADSPINORFLASH_HPP_
@@ -0,0 +1,335 @@
+/**
+ * \file
+ * \brief QuadspiPeripheral class header for QUADSPIv1 in STM32
+ *
+ * \author Copyright (C) 2020 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SOURCE_CHIP_STM32_PERIPHERALS_QUADSPIV1_INCLUDE_DISTORTOS_CHIP_STM32_QUADSPIV1_QUADSPIPERIPHERAL_HPP_
+#define SOURCE_CHIP_STM32_PERIPHERALS_QUADSPIV1_INCLUDE_DISTORTOS_CHIP_STM32_QUADSPIV1_QUADSPIPERIPHERAL_HPP_
+
+#include "distortos/chip/getBusFrequency.hpp"
+
+namespace distortos
+{
+
+namespace chip
+{
+
+/// QuadspiPeripheral class is a raw QUADSPI peripheral for QUADSPIv1 in STM32
+class QuadspiPeripheral
+{
+public:
+
+	/**
+	 * \brief QuadspiPeripheral's constructor
+	 *
+	 * \param [in] quadspiBase is a base address of QUADSPI peripheral
+	 * \param [in] memoryMappedBase is a base address of memory-mapped region of QUADSPI peripheral
+	 */
+
+	constexpr QuadspiPeripheral(const uintptr_t quadspiBase, const uintptr_t memoryMappedBase) :
+			quadspiBase_{quadspiBase},
+			memoryMappedBase_{memoryMappedBase},
+			peripheralFrequency_{getBusFrequency(quadspiBase)}
+	{
+
+	}
+
+	/**
+	 * \return address of DR register
+	 */
+
+	uintptr_t getDrAddress() const
+	{
+		return reinterpret_cast<uintptr_t>(&getQuadspi().DR);
+	}
+
+	/**
+	 * \return base address of memory-mapped region of QUADSPI peripheral
+	 */
+
+	uintptr_t getMemoryMappedBase() const
+	{
+		return memoryMappedBase_;
+	}
+
+	/**
+	 * \return peripheral clock frequency, Hz
+	 */
+
+	uint32_t getPeripheralFrequency() const
+	{
+		return peripheralFrequency_;
+	}
+
+	/**
+	 * \return current value of CR register
+	 */
+
+	uint32_t readCr() const
+	{
+		return getQuadspi().CR;
+	}
+
+	/**
+	 * \return current value of DCR register
+	 */
+
+	uint32_t readDcr() const
+	{
+		return getQuadspi().DCR;
+	}
+
+	/**
+	 * \return current value of SR register
+	 */
+
+	uint32_t readSr() const
+	{
+		return getQuadspi().SR;
+	}
+
+	/**
+	 * \return current value of DLR register
+	 */
+
+	uint32_t readDlr() const
+	{
+		return getQuadspi().DLR;
+	}
+
+	/**
+	 * \return current value of CCR register
+	 */
+
+	uint32_t readCcr() const
+	{
+		return getQuadspi().CCR;
+	}
+
+	/**
+	 * \return current value of AR register
+	 */
+
+	uint32_t readAr() const
+	{
+		return getQuadspi().AR;
+	}
+
+	/**
+	 * \return current value of ABR register
+	 */
+
+	uint32_t readAbr() const
+	{
+		return getQuadspi().ABR;
+	}
+
+	/**
+	 * \return current value of DR register
+	 */
+
+	uint32_t readDr() const
+	{
+		return getQuadspi().DR;
+	}
+
+	/**
+	 * \return current value of PSMKR register
+	 */
+
+	uint32_t readPsmkr() const
+	{
+		return getQuadspi().PSMKR;
+	}
+
+	/**
+	 * \return current value of PSMAR register
+	 */
+
+	uint32_t readPsmar() const
+	{
+		return getQuadspi().PSMAR;
+	}
+
+	/**
+	 * \return current value of PIR register
+	 */
+
+	uint32_t readPir() const
+	{
+		return getQuadspi().PIR;
+	}
+
+	/**
+	 * \return current value of LPTR register
+	 */
+
+	uint32_t readLptr() const
+	{
+		return getQuadspi().LPTR;
+	}
+
+	/**
+	 * \brief Writes value to CR register.
+	 *
+	 * \param [in] cr is the value that will be written to CR register
+	 */
+
+	void writeCr(const uint32_t cr) const
+	{
+		getQuadspi().CR = cr;
+	}
+
+	/**
+	 * \brief Writes value to DCR register.
+	 *
+	 * \param [in] dcr is the value that will be written to DCR register
+	 */
+
+	void writeDcr(const uint32_t dcr) const
+	{
+		getQuadspi().DCR = dcr;
+	}
+
+	/**
+	 * \brief Writes value to FCR register.
+	 *
+	 * \param [in] fcr is the value that will be written to FCR register
+	 */
+
+	void writeFcr(const uint32_t fcr) const
+	{
+		getQuadspi().FCR = fcr;
+	}
+
+	/**
+	 * \brief Writes value to DLR register.
+	 *
+	 * \param [in] dlr is the value that will be written to DLR register
+	 */
+
+	void writeDlr(const uint32_t dlr) const
+	{
+		getQuadspi().DLR = dlr;
+	}
+
+	/**
+	 * \brief Writes value to CCR register.
+	 *
+	 * \param [in] ccr is the value that will be written to CCR register
+	 */
+
+	void writeCcr(const uint32_t ccr) const
+	{
+		getQuadspi().CCR = ccr;
+	}
+
+	/**
+	 * \brief Writes value to AR register.
+	 *
+	 * \param [in] ar is the value that will be written to AR register
+	 */
+
+	void writeAr(const uint32_t ar) const
+	{
+		getQuadspi().AR = ar;
+	}
+
+	/**
+	 * \brief Writes value to ABR register.
+	 *
+	 * \param [in] abr is the value that will be written to ABR register
+	 */
+
+	void writeAbr(const uint32_t abr) const
+	{
+		getQuadspi().ABR = abr;
+	}
+
+	/**
+	 * \brief Writes value to DR register.
+	 *
+	 * \param [in] dr is the value that will be written to DR register
+	 */
+
+	void writeDr(const uint32_t dr) const
+	{
+		getQuadspi().DR = dr;
+	}
+
+	/**
+	 * \brief Writes value to PSMKR register.
+	 *
+	 * \param [in] psmkr is the value that will be written to PSMKR register
+	 */
+
+	void writePsmkr(const uint32_t psmkr) const
+	{
+		getQuadspi().PSMKR = psmkr;
+	}
+
+	/**
+	 * \brief Writes value to PSMAR register.
+	 *
+	 * \param [in] psmar is the value that will be written to PSMAR register
+	 */
+
+	void writePsmar(const uint32_t psmar) const
+	{
+		getQuadspi().PSMAR = psmar;
+	}
+
+	/**
+	 * \brief Writes value to PIR register.
+	 *
+	 * \param [in] pir is the value that will be written to PIR register
+	 */
+
+	void writePir(const uint32_t pir) const
+	{
+		getQuadspi().PIR = pir;
+	}
+
+	/**
+	 * \brief Writes value to LPTR register.
+	 *
+	 * \param [in] lptr is the value that will be written to LPTR register
+	 */
+
+	void writeLptr(const uint32_t lptr) const
+	{
+		getQuadspi().LPTR = lptr;
+	}
+
+private:
+
+	/**
+	 * \return reference to QUADSPI_TypeDef object
+	 */
+
+	QUADSPI_TypeDef& getQuadspi() const
+	{
+		return *reinterpret_cast<QUADSPI_TypeDef*>(quadspiBase_);
+	}
+
+	/// base address of QUADSPI peripheral
+	uintptr_t quadspiBase_;
+
+	/// base address of memory-mapped region of QUADSPI peripheral
+	uintptr_t memoryMappedBase_;
+
+	/// peripheral clock frequency, Hz
+	uint32_t peripheralFrequency_;
+};
+
+}	// namespace chip
+
+}	// namespace distortos
+
+#endif	// SOURCE_CHIP_STM32_PERIPHERALS_QUADSPIV1_INCLUDE_DISTORTOS_CHIP_STM32_QUADSPIV1_QUADSPIPERIPHERAL_HPP_
@@ -106,7 +106,9 @@ public:
 	 *
 	 * This function returns immediately. When the transaction is physically finished (either command, its argument,
 	 * response and associated transfer were sent/received or an error was detected),
-	 * SdMmcCardBase::transactionCompleteEvent() will be executed.
+	 * SdMmcCardBase::transactionCompleteEvent() will be executed. For write transfers the data path state machine of
+	 * SDMMC stays in "busy" state until the card releases DAT0 line after the last block, so "data end" interrupt - and
+	 * SdMmcCardBase::transactionCompleteEvent() - is also the "busy end" event for the written data.
 	 *
 	 * \pre Driver is started.
 	 * \pre No transaction is in progress.
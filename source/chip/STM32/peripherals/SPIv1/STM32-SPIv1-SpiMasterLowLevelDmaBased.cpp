@@ -42,8 +42,17 @@ void SpiMasterLowLevelDmaBased::configure(const devices::SpiMode mode, const uin
 	assert(isTransferInProgress() == false);
 
 	txDummyData_ = dummyData;
-	wordLength_ = wordLength;
+
+	if (configured_ == true && mode == mode_ && clockFrequency == clockFrequency_ && wordLength == wordLength_ &&
+			lsbFirst == lsbFirst_)
+		return;
+
 	configureSpi(spiPeripheral_, mode, clockFrequency, wordLength, lsbFirst);
+	clockFrequency_ = clockFrequency;
+	mode_ = mode;
+	wordLength_ = wordLength;
+	configured_ = true;
+	lsbFirst_ = lsbFirst;
 }
 
 int SpiMasterLowLevelDmaBased::start()
@@ -69,6 +78,7 @@ int SpiMasterLowLevelDmaBased::start()
 
 	rxDmaChannelHandleScopeGuard.release();
 
+	configured_ = false;
 	wordLength_ = 8;
 	spiPeripheral_.writeCr1(SPI_CR1_SSM | SPI_CR1_SSI | SPI_CR1_SPE | SPI_CR1_BR | SPI_CR1_MSTR);
 	spiPeripheral_.writeCr2(SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
@@ -15,6 +15,7 @@ target_include_directories(distortos PUBLIC
 target_sources(distortos PRIVATE
 		${CMAKE_CURRENT_LIST_DIR}/STM32-SPIv1.cpp
 		${CMAKE_CURRENT_LIST_DIR}/STM32-SPIv1-SpiMasterLowLevelDmaBased.cpp
-		${CMAKE_CURRENT_LIST_DIR}/STM32-SPIv1-SpiMasterLowLevelInterruptBased.cpp)
+		${CMAKE_CURRENT_LIST_DIR}/STM32-SPIv1-SpiMasterLowLevelInterruptBased.cpp
+		${CMAKE_CURRENT_LIST_DIR}/STM32-SPIv1-SpiSlaveLowLevelDmaBased.cpp)
 
 doxygen(INPUT ${CMAKE_CURRENT_LIST_DIR} INCLUDE_PATH ${CMAKE_CURRENT_LIST_DIR}/include)
@@ -57,12 +57,16 @@ public:
 					rxDmaChannelFunctor_{*this},
 					txDmaChannelFunctor_{*this},
 					spiMasterBase_{},
+					clockFrequency_{},
 					rxDummyData_{},
 					txDummyData_{},
 					rxDmaRequest_{rxDmaRequest},
 					txDmaRequest_{txDmaRequest},
+					mode_{},
 					started_{},
-					wordLength_{8}
+					wordLength_{8},
+					configured_{},
+					lsbFirst_{}
 	{
 
 	}
@@ -78,6 +82,9 @@ public:
 	/**
 	 * \brief Configures parameters of low-level SPI master driver.
 	 *
+	 * SPI peripheral is reconfigured only if mode, clock frequency, word length or bit order differ from currently
+	 * configured values.
+	 *
 	 * \pre Driver is started.
 	 * \pre No transfer is in progress.
 	 * \pre \a clockFrequency is greater than or equal to `spiPeripheral_.getPeripheralFrequency() / 256`.
@@ -140,8 +147,8 @@ public:
 
 private:
 
-	/// RxDmaChannelFunctor class is a DmaChannelFunctor for DMA channel used for reception
-	class RxDmaChannelFunctor : public DmaChannelFunctor
+	/// RxDmaChannelFunctor class is a DmaChannelFunctorCommon for DMA channel used for reception
+	class RxDmaChannelFunctor : public DmaChannelFunctorCommon
 	{
 	public:
 
@@ -264,6 +271,9 @@ private:
 	/// pointer to SpiMasterBase object associated with this one
 	devices::SpiMasterBase* volatile spiMasterBase_;
 
+	/// currently configured clock frequency, Hz
+	uint32_t clockFrequency_;
+
 	/// object used as reception DMA target if read buffer of transfer is nullptr
 	uint16_t rxDummyData_;
 
@@ -276,11 +286,20 @@ private:
 	/// request identifier for DMA channel used for transmission
 	uint8_t txDmaRequest_;
 
+	/// currently configured SPI mode
+	devices::SpiMode mode_;
+
 	/// true if driver is started, false otherwise
 	bool started_;
 
 	/// selected word length, bits, [4; 16] or [minSpiWordLength; maxSpiWordLength]
 	uint8_t wordLength_;
+
+	/// tells whether SPI peripheral was configured since the driver was started (true) or not (false)
+	bool configured_;
+
+	/// currently configured bit order - MSB (false) or LSB (true) first
+	bool lsbFirst_;
 };
 
 }	// namespace chip
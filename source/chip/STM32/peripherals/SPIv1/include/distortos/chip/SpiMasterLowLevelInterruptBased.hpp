@@ -48,9 +48,13 @@ public:
 			size_{},
 			readPosition_{},
 			writePosition_{},
+			clockFrequency_{},
 			dummyData_{},
+			mode_{},
 			started_{},
-			wordLength_{8}
+			wordLength_{8},
+			configured_{},
+			lsbFirst_{}
 	{
 
 	}
@@ -66,6 +70,9 @@ public:
 	/**
 	 * \brief Configures parameters of low-level SPI master driver.
 	 *
+	 * SPI peripheral is reconfigured only if mode, clock frequency, word length or bit order differ from currently
+	 * configured values.
+	 *
 	 * \pre Driver is started.
 	 * \pre No transfer is in progress.
 	 * \pre \a clockFrequency is greater than or equal to `spiPeripheral_.getPeripheralFrequency() / 256`.
@@ -180,14 +187,26 @@ private:
 	/// current position in \a writeBuffer_
 	volatile size_t writePosition_;
 
+	/// currently configured clock frequency, Hz
+	uint32_t clockFrequency_;
+
 	/// dummy data that will be sent if write buffer of transfer is nullptr
 	uint16_t dummyData_;
 
+	/// currently configured SPI mode
+	devices::SpiMode mode_;
+
 	/// true if driver is started, false otherwise
 	bool started_;
 
 	/// selected word length, bits, {8, 16}
 	uint8_t wordLength_;
+
+	/// tells whether SPI peripheral was configured since the driver was started (true) or not (false)
+	bool configured_;
+
+	/// currently configured bit order - MSB (false) or LSB (true) first
+	bool lsbFirst_;
 };
 
 }	// namespace chip
@@ -40,8 +40,17 @@ void SpiMasterLowLevelInterruptBased::configure(const devices::SpiMode mode, con
 	assert(isTransferInProgress() == false);
 
 	dummyData_ = dummyData;
-	wordLength_ = wordLength;
+
+	if (configured_ == true && mode == mode_ && clockFrequency == clockFrequency_ && wordLength == wordLength_ &&
+			lsbFirst == lsbFirst_)
+		return;
+
 	configureSpi(spiPeripheral_, mode, clockFrequency, wordLength, lsbFirst);
+	clockFrequency_ = clockFrequency;
+	mode_ = mode;
+	wordLength_ = wordLength;
+	configured_ = true;
+	lsbFirst_ = lsbFirst;
 }
 
 void SpiMasterLowLevelInterruptBased::interruptHandler()
@@ -85,6 +94,7 @@ int SpiMasterLowLevelInterruptBased::start()
 {
 	assert(isStarted() == false);
 
+	configured_ = false;
 	wordLength_ = 8;
 	spiPeripheral_.writeCr1(SPI_CR1_SSM | SPI_CR1_SSI | SPI_CR1_SPE | SPI_CR1_BR | SPI_CR1_MSTR);
 	spiPeripheral_.writeCr2(SPI_CR2_FRXTH | (wordLength_ - 1) << SPI_CR2_DS_Pos);
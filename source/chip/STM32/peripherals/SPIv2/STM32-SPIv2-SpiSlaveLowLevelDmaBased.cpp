@@ -0,0 +1,188 @@
+/**
+ * \file
+ * \brief SpiSlaveLowLevelDmaBased class implementation for SPIv2 in STM32
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/chip/SpiSlaveLowLevelDmaBased.hpp"
+
+#include "distortos/chip/STM32-SPIv2.hpp"
+#include "distortos/chip/STM32-SPIv2-SpiPeripheral.hpp"
+
+#include "distortos/devices/communication/SpiSlaveBase.hpp"
+
+#include "distortos/assert.h"
+
+#include "estd/ScopeGuard.hpp"
+
+#include <limits>
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace chip
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+SpiSlaveLowLevelDmaBased::~SpiSlaveLowLevelDmaBased()
+{
+	assert(isStarted() == false);
+}
+
+int SpiSlaveLowLevelDmaBased::start(devices::SpiSlaveBase& spiSlaveBase, void* const readBuffer,
+		void* const writeBuffer, const size_t size, const devices::SpiMode mode, const uint8_t wordLength,
+		const bool lsbFirst)
+{
+	if (isStarted() == true)
+		return EBADF;
+
+	if (wordLength < minSpiWordLength || wordLength > maxSpiWordLength)
+		return EINVAL;
+
+	const auto dataSize = (wordLength + 8 - 1) / 8;
+	const auto transactions = size / dataSize;
+	if (readBuffer == nullptr || size == 0 || size % (2 * dataSize) != 0 ||
+			transactions > std::numeric_limits<uint16_t>::max())
+		return EINVAL;
+
+	{
+		const auto ret = rxDmaChannelHandle_.reserve(rxDmaChannel_, rxDmaRequest_, rxDmaChannelFunctor_);
+		if (ret != 0)
+			return ret;
+	}
+
+	auto rxDmaChannelHandleScopeGuard = estd::makeScopeGuard([this]()
+			{
+				rxDmaChannelHandle_.release();
+			});
+
+	{
+		const auto ret = txDmaChannelHandle_.reserve(txDmaChannel_, txDmaRequest_, txDmaChannelFunctor_);
+		if (ret != 0)
+			return ret;
+	}
+
+	rxDmaChannelHandleScopeGuard.release();
+
+	spiSlaveBase_ = &spiSlaveBase;
+	readBuffer_ = static_cast<uint8_t*>(readBuffer);
+	writeBuffer_ = static_cast<uint8_t*>(writeBuffer);
+	frameSize_ = size / 2;
+
+	// slave mode with NSS managed by hardware
+	const uint32_t cr1 = lsbFirst << SPI_CR1_LSBFIRST_Pos |
+			(mode == devices::SpiMode::cpol1cpha0 || mode == devices::SpiMode::cpol1cpha1) << SPI_CR1_CPOL_Pos |
+			(mode == devices::SpiMode::cpol0cpha1 || mode == devices::SpiMode::cpol1cpha1) << SPI_CR1_CPHA_Pos;
+	spiPeripheral_.writeCr1(cr1);
+	const uint32_t cr2 = (wordLength <= 8) << SPI_CR2_FRXTH_Pos | (wordLength - 1) << SPI_CR2_DS_Pos |
+			SPI_CR2_RXDMAEN;
+	spiPeripheral_.writeCr2(cr2);
+
+	const auto commonDmaFlags = DmaChannel::Flags::circularModeEnable | DmaChannel::Flags::peripheralFixed |
+			(dataSize == 1 ? DmaChannel::Flags::dataSize1 : DmaChannel::Flags::dataSize2);
+
+	{
+		const auto rxDmaFlags = DmaChannel::Flags::halfTransferInterruptEnable |
+				DmaChannel::Flags::transferCompleteInterruptEnable | DmaChannel::Flags::peripheralToMemory |
+				DmaChannel::Flags::memoryIncrement | DmaChannel::Flags::veryHighPriority;
+		rxDmaChannelHandle_.startTransfer(reinterpret_cast<uintptr_t>(readBuffer), spiPeripheral_.getDrAddress(),
+				transactions, commonDmaFlags | rxDmaFlags);
+	}
+	{
+		const auto memoryAddress = reinterpret_cast<uintptr_t>(writeBuffer != nullptr ? writeBuffer : &txDummyData_);
+		const auto txDmaFlags = DmaChannel::Flags::transferCompleteInterruptDisable |
+				DmaChannel::Flags::memoryToPeripheral |
+				(writeBuffer != nullptr ? DmaChannel::Flags::memoryIncrement : DmaChannel::Flags::memoryFixed) |
+				DmaChannel::Flags::lowPriority;
+		txDmaChannelHandle_.startTransfer(memoryAddress, spiPeripheral_.getDrAddress(), transactions,
+				commonDmaFlags | txDmaFlags);
+	}
+
+	spiPeripheral_.writeCr2(cr2 | SPI_CR2_TXDMAEN);
+	spiPeripheral_.writeCr1(cr1 | SPI_CR1_SPE);
+
+	return {};
+}
+
+int SpiSlaveLowLevelDmaBased::stop()
+{
+	if (isStarted() == false)
+		return EBADF;
+
+	txDmaChannelHandle_.stopTransfer();
+	rxDmaChannelHandle_.stopTransfer();
+	rxDmaChannelHandle_.release();
+	txDmaChannelHandle_.release();
+
+	// reset peripheral
+	spiPeripheral_.writeCr1({});
+	spiPeripheral_.writeCr2({});
+	spiSlaveBase_ = {};
+
+	return {};
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void SpiSlaveLowLevelDmaBased::errorEventHandler()
+{
+	txDmaChannelHandle_.stopTransfer();
+	rxDmaChannelHandle_.stopTransfer();
+
+	const auto spiSlaveBase = spiSlaveBase_;
+	assert(spiSlaveBase != nullptr);
+	spiSlaveBase->transferErrorEvent();
+}
+
+void SpiSlaveLowLevelDmaBased::frameEventHandler(const uint8_t frame)
+{
+	const auto spiSlaveBase = spiSlaveBase_;
+	assert(spiSlaveBase != nullptr);
+	const auto offset = frame * frameSize_;
+	spiSlaveBase->frameCompleteEvent(readBuffer_ + offset, writeBuffer_ != nullptr ? writeBuffer_ + offset : nullptr,
+			frameSize_);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| SpiSlaveLowLevelDmaBased::RxDmaChannelFunctor public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void SpiSlaveLowLevelDmaBased::RxDmaChannelFunctor::halfTransferEvent()
+{
+	owner_.frameEventHandler(0);
+}
+
+void SpiSlaveLowLevelDmaBased::RxDmaChannelFunctor::transferCompleteEvent()
+{
+	owner_.frameEventHandler(1);
+}
+
+void SpiSlaveLowLevelDmaBased::RxDmaChannelFunctor::transferErrorEvent(size_t)
+{
+	owner_.errorEventHandler();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| SpiSlaveLowLevelDmaBased::TxDmaChannelFunctor public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void SpiSlaveLowLevelDmaBased::TxDmaChannelFunctor::transferErrorEvent(size_t)
+{
+	owner_.errorEventHandler();
+}
+
+}	// namespace chip
+
+}	// namespace distortos
@@ -0,0 +1,276 @@
+/**
+ * \file
+ * \brief SpiSlaveLowLevelDmaBased class header for SPIv2 in STM32
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SOURCE_CHIP_STM32_PERIPHERALS_SPIV2_INCLUDE_DISTORTOS_CHIP_SPISLAVELOWLEVELDMABASED_HPP_
+#define SOURCE_CHIP_STM32_PERIPHERALS_SPIV2_INCLUDE_DISTORTOS_CHIP_SPISLAVELOWLEVELDMABASED_HPP_
+
+#include "distortos/chip/DmaChannelFunctorCommon.hpp"
+#include "distortos/chip/DmaChannelHandle.hpp"
+
+#include "distortos/devices/communication/SpiSlaveLowLevel.hpp"
+
+namespace distortos
+{
+
+namespace chip
+{
+
+class SpiPeripheral;
+
+/**
+ * \brief SpiSlaveLowLevelDmaBased class is a low-level SPI slave driver for SPIv2 in STM32.
+ *
+ * This driver uses DMA in circular mode for data transfers, so both directions are serviced continuously without CPU
+ * intervention - the peripheral is never left without data to transmit or space for received data. NSS pin is managed
+ * by hardware.
+ *
+ * \ingroup devices
+ */
+
+class SpiSlaveLowLevelDmaBased : public devices::SpiSlaveLowLevel
+{
+public:
+
+	/**
+	 * \brief SpiSlaveLowLevelDmaBased's constructor
+	 *
+	 * \param [in] spiPeripheral is a reference to raw SPI peripheral
+	 * \param [in] rxDmaChannel is a reference to DMA channel used for reception
+	 * \param [in] rxDmaRequest is the request identifier for DMA channel used for reception
+	 * \param [in] txDmaChannel is a reference to DMA channel used for transmission
+	 * \param [in] txDmaRequest is the request identifier for DMA channel used for transmission
+	 */
+
+	constexpr SpiSlaveLowLevelDmaBased(const SpiPeripheral& spiPeripheral, DmaChannel& rxDmaChannel,
+			const uint8_t rxDmaRequest, DmaChannel& txDmaChannel, const uint8_t txDmaRequest) :
+					spiPeripheral_{spiPeripheral},
+					rxDmaChannel_{rxDmaChannel},
+					txDmaChannel_{txDmaChannel},
+					rxDmaChannelHandle_{},
+					txDmaChannelHandle_{},
+					rxDmaChannelFunctor_{*this},
+					txDmaChannelFunctor_{*this},
+					spiSlaveBase_{},
+					readBuffer_{},
+					writeBuffer_{},
+					frameSize_{},
+					txDummyData_{},
+					rxDmaRequest_{rxDmaRequest},
+					txDmaRequest_{txDmaRequest}
+	{
+
+	}
+
+	/**
+	 * \brief SpiSlaveLowLevelDmaBased's destructor
+	 *
+	 * \pre Driver is stopped.
+	 */
+
+	~SpiSlaveLowLevelDmaBased() override;
+
+	/**
+	 * \brief Starts low-level SPI slave driver.
+	 *
+	 * This function returns immediately. Each time half of circular buffers is transferred,
+	 * SpiSlaveBase::frameCompleteEvent() will be executed. When transfer error is detected, both DMA channels are
+	 * stopped and SpiSlaveBase::transferErrorEvent() will be executed.
+	 *
+	 * \warning If data cache is enabled, \a readBuffer should be aligned to the size of cache line and size of its half
+	 * should be a multiple of the size of cache line.
+	 *
+	 * \param [in] spiSlaveBase is a reference to SpiSlaveBase object that will be associated with this one
+	 * \param [out] readBuffer is the circular buffer to which received data will be written
+	 * \param [in] writeBuffer is the circular buffer with data that will be transmitted, nullptr to send zeros
+	 * \param [in] size is the size of \a readBuffer and \a writeBuffer, bytes, must be divisible by two frames, buffers
+	 * must have at most 65535 words
+	 * \param [in] mode is the desired SPI mode
+	 * \param [in] wordLength selects word length, bits, [minSpiWordLength; maxSpiWordLength]
+	 * \param [in] lsbFirst selects whether MSB (false) or LSB (true) is transmitted first
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the driver is not stopped;
+	 * - EINVAL - \a readBuffer, \a size and/or \a wordLength are invalid;
+	 * - error codes returned by DmaChannelHandle::reserve();
+	 */
+
+	int start(devices::SpiSlaveBase& spiSlaveBase, void* readBuffer, void* writeBuffer, size_t size,
+			devices::SpiMode mode, uint8_t wordLength, bool lsbFirst) override;
+
+	/**
+	 * \brief Stops low-level SPI slave driver.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the driver is not started;
+	 */
+
+	int stop() override;
+
+	SpiSlaveLowLevelDmaBased(const SpiSlaveLowLevelDmaBased&) = delete;
+	SpiSlaveLowLevelDmaBased(SpiSlaveLowLevelDmaBased&&) = delete;
+	const SpiSlaveLowLevelDmaBased& operator=(const SpiSlaveLowLevelDmaBased&) = delete;
+	SpiSlaveLowLevelDmaBased& operator=(SpiSlaveLowLevelDmaBased&&) = delete;
+
+private:
+
+	/// RxDmaChannelFunctor class is a DmaChannelFunctorCommon for DMA channel used for reception
+	class RxDmaChannelFunctor : public DmaChannelFunctorCommon
+	{
+	public:
+
+		/**
+		 * \brief RxDmaChannelFunctor's constructor
+		 *
+		 * \param [in] owner is a reference to owner SpiSlaveLowLevelDmaBased object
+		 */
+
+		constexpr explicit RxDmaChannelFunctor(SpiSlaveLowLevelDmaBased& owner) :
+				owner_{owner}
+		{
+
+		}
+
+		/**
+		 * \brief "Half transfer" event
+		 *
+		 * Called by low-level DMA channel driver when first half of circular buffer is filled.
+		 */
+
+		void halfTransferEvent() override;
+
+		/**
+		 * \brief "Transfer complete" event
+		 *
+		 * Called by low-level DMA channel driver when second half of circular buffer is filled.
+		 */
+
+		void transferCompleteEvent() override;
+
+		/**
+		 * \brief "Transfer error" event
+		 *
+		 * Called by low-level DMA channel driver when transfer error is detected.
+		 *
+		 * \param [in] transactionsLeft is the number of transactions left
+		 */
+
+		void transferErrorEvent(size_t transactionsLeft) override;
+
+	private:
+
+		/// reference to owner SpiSlaveLowLevelDmaBased object
+		SpiSlaveLowLevelDmaBased& owner_;
+	};
+
+	/// TxDmaChannelFunctor class is a DmaChannelFunctorCommon for DMA channel used for transmission
+	class TxDmaChannelFunctor : public DmaChannelFunctorCommon
+	{
+	public:
+
+		/**
+		 * \brief TxDmaChannelFunctor's constructor
+		 *
+		 * \param [in] owner is a reference to owner SpiSlaveLowLevelDmaBased object
+		 */
+
+		constexpr explicit TxDmaChannelFunctor(SpiSlaveLowLevelDmaBased& owner) :
+				owner_{owner}
+		{
+
+		}
+
+		/**
+		 * \brief "Transfer error" event
+		 *
+		 * Called by low-level DMA channel driver when transfer error is detected.
+		 *
+		 * \param [in] transactionsLeft is the number of transactions left
+		 */
+
+		void transferErrorEvent(size_t transactionsLeft) override;
+
+	private:
+
+		/// reference to owner SpiSlaveLowLevelDmaBased object
+		SpiSlaveLowLevelDmaBased& owner_;
+	};
+
+	/**
+	 * \brief "Transfer error" event handler
+	 */
+
+	void errorEventHandler();
+
+	/**
+	 * \brief "Frame complete" event handler
+	 *
+	 * \param [in] frame is the index of frame which was received, {0, 1}
+	 */
+
+	void frameEventHandler(uint8_t frame);
+
+	/**
+	 * \return true if driver is started, false otherwise
+	 */
+
+	bool isStarted() const
+	{
+		return spiSlaveBase_ != nullptr;
+	}
+
+	/// reference to raw SPI peripheral
+	const SpiPeripheral& spiPeripheral_;
+
+	/// reference to DMA channel used for reception
+	DmaChannel& rxDmaChannel_;
+
+	/// reference to DMA channel used for transmission
+	DmaChannel& txDmaChannel_;
+
+	/// handle of DMA channel used for reception
+	DmaChannelHandle rxDmaChannelHandle_;
+
+	/// handle of DMA channel used for transmission
+	DmaChannelHandle txDmaChannelHandle_;
+
+	/// functor for DMA channel used for reception
+	RxDmaChannelFunctor rxDmaChannelFunctor_;
+
+	/// functor for DMA channel used for transmission
+	TxDmaChannelFunctor txDmaChannelFunctor_;
+
+	/// pointer to SpiSlaveBase object associated with this one, nullptr if driver is stopped
+	devices::SpiSlaveBase* volatile spiSlaveBase_;
+
+	/// circular buffer to which received data is written
+	uint8_t* readBuffer_;
+
+	/// circular buffer with data that is transmitted, nullptr if dummy data is sent
+	uint8_t* writeBuffer_;
+
+	/// size of single frame (half of circular buffers), bytes
+	size_t frameSize_;
+
+	/// dummy data that is sent if write buffer is nullptr
+	uint16_t txDummyData_;
+
+	/// request identifier for DMA channel used for reception
+	uint8_t rxDmaRequest_;
+
+	/// request identifier for DMA channel used for transmission
+	uint8_t txDmaRequest_;
+};
+
+}	// namespace chip
+
+}	// namespace distortos
+
+#endif	// SOURCE_CHIP_STM32_PERIPHERALS_SPIV2_INCLUDE_DISTORTOS_CHIP_SPISLAVELOWLEVELDMABASED_HPP_
@@ -0,0 +1,282 @@
+/**
+ * \file
+ * \brief UartLowLevelDmaBased class implementation for USARTv1 in STM32
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/chip/UartLowLevelDmaBased.hpp"
+
+#include "distortos/chip/STM32-USARTv1-UartPeripheral.hpp"
+
+#include "distortos/devices/communication/UartBase.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/distortosConfiguration.h"
+
+#include "estd/ScopeGuard.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace chip
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Decode value of USART_SR register to devices::UartBase::ErrorSet
+ *
+ * \param [in] sr is the value of USART_SR register that will be decoded
+ *
+ * \return devices::UartBase::ErrorSet with errors decoded from \a sr
+ */
+
+devices::UartBase::ErrorSet decodeErrors(const uint32_t sr)
+{
+	devices::UartBase::ErrorSet errorSet {};
+	errorSet[devices::UartBase::framingError] = (sr & USART_SR_FE) != 0;
+	errorSet[devices::UartBase::noiseError] = (sr & USART_SR_NE) != 0;
+	errorSet[devices::UartBase::overrunError] = (sr & USART_SR_ORE) != 0;
+	errorSet[devices::UartBase::parityError] = (sr & USART_SR_PE) != 0;
+	return errorSet;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+UartLowLevelDmaBased::~UartLowLevelDmaBased()
+{
+	assert(isStarted() == false);
+}
+
+void UartLowLevelDmaBased::interruptHandler()
+{
+	const auto sr = uartPeripheral_.readSr();
+	const auto cr1 = uartPeripheral_.readCr1();
+	const auto idle = (sr & USART_SR_IDLE) != 0 && (cr1 & USART_CR1_IDLEIE) != 0;
+	const auto srErrorFlags = sr & (USART_SR_FE | USART_SR_NE | USART_SR_ORE | USART_SR_PE);
+
+	// IDLE flag and error flags are cleared by reading SR followed by reading DR - if read operation is in progress,
+	// DMA will read DR anyway, otherwise the erroneous character must be dropped
+	if (idle == true || (srErrorFlags != 0 && isReadInProgress() == false))
+		uartPeripheral_.readDr();
+
+	if (srErrorFlags != 0)
+		uartBase_->receiveErrorEvent(decodeErrors(sr));
+
+	if (idle == true)
+	{
+		const auto readSize = readSize_;
+		if (readSize != 0 && rxDmaChannelHandle_.getTransactionsLeft() * getDataSize() != readSize)
+			uartBase_->readCompleteEvent(stopRead());
+	}
+
+	if ((sr & USART_SR_TC) != 0 && (cr1 & USART_CR1_TCIE) != 0)	// transmit complete
+	{
+		uartPeripheral_.enableTcInterrupt(false);
+		uartBase_->transmitCompleteEvent();
+	}
+}
+
+std::pair<int, uint32_t> UartLowLevelDmaBased::start(devices::UartBase& uartBase, const uint32_t baudRate,
+		const uint8_t characterLength, const devices::UartParity parity, const bool _2StopBits,
+		const bool hardwareFlowControl)
+{
+	if (isStarted() == true)
+		return {EBADF, {}};
+
+	const auto peripheralFrequency = uartPeripheral_.getPeripheralFrequency();
+	const auto divider = (peripheralFrequency + baudRate / 2) / baudRate;
+#ifdef DISTORTOS_CHIP_USART_HAS_CR1_OVER8_BIT
+	const auto over8 = divider < 16;
+#else	// !def DISTORTOS_CHIP_USART_HAS_CR1_OVER8_BIT
+	constexpr bool over8 {false};
+#endif	// !def DISTORTOS_CHIP_USART_HAS_CR1_OVER8_BIT
+	const auto mantissa = divider / (over8 == false ? 16 : 8);
+	const auto fraction = divider % (over8 == false ? 16 : 8);
+
+	if (mantissa == 0 || mantissa > (USART_BRR_DIV_Mantissa >> USART_BRR_DIV_Mantissa_Pos))
+		return {EINVAL, {}};
+
+	const auto realCharacterLength = characterLength + (parity != devices::UartParity::none);
+	if (realCharacterLength < minCharacterLength + 1 || realCharacterLength > maxCharacterLength)
+		return {EINVAL, {}};
+
+	{
+		const auto ret = rxDmaChannelHandle_.reserve(rxDmaChannel_, rxDmaRequest_, rxDmaChannelFunctor_);
+		if (ret != 0)
+			return {ret, {}};
+	}
+
+	auto rxDmaChannelHandleScopeGuard = estd::makeScopeGuard([this]()
+			{
+				rxDmaChannelHandle_.release();
+			});
+
+	{
+		const auto ret = txDmaChannelHandle_.reserve(txDmaChannel_, txDmaRequest_, txDmaChannelFunctor_);
+		if (ret != 0)
+			return {ret, {}};
+	}
+
+	rxDmaChannelHandleScopeGuard.release();
+
+	uartBase_ = &uartBase;
+	characterLength_ = characterLength;
+	uartPeripheral_.writeBrr(mantissa << USART_BRR_DIV_Mantissa_Pos | fraction << USART_BRR_DIV_Fraction_Pos);
+	uartPeripheral_.writeCr3((hardwareFlowControl == true ? USART_CR3_CTSE | USART_CR3_RTSE : 0) | USART_CR3_DMAT |
+			USART_CR3_DMAR | USART_CR3_EIE);
+	uartPeripheral_.writeCr2(_2StopBits << (USART_CR2_STOP_Pos + 1));
+	uartPeripheral_.writeCr1(USART_CR1_RE | USART_CR1_TE | USART_CR1_UE | USART_CR1_PEIE |
+#ifdef DISTORTOS_CHIP_USART_HAS_CR1_OVER8_BIT
+			over8 << USART_CR1_OVER8_Pos |
+#endif	// def DISTORTOS_CHIP_USART_HAS_CR1_OVER8_BIT
+			(realCharacterLength == maxCharacterLength) << USART_CR1_M_Pos |
+			(parity != devices::UartParity::none) << USART_CR1_PCE_Pos |
+			(parity == devices::UartParity::odd) << USART_CR1_PS_Pos);
+	return {{}, peripheralFrequency / divider};
+}
+
+int UartLowLevelDmaBased::startRead(void* const buffer, const size_t size)
+{
+	if (buffer == nullptr || size == 0)
+		return EINVAL;
+
+	if (isStarted() == false)
+		return EBADF;
+
+	if (isReadInProgress() == true)
+		return EBUSY;
+
+	const auto dataSize = getDataSize();
+	if (size % dataSize != 0)
+		return EINVAL;
+
+	readSize_ = size;
+	rxDmaChannelHandle_.startTransfer(reinterpret_cast<uintptr_t>(buffer), uartPeripheral_.getDrAddress(),
+			size / dataSize, (dataSize == 1 ? DmaChannel::Flags::dataSize1 : DmaChannel::Flags::dataSize2) |
+			DmaChannel::Flags::transferCompleteInterruptEnable | DmaChannel::Flags::peripheralToMemory |
+			DmaChannel::Flags::peripheralFixed | DmaChannel::Flags::memoryIncrement |
+			DmaChannel::Flags::veryHighPriority);
+	uartPeripheral_.enableIdleInterrupt(true);
+	return 0;
+}
+
+int UartLowLevelDmaBased::startWrite(const void* const buffer, const size_t size)
+{
+	if (buffer == nullptr || size == 0)
+		return EINVAL;
+
+	if (isStarted() == false)
+		return EBADF;
+
+	if (isWriteInProgress() == true)
+		return EBUSY;
+
+	const auto dataSize = getDataSize();
+	if (size % dataSize != 0)
+		return EINVAL;
+
+	writeSize_ = size;
+	uartPeripheral_.enableTcInterrupt(false);
+
+	if ((uartPeripheral_.readSr() & USART_SR_TC) != 0)
+		uartBase_->transmitStartEvent();
+
+	txDmaChannelHandle_.startTransfer(reinterpret_cast<uintptr_t>(buffer), uartPeripheral_.getDrAddress(),
+			size / dataSize, (dataSize == 1 ? DmaChannel::Flags::dataSize1 : DmaChannel::Flags::dataSize2) |
+			DmaChannel::Flags::transferCompleteInterruptEnable | DmaChannel::Flags::memoryToPeripheral |
+			DmaChannel::Flags::peripheralFixed | DmaChannel::Flags::memoryIncrement |
+			DmaChannel::Flags::lowPriority);
+	return 0;
+}
+
+int UartLowLevelDmaBased::stop()
+{
+	if (isStarted() == false)
+		return EBADF;
+
+	if (isReadInProgress() == true || isWriteInProgress() == true)
+		return EBUSY;
+
+	rxDmaChannelHandle_.release();
+	txDmaChannelHandle_.release();
+
+	// reset peripheral
+	uartPeripheral_.writeCr1({});
+	uartPeripheral_.writeCr2({});
+	uartPeripheral_.writeCr3({});
+	uartBase_ = nullptr;
+	return 0;
+}
+
+size_t UartLowLevelDmaBased::stopRead()
+{
+	if (isReadInProgress() == false)
+		return 0;
+
+	uartPeripheral_.enableIdleInterrupt(false);
+	rxDmaChannelHandle_.stopTransfer();
+	const auto bytesRead = readSize_ - rxDmaChannelHandle_.getTransactionsLeft() * getDataSize();
+	readSize_ = {};
+	return bytesRead;
+}
+
+size_t UartLowLevelDmaBased::stopWrite()
+{
+	if (isWriteInProgress() == false)
+		return 0;
+
+	txDmaChannelHandle_.stopTransfer();
+	const auto bytesWritten = writeSize_ - txDmaChannelHandle_.getTransactionsLeft() * getDataSize();
+	writeSize_ = {};
+	uartPeripheral_.enableTcInterrupt(true);
+	return bytesWritten;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| UartLowLevelDmaBased::RxDmaChannelFunctor public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void UartLowLevelDmaBased::RxDmaChannelFunctor::transferCompleteEvent()
+{
+	owner_.uartBase_->readCompleteEvent(owner_.stopRead());
+}
+
+void UartLowLevelDmaBased::RxDmaChannelFunctor::transferErrorEvent(size_t)
+{
+	owner_.uartBase_->readCompleteEvent(owner_.stopRead());
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| UartLowLevelDmaBased::TxDmaChannelFunctor public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void UartLowLevelDmaBased::TxDmaChannelFunctor::transferCompleteEvent()
+{
+	owner_.uartBase_->writeCompleteEvent(owner_.stopWrite());
+}
+
+void UartLowLevelDmaBased::TxDmaChannelFunctor::transferErrorEvent(size_t)
+{
+	owner_.uartBase_->writeCompleteEvent(owner_.stopWrite());
+}
+
+}	// namespace chip
+
+}	// namespace distortos
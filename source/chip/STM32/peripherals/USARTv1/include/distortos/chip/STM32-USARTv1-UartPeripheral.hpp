@@ -0,0 +1,183 @@
+/**
+ * \file
+ * \brief UartPeripheral class header for USARTv1 in STM32
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SOURCE_CHIP_STM32_PERIPHERALS_USARTV1_INCLUDE_DISTORTOS_CHIP_STM32_USARTV1_UARTPERIPHERAL_HPP_
+#define SOURCE_CHIP_STM32_PERIPHERALS_USARTV1_INCLUDE_DISTORTOS_CHIP_STM32_USARTV1_UARTPERIPHERAL_HPP_
+
+#include "distortos/chip/getBusFrequency.hpp"
+#include "distortos/chip/STM32-bit-banding.h"
+
+namespace distortos
+{
+
+namespace chip
+{
+
+/// UartPeripheral class is a raw UART peripheral for USARTv1 in STM32
+class UartPeripheral
+{
+public:
+
+	/**
+	 * \brief UartPeripheral's constructor
+	 *
+	 * \param [in] uartBase is a base address of UART peripheral
+	 */
+
+	constexpr explicit UartPeripheral(const uintptr_t uartBase) :
+			uartBase_{uartBase},
+			peripheralFrequency_{getBusFrequency(uartBase)},
+			idleieBbAddress_{STM32_BITBAND_IMPLEMENTATION(uartBase, USART_TypeDef, CR1, USART_CR1_IDLEIE)},
+			tcieBbAddress_{STM32_BITBAND_IMPLEMENTATION(uartBase, USART_TypeDef, CR1, USART_CR1_TCIE)}
+	{
+
+	}
+
+	/**
+	 * \brief Enables or disables IDLE interrupt of UART.
+	 *
+	 * \param [in] enable selects whether the interrupt will be enabled (true) or disabled (false)
+	 */
+
+	void enableIdleInterrupt(const bool enable) const
+	{
+		*reinterpret_cast<volatile unsigned long*>(idleieBbAddress_) = enable;
+	}
+
+	/**
+	 * \brief Enables or disables TC interrupt of UART.
+	 *
+	 * \param [in] enable selects whether the interrupt will be enabled (true) or disabled (false)
+	 */
+
+	void enableTcInterrupt(const bool enable) const
+	{
+		*reinterpret_cast<volatile unsigned long*>(tcieBbAddress_) = enable;
+	}
+
+	/**
+	 * \return address of DR register
+	 */
+
+	uintptr_t getDrAddress() const
+	{
+		return reinterpret_cast<uintptr_t>(&getUart().DR);
+	}
+
+	/**
+	 * \return peripheral clock frequency, Hz
+	 */
+
+	uint32_t getPeripheralFrequency() const
+	{
+		return peripheralFrequency_;
+	}
+
+	/**
+	 * \return current value of CR1 register
+	 */
+
+	uint32_t readCr1() const
+	{
+		return getUart().CR1;
+	}
+
+	/**
+	 * \return current value of DR register
+	 */
+
+	uint32_t readDr() const
+	{
+		return getUart().DR;
+	}
+
+	/**
+	 * \return current value of SR register
+	 */
+
+	uint32_t readSr() const
+	{
+		return getUart().SR;
+	}
+
+	/**
+	 * \brief Writes value to BRR register.
+	 *
+	 * \param [in] brr is the value that will be written to BRR register
+	 */
+
+	void writeBrr(const uint32_t brr) const
+	{
+		getUart().BRR = brr;
+	}
+
+	/**
+	 * \brief Writes value to CR1 register.
+	 *
+	 * \param [in] cr1 is the value that will be written to CR1 register
+	 */
+
+	void writeCr1(const uint32_t cr1) const
+	{
+		getUart().CR1 = cr1;
+	}
+
+	/**
+	 * \brief Writes value to CR2 register.
+	 *
+	 * \param [in] cr2 is the value that will be written to CR2 register
+	 */
+
+	void writeCr2(const uint32_t cr2) const
+	{
+		getUart().CR2 = cr2;
+	}
+
+	/**
+	 * \brief Writes value to CR3 register.
+	 *
+	 * \param [in] cr3 is the value that will be written to CR3 register
+	 */
+
+	void writeCr3(const uint32_t cr3) const
+	{
+		getUart().CR3 = cr3;
+	}
+
+private:
+
+	/**
+	 * \return reference to USART_TypeDef object
+	 */
+
+	USART_TypeDef& getUart() const
+	{
+		return *reinterpret_cast<USART_TypeDef*>(uartBase_);
+	}
+
+	/// base address of UART peripheral
+	uintptr_t uartBase_;
+
+	/// peripheral clock frequency, Hz
+	uint32_t peripheralFrequency_;
+
+	/// address of bitband alias of IDLEIE bit in USART_CR1 register
+	uintptr_t idleieBbAddress_;
+
+	/// address of bitband alias of TCIE bit in USART_CR1 register
+	uintptr_t tcieBbAddress_;
+};
+
+}	// namespace chip
+
+}	// namespace distortos
+
+#endif	// SOURCE_CHIP_STM32_PERIPHERALS_USARTV1_INCLUDE_DISTORTOS_CHIP_STM32_USARTV1_UARTPERIPHERAL_HPP_
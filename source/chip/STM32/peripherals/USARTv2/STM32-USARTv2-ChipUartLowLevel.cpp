@@ -395,6 +395,23 @@ ChipUartLowLevel::~ChipUartLowLevel()
 	parameters_.enablePeripheralClock(false);
 }
 
+int ChipUartLowLevel::configureHardwareDriverEnable(const bool enable, const bool driverEnabledState,
+		const uint8_t assertionTime, const uint8_t deassertionTime)
+{
+	if (isStarted() == true)
+		return EBADF;
+
+	constexpr uint8_t maxDriverEnableTime {USART_CR1_DEAT >> USART_CR1_DEAT_Pos};
+	if (assertionTime > maxDriverEnableTime || deassertionTime > maxDriverEnableTime)
+		return EINVAL;
+
+	driverEnableAssertionTime_ = assertionTime;
+	driverEnableDeassertionTime_ = deassertionTime;
+	driverEnabledState_ = driverEnabledState;
+	hardwareDriverEnable_ = enable;
+	return 0;
+}
+
 void ChipUartLowLevel::interruptHandler()
 {
 	auto& uart = parameters_.getUart();
@@ -449,6 +466,9 @@ std::pair<int, uint32_t> ChipUartLowLevel::start(devices::UartBase& uartBase, co
 	if (isStarted() == true)
 		return {EBADF, {}};
 
+	if (hardwareFlowControl == true && hardwareDriverEnable_ == true)
+		return {EINVAL, {}};
+
 	const auto peripheralFrequency = parameters_.getPeripheralFrequency();
 	const auto divider = (peripheralFrequency + baudRate / 2) / baudRate;
 	const auto over8 = divider < 16;
@@ -462,6 +482,11 @@ std::pair<int, uint32_t> ChipUartLowLevel::start(devices::UartBase& uartBase, co
 	if (realCharacterLength < minCharacterLength + 1 || realCharacterLength > maxCharacterLength)
 		return {EINVAL, {}};
 
+	// driver enable times are configured in 1/16 of bit period, but peripheral uses sampling time units
+	const uint32_t driverEnableTimes = hardwareDriverEnable_ == false ? 0 :
+			(driverEnableAssertionTime_ + over8) >> over8 << USART_CR1_DEAT_Pos |
+			(driverEnableDeassertionTime_ + over8) >> over8 << USART_CR1_DEDT_Pos;
+
 	parameters_.enablePeripheralClock(true);
 	parameters_.resetPeripheral();
 
@@ -471,7 +496,9 @@ std::pair<int, uint32_t> ChipUartLowLevel::start(devices::UartBase& uartBase, co
 	uart.CR2 = _2StopBits << (USART_CR2_STOP_Pos + 1);
 	if (hardwareFlowControl == true)
 		uart.CR3 = USART_CR3_CTSE | USART_CR3_RTSE;
-	uart.CR1 = USART_CR1_RE | USART_CR1_TE | USART_CR1_UE | over8 << USART_CR1_OVER8_Pos |
+	else if (hardwareDriverEnable_ == true)
+		uart.CR3 = USART_CR3_DEM | (driverEnabledState_ == false) << USART_CR3_DEP_Pos;
+	uart.CR1 = USART_CR1_RE | USART_CR1_TE | USART_CR1_UE | over8 << USART_CR1_OVER8_Pos | driverEnableTimes |
 			(realCharacterLength == maxCharacterLength) << USART_CR1_M0_Pos |
 #ifdef DISTORTOS_CHIP_USART_HAS_CR1_M1_BIT
 			(realCharacterLength == minCharacterLength + 1) << USART_CR1_M1_Pos |
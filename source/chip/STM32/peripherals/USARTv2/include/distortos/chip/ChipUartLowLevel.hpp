@@ -142,7 +142,11 @@ public:
 			readPosition_{},
 			writeBuffer_{},
 			writeSize_{},
-			writePosition_{}
+			writePosition_{},
+			driverEnableAssertionTime_{},
+			driverEnableDeassertionTime_{},
+			driverEnabledState_{},
+			hardwareDriverEnable_{}
 	{
 
 	}
@@ -155,6 +159,28 @@ public:
 
 	~ChipUartLowLevel() override;
 
+	/**
+	 * \brief Configures hardware control of RS-485 driver.
+	 *
+	 * When hardware control is enabled, "driver enable" output of UART (multiplexed with RTS) is asserted by hardware
+	 * for the duration of each transmission. New configuration is used by next call to start(). Hardware control of
+	 * RS-485 driver cannot be used together with hardware flow control.
+	 *
+	 * \param [in] enable selects whether hardware control of RS-485 driver is enabled (true) or disabled (false)
+	 * \param [in] driverEnabledState is the state of "driver enable" output in which RS-485 driver is enabled
+	 * \param [in] assertionTime is the time between assertion of "driver enable" output and the beginning of start bit
+	 * of first transmitted character, 1/16 of bit period, [0; 31]
+	 * \param [in] deassertionTime is the time between the end of stop bit of last transmitted character and deassertion
+	 * of "driver enable" output, 1/16 of bit period, [0; 31]
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the driver is not stopped;
+	 * - EINVAL - \a assertionTime and/or \a deassertionTime are invalid;
+	 */
+
+	int configureHardwareDriverEnable(bool enable, bool driverEnabledState, uint8_t assertionTime,
+			uint8_t deassertionTime) override;
+
 	/**
 	 * \brief Interrupt handler
 	 *
@@ -307,6 +333,18 @@ private:
 
 	/// current position in \a writeBuffer_
 	volatile size_t writePosition_;
+
+	/// time between assertion of "driver enable" output and the beginning of start bit, 1/16 of bit period
+	uint8_t driverEnableAssertionTime_;
+
+	/// time between the end of stop bit and deassertion of "driver enable" output, 1/16 of bit period
+	uint8_t driverEnableDeassertionTime_;
+
+	/// state of "driver enable" output in which RS-485 driver is enabled
+	bool driverEnabledState_;
+
+	/// selects whether hardware control of RS-485 driver is enabled (true) or disabled (false)
+	bool hardwareDriverEnable_;
 };
 
 }	// namespace chip
@@ -0,0 +1,218 @@
+/**
+ * \file
+ * \brief UartPeripheral class header for USARTv2 in STM32
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SOURCE_CHIP_STM32_PERIPHERALS_USARTV2_INCLUDE_DISTORTOS_CHIP_STM32_USARTV2_UARTPERIPHERAL_HPP_
+#define SOURCE_CHIP_STM32_PERIPHERALS_USARTV2_INCLUDE_DISTORTOS_CHIP_STM32_USARTV2_UARTPERIPHERAL_HPP_
+
+#include "distortos/chip/getBusFrequency.hpp"
+#include "distortos/chip/STM32-bit-banding.h"
+
+#ifndef DISTORTOS_BITBANDING_SUPPORTED
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#endif	// !def DISTORTOS_BITBANDING_SUPPORTED
+
+namespace distortos
+{
+
+namespace chip
+{
+
+/// UartPeripheral class is a raw UART peripheral for USARTv2 in STM32
+class UartPeripheral
+{
+public:
+
+	/**
+	 * \brief UartPeripheral's constructor
+	 *
+	 * \param [in] uartBase is a base address of UART peripheral
+	 */
+
+	constexpr explicit UartPeripheral(const uintptr_t uartBase) :
+			uartBase_{uartBase},
+			peripheralFrequency_{getBusFrequency(uartBase)}
+#ifdef DISTORTOS_BITBANDING_SUPPORTED
+			, idleieBbAddress_{STM32_BITBAND_IMPLEMENTATION(uartBase, USART_TypeDef, CR1, USART_CR1_IDLEIE)},
+			tcieBbAddress_{STM32_BITBAND_IMPLEMENTATION(uartBase, USART_TypeDef, CR1, USART_CR1_TCIE)}
+#endif	// def DISTORTOS_BITBANDING_SUPPORTED
+	{
+
+	}
+
+	/**
+	 * \brief Enables or disables IDLE interrupt of UART.
+	 *
+	 * \param [in] enable selects whether the interrupt will be enabled (true) or disabled (false)
+	 */
+
+	void enableIdleInterrupt(const bool enable) const
+	{
+#ifdef DISTORTOS_BITBANDING_SUPPORTED
+		*reinterpret_cast<volatile unsigned long*>(idleieBbAddress_) = enable;
+#else	// !def DISTORTOS_BITBANDING_SUPPORTED
+		auto& uart = getUart();
+		const InterruptMaskingLock interruptMaskingLock;
+		uart.CR1 = (uart.CR1 & ~USART_CR1_IDLEIE) | (enable == true ? USART_CR1_IDLEIE : 0);
+#endif	// !def DISTORTOS_BITBANDING_SUPPORTED
+	}
+
+	/**
+	 * \brief Enables or disables TC interrupt of UART.
+	 *
+	 * \param [in] enable selects whether the interrupt will be enabled (true) or disabled (false)
+	 */
+
+	void enableTcInterrupt(const bool enable) const
+	{
+#ifdef DISTORTOS_BITBANDING_SUPPORTED
+		*reinterpret_cast<volatile unsigned long*>(tcieBbAddress_) = enable;
+#else	// !def DISTORTOS_BITBANDING_SUPPORTED
+		auto& uart = getUart();
+		const InterruptMaskingLock interruptMaskingLock;
+		uart.CR1 = (uart.CR1 & ~USART_CR1_TCIE) | (enable == true ? USART_CR1_TCIE : 0);
+#endif	// !def DISTORTOS_BITBANDING_SUPPORTED
+	}
+
+	/**
+	 * \return peripheral clock frequency, Hz
+	 */
+
+	uint32_t getPeripheralFrequency() const
+	{
+		return peripheralFrequency_;
+	}
+
+	/**
+	 * \return address of RDR register
+	 */
+
+	uintptr_t getRdrAddress() const
+	{
+		return reinterpret_cast<uintptr_t>(&getUart().RDR);
+	}
+
+	/**
+	 * \return address of TDR register
+	 */
+
+	uintptr_t getTdrAddress() const
+	{
+		return reinterpret_cast<uintptr_t>(&getUart().TDR);
+	}
+
+	/**
+	 * \return current value of CR1 register
+	 */
+
+	uint32_t readCr1() const
+	{
+		return getUart().CR1;
+	}
+
+	/**
+	 * \return current value of ISR register
+	 */
+
+	uint32_t readIsr() const
+	{
+		return getUart().ISR;
+	}
+
+	/**
+	 * \brief Writes value to BRR register.
+	 *
+	 * \param [in] brr is the value that will be written to BRR register
+	 */
+
+	void writeBrr(const uint32_t brr) const
+	{
+		getUart().BRR = brr;
+	}
+
+	/**
+	 * \brief Writes value to CR1 register.
+	 *
+	 * \param [in] cr1 is the value that will be written to CR1 register
+	 */
+
+	void writeCr1(const uint32_t cr1) const
+	{
+		getUart().CR1 = cr1;
+	}
+
+	/**
+	 * \brief Writes value to CR2 register.
+	 *
+	 * \param [in] cr2 is the value that will be written to CR2 register
+	 */
+
+	void writeCr2(const uint32_t cr2) const
+	{
+		getUart().CR2 = cr2;
+	}
+
+	/**
+	 * \brief Writes value to CR3 register.
+	 *
+	 * \param [in] cr3 is the value that will be written to CR3 register
+	 */
+
+	void writeCr3(const uint32_t cr3) const
+	{
+		getUart().CR3 = cr3;
+	}
+
+	/**
+	 * \brief Writes value to ICR register.
+	 *
+	 * \param [in] icr is the value that will be written to ICR register
+	 */
+
+	void writeIcr(const uint32_t icr) const
+	{
+		getUart().ICR = icr;
+	}
+
+private:
+
+	/**
+	 * \return reference to USART_TypeDef object
+	 */
+
+	USART_TypeDef& getUart() const
+	{
+		return *reinterpret_cast<USART_TypeDef*>(uartBase_);
+	}
+
+	/// base address of UART peripheral
+	uintptr_t uartBase_;
+
+	/// peripheral clock frequency, Hz
+	uint32_t peripheralFrequency_;
+
+#ifdef DISTORTOS_BITBANDING_SUPPORTED
+
+	/// address of bitband alias of IDLEIE bit in USART_CR1 register
+	uintptr_t idleieBbAddress_;
+
+	/// address of bitband alias of TCIE bit in USART_CR1 register
+	uintptr_t tcieBbAddress_;
+
+#endif	// def DISTORTOS_BITBANDING_SUPPORTED
+};
+
+}	// namespace chip
+
+}	// namespace distortos
+
+#endif	// SOURCE_CHIP_STM32_PERIPHERALS_USARTV2_INCLUDE_DISTORTOS_CHIP_STM32_USARTV2_UARTPERIPHERAL_HPP_
@@ -0,0 +1,397 @@
+/**
+ * \file
+ * \brief UartLowLevelDmaBased class header for USARTv2 in STM32
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SOURCE_CHIP_STM32_PERIPHERALS_USARTV2_INCLUDE_DISTORTOS_CHIP_UARTLOWLEVELDMABASED_HPP_
+#define SOURCE_CHIP_STM32_PERIPHERALS_USARTV2_INCLUDE_DISTORTOS_CHIP_UARTLOWLEVELDMABASED_HPP_
+
+#include "distortos/chip/DmaChannelFunctorCommon.hpp"
+#include "distortos/chip/DmaChannelHandle.hpp"
+
+#include "distortos/devices/communication/UartLowLevel.hpp"
+
+#include "distortos/distortosConfiguration.h"
+
+namespace distortos
+{
+
+namespace chip
+{
+
+class UartPeripheral;
+
+/**
+ * \brief UartLowLevelDmaBased class is a low-level UART driver for USARTv2 in STM32.
+ *
+ * This driver uses DMA for data transfers. UART interrupt is used only for idle line detection (which completes read
+ * operations early when at least one character was received), reception errors and end of transmission.
+ *
+ * \ingroup devices
+ */
+
+class UartLowLevelDmaBased : public devices::UartLowLevel
+{
+public:
+
+	/// minimum allowed value for UART character length
+#ifdef DISTORTOS_CHIP_USART_HAS_CR1_M1_BIT
+	constexpr static uint8_t minCharacterLength {6};
+#else	// !def DISTORTOS_CHIP_USART_HAS_CR1_M1_BIT
+	constexpr static uint8_t minCharacterLength {7};
+#endif	// !def DISTORTOS_CHIP_USART_HAS_CR1_M1_BIT
+
+	/// maximum allowed value for UART character length
+	constexpr static uint8_t maxCharacterLength {9};
+
+	/**
+	 * \brief UartLowLevelDmaBased's constructor
+	 *
+	 * \param [in] uartPeripheral is a reference to raw UART peripheral
+	 * \param [in] rxDmaChannel is a reference to DMA channel used for reception
+	 * \param [in] rxDmaRequest is the request identifier for DMA channel used for reception
+	 * \param [in] txDmaChannel is a reference to DMA channel used for transmission
+	 * \param [in] txDmaRequest is the request identifier for DMA channel used for transmission
+	 */
+
+	constexpr UartLowLevelDmaBased(const UartPeripheral& uartPeripheral, DmaChannel& rxDmaChannel,
+			const uint8_t rxDmaRequest, DmaChannel& txDmaChannel, const uint8_t txDmaRequest) :
+					uartPeripheral_{uartPeripheral},
+					rxDmaChannel_{rxDmaChannel},
+					txDmaChannel_{txDmaChannel},
+					rxDmaChannelHandle_{},
+					txDmaChannelHandle_{},
+					rxDmaChannelFunctor_{*this},
+					txDmaChannelFunctor_{*this},
+					uartBase_{},
+					readSize_{},
+					writeSize_{},
+					rxDmaRequest_{rxDmaRequest},
+					txDmaRequest_{txDmaRequest},
+					characterLength_{},
+					driverEnableAssertionTime_{},
+					driverEnableDeassertionTime_{},
+					driverEnabledState_{},
+					hardwareDriverEnable_{}
+	{
+
+	}
+
+	/**
+	 * \brief UartLowLevelDmaBased's destructor
+	 *
+	 * \pre Driver is stopped.
+	 */
+
+	~UartLowLevelDmaBased() override;
+
+	/**
+	 * \brief Configures hardware control of RS-485 driver.
+	 *
+	 * When hardware control is enabled, "driver enable" output of UART (multiplexed with RTS) is asserted by hardware
+	 * for the duration of each transmission. New configuration is used by next call to start(). Hardware control of
+	 * RS-485 driver cannot be used together with hardware flow control.
+	 *
+	 * \param [in] enable selects whether hardware control of RS-485 driver is enabled (true) or disabled (false)
+	 * \param [in] driverEnabledState is the state of "driver enable" output in which RS-485 driver is enabled
+	 * \param [in] assertionTime is the time between assertion of "driver enable" output and the beginning of start bit
+	 * of first transmitted character, 1/16 of bit period, [0; 31]
+	 * \param [in] deassertionTime is the time between the end of stop bit of last transmitted character and deassertion
+	 * of "driver enable" output, 1/16 of bit period, [0; 31]
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the driver is not stopped;
+	 * - EINVAL - \a assertionTime and/or \a deassertionTime are invalid;
+	 */
+
+	int configureHardwareDriverEnable(bool enable, bool driverEnabledState, uint8_t assertionTime,
+			uint8_t deassertionTime) override;
+
+	/**
+	 * \brief Interrupt handler
+	 *
+	 * \note this must not be called by user code
+	 */
+
+	void interruptHandler();
+
+	/**
+	 * \brief Starts low-level UART driver.
+	 *
+	 * Not all combinations of data format are supported. The general rules are:
+	 * - if parity control is disabled, character length must not be \a minCharacterLength,
+	 * - if parity control is enabled, character length must not be 9.
+	 *
+	 * \note If character length is smaller than 8 and parity control is enabled, the most significant bit of each
+	 * received byte contains parity bit - DMA transfers whole data register, so it is not masked.
+	 *
+	 * \param [in] uartBase is a reference to UartBase object that will be associated with this one
+	 * \param [in] baudRate is the desired baud rate, bps
+	 * \param [in] characterLength selects character length, bits, [minCharacterLength; maxCharacterLength]
+	 * \param [in] parity selects parity
+	 * \param [in] _2StopBits selects whether 1 (false) or 2 (true) stop bits are used
+	 * \param [in] hardwareFlowControl selects whether hardware flow control is disabled (false) or enabled (true)
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and real baud rate; error codes:
+	 * - EBADF - the driver is not stopped;
+	 * - EINVAL - selected baud rate and/or format are invalid;
+	 * - error codes returned by DmaChannelHandle::reserve();
+	 */
+
+	std::pair<int, uint32_t> start(devices::UartBase& uartBase, uint32_t baudRate, uint8_t characterLength,
+			devices::UartParity parity, bool _2StopBits, bool hardwareFlowControl) override;
+
+	/**
+	 * \brief Starts asynchronous read operation.
+	 *
+	 * This function returns immediately. When the operation is finished (expected number of bytes were read or idle
+	 * line was detected after at least one character was received), UartBase::readCompleteEvent() will be executed.
+	 * For any detected error during reception, UartBase::receiveErrorEvent() will be executed. Note that errors may be
+	 * reported even if they happened when no read operation was in progress - in that case the erroneous character is
+	 * dropped.
+	 *
+	 * \param [out] buffer is the buffer to which the data will be written
+	 * \param [in] size is the size of \a buffer, bytes, must be even if selected character length is greater than 8
+	 * bits
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the driver is not started;
+	 * - EBUSY - read is in progress;
+	 * - EINVAL - \a buffer and/or \a size are invalid;
+	 */
+
+	int startRead(void* buffer, size_t size) override;
+
+	/**
+	 * \brief Starts asynchronous write operation.
+	 *
+	 * This function returns immediately. If no transmission is active, UartBase::transmitStartEvent() will be executed.
+	 * When the operation is finished (expected number of bytes were written), UartBase::writeCompleteEvent() will be
+	 * executed. When the transmission physically ends, UartBase::transmitCompleteEvent() will be executed.
+	 *
+	 * \param [in] buffer is the buffer with data that will be transmitted
+	 * \param [in] size is the size of \a buffer, bytes, must be even if selected character length is greater than 8
+	 * bits
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the driver is not started;
+	 * - EBUSY - write is in progress;
+	 * - EINVAL - \a buffer and/or \a size are invalid;
+	 */
+
+	int startWrite(const void* buffer, size_t size) override;
+
+	/**
+	 * \brief Stops low-level UART driver.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the driver is not started;
+	 * - EBUSY - read and/or write are in progress;
+	 */
+
+	int stop() override;
+
+	/**
+	 * \brief Stops asynchronous read operation.
+	 *
+	 * This function returns immediately. After this call UartBase::readCompleteEvent() will not be executed.
+	 *
+	 * \return number of bytes already read by low-level UART driver (and written to read buffer)
+	 */
+
+	size_t stopRead() override;
+
+	/**
+	 * \brief Stops asynchronous write operation.
+	 *
+	 * This function returns immediately. After this call UartBase::writeCompleteEvent() will not be executed.
+	 * UartBase::transmitCompleteEvent() will not be suppressed.
+	 *
+	 * \return number of bytes already written by low-level UART driver (and read from write buffer)
+	 */
+
+	size_t stopWrite() override;
+
+private:
+
+	/// RxDmaChannelFunctor class is a DmaChannelFunctorCommon for DMA channel used for reception
+	class RxDmaChannelFunctor : public DmaChannelFunctorCommon
+	{
+	public:
+
+		/**
+		 * \brief RxDmaChannelFunctor's constructor
+		 *
+		 * \param [in] owner is a reference to owner UartLowLevelDmaBased object
+		 */
+
+		constexpr explicit RxDmaChannelFunctor(UartLowLevelDmaBased& owner) :
+				owner_{owner}
+		{
+
+		}
+
+		/**
+		 * \brief "Transfer complete" event
+		 *
+		 * Called by low-level DMA channel driver when the transfer is physically finished.
+		 */
+
+		void transferCompleteEvent() override;
+
+		/**
+		 * \brief "Transfer error" event
+		 *
+		 * Called by low-level DMA channel driver when transfer error is detected.
+		 *
+		 * \param [in] transactionsLeft is the number of transactions left
+		 */
+
+		void transferErrorEvent(size_t transactionsLeft) override;
+
+	private:
+
+		/// reference to owner UartLowLevelDmaBased object
+		UartLowLevelDmaBased& owner_;
+	};
+
+	/// TxDmaChannelFunctor class is a DmaChannelFunctorCommon for DMA channel used for transmission
+	class TxDmaChannelFunctor : public DmaChannelFunctorCommon
+	{
+	public:
+
+		/**
+		 * \brief TxDmaChannelFunctor's constructor
+		 *
+		 * \param [in] owner is a reference to owner UartLowLevelDmaBased object
+		 */
+
+		constexpr explicit TxDmaChannelFunctor(UartLowLevelDmaBased& owner) :
+				owner_{owner}
+		{
+
+		}
+
+		/**
+		 * \brief "Transfer complete" event
+		 *
+		 * Called by low-level DMA channel driver when the transfer is physically finished.
+		 */
+
+		void transferCompleteEvent() override;
+
+		/**
+		 * \brief "Transfer error" event
+		 *
+		 * Called by low-level DMA channel driver when transfer error is detected.
+		 *
+		 * \param [in] transactionsLeft is the number of transactions left
+		 */
+
+		void transferErrorEvent(size_t transactionsLeft) override;
+
+	private:
+
+		/// reference to owner UartLowLevelDmaBased object
+		UartLowLevelDmaBased& owner_;
+	};
+
+	/**
+	 * \return size of single DMA transaction, bytes
+	 */
+
+	size_t getDataSize() const
+	{
+		return characterLength_ > 8 ? 2 : 1;
+	}
+
+	/**
+	 * \return true if driver is started, false otherwise
+	 */
+
+	bool isStarted() const
+	{
+		return uartBase_ != nullptr;
+	}
+
+	/**
+	 * \return true if read operation is in progress, false otherwise
+	 */
+
+	bool isReadInProgress() const
+	{
+		return readSize_ != 0;
+	}
+
+	/**
+	 * \return true if write operation is in progress, false otherwise
+	 */
+
+	bool isWriteInProgress() const
+	{
+		return writeSize_ != 0;
+	}
+
+	/// reference to raw UART peripheral
+	const UartPeripheral& uartPeripheral_;
+
+	/// reference to DMA channel used for reception
+	DmaChannel& rxDmaChannel_;
+
+	/// reference to DMA channel used for transmission
+	DmaChannel& txDmaChannel_;
+
+	/// handle of DMA channel used for reception
+	DmaChannelHandle rxDmaChannelHandle_;
+
+	/// handle of DMA channel used for transmission
+	DmaChannelHandle txDmaChannelHandle_;
+
+	/// functor for DMA channel used for reception
+	RxDmaChannelFunctor rxDmaChannelFunctor_;
+
+	/// functor for DMA channel used for transmission
+	TxDmaChannelFunctor txDmaChannelFunctor_;
+
+	/// pointer to UartBase object associated with this one
+	devices::UartBase* uartBase_;
+
+	/// size of read operation in progress, bytes, 0 if no read operation is in progress
+	volatile size_t readSize_;
+
+	/// size of write operation in progress, bytes, 0 if no write operation is in progress
+	volatile size_t writeSize_;
+
+	/// request identifier for DMA channel used for reception
+	uint8_t rxDmaRequest_;
+
+	/// request identifier for DMA channel used for transmission
+	uint8_t txDmaRequest_;
+
+	/// selected character length, bits, [minCharacterLength; maxCharacterLength]
+	uint8_t characterLength_;
+
+	/// time between assertion of "driver enable" output and the beginning of start bit, 1/16 of bit period
+	uint8_t driverEnableAssertionTime_;
+
+	/// time between the end of stop bit and deassertion of "driver enable" output, 1/16 of bit period
+	uint8_t driverEnableDeassertionTime_;
+
+	/// state of "driver enable" output in which RS-485 driver is enabled
+	bool driverEnabledState_;
+
+	/// selects whether hardware control of RS-485 driver is enabled (true) or disabled (false)
+	bool hardwareDriverEnable_;
+};
+
+}	// namespace chip
+
+}	// namespace distortos
+
+#endif	// SOURCE_CHIP_STM32_PERIPHERALS_USARTV2_INCLUDE_DISTORTOS_CHIP_UARTLOWLEVELDMABASED_HPP_
@@ -2,7 +2,7 @@
  * \file
  * \brief Rs485 class implementation
  *
- * \author Copyright (C) 2016 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ * \author Copyright (C) 2016-2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -11,6 +11,8 @@
 
 #include "distortos/devices/communication/Rs485.hpp"
 
+#include "distortos/devices/communication/UartLowLevel.hpp"
+
 #include "distortos/devices/io/OutputPin.hpp"
 
 namespace distortos
@@ -28,19 +30,37 @@ Rs485::~Rs485()
 	enableDriver(false);
 }
 
+int Rs485::open(const uint32_t baudRate, const uint8_t characterLength, const UartParity parity,
+		const bool _2StopBits, const bool hardwareFlowControl)
+{
+	if (hardwareDriverEnable_ == true)
+	{
+		const auto ret = getUart().configureHardwareDriverEnable(true, driverEnabledState_,
+				driverEnableAssertionTime_, driverEnableDeassertionTime_);
+		if (ret == 0 || ret == ENOTSUP)
+			hardwareDriverEnableActive_ = ret == 0;
+		else if (ret != EBADF)	// EBADF - low-level UART driver was already started by previous open
+			return ret;
+	}
+
+	return SerialPort::open(baudRate, characterLength, parity, _2StopBits, hardwareFlowControl);
+}
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | protected functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
 void Rs485::transmitCompleteEvent()
 {
-	enableDriver(false);
+	if (hardwareDriverEnableActive_ == false)
+		enableDriver(false);
 	SerialPort::transmitCompleteEvent();
 }
 
 void Rs485::transmitStartEvent()
 {
-	enableDriver(true);
+	if (hardwareDriverEnableActive_ == false)
+		enableDriver(true);
 	SerialPort::transmitStartEvent();
 }
 
@@ -126,6 +126,23 @@ int SerialPort::close()
 	return 0;
 }
 
+int SerialPort::consume(const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const std::lock_guard<Mutex> readLockGuard {readMutex_};
+
+	if (openCount_ == 0)
+		return EBADF;
+
+	if (size > readBuffer_.getReadBlock().second || (characterLength_ > 8 && size % 2 != 0))
+		return EINVAL;
+
+	readBuffer_.increaseReadPosition(size);
+	// if internal buffer was full, there's no read operation in progress
+	return startReadWrapper();
+}
+
 int SerialPort::open(const uint32_t baudRate, const uint8_t characterLength, const UartParity parity,
 			const bool _2StopBits, const bool hardwareFlowControl)
 {
@@ -168,6 +185,31 @@ int SerialPort::open(const uint32_t baudRate, const uint8_t characterLength, con
 	return 0;
 }
 
+std::pair<int, std::pair<const void*, size_t>> SerialPort::peek(const size_t minSize,
+		const TickClock::time_point* const timePoint)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	{
+		const auto ret = minSize == 0 ? readMutex_.tryLock() :
+				timePoint != nullptr ? readMutex_.tryLockUntil(*timePoint) : readMutex_.lock();
+		if (ret != 0)
+			return {ret != EBUSY ? ret : EAGAIN, {}};
+	}
+
+	const std::lock_guard<Mutex> readLockGuard {readMutex_, std::adopt_lock};
+
+	if (openCount_ == 0)
+		return {EBADF, {}};
+
+	// when character length is greater than 8 bits, round up "minSize" value
+	const auto adjustedMinSize =
+			std::min(readBuffer_.getCapacity(), characterLength_ <= 8 ? minSize : ((minSize + 1) / 2) * 2);
+	const auto ret = waitForReadBuffer(adjustedMinSize, timePoint);
+	const auto readBlock = readBuffer_.getReadBlock();
+	return {ret != 0 || readBlock.second != 0 ? ret : EAGAIN, readBlock};
+}
+
 std::pair<int, size_t> SerialPort::read(void* const buffer, const size_t size, const size_t minSize,
 		const TickClock::time_point* const timePoint)
 {
@@ -464,6 +506,47 @@ size_t SerialPort::stopWriteWrapper()
 	return bytesWritten;
 }
 
+int SerialPort::waitForReadBuffer(const size_t minSize, const TickClock::time_point* const timePoint)
+{
+	if (readBuffer_.isEmpty() == false && readBuffer_.getSize() >= minSize)
+		return 0;
+
+	decltype(std::declval<Semaphore>().wait()) semaphoreRet {};
+	{
+		Semaphore semaphore {0};
+		const auto scopeGuard = estd::makeScopeGuard(
+				[this]()
+				{
+					const InterruptMaskingLock interruptMaskingLock;
+					readLimit_ = {};
+					readSemaphore_ = {};
+				});
+
+		{
+			// The current read transfer (if any) must be stopped for a short moment to make all received data available
+			// in the raw circular buffer (interrupts are masked to prevent preemption, which could make this "short
+			// moment" very long). By subtracting the amount of available data from the minimum amount of data we get
+			// size limit of read operation. Notification after exactly that number of bytes will mean that the buffer
+			// has enough data.
+			const InterruptMaskingLock interruptMaskingLock;
+			stopReadWrapper();
+			const auto size = readBuffer_.getSize();
+			if (minSize > size)	// is blocking required?
+			{
+				readLimit_ = minSize - size;
+				readSemaphore_ = &semaphore;
+			}
+			const auto ret = startReadWrapper();
+			if (ret != 0 || minSize <= size)
+				return ret;
+		}
+
+		semaphoreRet = timePoint != nullptr ? semaphore.tryWaitUntil(*timePoint) : semaphore.wait();
+	}
+
+	return semaphoreRet;
+}
+
 int SerialPort::writeImplementation(estd::RawCircularBuffer& buffer, const size_t minSize,
 		const TickClock::time_point* const timePoint)
 {
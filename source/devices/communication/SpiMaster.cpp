@@ -12,11 +12,13 @@
 #include "distortos/devices/communication/SpiMaster.hpp"
 
 #include "distortos/devices/communication/SpiMasterLowLevel.hpp"
+#include "distortos/devices/io/OutputPin.hpp"
 #include "distortos/devices/communication/SpiMasterTransfer.hpp"
 
 #include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
 
 #include "distortos/assert.h"
+#include "distortos/InterruptMaskingLock.hpp"
 #include "distortos/Semaphore.hpp"
 
 #include "estd/ScopeGuard.hpp"
@@ -24,6 +26,7 @@
 #include <mutex>
 
 #include <cerrno>
+#include <cstring>
 
 namespace distortos
 {
@@ -40,6 +43,30 @@ SpiMaster::~SpiMaster()
 	assert(openCount_ == 0);
 }
 
+int SpiMaster::submitTransaction(SpiMasterTransaction& transaction)
+{
+	if (transaction.transfersRange_.size() == 0)
+		return EINVAL;
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (openCount_ == 0)
+		return EBADF;
+
+	if (transaction.pending_ == true)
+		return EBUSY;
+
+	transaction.ret_ = {};
+	transaction.pending_ = true;
+
+	if (transaction_ == nullptr && lockCount_ == 0 && transactionList_.empty() == true)	// idle and not locked?
+		startTransaction(transaction);
+	else
+		transactionList_.push_back(transaction);
+
+	return 0;
+}
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | private functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -49,17 +76,30 @@ void SpiMaster::close()
 	assert(openCount_ != 0);
 
 	if (openCount_ == 1)	// last close?
+	{
+		assert(transaction_ == nullptr && transactionList_.empty() == true);
 		spiMaster_.stop();
+	}
 
 	--openCount_;
 }
 
 void SpiMaster::configure(const SpiMode mode, const uint32_t clockFrequency, const uint8_t wordLength,
-		const bool lsbFirst, const uint32_t dummyData) const
+		const bool lsbFirst, const uint32_t dummyData)
 {
 	assert(openCount_ != 0);
 
+	if (configured_ == true && mode == mode_ && clockFrequency == clockFrequency_ && wordLength == wordLength_ &&
+			lsbFirst == lsbFirst_ && dummyData == dummyData_)
+		return;
+
 	spiMaster_.configure(mode, clockFrequency, wordLength, lsbFirst, dummyData);
+	clockFrequency_ = clockFrequency;
+	dummyData_ = dummyData;
+	mode_ = mode;
+	wordLength_ = wordLength;
+	lsbFirst_ = lsbFirst;
+	configured_ = true;
 }
 
 int SpiMaster::executeTransaction(const SpiMasterTransfersRange transfersRange)
@@ -79,20 +119,60 @@ int SpiMaster::executeTransaction(const SpiMasterTransfersRange transfersRange)
 				semaphore_ = {};
 			});
 
-	{
-		const auto transfer = transfersRange_.begin();
-		spiMaster_.startTransfer(*this, transfer->getWriteBuffer(), transfer->getReadBuffer(), transfer->getSize());
-	}
+	startNextTransfer();
 
 	while (semaphore.wait() != 0);
 
 	return success_ == true ? 0 : EIO;
 }
 
+void SpiMaster::finishTransaction(const bool success)
+{
+	const auto transaction = transaction_;
+	assert(transaction != nullptr);
+
+	const auto slaveSelectPin = transaction->slaveSelectPin_;
+	if (slaveSelectPin != nullptr)
+		slaveSelectPin->set(true);
+
+	transaction_ = {};
+	transfersRange_ = {};
+	startNextTransaction();
+
+	const auto ret = success == true ? 0 : EIO;
+	transaction->ret_ = ret;
+	transaction->transactionCompleteEvent(ret);
+	transaction->pending_ = false;
+}
+
 void SpiMaster::lock()
 {
-	const auto ret = mutex_.lock();
-	assert(ret == 0);
+	{
+		const auto ret = mutex_.lock();
+		assert(ret == 0);
+	}
+
+	if (lockCount_ != 0)	// recursive lock?
+	{
+		++lockCount_;
+		return;
+	}
+
+	Semaphore semaphore {0};
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+
+		lockCount_ = 1;
+		if (transaction_ == nullptr)	// no asynchronous transaction is executed?
+			return;
+
+		semaphore_ = &semaphore;
+	}
+
+	while (semaphore.wait() != 0);
+
+	semaphore_ = {};
 }
 
 void SpiMaster::notifyWaiter(const bool success)
@@ -112,34 +192,146 @@ int SpiMaster::open()
 		const auto ret = spiMaster_.start();
 		if (ret != 0)
 			return ret;
+
+		configured_ = false;
 	}
 
 	++openCount_;
 	return 0;
 }
 
+void SpiMaster::startNextTransaction()
+{
+	assert(transaction_ == nullptr);
+
+	if (lockCount_ != 0)	// locked? notify thread waiting in lock()
+	{
+		const auto semaphore = semaphore_;
+		if (semaphore != nullptr)
+			semaphore->post();
+		return;
+	}
+
+	if (transactionList_.empty() == true)
+		return;
+
+	auto& transaction = transactionList_.front();
+	transactionList_.pop_front();
+	startTransaction(transaction);
+}
+
+void SpiMaster::startTransaction(SpiMasterTransaction& transaction)
+{
+	assert(transaction_ == nullptr);
+
+	transaction_ = &transaction;
+	transfersRange_ = transaction.transfersRange_;
+	configure(transaction.mode_, transaction.clockFrequency_, transaction.wordLength_, transaction.lsbFirst_,
+			transaction.dummyData_);
+
+	const auto slaveSelectPin = transaction.slaveSelectPin_;
+	if (slaveSelectPin != nullptr)
+		slaveSelectPin->set(false);
+
+	startNextTransfer();
+}
+
+void SpiMaster::startNextTransfer()
+{
+	assert(transfersRange_.size() != 0);
+
+	// count leading transfers which fit in staging buffer together
+	size_t stagedSize {};
+	uint8_t stagedTransfers {};
+	for (const auto& transfer : transfersRange_)
+	{
+		if (stagedSize + transfer.getSize() > stagingBufferSize)
+			break;
+
+		stagedSize += transfer.getSize();
+		++stagedTransfers;
+	}
+
+	if (stagedTransfers < 2)	// nothing to merge?
+	{
+		stagedTransfers_ = {};
+		const auto transfer = transfersRange_.begin();
+		spiMaster_.startTransfer(*this, transfer->getWriteBuffer(), transfer->getReadBuffer(), transfer->getSize());
+		return;
+	}
+
+	// gather data of all staged transfers, buffers without write data are filled with dummy data; word of dummy data is
+	// copied from the least significant bytes of dummyData_, which matches the way it is sent by low-level driver on a
+	// little-endian target
+	const auto wordSize = (wordLength_ + 8u - 1) / 8;
+	auto stagingBufferPosition = stagingBuffer_;
+	for (size_t i {}; i < stagedTransfers; ++i)
+	{
+		const auto& transfer = transfersRange_[i];
+		const auto writeBuffer = transfer.getWriteBuffer();
+		const auto size = transfer.getSize();
+		if (writeBuffer != nullptr)
+			memcpy(stagingBufferPosition, writeBuffer, size);
+		else
+			for (size_t offset {}; offset < size; offset += wordSize)
+				memcpy(stagingBufferPosition + offset, &dummyData_, wordSize);
+		stagingBufferPosition += size;
+	}
+
+	// staging buffer is used for both directions - low-level driver always reads word to write before the word at the
+	// same position is received
+	stagedTransfers_ = stagedTransfers;
+	spiMaster_.startTransfer(*this, stagingBuffer_, stagingBuffer_, stagedSize);
+}
+
 void SpiMaster::transferCompleteEvent(const bool success)
 {
 	assert(transfersRange_.size() != 0);
 
 	if (success == true)	// handling of last transfer successful?
-		transfersRange_ = {transfersRange_.begin() + 1, transfersRange_.end()};
+	{
+		const auto stagedTransfers = stagedTransfers_;
+		if (stagedTransfers != 0)	// scatter data received by merged transfers
+		{
+			auto stagingBufferPosition = stagingBuffer_;
+			for (size_t i {}; i < stagedTransfers; ++i)
+			{
+				const auto& transfer = transfersRange_[i];
+				const auto readBuffer = transfer.getReadBuffer();
+				const auto size = transfer.getSize();
+				if (readBuffer != nullptr)
+					memcpy(readBuffer, stagingBufferPosition, size);
+				stagingBufferPosition += size;
+			}
+		}
+
+		transfersRange_ = {transfersRange_.begin() + (stagedTransfers != 0 ? stagedTransfers : 1),
+				transfersRange_.end()};
+	}
 
 	if (transfersRange_.size() == 0 || success == false)	// all transfers are done or handling of last one failed?
 	{
-		notifyWaiter(success);
+		if (transaction_ != nullptr)	// asynchronous transaction?
+			finishTransaction(success);
+		else
+			notifyWaiter(success);
 		return;
 	}
 
-	{
-		const auto nextTransfer = transfersRange_.begin();
-		spiMaster_.startTransfer(*this, nextTransfer->getWriteBuffer(), nextTransfer->getReadBuffer(),
-				nextTransfer->getSize());
-	}
+	startNextTransfer();
 }
 
 void SpiMaster::unlock()
 {
+	assert(lockCount_ != 0);
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+
+		if (--lockCount_ == 0)	// last unlock? resume asynchronous transactions
+			startNextTransaction();
+	}
+
 	const auto ret = mutex_.unlock();
 	assert(ret == 0);
 }
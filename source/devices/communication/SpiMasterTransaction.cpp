@@ -0,0 +1,45 @@
+/**
+ * \file
+ * \brief SpiMasterTransaction class implementation
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/devices/communication/SpiMasterTransaction.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/Semaphore.hpp"
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+SpiMasterTransaction::~SpiMasterTransaction()
+{
+	assert(pending_ == false);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void SpiMasterTransaction::transactionCompleteEvent(int)
+{
+	const auto semaphore = semaphore_;
+	if (semaphore != nullptr)
+		semaphore->post();
+}
+
+}	// namespace devices
+
+}	// namespace distortos
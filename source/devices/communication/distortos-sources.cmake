@@ -10,4 +10,5 @@
 target_sources(distortos PRIVATE
 		${CMAKE_CURRENT_LIST_DIR}/Rs485.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SerialPort.cpp
-		${CMAKE_CURRENT_LIST_DIR}/SpiMaster.cpp)
+		${CMAKE_CURRENT_LIST_DIR}/SpiMaster.cpp
+		${CMAKE_CURRENT_LIST_DIR}/SpiMasterTransaction.cpp)
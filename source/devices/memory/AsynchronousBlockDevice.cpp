@@ -0,0 +1,150 @@
+/**
+ * \file
+ * \brief AsynchronousBlockDevice class implementation
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/devices/memory/AsynchronousBlockDevice.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <mutex>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+AsynchronousBlockDevice::~AsynchronousBlockDevice()
+{
+	assert(requestList_.empty() == true);
+}
+
+int AsynchronousBlockDevice::close()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	return blockDevice_.close();
+}
+
+int AsynchronousBlockDevice::discard(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	return blockDevice_.discard(address, size);
+}
+
+int AsynchronousBlockDevice::erase(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	return blockDevice_.erase(address, size);
+}
+
+void AsynchronousBlockDevice::executeNextRequest()
+{
+	while (semaphore_.wait() != 0);
+
+	BlockDeviceRequest* request;
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+
+		assert(requestList_.empty() == false);
+		request = &requestList_.front();
+		requestList_.pop_front();
+	}
+
+	const auto ret = request->isWriteRequest() == false ?
+			blockDevice_.read(request->getAddress(), request->getReadBuffer(), request->getSize()) :
+			blockDevice_.write(request->getAddress(), request->getWriteBuffer(), request->getSize());
+	finishRequest(*request, ret);
+}
+
+size_t AsynchronousBlockDevice::getBlockSize() const
+{
+	return blockDevice_.getBlockSize();
+}
+
+uint64_t AsynchronousBlockDevice::getSize() const
+{
+	return blockDevice_.getSize();
+}
+
+void AsynchronousBlockDevice::lock()
+{
+	const auto ret = mutex_.lock();
+	assert(ret == 0);
+}
+
+int AsynchronousBlockDevice::open()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	return blockDevice_.open();
+}
+
+int AsynchronousBlockDevice::read(const uint64_t address, void* const buffer, const size_t size)
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	return blockDevice_.read(address, buffer, size);
+}
+
+void AsynchronousBlockDevice::run()
+{
+	while (1)
+		executeNextRequest();
+}
+
+int AsynchronousBlockDevice::submitRequest(BlockDeviceRequest& request)
+{
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+
+		if (request.isPending() == true)
+			return EBUSY;
+
+		beginRequest(request);
+		requestList_.push_back(request);
+	}
+
+	const auto ret = semaphore_.post();
+	assert(ret == 0);
+	return 0;
+}
+
+int AsynchronousBlockDevice::synchronize()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	return blockDevice_.synchronize();
+}
+
+void AsynchronousBlockDevice::unlock()
+{
+	const auto ret = mutex_.unlock();
+	assert(ret == 0);
+}
+
+int AsynchronousBlockDevice::write(const uint64_t address, const void* const buffer, const size_t size)
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+
+	return blockDevice_.write(address, buffer, size);
+}
+
+}	// namespace devices
+
+}	// namespace distortos
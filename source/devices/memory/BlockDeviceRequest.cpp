@@ -0,0 +1,65 @@
+/**
+ * \file
+ * \brief BlockDeviceRequest class implementation
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/devices/memory/BlockDeviceRequest.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/Semaphore.hpp"
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+BlockDeviceRequest::~BlockDeviceRequest()
+{
+	assert(pending_ == false);
+}
+
+void BlockDeviceRequest::setReadRequest(const uint64_t address, void* const readBuffer, const size_t size)
+{
+	assert(pending_ == false);
+
+	address_ = address;
+	readBuffer_ = readBuffer;
+	size_ = size;
+	writeRequest_ = {};
+}
+
+void BlockDeviceRequest::setWriteRequest(const uint64_t address, const void* const writeBuffer, const size_t size)
+{
+	assert(pending_ == false);
+
+	address_ = address;
+	writeBuffer_ = writeBuffer;
+	size_ = size;
+	writeRequest_ = true;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void BlockDeviceRequest::requestCompleteEvent(int)
+{
+	const auto semaphore = semaphore_;
+	if (semaphore != nullptr)
+		semaphore->post();
+}
+
+}	// namespace devices
+
+}	// namespace distortos
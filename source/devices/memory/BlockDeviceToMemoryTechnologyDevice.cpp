@@ -57,7 +57,7 @@ int BlockDeviceToMemoryTechnologyDevice::close()
 		int eraseRet {};
 		if (pendingEraseSize_ != 0)
 		{
-			eraseRet = blockDevice_.erase(pendingEraseAddress_, pendingEraseSize_);
+			eraseRet = blockDevice_.discard(pendingEraseAddress_, pendingEraseSize_);
 			pendingEraseAddress_ = {};
 			pendingEraseSize_ = {};
 		}
@@ -96,7 +96,7 @@ int BlockDeviceToMemoryTechnologyDevice::erase(const uint64_t address, const uin
 		}
 
 		// ranges cannot be merged so flush the pending erase
-		const auto ret = blockDevice_.erase(pendingEraseAddress_, pendingEraseSize_);
+		const auto ret = blockDevice_.discard(pendingEraseAddress_, pendingEraseSize_);
 		if (ret != 0)
 			return ret;
 	}
@@ -170,7 +170,7 @@ int BlockDeviceToMemoryTechnologyDevice::program(const uint64_t address, const v
 		// based on assumption that the part above is more likely to be written soon.
 
 		const auto eraseSize = address - pendingEraseAddress_;
-		const auto ret = blockDevice_.erase(pendingEraseAddress_, eraseSize);
+		const auto ret = blockDevice_.discard(pendingEraseAddress_, eraseSize);
 		if (ret != 0)
 			return ret;
 
@@ -233,7 +233,7 @@ int BlockDeviceToMemoryTechnologyDevice::read(const uint64_t address, void* cons
 			eraseSize = overlapEnd - pendingEraseAddress_;
 		}
 
-		const auto ret = blockDevice_.erase(eraseAddress, eraseSize);
+		const auto ret = blockDevice_.discard(eraseAddress, eraseSize);
 		if (ret != 0)
 			return ret;
 
@@ -253,7 +253,7 @@ int BlockDeviceToMemoryTechnologyDevice::synchronize()
 
 	if (pendingEraseSize_ != 0)
 	{
-		const auto ret = blockDevice_.erase(pendingEraseAddress_, pendingEraseSize_);
+		const auto ret = blockDevice_.discard(pendingEraseAddress_, pendingEraseSize_);
 		if (ret != 0)
 			return ret;
 
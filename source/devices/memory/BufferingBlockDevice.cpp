@@ -11,6 +11,8 @@
 
 #include "distortos/devices/memory/BufferingBlockDevice.hpp"
 
+#include "distortos/devices/memory/MemcpyEngine.hpp"
+
 #include "AddressRange.hpp"
 
 #include "distortos/assert.h"
@@ -22,6 +24,7 @@
 #endif	// !def DISTORTOS_UNIT_TEST
 
 #include <mutex>
+#include <utility>
 
 #include <cstring>
 
@@ -49,19 +52,24 @@ int BufferingBlockDevice::close()
 	int ret {};
 	if (openCount_ == 1)	// last close?
 	{
+		if (readAheadSubmitted_ == true)
+			finishReadAhead();
+
 		const auto flushRet = flushWriteBuffer();
-		// make sure both buffers are invalidated even if flushing fails
+		const auto finishRet = finishFlush();
+		// make sure all buffers are invalidated even if flushing fails
 		readBufferValid_ = {};
+		flushBufferValidSize_ = {};
 		writeBufferValidSize_ = {};
 		const auto closeRet = blockDevice_.close();
-		ret = flushRet != 0 ? flushRet : closeRet;
+		ret = flushRet != 0 ? flushRet : finishRet != 0 ? finishRet : closeRet;
 	}
 
 	--openCount_;
 	return ret;
 }
 
-int BufferingBlockDevice::erase(const uint64_t address, const uint64_t size)
+int BufferingBlockDevice::discard(const uint64_t address, const uint64_t size)
 {
 	const std::lock_guard<BufferingBlockDevice> lockGuard {*this};
 
@@ -74,51 +82,32 @@ int BufferingBlockDevice::erase(const uint64_t address, const uint64_t size)
 	if (size == 0)
 		return {};
 
-	const AddressRange eraseRange {address, size};
-
 	{
-		const AddressRange readBufferRange {readBufferAddress_, readBufferSize_ * readBufferValid_};
-		const auto intersection = eraseRange & readBufferRange;
-		if (intersection.size() != 0)
-			readBufferValid_ = {};
+		const auto ret = invalidateRange(address, size);
+		if (ret != 0)
+			return ret;
 	}
-	{
-		const AddressRange writeBufferRange {writeBufferAddress_, writeBufferValidSize_};
-		const auto intersection = eraseRange & writeBufferRange;
-		if (intersection.size() != 0)
-		{
-			if (intersection == writeBufferRange)
-			{
-				// erase range completely overlaps write buffer - drop it
-				writeBufferValidSize_ = {};
-			}
-			else if (intersection.begin() == writeBufferRange.begin())
-			{
-				// erase range overlaps front part of write buffer - resize it and shift its contents
-				memmove(writeBuffer_, static_cast<const uint8_t*>(writeBuffer_) + intersection.size(),
-						writeBufferValidSize_ - intersection.size());
-				writeBufferAddress_ += intersection.size();
-				writeBufferValidSize_ -= intersection.size();
-			}
-			else if (intersection.end() == writeBufferRange.end())
-			{
-				// erase range overlaps back part of write buffer - resize it
-				writeBufferValidSize_ -= intersection.size();
-			}
-			else
-			{
-				// erase range overlaps middle part of write buffer - flush the front part, resize it and shift the back
-				// part
-				const auto ret = flushWriteBuffer(intersection.begin() - writeBufferRange.begin());
-				if (ret != 0)
-					return ret;
 
-				memmove(writeBuffer_, static_cast<const uint8_t*>(writeBuffer_) + intersection.size(),
-						writeBufferValidSize_ - intersection.size());
-				writeBufferAddress_ += intersection.size();
-				writeBufferValidSize_ -= intersection.size();
-			}
-		}
+	return blockDevice_.discard(address, size);
+}
+
+int BufferingBlockDevice::erase(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<BufferingBlockDevice> lockGuard {*this};
+
+	assert(openCount_ != 0);
+
+	const auto blockSize = blockDevice_.getBlockSize();
+	assert(address % blockSize == 0 && size % blockSize == 0);
+	assert(address + size <= blockDevice_.getSize());
+
+	if (size == 0)
+		return {};
+
+	{
+		const auto ret = invalidateRange(address, size);
+		if (ret != 0)
+			return ret;
 	}
 
 	return blockDevice_.erase(address, size);
@@ -152,7 +141,9 @@ int BufferingBlockDevice::open()
 			return ret;
 
 		assert(reinterpret_cast<uintptr_t>(readBuffer_) % DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT == 0);
+		assert(reinterpret_cast<uintptr_t>(readAheadBuffer_) % DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT == 0);
 		assert(reinterpret_cast<uintptr_t>(writeBuffer_) % DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT == 0);
+		assert(reinterpret_cast<uintptr_t>(flushBuffer_) % DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT == 0);
 		const auto blockSize = blockDevice_.getBlockSize();
 		assert(readBufferSize_ >= blockSize);
 		assert(readBufferSize_ % blockSize == 0);
@@ -209,7 +200,7 @@ int BufferingBlockDevice::read(const uint64_t address, void* const buffer, const
 		{
 			const auto sourceOffset = intersection1.begin() - writeBufferRange.begin();
 			const auto destinationOffset = intersection1.begin() - readRange.begin();
-			memcpy(static_cast<uint8_t*>(buffer) + destinationOffset,
+			copy(static_cast<uint8_t*>(buffer) + destinationOffset,
 					static_cast<const uint8_t*>(writeBuffer_) + sourceOffset, intersection1.size());
 		}
 
@@ -235,9 +226,16 @@ int BufferingBlockDevice::synchronize()
 
 	assert(openCount_ != 0);
 
-	const auto ret = flushWriteBuffer();
-	if (ret != 0)
-		return ret;
+	{
+		const auto ret = flushWriteBuffer();
+		if (ret != 0)
+			return ret;
+	}
+	{
+		const auto ret = finishFlush();
+		if (ret != 0)
+			return ret;
+	}
 
 	return blockDevice_.synchronize();
 }
@@ -297,7 +295,7 @@ int BufferingBlockDevice::write(uint64_t address, const void* buffer, size_t siz
 				const auto sourceOffset = intersection.begin() - writeRange.begin();
 				const auto destinationOffset = intersection.begin() - writeBufferRange.begin();
 				const auto chunk = intersection.size();
-				memcpy(static_cast<uint8_t*>(writeBuffer_) + destinationOffset,
+				copy(static_cast<uint8_t*>(writeBuffer_) + destinationOffset,
 						static_cast<const uint8_t*>(buffer) + sourceOffset, chunk);
 				size -= chunk;
 				if (sourceOffset == 0)
@@ -316,7 +314,7 @@ int BufferingBlockDevice::write(uint64_t address, const void* buffer, size_t siz
 		else
 		{
 			const auto chunk = std::min(size, writeBufferSize_);
-			memcpy(writeBuffer_, buffer, chunk);
+			copy(writeBuffer_, buffer, chunk);
 			writeBufferAddress_ = address;
 			writeBufferValidSize_ = chunk;
 			address += chunk;
@@ -332,15 +330,82 @@ int BufferingBlockDevice::write(uint64_t address, const void* buffer, size_t siz
 | private functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
+void BufferingBlockDevice::copy(void* const destination, const void* const source, const size_t size) const
+{
+	const auto memcpyEngine = memcpyEngine_;
+	if (memcpyEngine == nullptr || memcpyEngine->copy(destination, source, size) != 0)
+		memcpy(destination, source, size);
+}
+
+void BufferingBlockDevice::dropReadAhead(const uint64_t address, const uint64_t size)
+{
+	if (readAheadSubmitted_ == false)
+		return;
+
+	const AddressRange range {address, size};
+	const AddressRange readAheadRange {readAheadRequest_.getAddress(), readAheadRequest_.getSize()};
+	if ((range & readAheadRange).size() != 0)
+		finishReadAhead();
+}
+
+int BufferingBlockDevice::finishFlush()
+{
+	if (flushSubmitted_ == true)
+	{
+		while (flushSemaphore_.wait() != 0);
+		flushSubmitted_ = {};
+		const auto ret = flushRequest_.getResult();
+		if (ret != 0)
+			return ret;
+
+		flushBufferValidSize_ = {};
+		return {};
+	}
+
+	if (flushBufferValidSize_ == 0)
+		return {};
+
+	// asynchronous write or its submission failed - try again synchronously
+	const auto ret = blockDevice_.write(flushRequest_.getAddress(), flushBuffer_, flushBufferValidSize_);
+	if (ret != 0)
+		return ret;
+
+	flushBufferValidSize_ = {};
+	return {};
+}
+
+int BufferingBlockDevice::finishReadAhead()
+{
+	assert(readAheadSubmitted_ == true);
+
+	while (readAheadSemaphore_.wait() != 0);
+	readAheadSubmitted_ = {};
+	return readAheadRequest_.getResult();
+}
+
 int BufferingBlockDevice::flushWriteBuffer(const size_t size)
 {
 	const auto chunk = std::min(size, writeBufferValidSize_);
 	if (chunk == 0)
 		return {};
 
-	const auto ret = blockDevice_.write(writeBufferAddress_, writeBuffer_, chunk);
-	if (ret != 0)
-		return ret;
+	if (flushBuffer_ != nullptr)
+	{
+		// flush buffer must be empty before it can be used again
+		const auto ret = finishFlush();
+		if (ret != 0)
+			return ret;
+	}
+
+	// data of read-ahead window which is being overwritten would be stale
+	dropReadAhead(writeBufferAddress_, chunk);
+
+	if (flushBuffer_ == nullptr)
+	{
+		const auto ret = blockDevice_.write(writeBufferAddress_, writeBuffer_, chunk);
+		if (ret != 0)
+			return ret;
+	}
 
 	const AddressRange readBufferRange {readBufferAddress_, readBufferSize_ * readBufferValid_};
 	const AddressRange writeBufferRange {writeBufferAddress_, chunk};
@@ -349,10 +414,23 @@ int BufferingBlockDevice::flushWriteBuffer(const size_t size)
 	{
 		const auto sourceOffset = intersection.begin() - writeBufferRange.begin();
 		const auto destinationOffset = intersection.begin() - readBufferRange.begin();
-		memcpy(static_cast<uint8_t*>(readBuffer_) + destinationOffset,
+		copy(static_cast<uint8_t*>(readBuffer_) + destinationOffset,
 				static_cast<const uint8_t*>(writeBuffer_) + sourceOffset, intersection.size());
 	}
 
+	if (flushBuffer_ != nullptr)
+	{
+		if (chunk == writeBufferValidSize_)
+			std::swap(writeBuffer_, flushBuffer_);
+		else
+			copy(flushBuffer_, writeBuffer_, chunk);
+
+		flushRequest_.setWriteRequest(writeBufferAddress_, flushBuffer_, chunk);
+		flushBufferValidSize_ = chunk;
+		// if submission fails, the data will be written synchronously by finishFlush()
+		flushSubmitted_ = blockDevice_.submitRequest(flushRequest_) == 0;
+	}
+
 	writeBufferAddress_ += chunk;
 	writeBufferValidSize_ -= chunk;
 	if (writeBufferValidSize_ != 0)
@@ -360,6 +438,66 @@ int BufferingBlockDevice::flushWriteBuffer(const size_t size)
 	return {};
 }
 
+int BufferingBlockDevice::invalidateRange(const uint64_t address, const uint64_t size)
+{
+	dropReadAhead(address, size);
+
+	const AddressRange invalidatedRange {address, size};
+
+	{
+		const AddressRange readBufferRange {readBufferAddress_, readBufferSize_ * readBufferValid_};
+		const auto intersection = invalidatedRange & readBufferRange;
+		if (intersection.size() != 0)
+			readBufferValid_ = {};
+	}
+	{
+		const AddressRange writeBufferRange {writeBufferAddress_, writeBufferValidSize_};
+		const auto intersection = invalidatedRange & writeBufferRange;
+		if (intersection.size() != 0)
+		{
+			if (intersection == writeBufferRange)
+			{
+				// range completely overlaps write buffer - drop it
+				writeBufferValidSize_ = {};
+			}
+			else if (intersection.begin() == writeBufferRange.begin())
+			{
+				// range overlaps front part of write buffer - resize it and shift its contents
+				memmove(writeBuffer_, static_cast<const uint8_t*>(writeBuffer_) + intersection.size(),
+						writeBufferValidSize_ - intersection.size());
+				writeBufferAddress_ += intersection.size();
+				writeBufferValidSize_ -= intersection.size();
+			}
+			else if (intersection.end() == writeBufferRange.end())
+			{
+				// range overlaps back part of write buffer - resize it
+				writeBufferValidSize_ -= intersection.size();
+			}
+			else
+			{
+				// range overlaps middle part of write buffer - flush the front part, resize it and shift the back part
+				const auto ret = flushWriteBuffer(intersection.begin() - writeBufferRange.begin());
+				if (ret != 0)
+					return ret;
+
+				memmove(writeBuffer_, static_cast<const uint8_t*>(writeBuffer_) + intersection.size(),
+						writeBufferValidSize_ - intersection.size());
+				writeBufferAddress_ += intersection.size();
+				writeBufferValidSize_ -= intersection.size();
+			}
+		}
+	}
+
+	{
+		// data which is written in the background must reach the device before the range is invalidated
+		const auto ret = finishFlush();
+		if (ret != 0)
+			return ret;
+	}
+
+	return {};
+}
+
 int BufferingBlockDevice::readImplementation(uint64_t address, void* buffer, size_t size, const uint64_t deviceSize)
 {
 	while (size > 0)
@@ -374,13 +512,31 @@ int BufferingBlockDevice::readImplementation(uint64_t address, void* buffer, siz
 
 			const auto sourceOffset = intersection.begin() - readBufferRange.begin();
 			const auto chunk = intersection.size();
-			memcpy(buffer, static_cast<uint8_t*>(readBuffer_) + sourceOffset, chunk);
+			copy(buffer, static_cast<uint8_t*>(readBuffer_) + sourceOffset, chunk);
 			address += chunk;
 			buffer = static_cast<uint8_t*>(buffer) + chunk;
 			size -= chunk;
 		}
 		else
 		{
+			if (readAheadSubmitted_ == true)
+			{
+				const auto readAheadAddress = readAheadRequest_.getAddress();
+				const auto ret = finishReadAhead();
+				if (ret == 0 && address >= readAheadAddress && address - readAheadAddress < readBufferSize_)
+				{
+					// read-ahead hit - swap the buffers and request the next window
+					std::swap(readBuffer_, readAheadBuffer_);
+					readBufferAddress_ = readAheadAddress;
+					readBufferValid_ = true;
+					startReadAhead(deviceSize);
+					continue;
+				}
+			}
+
+			// read which continues right after the end of read buffer is considered sequential
+			const auto sequential = readBufferValid_ == true && address == readBufferAddress_ + readBufferSize_;
+
 			decltype(readBufferAddress_) newBufferAddress = address;
 			if (newBufferAddress > deviceSize - readBufferSize_)
 			{
@@ -398,6 +554,18 @@ int BufferingBlockDevice::readImplementation(uint64_t address, void* buffer, siz
 					newBufferAddress = {};
 			}
 
+			if (flushBufferValidSize_ != 0)
+			{
+				// data which is written in the background must reach the device before it is read
+				const AddressRange flushBufferRange {flushRequest_.getAddress(), flushBufferValidSize_};
+				if ((flushBufferRange & AddressRange{newBufferAddress, readBufferSize_}).size() != 0)
+				{
+					const auto ret = finishFlush();
+					if (ret != 0)
+						return ret;
+				}
+			}
+
 			readBufferValid_ = {};	// make sure to invalidate current read buffer
 
 			const auto ret = blockDevice_.read(newBufferAddress, readBuffer_, readBufferSize_);
@@ -406,12 +574,36 @@ int BufferingBlockDevice::readImplementation(uint64_t address, void* buffer, siz
 
 			readBufferAddress_ = newBufferAddress;
 			readBufferValid_ = true;
+
+			if (sequential == true)
+				startReadAhead(deviceSize);
 		}
 	}
 
 	return {};
 }
 
+void BufferingBlockDevice::startReadAhead(const uint64_t deviceSize)
+{
+	if (readAheadBuffer_ == nullptr)
+		return;
+
+	const auto address = readBufferAddress_ + readBufferSize_;
+	if (address > deviceSize - readBufferSize_)
+		return;
+
+	if (flushBufferValidSize_ != 0)
+	{
+		// window with data which is written in the background would have to wait for this write anyway
+		const AddressRange flushBufferRange {flushRequest_.getAddress(), flushBufferValidSize_};
+		if ((flushBufferRange & AddressRange{address, readBufferSize_}).size() != 0)
+			return;
+	}
+
+	readAheadRequest_.setReadRequest(address, readAheadBuffer_, readBufferSize_);
+	readAheadSubmitted_ = blockDevice_.submitRequest(readAheadRequest_) == 0;
+}
+
 }	// namespace devices
 
 }	// namespace distortos
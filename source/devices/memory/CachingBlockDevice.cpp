@@ -0,0 +1,426 @@
+/**
+ * \file
+ * \brief CachingBlockDevice class implementation
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/devices/memory/CachingBlockDevice.hpp"
+
+#include "distortos/devices/memory/MemcpyEngine.hpp"
+
+#include "AddressRange.hpp"
+
+#include "distortos/assert.h"
+
+#ifndef DISTORTOS_UNIT_TEST
+
+#include "distortos/distortosConfiguration.h"
+
+#endif	// !def DISTORTOS_UNIT_TEST
+
+#include <mutex>
+#include <tuple>
+
+#include <cstring>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+CachingBlockDevice::~CachingBlockDevice()
+{
+	assert(openCount_ == 0);
+}
+
+int CachingBlockDevice::close()
+{
+	const std::lock_guard<CachingBlockDevice> lockGuard {*this};
+
+	assert(openCount_ != 0);
+
+	int ret {};
+	if (openCount_ == 1)	// last close?
+	{
+		const auto flushRet = flush();
+		// make sure all entries are invalidated even if flushing fails
+		for (size_t i {}; i < entriesCount_; ++i)
+			entries_[i] = {};
+		const auto closeRet = blockDevice_.close();
+		ret = flushRet != 0 ? flushRet : closeRet;
+	}
+
+	--openCount_;
+	return ret;
+}
+
+int CachingBlockDevice::discard(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<CachingBlockDevice> lockGuard {*this};
+
+	assert(openCount_ != 0);
+	assert(address % blockSize_ == 0 && size % blockSize_ == 0);
+	assert(address + size <= blockDevice_.getSize());
+
+	if (size == 0)
+		return {};
+
+	dropEntries(address, size);
+	return blockDevice_.discard(address, size);
+}
+
+int CachingBlockDevice::erase(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<CachingBlockDevice> lockGuard {*this};
+
+	assert(openCount_ != 0);
+	assert(address % blockSize_ == 0 && size % blockSize_ == 0);
+	assert(address + size <= blockDevice_.getSize());
+
+	if (size == 0)
+		return {};
+
+	dropEntries(address, size);
+	return blockDevice_.erase(address, size);
+}
+
+size_t CachingBlockDevice::getBlockSize() const
+{
+	return blockDevice_.getBlockSize();
+}
+
+uint64_t CachingBlockDevice::getSize() const
+{
+	return blockDevice_.getSize();
+}
+
+void CachingBlockDevice::lock()
+{
+	blockDevice_.lock();
+}
+
+int CachingBlockDevice::open()
+{
+	const std::lock_guard<CachingBlockDevice> lockGuard {*this};
+
+	assert(openCount_ < std::numeric_limits<decltype(openCount_)>::max());
+
+	if (openCount_ == 0)	// first open?
+	{
+		const auto ret = blockDevice_.open();
+		if (ret != 0)
+			return ret;
+
+		assert(reinterpret_cast<uintptr_t>(buffer_) % DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT == 0);
+		assert(entries_ != nullptr && entriesCount_ != 0);
+		blockSize_ = blockDevice_.getBlockSize();
+		for (size_t i {}; i < entriesCount_; ++i)
+			entries_[i] = {};
+		useCounter_ = {};
+	}
+
+	++openCount_;
+	return {};
+}
+
+int CachingBlockDevice::pin(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<CachingBlockDevice> lockGuard {*this};
+
+	for (auto& pinnedRegion : pinnedRegions_)
+		if (pinnedRegion.size == 0)
+		{
+			pinnedRegion = {address, size};
+			return {};
+		}
+
+	return ENOSPC;
+}
+
+int CachingBlockDevice::read(const uint64_t address, void* const buffer, const size_t size)
+{
+	const std::lock_guard<CachingBlockDevice> lockGuard {*this};
+
+	assert(openCount_ != 0);
+	assert(buffer != nullptr);
+	assert(address % blockSize_ == 0 && size % blockSize_ == 0);
+	assert(address + size <= blockDevice_.getSize());
+
+	const auto blocks = size / blockSize_;
+	size_t block {};
+	while (block < blocks)
+	{
+		const auto blockAddress = address + block * blockSize_;
+		const auto blockBuffer = static_cast<uint8_t*>(buffer) + block * blockSize_;
+		auto entry = findEntry(blockAddress);
+		if (entry == nullptr)
+		{
+			const auto uncachedBlocks = getUncachedBlocks(blockAddress, blocks - block);
+			if (uncachedBlocks > 1 &&
+					reinterpret_cast<uintptr_t>(blockBuffer) % DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT == 0)
+			{
+				// long run of uncached blocks - bypass the cache
+				const auto ret = blockDevice_.read(blockAddress, blockBuffer, uncachedBlocks * blockSize_);
+				if (ret != 0)
+					return ret;
+
+				block += uncachedBlocks;
+				continue;
+			}
+
+			int ret;
+			std::tie(ret, entry) = loadEntry(blockAddress);
+			if (ret != 0)
+				return ret;
+		}
+
+		copy(blockBuffer, getEntryBuffer(*entry), blockSize_);
+		touch(*entry);
+		++block;
+	}
+
+	return {};
+}
+
+int CachingBlockDevice::synchronize()
+{
+	const std::lock_guard<CachingBlockDevice> lockGuard {*this};
+
+	assert(openCount_ != 0);
+
+	const auto ret = flush();
+	if (ret != 0)
+		return ret;
+
+	return blockDevice_.synchronize();
+}
+
+void CachingBlockDevice::unlock()
+{
+	blockDevice_.unlock();
+}
+
+int CachingBlockDevice::unpin(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<CachingBlockDevice> lockGuard {*this};
+
+	for (auto& pinnedRegion : pinnedRegions_)
+		if (pinnedRegion.size != 0 && pinnedRegion.address == address && pinnedRegion.size == size)
+		{
+			pinnedRegion = {};
+			return {};
+		}
+
+	return EINVAL;
+}
+
+int CachingBlockDevice::write(const uint64_t address, const void* const buffer, const size_t size)
+{
+	const std::lock_guard<CachingBlockDevice> lockGuard {*this};
+
+	assert(openCount_ != 0);
+	assert(buffer != nullptr);
+	assert(address % blockSize_ == 0 && size % blockSize_ == 0);
+	assert(address + size <= blockDevice_.getSize());
+
+	const auto blocks = size / blockSize_;
+	size_t block {};
+	while (block < blocks)
+	{
+		const auto blockAddress = address + block * blockSize_;
+		const auto blockBuffer = static_cast<const uint8_t*>(buffer) + block * blockSize_;
+		auto entry = findEntry(blockAddress);
+		if (entry == nullptr)
+		{
+			const auto uncachedBlocks = getUncachedBlocks(blockAddress, blocks - block);
+			if (uncachedBlocks > 1 &&
+					reinterpret_cast<uintptr_t>(blockBuffer) % DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT == 0)
+			{
+				// long run of uncached blocks - bypass the cache
+				const auto ret = blockDevice_.write(blockAddress, blockBuffer, uncachedBlocks * blockSize_);
+				if (ret != 0)
+					return ret;
+
+				block += uncachedBlocks;
+				continue;
+			}
+
+			int ret;
+			std::tie(ret, entry) = allocateEntry(blockAddress);
+			if (ret != 0)
+				return ret;
+
+			// whole block is overwritten, so there's no need to read it first
+			entry->valid = true;
+		}
+
+		copy(getEntryBuffer(*entry), blockBuffer, blockSize_);
+		entry->dirty = true;
+		touch(*entry);
+		++block;
+	}
+
+	return {};
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<int, CachingBlockDevice::Entry*> CachingBlockDevice::allocateEntry(const uint64_t address)
+{
+	Entry* victim {};
+	bool victimPinned {};
+	for (size_t i {}; i < entriesCount_; ++i)
+	{
+		auto& entry = entries_[i];
+		if (entry.valid == false)
+		{
+			victim = &entry;
+			break;
+		}
+
+		const auto pinned = isPinned(entry.address);
+		if (victim != nullptr && (victimPinned == false || pinned == true))
+		{
+			if (victimPinned != pinned)
+				continue;
+
+			// "age" is compared instead of "last use" values, so that overflow of use counter is harmless
+			const auto age = static_cast<uint32_t>(useCounter_ - entry.lastUse);
+			const auto victimAge = static_cast<uint32_t>(useCounter_ - victim->lastUse);
+			if (age <= victimAge)
+				continue;
+		}
+
+		victim = &entry;
+		victimPinned = pinned;
+	}
+
+	assert(victim != nullptr);
+
+	if (victim->valid == true)
+	{
+		const auto ret = writeBack(*victim);
+		if (ret != 0)
+			return {ret, nullptr};
+	}
+
+	*victim = {};
+	victim->address = address;
+	return {{}, victim};
+}
+
+void CachingBlockDevice::copy(void* const destination, const void* const source, const size_t size) const
+{
+	const auto memcpyEngine = memcpyEngine_;
+	if (memcpyEngine == nullptr || memcpyEngine->copy(destination, source, size) != 0)
+		memcpy(destination, source, size);
+}
+
+void CachingBlockDevice::dropEntries(const uint64_t address, const uint64_t size)
+{
+	const AddressRange droppedRange {address, size};
+	for (size_t i {}; i < entriesCount_; ++i)
+	{
+		auto& entry = entries_[i];
+		if (entry.valid == true && (droppedRange & AddressRange{entry.address, blockSize_}).size() != 0)
+			entry = {};
+	}
+}
+
+CachingBlockDevice::Entry* CachingBlockDevice::findEntry(const uint64_t address) const
+{
+	for (size_t i {}; i < entriesCount_; ++i)
+		if (entries_[i].valid == true && entries_[i].address == address)
+			return &entries_[i];
+
+	return {};
+}
+
+int CachingBlockDevice::flush()
+{
+	while (1)
+	{
+		// write back modified entries in the order of their addresses, which is optimal for most devices
+		Entry* oldest {};
+		for (size_t i {}; i < entriesCount_; ++i)
+		{
+			auto& entry = entries_[i];
+			if (entry.valid == true && entry.dirty == true && (oldest == nullptr || entry.address < oldest->address))
+				oldest = &entry;
+		}
+
+		if (oldest == nullptr)
+			return {};
+
+		const auto ret = writeBack(*oldest);
+		if (ret != 0)
+			return ret;
+	}
+}
+
+void* CachingBlockDevice::getEntryBuffer(const Entry& entry) const
+{
+	return static_cast<uint8_t*>(buffer_) + (&entry - entries_) * blockSize_;
+}
+
+size_t CachingBlockDevice::getUncachedBlocks(const uint64_t address, const size_t maxBlocks) const
+{
+	size_t blocks {};
+	while (blocks < maxBlocks && findEntry(address + blocks * blockSize_) == nullptr)
+		++blocks;
+	return blocks;
+}
+
+bool CachingBlockDevice::isPinned(const uint64_t address) const
+{
+	for (auto& pinnedRegion : pinnedRegions_)
+		if (pinnedRegion.size != 0 && address >= pinnedRegion.address &&
+				address - pinnedRegion.address < pinnedRegion.size)
+			return true;
+
+	return false;
+}
+
+std::pair<int, CachingBlockDevice::Entry*> CachingBlockDevice::loadEntry(const uint64_t address)
+{
+	const auto allocation = allocateEntry(address);
+	if (allocation.first != 0)
+		return allocation;
+
+	const auto entry = allocation.second;
+	const auto ret = blockDevice_.read(address, getEntryBuffer(*entry), blockSize_);
+	if (ret != 0)
+		return {ret, nullptr};
+
+	entry->valid = true;
+	return {{}, entry};
+}
+
+int CachingBlockDevice::writeBack(Entry& entry)
+{
+	if (entry.dirty == false)
+		return {};
+
+	const auto ret = blockDevice_.write(entry.address, getEntryBuffer(entry), blockSize_);
+	if (ret != 0)
+		return ret;
+
+	entry.dirty = false;
+	return {};
+}
+
+}	// namespace devices
+
+}	// namespace distortos
@@ -215,6 +215,15 @@ public:
 
 	}
 
+	/**
+	 * \return value of CCC (card command classes) bit field
+	 */
+
+	uint16_t getCcc() const
+	{
+		return estd::extractBitField<84, 12>(csd_);
+	}
+
 	/**
 	 * \return value of CSD_STRUCTURE (CSD structure) bit field
 	 */
@@ -644,6 +653,15 @@ public:
 		return estd::extractBitField<428, 4, true>(sdStatus_);
 	}
 
+	/**
+	 * \return value of DISCARD_SUPPORT (discard support) bit field
+	 */
+
+	bool getDiscardSupport() const
+	{
+		return estd::extractBitField<313, 1, true>(sdStatus_);
+	}
+
 	/**
 	 * \return value of ERASE_OFFSET (fixed offset value added to erase time) bit field
 	 */
@@ -677,6 +695,77 @@ private:
 	RawSdStatus sdStatus_;
 };
 
+/// switch function status, returned by CMD6
+class SwitchFunctionStatus
+{
+public:
+
+	/// type of raw switch function status data
+	using RawSwitchFunctionStatus = std::array<uint8_t, 512 / (sizeof(uint8_t) * CHAR_BIT)>;
+
+	SwitchFunctionStatus() = default;
+
+	/**
+	 * \brief SwitchFunctionStatus' constructor
+	 *
+	 * \param [in] switchFunctionStatus is the raw switch function status data
+	 */
+
+	constexpr explicit SwitchFunctionStatus(const RawSwitchFunctionStatus switchFunctionStatus) :
+			switchFunctionStatus_{switchFunctionStatus}
+	{
+
+	}
+
+	/**
+	 * \return value of "function group 1, selection result" bit field
+	 */
+
+	uint8_t getFunctionGroup1Selection() const
+	{
+		return estd::extractBitField<376, 4, true>(switchFunctionStatus_);
+	}
+
+	/**
+	 * \return value of "function group 1, support bits of functions" bit field
+	 */
+
+	uint16_t getFunctionGroup1Support() const
+	{
+		return estd::extractBitField<400, 16, true>(switchFunctionStatus_);
+	}
+
+	/**
+	 * \return value of "maximum current/power consumption" bit field, 0 indicates an error
+	 */
+
+	uint16_t getMaxCurrent() const
+	{
+		return estd::extractBitField<496, 16, true>(switchFunctionStatus_);
+	}
+
+private:
+
+	/// raw switch function status data
+	RawSwitchFunctionStatus switchFunctionStatus_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// max clock frequency in default speed mode, Hz
+constexpr uint32_t defaultSpeedMaxClockFrequency {25000000};
+
+/// max clock frequency in high speed mode, Hz
+constexpr uint32_t highSpeedMaxClockFrequency {50000000};
+
+/// high speed function in function group 1 (access mode)
+constexpr uint8_t highSpeedFunction {1};
+
+/// switch (class 10) commands in CCC (card command classes) bit field
+constexpr uint16_t switchCommandClass {1 << 10};
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | local functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -895,6 +984,34 @@ std::pair<int, R6Response> executeCmd3(SynchronousSdMmcCardLowLevel& sdCard)
 	return executeCmdWithR6Response(sdCard, 3, {}, {});
 }
 
+/**
+ * \brief Executes CMD6 command on SD card.
+ *
+ * This is SWITCH_FUNC command. Only function group 1 (access mode) is checked or switched, other function groups are
+ * not changed.
+ *
+ * \param [in] sdCard is a reference to synchronous low-level SD/MMC card driver
+ * \param [in] switchMode selects whether function is only checked (false) or switched (true)
+ * \param [in] accessMode is the function in function group 1 (access mode) which will be checked or switched
+ * \param [in] timeoutMs is the timeout of read transfer, milliseconds
+ *
+ * \return tuple with return code (0 on success, error code otherwise), R1 response and switch function status; error
+ * codes:
+ * - error codes returned by executeCmdWithR1Response();
+ */
+
+std::tuple<int, R1Response, SwitchFunctionStatus> executeCmd6(SynchronousSdMmcCardLowLevel& sdCard,
+		const bool switchMode, const uint8_t accessMode, const uint16_t timeoutMs)
+{
+	SwitchFunctionStatus::RawSwitchFunctionStatus switchFunctionStatus
+			__attribute__((aligned(DISTORTOS_SDMMCCARD_BUFFER_ALIGNMENT))) {};
+	const auto ret = executeCmdWithR1Response(sdCard, 6,
+			static_cast<uint32_t>(switchMode) << 31 | 0xfffff0 | (accessMode & 0xf),
+			SdMmcCardLowLevel::ReadTransfer{switchFunctionStatus.data(), sizeof(switchFunctionStatus),
+			sizeof(switchFunctionStatus), timeoutMs});
+	return std::make_tuple(ret.first, ret.second, SwitchFunctionStatus{switchFunctionStatus});
+}
+
 /**
  * \brief Executes CMD7 command on SD card.
  *
@@ -1120,14 +1237,15 @@ std::pair<int, R1Response> executeCmd33(SynchronousSdMmcCardLowLevel& sdCard, co
  * This is ERASE command.
  *
  * \param [in] sdCard is a reference to synchronous low-level SD/MMC card driver
+ * \param [in] discard selects whether the blocks will be erased (false) or discarded (true)
  *
  * \return pair with return code (0 on success, error code otherwise) and R1 response; error codes:
  * - error codes returned by executeCmdWithR1Response();
  */
 
-std::pair<int, R1Response> executeCmd38(SynchronousSdMmcCardLowLevel& sdCard)
+std::pair<int, R1Response> executeCmd38(SynchronousSdMmcCardLowLevel& sdCard, const bool discard)
 {
-	return executeCmdWithR1Response(sdCard, 38, {}, {});
+	return executeCmdWithR1Response(sdCard, 38, discard == true ? 1 : 0, {});
 }
 
 /**
@@ -1295,6 +1413,43 @@ std::pair<int, R3Response> executeAcmd41(SynchronousSdMmcCardLowLevel& sdCard, c
 			static_cast<uint32_t>(xpc) << 28 | static_cast<uint32_t>(s18r) << 24 | (vddVoltageWindow & 0xffffff), {});
 }
 
+/**
+ * \brief Switches card to high speed mode.
+ *
+ * Support for high speed function is checked first, then the function is switched. The card stays in transfer (tran)
+ * state, so on failure it can still be used in default speed mode.
+ *
+ * \param [in] sdCard is a reference to synchronous low-level SD/MMC card driver
+ * \param [in] timeoutMs is the timeout of read transfer, milliseconds
+ *
+ * \return 0 on success, error code otherwise:
+ * - EIO - R1 response or switch function status indicates an error;
+ * - ENOTSUP - high speed mode is not supported by the card;
+ * - error codes returned by executeCmd6();
+ */
+
+int switchToHighSpeed(SynchronousSdMmcCardLowLevel& sdCard, const uint16_t timeoutMs)
+{
+	for (const auto switchMode : {false, true})
+	{
+		int ret;
+		R1Response r1Response;
+		SwitchFunctionStatus switchFunctionStatus;
+		std::tie(ret, r1Response, switchFunctionStatus) = executeCmd6(sdCard, switchMode, highSpeedFunction,
+				timeoutMs);
+		if (ret != 0)
+			return ret;
+		if (r1Response.isError() == true || switchFunctionStatus.getMaxCurrent() == 0)
+			return EIO;
+		if ((switchFunctionStatus.getFunctionGroup1Support() & 1 << highSpeedFunction) == 0)
+			return ENOTSUP;
+		if (switchFunctionStatus.getFunctionGroup1Selection() != highSpeedFunction)
+			return switchMode == false ? ENOTSUP : EIO;
+	}
+
+	return {};
+}
+
 /**
  * \brief Waits until card goes back to transfer (tran) state.
  *
@@ -1356,7 +1511,7 @@ int SdCard::close()
 	int ret {};
 	if (openCount_ == 1)	// last close?
 	{
-		ret = waitForTransferState(sdCard_, rca_, busyDeadline_);
+		ret = waitWhileBusy();
 		sdCard_.stop();
 		deinitialize();
 	}
@@ -1365,73 +1520,25 @@ int SdCard::close()
 	return ret;
 }
 
-int SdCard::erase(const uint64_t address, const uint64_t size)
+int SdCard::discard(const uint64_t address, const uint64_t size)
 {
 	const std::lock_guard<Mutex> lockGuard {mutex_};
 
 	assert(openCount_ != 0);
-	assert(address % blockSize == 0 && size % blockSize == 0);
-
-	const auto firstBlock = address / blockSize;
-	const auto blocks = size / blockSize;
-	assert(firstBlock + blocks <= blocksCount_);
 
-	if (size == 0)
+	if (discardSupport_ == false)
 		return {};
 
-	uint64_t erased {};
-	while (erased < size)
-	{
-		{
-			const auto ret = waitForTransferState(sdCard_, rca_, busyDeadline_);
-			if (ret != 0)
-				return ret;
-		}
-
-		const auto beginAddress = address + erased;
-		// erase no more than 1 AU at a time
-		const auto endAddress = std::min(address + size, beginAddress / auSize_ * auSize_ + auSize_);
-
-		{
-			int ret;
-			R1Response r1Response;
-			const auto commandAddress = blockAddressing_ == true ? beginAddress / blockSize : beginAddress;
-			std::tie(ret, r1Response) = executeCmd32(sdCard_, commandAddress);
-			if (ret != 0)
-				return ret;
-			if (r1Response.isError() == true)
-				return EIO;
-		}
-		{
-			int ret;
-			R1Response r1Response;
-			const auto commandAddress = blockAddressing_ == true ? (endAddress - blockSize) / blockSize :
-					(endAddress - blockSize);
-			std::tie(ret, r1Response) = executeCmd33(sdCard_, commandAddress);
-			if (ret != 0)
-				return ret;
-			if (r1Response.isError() == true)
-				return EIO;
-		}
-		{
-			int ret;
-			R1Response r1Response;
-			std::tie(ret, r1Response) = executeCmd38(sdCard_);
-			if (ret != 0)
-				return ret;
-			if (r1Response.isError() == true)
-				return EIO;
-		}
+	return eraseImplementation(address, size, true);
+}
 
-		erased += endAddress - beginAddress;
+int SdCard::erase(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
 
-		const auto beginPartial = beginAddress % auSize_ != 0;
-		const auto endPartial = endAddress % auSize_ != 0;
-		busyDeadline_ = TickClock::now() + std::chrono::milliseconds{eraseTimeoutMs_} +
-				std::chrono::milliseconds{250} * (beginPartial + endPartial);
-	}
+	assert(openCount_ != 0);
 
-	return {};
+	return eraseImplementation(address, size, false);
 }
 
 size_t SdCard::getBlockSize() const
@@ -1503,7 +1610,7 @@ int SdCard::read(const uint64_t address, void* const buffer, const size_t size)
 		return {};
 
 	{
-		const auto ret = waitForTransferState(sdCard_, rca_, busyDeadline_);
+		const auto ret = waitWhileBusy();
 		if (ret != 0)
 			return ret;
 	}
@@ -1546,7 +1653,7 @@ int SdCard::synchronize()
 
 	assert(openCount_ != 0);
 
-	return waitForTransferState(sdCard_, rca_, busyDeadline_);
+	return waitWhileBusy();
 }
 
 void SdCard::unlock()
@@ -1570,7 +1677,7 @@ int SdCard::write(const uint64_t address, const void* const buffer, const size_t
 		return {};
 
 	{
-		const auto ret = waitForTransferState(sdCard_, rca_, busyDeadline_);
+		const auto ret = waitWhileBusy();
 		if (ret != 0)
 			return ret;
 	}
@@ -1612,7 +1719,11 @@ int SdCard::write(const uint64_t address, const void* const buffer, const size_t
 		}
 	}
 
-	busyDeadline_ = TickClock::now() + std::chrono::milliseconds{writeTimeoutMs_};
+	// low-level driver finishes write transfer only after the card stops signalling busy after the last block, so
+	// successful single block write leaves the card in transfer (tran) state - no need to poll it with CMD13
+	transferState_ = blocks == 1 && ret == 0;
+	if (transferState_ == false)
+		busyDeadline_ = TickClock::now() + std::chrono::milliseconds{writeTimeoutMs_};
 
 	return ret;
 }
@@ -1631,6 +1742,74 @@ void SdCard::deinitialize()
 	readTimeoutMs_ = {};
 	writeTimeoutMs_ = {};
 	blockAddressing_ = {};
+	discardSupport_ = {};
+	transferState_ = {};
+}
+
+int SdCard::eraseImplementation(const uint64_t address, const uint64_t size, const bool discard)
+{
+	assert(address % blockSize == 0 && size % blockSize == 0);
+
+	const auto firstBlock = address / blockSize;
+	const auto blocks = size / blockSize;
+	assert(firstBlock + blocks <= blocksCount_);
+
+	if (size == 0)
+		return {};
+
+	uint64_t erased {};
+	while (erased < size)
+	{
+		{
+			const auto ret = waitWhileBusy();
+			if (ret != 0)
+				return ret;
+		}
+
+		const auto beginAddress = address + erased;
+		// erase no more than 1 AU at a time
+		const auto endAddress = std::min(address + size, beginAddress / auSize_ * auSize_ + auSize_);
+
+		{
+			int ret;
+			R1Response r1Response;
+			const auto commandAddress = blockAddressing_ == true ? beginAddress / blockSize : beginAddress;
+			std::tie(ret, r1Response) = executeCmd32(sdCard_, commandAddress);
+			if (ret != 0)
+				return ret;
+			if (r1Response.isError() == true)
+				return EIO;
+		}
+		{
+			int ret;
+			R1Response r1Response;
+			const auto commandAddress = blockAddressing_ == true ? (endAddress - blockSize) / blockSize :
+					(endAddress - blockSize);
+			std::tie(ret, r1Response) = executeCmd33(sdCard_, commandAddress);
+			if (ret != 0)
+				return ret;
+			if (r1Response.isError() == true)
+				return EIO;
+		}
+		{
+			int ret;
+			R1Response r1Response;
+			std::tie(ret, r1Response) = executeCmd38(sdCard_, discard);
+			if (ret != 0)
+				return ret;
+			if (r1Response.isError() == true)
+				return EIO;
+		}
+
+		erased += endAddress - beginAddress;
+
+		const auto beginPartial = beginAddress % auSize_ != 0;
+		const auto endPartial = endAddress % auSize_ != 0;
+		busyDeadline_ = TickClock::now() + std::chrono::milliseconds{eraseTimeoutMs_} +
+				std::chrono::milliseconds{250} * (beginPartial + endPartial);
+	}
+
+	return {};
 }
 
 int SdCard::initialize()
@@ -1691,6 +1870,7 @@ int SdCard::initialize()
 		rca_ = r6Response.getRca();
 	}
 
+	uint16_t ccc;
 	{
 		int ret;
 		Csd csd;
@@ -1698,6 +1878,8 @@ int SdCard::initialize()
 		if (ret != 0)
 			return ret;
 
+		ccc = csd.getCcc();
+
 		const auto csdStructure = csd.getCsdStructure();
 		if (csdStructure == 0)	// CSD version 1.0
 		{
@@ -1746,7 +1928,12 @@ int SdCard::initialize()
 	{
 		const auto busMode =
 				_4BitBusMode_ == false ? SdMmcCardLowLevel::BusMode::_1Bit : SdMmcCardLowLevel::BusMode::_4Bit;
-		sdCard_.configure(busMode, maxClockFrequency_);
+		sdCard_.configure(busMode, std::min(maxClockFrequency_, defaultSpeedMaxClockFrequency));
+
+		// failure to switch to high speed mode is not fatal - card stays in default speed mode
+		if (maxClockFrequency_ > defaultSpeedMaxClockFrequency && (ccc & switchCommandClass) != 0 &&
+				switchToHighSpeed(sdCard_, readTimeoutMs_) == 0)
+			sdCard_.configure(busMode, std::min(maxClockFrequency_, highSpeedMaxClockFrequency));
 	}
 
 	if (blockAddressing_ == false)
@@ -1797,11 +1984,24 @@ int SdCard::initialize()
 		assert(auSize - 1u < sizeof(auSizeAssociation) / sizeof(*auSizeAssociation));
 		auSize_ = auSizeAssociation[auSize - 1u];
 		eraseTimeoutMs_ = std::max(eraseTimeout * 1000 / eraseSize + sdStatus.getEraseOffset() * 1000, 1000);
+		discardSupport_ = sdStatus.getDiscardSupport();
 	}
 
 	return {};
 }
 
+int SdCard::waitWhileBusy()
+{
+	if (transferState_ == true)
+	{
+		// state of the card is unknown after the operation which follows this call
+		transferState_ = false;
+		return {};
+	}
+
+	return waitForTransferState(sdCard_, rca_, busyDeadline_);
+}
+
 }	// namespace devices
 
 }	// namespace distortos
@@ -20,6 +20,7 @@
 
 #include "estd/ScopeGuard.hpp"
 
+#include <algorithm>
 #include <mutex>
 
 #include <cstring>
@@ -265,6 +266,9 @@ constexpr uint32_t ocrCcsMask {1 << 30};
 /// ACMD41 argument - HCS bit position
 constexpr uint8_t acmd41HcsPosition {30};
 
+/// max number of bytes clocked in single poll of busy card
+constexpr size_t maxBusyPollSize {64};
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | local functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -425,21 +429,44 @@ std::pair<int, uint8_t> waitWhile(const SpiMasterHandle& spiMasterHandle, const
 /**
  * \brief Waits while SD card connected via SPI is busy.
  *
+ * Card keeps its output low while it is busy and releases it when it is done, so only the last byte clocked by each
+ * poll has to be checked. Polling uses an adaptive schedule - it starts with single byte (short busy periods are
+ * detected with minimal latency) and the number of bytes clocked by each subsequent poll is doubled up to
+ * maxBusyPollSize. The SPI clock is used as a fine-grained delay between checks, which reduces the number of
+ * transactions (and interrupts) during long busy periods, while the overshoot after the card stops being busy stays
+ * bounded.
+ *
  * \param [in] spiMasterHandle is a reference to SpiMasterHandle object used for communication
  * \param [in] duration is the duration of wait before giving up
  *
  * \return 0 on success, error code otherwise:
- * - error codes returned by waitWhile();
+ * - ETIMEDOUT - the wait could not be completed before the specified timeout expired;
+ * - error codes returned by SpiMasterHandle::executeTransaction();
  */
 
 int waitWhileBusy(const SpiMasterHandle& spiMasterHandle, const distortos::TickClock::duration duration)
 {
-	const auto ret = waitWhile(spiMasterHandle, duration,
-			[](const uint8_t& byte)
-			{
-				return byte != 0xff;
-			});
-	return ret.first;
+	const auto deadline = distortos::TickClock::now() + duration;
+	size_t pollSize {1};
+	while (distortos::TickClock::now() < deadline)
+	{
+		uint8_t byte;
+		const SpiMasterTransfer transfers[]
+		{
+				{nullptr, nullptr, pollSize - 1},
+				{nullptr, &byte, sizeof(byte)},
+		};
+		const auto ret = spiMasterHandle.executeTransaction(SpiMasterTransfersRange{pollSize == 1 ? transfers + 1 :
+				transfers, std::end(transfers)});
+		if (ret != 0)
+			return ret;
+		if (byte == 0xff)
+			return {};
+
+		pollSize = std::min(pollSize * 2, maxBusyPollSize);
+	}
+
+	return ETIMEDOUT;
 }
 
 /**
@@ -961,6 +988,7 @@ std::pair<int, uint8_t> executeCmd33(const SpiMasterHandle& spiMasterHandle, con
  * This is ERASE command.
  *
  * \param [in] spiMasterHandle is a reference to SpiMasterHandle object used for communication
+ * \param [in] discard selects whether the blocks will be erased (false) or discarded (true)
  * \param [in] duration is the duration of wait before giving up
  *
  * \return pair with return code (0 on success, error code otherwise) and R1 response; error codes:
@@ -968,10 +996,10 @@ std::pair<int, uint8_t> executeCmd33(const SpiMasterHandle& spiMasterHandle, con
  * - error codes returned by writeCmdReadR1();
  */
 
-std::pair<int, uint8_t> executeCmd38(const SpiMasterHandle& spiMasterHandle,
+std::pair<int, uint8_t> executeCmd38(const SpiMasterHandle& spiMasterHandle, const bool discard,
 		const distortos::TickClock::duration duration)
 {
-	const auto response = writeCmdReadR1(spiMasterHandle, 38);
+	const auto response = writeCmdReadR1(spiMasterHandle, 38, discard == true ? 1 : 0);
 	if (response.first != 0)
 		return response;
 
@@ -1175,68 +1203,25 @@ int SdCardSpiBased::close()
 	return {};
 }
 
-int SdCardSpiBased::erase(const uint64_t address, const uint64_t size)
+int SdCardSpiBased::discard(const uint64_t address, const uint64_t size)
 {
 	const std::lock_guard<Mutex> lockGuard {mutex_};
 
 	assert(openCount_ != 0);
-	assert(address % blockSize == 0 && size % blockSize == 0);
 
-	const auto firstBlock = address / blockSize;
-	const auto blocks = size / blockSize;
-	assert(firstBlock + blocks <= blocksCount_);
-
-	if (size == 0)
+	if (discardSupport_ == false)
 		return {};
 
-	const SpiMasterHandle spiMasterHandle {spiMaster_};
-	spiMasterHandle.configure(SpiMode::_0, clockFrequency_, 8, false, UINT32_MAX);
-
-	uint64_t erased {};
-	while (erased < size)
-	{
-		const auto beginAddress = address + erased;
-		// erase no more than 1 AU at a time
-		const auto endAddress = std::min(address + size, beginAddress / auSize_ * auSize_ + auSize_);
-
-		{
-			const SelectGuard selectGuard {slaveSelectPin_ ,spiMasterHandle};
-
-			const auto commandAddress = blockAddressing_ == true ? beginAddress / blockSize : beginAddress;
-			const auto ret = executeCmd32(spiMasterHandle, commandAddress);
-			if (ret.first != 0)
-				return ret.first;
-			if (ret.second != 0)
-				return EIO;
-		}
-		{
-			const SelectGuard selectGuard {slaveSelectPin_ ,spiMasterHandle};
-
-			const auto commandAddress = blockAddressing_ == true ? (endAddress - blockSize) / blockSize :
-					(endAddress - blockSize);
-			const auto ret = executeCmd33(spiMasterHandle, commandAddress);
-			if (ret.first != 0)
-				return ret.first;
-			if (ret.second != 0)
-				return EIO;
-		}
-		{
-			const SelectGuard selectGuard {slaveSelectPin_ ,spiMasterHandle};
+	return eraseImplementation(address, size, true);
+}
 
-			const auto beginPartial = beginAddress % auSize_ != 0;
-			const auto endPartial = endAddress % auSize_ != 0;
-			const auto ret = executeCmd38(spiMasterHandle, std::chrono::milliseconds{eraseTimeoutMs_} +
-					std::chrono::milliseconds{250} * (beginPartial + endPartial));
-			if (ret.first != 0)
-				return ret.first;
-			if (ret.second != 0)
-				return EIO;
-		}
+int SdCardSpiBased::erase(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
 
-		erased += endAddress - beginAddress;
-	}
+	assert(openCount_ != 0);
 
-	return {};
+	return eraseImplementation(address, size, false);
 }
 
 size_t SdCardSpiBased::getBlockSize() const
@@ -1444,6 +1429,68 @@ void SdCardSpiBased::deinitialize()
 	readTimeoutMs_ = {};
 	writeTimeoutMs_ = {};
 	blockAddressing_ = {};
+	discardSupport_ = {};
+}
+
+int SdCardSpiBased::eraseImplementation(const uint64_t address, const uint64_t size, const bool discard)
+{
+	assert(address % blockSize == 0 && size % blockSize == 0);
+
+	const auto firstBlock = address / blockSize;
+	const auto blocks = size / blockSize;
+	assert(firstBlock + blocks <= blocksCount_);
+
+	if (size == 0)
+		return {};
+
+	const SpiMasterHandle spiMasterHandle {spiMaster_};
+	spiMasterHandle.configure(SpiMode::_0, clockFrequency_, 8, false, UINT32_MAX);
+
+	uint64_t erased {};
+	while (erased < size)
+	{
+		const auto beginAddress = address + erased;
+		// erase no more than 1 AU at a time
+		const auto endAddress = std::min(address + size, beginAddress / auSize_ * auSize_ + auSize_);
+
+		{
+			const SelectGuard selectGuard {slaveSelectPin_ ,spiMasterHandle};
+
+			const auto commandAddress = blockAddressing_ == true ? beginAddress / blockSize : beginAddress;
+			const auto ret = executeCmd32(spiMasterHandle, commandAddress);
+			if (ret.first != 0)
+				return ret.first;
+			if (ret.second != 0)
+				return EIO;
+		}
+		{
+			const SelectGuard selectGuard {slaveSelectPin_ ,spiMasterHandle};
+
+			const auto commandAddress = blockAddressing_ == true ? (endAddress - blockSize) / blockSize :
+					(endAddress - blockSize);
+			const auto ret = executeCmd33(spiMasterHandle, commandAddress);
+			if (ret.first != 0)
+				return ret.first;
+			if (ret.second != 0)
+				return EIO;
+		}
+		{
+			const SelectGuard selectGuard {slaveSelectPin_ ,spiMasterHandle};
+
+			const auto beginPartial = beginAddress % auSize_ != 0;
+			const auto endPartial = endAddress % auSize_ != 0;
+			const auto ret = executeCmd38(spiMasterHandle, discard, std::chrono::milliseconds{eraseTimeoutMs_} +
+					std::chrono::milliseconds{250} * (beginPartial + endPartial));
+			if (ret.first != 0)
+				return ret.first;
+			if (ret.second != 0)
+				return EIO;
+		}
+
+		erased += endAddress - beginAddress;
+	}
+
+	return {};
 }
 
 int SdCardSpiBased::initialize()
@@ -1597,6 +1644,7 @@ int SdCardSpiBased::initialize()
 		auSize_ = auSizeAssociation[sdStatus.auSize - 1u];
 		eraseTimeoutMs_ =
 				std::max(sdStatus.eraseTimeout * 1000 / sdStatus.eraseSize + sdStatus.eraseOffset * 1000, 1000);
+		discardSupport_ = sdStatus.discardSupport != 0;
 	}
 
 	return 0;
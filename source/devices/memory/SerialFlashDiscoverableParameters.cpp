@@ -0,0 +1,1013 @@
+/**
+ * \file
+ * \brief SerialFlashDiscoverableParameters class implementation
+ *
+ * \author Copyright (C) 2020 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/devices/memory/SerialFlashDiscoverableParameters.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/ThisThread.hpp"
+
+#include "estd/EnumClassFlags.hpp"
+#include "estd/extractBitField.hpp"
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+
+#include <cerrno>
+
+namespace estd
+{
+
+/// \brief Enable bitwise operators for distortos::devices::SerialFlashDiscoverableParameters::AddressFlags
+template<>
+struct isEnumClassFlags<distortos::devices::SerialFlashDiscoverableParameters::AddressFlags> : std::true_type
+{
+
+};
+
+/// \brief Enable bitwise operators for distortos::devices::SerialFlashDiscoverableParameters::SoftwareResetFlags
+template<>
+struct isEnumClassFlags<distortos::devices::SerialFlashDiscoverableParameters::SoftwareResetFlags> : std::true_type
+{
+
+};
+
+}	// namespace estd
+
+namespace distortos
+{
+
+namespace devices
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// import SerialFlashDiscoverableParameters::AddressFlags
+using AddressFlags = SerialFlashDiscoverableParameters::AddressFlags;
+
+/// import SerialFlashDiscoverableParameters::BasicFlashParameters
+using BasicFlashParameters = SerialFlashDiscoverableParameters::BasicFlashParameters;
+
+/// import SerialFlashDiscoverableParameters::CommandExecutor
+using CommandExecutor = SerialFlashDiscoverableParameters::CommandExecutor;
+
+/// single DWORD of SFDP
+using Dword = uint32_t;
+
+/// import SerialFlashDiscoverableParameters::QuadEnableRequirements
+using QuadEnableRequirements = SerialFlashDiscoverableParameters::QuadEnableRequirements;
+
+/// import SerialFlashDiscoverableParameters::SectorMap
+using SectorMap = SerialFlashDiscoverableParameters::SectorMap;
+
+/// import SerialFlashDiscoverableParameters::SoftwareResetFlags
+using SoftwareResetFlags = SerialFlashDiscoverableParameters::SoftwareResetFlags;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Extracts a bit field from array of DWORDs.
+ *
+ * \tparam dword is the index of starting DWORD
+ * \tparam index is the index of starting bit in selected DWORD
+ * \tparam size is the size of bit field to extract, bits
+ * \tparam Ret is the type of returned value, default - fixed width type with at least \a size bits
+ * \tparam arraySize is the number of elements in \a array, default - deduced from argument
+ *
+ * \param [in] array is a reference to array with raw DWORDs from which the bit field will be extracted
+ *
+ * \return bit field extracted from \a array
+ */
+
+template<size_t dword, size_t index, size_t size, typename Ret = estd::TypeFromSize<(size + CHAR_BIT - 1) / CHAR_BIT>,
+		size_t arraySize>
+inline static Ret extractBitField(const std::array<Dword, arraySize>& array)
+{
+	return estd::extractBitField<dword * sizeof(Dword) * CHAR_BIT + index, size>(array);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// first DWORD of Configuration Detection Command Descriptor
+class ConfigurationDetectionCommandDescriptor
+{
+public:
+
+	/// type of raw data with first DWORD of Configuration Detection Command Descriptor
+	using RawData = std::array<Dword, 1>;
+
+	/**
+	 * \brief ConfigurationDetectionCommandDescriptor's constructor
+	 *
+	 * \param [in] rawData is the raw data with first DWORD of Configuration Detection Command Descriptor
+	 */
+
+	constexpr explicit ConfigurationDetectionCommandDescriptor(const RawData rawData) :
+			rawData_{rawData}
+	{
+
+	}
+
+	/**
+	 * \return value of Address Length bit field
+	 */
+
+	uint8_t getAddressLength() const
+	{
+		return extractBitField<0, 22, 2>(rawData_);
+	}
+
+	/**
+	 * \return value of Instruction bit field
+	 */
+
+	uint8_t getInstruction() const
+	{
+		return extractBitField<0, 8, 8>(rawData_);
+	}
+
+	/**
+	 * \return value of Read Data Mask bit field
+	 */
+
+	uint8_t getReadDataMask() const
+	{
+		return extractBitField<0, 24, 8>(rawData_);
+	}
+
+	/**
+	 * \return value of Read Latency bit field
+	 */
+
+	uint8_t getReadLatency() const
+	{
+		return extractBitField<0, 16, 4>(rawData_);
+	}
+
+	/**
+	 * \return value of Sequence End Indicator bit field
+	 */
+
+	uint8_t getSequenceEndIndicator() const
+	{
+		return extractBitField<0, 0, 1>(rawData_);
+	}
+
+private:
+
+	/// raw data with first DWORD of Configuration Detection Command Descriptor
+	RawData rawData_;
+};
+
+/// Configuration Map Descriptor Header
+class ConfigurationMapDescriptorHeader
+{
+public:
+
+	/// type of raw data with Configuration Map Descriptor Header
+	using RawData = std::array<Dword, 1>;
+
+	/**
+	 * \brief ConfigurationMapDescriptorHeader's constructor
+	 *
+	 * \param [in] rawData is the raw data with Configuration Map Descriptor Header
+	 */
+
+	constexpr explicit ConfigurationMapDescriptorHeader(const RawData rawData) :
+			rawData_{rawData}
+	{
+
+	}
+
+	/**
+	 * \return value of Configuration ID bit field
+	 */
+
+	uint8_t getConfigurationId() const
+	{
+		return extractBitField<0, 8, 8>(rawData_);
+	}
+
+	/**
+	 * \return value of Region Count bit field
+	 */
+
+	uint8_t getRegionCount() const
+	{
+		return extractBitField<0, 16, 8>(rawData_);
+	}
+
+	/**
+	 * \return value of Sequence End Indicator bit field
+	 */
+
+	uint8_t getSequenceEndIndicator() const
+	{
+		return extractBitField<0, 0, 1>(rawData_);
+	}
+
+private:
+
+	/// raw data with Configuration Map Descriptor Header
+	RawData rawData_;
+};
+
+/// Parameter Header
+class ParameterHeader
+{
+public:
+
+	/// type of raw data with Parameter Header
+	using RawData = std::array<Dword, 2>;
+
+	/**
+	 * \brief ParameterHeader's constructor
+	 */
+
+	constexpr ParameterHeader() :
+			rawData_{}
+	{
+
+	}
+
+	/**
+	 * \brief ParameterHeader's constructor
+	 *
+	 * \param [in] rawData is the raw data with Parameter Header
+	 */
+
+	constexpr explicit ParameterHeader(const RawData rawData) :
+			rawData_{rawData}
+	{
+
+	}
+
+	/**
+	 * \return value of ID bit field
+	 */
+
+	uint16_t getId() const
+	{
+		const uint16_t msb = extractBitField<1, 24, 8>(rawData_);
+		const uint16_t lsb = extractBitField<0, 0, 8>(rawData_);
+		return msb << CHAR_BIT | lsb << 0;
+	}
+
+	/**
+	 * \return value of Table Length bit field
+	 */
+
+	uint8_t getTableLength() const
+	{
+		return extractBitField<0, 24, 8>(rawData_);
+	}
+
+	/**
+	 * \return value of Table Pointer bit field
+	 */
+
+	uint32_t getTablePointer() const
+	{
+		return extractBitField<1, 0, 24>(rawData_);
+	}
+
+	/**
+	 * \return value of Table Revision Number bit field
+	 */
+
+	uint16_t getTableRevisionNumber() const
+	{
+		return extractBitField<0, 8, 16>(rawData_);
+	}
+
+private:
+
+	/// raw data with Parameter Header
+	RawData rawData_;
+};
+
+/// Region
+class Region
+{
+public:
+
+	/// type of raw data with Region
+	using RawData = std::array<Dword, 1>;
+
+	/**
+	 * \brief Region's constructor
+	 *
+	 * \param [in] rawData is the raw data with Region
+	 */
+
+	constexpr explicit Region(const RawData rawData) :
+			rawData_{rawData}
+	{
+
+	}
+
+	/**
+	 * \return value of Erase Types bit field
+	 */
+
+	uint8_t getEraseTypes() const
+	{
+		return extractBitField<0, 0, 4>(rawData_);
+	}
+
+	/**
+	 * \return value of Size bit field
+	 */
+
+	uint32_t getSize() const
+	{
+		return extractBitField<0, 8, 24>(rawData_);
+	}
+
+private:
+
+	/// raw data with Region
+	RawData rawData_;
+};
+
+/// Sector Map Descriptor
+class SectorMapDescriptor
+{
+public:
+
+	/// type of raw data with Sector Map Descriptor
+	using RawData = std::array<Dword, 1>;
+
+	/**
+	 * \brief SectorMapDescriptor's constructor
+	 *
+	 * \param [in] rawData is the raw data with Sector Map Descriptor
+	 */
+
+	constexpr explicit SectorMapDescriptor(const RawData rawData) :
+			rawData_{rawData}
+	{
+
+	}
+
+	/**
+	 * \return first DWORD of Configuration Detection Command Descriptor, valid only if Type equals 0
+	 */
+
+	ConfigurationDetectionCommandDescriptor getConfigurationDetectionCommandDescriptor() const
+	{
+		return ConfigurationDetectionCommandDescriptor{rawData_};
+	}
+
+	/**
+	 * \return Configuration Map Descriptor Header, valid only if Type equals 1
+	 */
+
+	ConfigurationMapDescriptorHeader getConfigurationMapDescriptorHeader() const
+	{
+		return ConfigurationMapDescriptorHeader{rawData_};
+	}
+
+	/**
+	 * \return value of Sequence End Indicator bit field
+	 */
+
+	uint8_t getSequenceEndIndicator() const
+	{
+		return extractBitField<0, 0, 1>(rawData_);
+	}
+
+	/**
+	 * \return value of Type bit field
+	 */
+
+	uint8_t getType() const
+	{
+		return extractBitField<0, 1, 1>(rawData_);
+	}
+
+private:
+
+	/// raw data with Sector Map Descriptor
+	RawData rawData_;
+};
+
+/// SFDP Header
+class SfdpHeader
+{
+public:
+
+	/// expected SFDP header's signature
+	constexpr static Dword expectedSignature {Dword{'S'} << 0 * CHAR_BIT | Dword{'F'} << 1 * CHAR_BIT |
+			Dword{'D'} << 2 * CHAR_BIT | Dword{'P'} << 3 * CHAR_BIT};
+
+	/// type of raw data with SFDP Header
+	using RawData = std::array<Dword, 2>;
+
+	/**
+	 * \brief SfdpHeader's constructor
+	 */
+
+	constexpr SfdpHeader() :
+			rawData_{}
+	{
+
+	}
+
+	/**
+	 * \brief SfdpHeader's constructor
+	 *
+	 * \param [in] rawData is the raw data with SFDP Header
+	 */
+
+	constexpr explicit SfdpHeader(const RawData rawData) :
+			rawData_{rawData}
+	{
+
+	}
+
+	/**
+	 * \return value of Number of Parameter Headers (NPH) bit field
+	 */
+
+	uint8_t getNumberOfParameterHeaders() const
+	{
+		return extractBitField<1, 16, 8>(rawData_);
+	}
+
+	/**
+	 * \return value of Revision Number bit field
+	 */
+
+	uint16_t getRevisionNumber() const
+	{
+		return extractBitField<1, 0, 16>(rawData_);
+	}
+
+	/**
+	 * \return value of Signature bit field
+	 */
+
+	uint32_t getSignature() const
+	{
+		return extractBitField<0, 0, 32>(rawData_);
+	}
+
+private:
+
+	/// raw data with SFDP Header
+	RawData rawData_;
+};
+
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Executes RSFDP command.
+ *
+ * \param [in] commandExecutor is a reference to object used to execute commands
+ * \param [in] address is the address for the command
+ * \param [out] buffer is the buffer for data that will be read
+ * \param [in] size is the size of \a buffer
+ *
+ * \return 0 on success, error code otherwise:
+ * - error codes returned by CommandExecutor::executeReadCommand();
+ */
+
+int executeRsfdp(CommandExecutor& commandExecutor, const uint32_t address, void* const buffer, const size_t size)
+{
+	return commandExecutor.executeReadCommand(0x5a, address, 3, 8, buffer, size);
+}
+
+/**
+ * \brief Reads one Parameter Header.
+ *
+ * \param [in] commandExecutor is a reference to object used to execute commands
+ * \param [in] index is the index of parameter header that will be read
+ *
+ * \return pair with return code (0 on success, error code otherwise) and Parameter Header; error codes:
+ * - error codes returned by executeRsfdp();
+ */
+
+std::pair<int, ParameterHeader> readParameterHeader(CommandExecutor& commandExecutor, const uint8_t index)
+{
+	ParameterHeader::RawData rawParameterHeader;
+	const auto ret = executeRsfdp(commandExecutor, sizeof(Dword[2]) * (index + 1), rawParameterHeader.data(),
+			sizeof(rawParameterHeader));
+	return {ret, ParameterHeader{rawParameterHeader}};
+}
+
+/**
+ * \brief Reads Basic Flash and Sector Map parameter headers.
+ *
+ * \param [in] commandExecutor is a reference to object used to execute commands
+ * \param [in] numberOfParameterHeaders is the number of parameter headers available
+ *
+ * \return tuple with return code (0 on success, error code otherwise), Basic Flash and Sector Map parameter headers;
+ * error codes:
+ * - error codes returned by readParameterHeader();
+ */
+
+std::tuple<int, ParameterHeader, ParameterHeader> readParameterHeaders(CommandExecutor& commandExecutor,
+		const uint8_t numberOfParameterHeaders)
+{
+	ParameterHeader basicFlashParameterHeader {};
+	ParameterHeader sectorMapParameterHeader {};
+	for (size_t index {}; index < numberOfParameterHeaders; ++index)
+	{
+		int ret;
+		ParameterHeader parameterHeader;
+		std::tie(ret, parameterHeader) = readParameterHeader(commandExecutor, index);
+		if (ret != 0)
+			return std::make_tuple(ret, ParameterHeader{}, ParameterHeader{});
+
+		const auto revisionNumber = parameterHeader.getTableRevisionNumber();
+		if ((revisionNumber & 0xff00) != 0x0100)	// ignore if major revision number is not 1
+			continue;
+
+		const auto id = parameterHeader.getId();
+		if (id == 0xff00 && basicFlashParameterHeader.getTableRevisionNumber() < revisionNumber)
+			basicFlashParameterHeader = parameterHeader;
+		if (id == 0xff81 && sectorMapParameterHeader.getTableRevisionNumber() < revisionNumber)
+			sectorMapParameterHeader = parameterHeader;
+	}
+
+	return std::make_tuple(int{}, basicFlashParameterHeader, sectorMapParameterHeader);
+}
+
+/**
+ * \brief Reads SFDP Header.
+ *
+ * \param [in] commandExecutor is a reference to object used to execute commands
+ *
+ * \return pair with return code (0 on success, error code otherwise) and SFDP Header; error codes:
+ * - error codes returned by executeRsfdp();
+ */
+
+std::pair<int, SfdpHeader> readSfdpHeader(CommandExecutor& commandExecutor)
+{
+	SfdpHeader::RawData rawSfdpHeader;
+	const auto ret = executeRsfdp(commandExecutor, {}, rawSfdpHeader.data(), sizeof(rawSfdpHeader));
+	return {ret, SfdpHeader{rawSfdpHeader}};
+}
+
+/**
+ * \brief Parses Basic Flash Parameter Table.
+ *
+ * \param [in] commandExecutor is a reference to object used to execute commands
+ * \param [in] header is a reference to Basic Flash parameter header
+ *
+ * \return pair with return code (0 on success, error code otherwise) and parsed basic flash parameters; error codes:
+ * - ENOTSUP - Basic Flash Parameter Table is invalid and cannot be parsed;
+ * - error codes returned by executeRsfdp();
+ */
+
+std::pair<int, BasicFlashParameters> parseBasicFlashParameterTable(CommandExecutor& commandExecutor,
+		const ParameterHeader& header)
+{
+	const auto revision = header.getTableRevisionNumber();
+	using RevisionExpectedLength = std::pair<uint16_t, uint8_t>;	// revision + expected length
+	static const RevisionExpectedLength expectedLengths[]
+	{
+			{0x0107, 20},	// JESD216C & JESD216D (revision 1.7)
+			{0x0106, 16},	// JESD216B (revision 1.6)
+			{0x0105, 16},	// JESD216A (revision 1.5)
+			{0x0100, 9},	// JESD216 (revision 1.0)
+	};
+	const auto iterator = std::find_if(std::begin(expectedLengths), std::end(expectedLengths),
+			[&revision](const RevisionExpectedLength& entry)
+			{
+				return revision >= entry.first;
+			});
+	assert(iterator != std::end(expectedLengths));
+	const auto expectedLengthDwords = iterator->second;
+	const auto lengthDwords = header.getTableLength();
+	if (lengthDwords < expectedLengthDwords)
+		return {ENOTSUP, {}};
+
+	std::array<Dword, 20> basicFlashParameterTable;
+	{
+		const auto ret = executeRsfdp(commandExecutor, header.getTablePointer(), basicFlashParameterTable.data(),
+				lengthDwords * sizeof(Dword));
+		if (ret != 0)
+			return {ret, {}};
+	}
+
+	BasicFlashParameters basicFlashParameters {};
+
+	// JESD216 (revision 1.0) and above - first 9 DWORDs
+
+	const auto writeGranularity = extractBitField<0, 2, 1>(basicFlashParameterTable);
+	basicFlashParameters.pageSize = writeGranularity == 0 ? 1 : 64;
+
+	const auto addressBytes = extractBitField<0, 17, 2>(basicFlashParameterTable);
+	if (addressBytes == 3)
+		return {ENOTSUP, {}};
+
+	basicFlashParameters.addressFlags = addressBytes == 0 ? AddressFlags::_3 :
+		addressBytes == 1 ? AddressFlags::_3 | AddressFlags::_4 : AddressFlags::_4;
+
+	const auto flashMemoryDensity = basicFlashParameterTable[1];
+	if ((flashMemoryDensity & (1 << 31)) == 0)
+		basicFlashParameters.size = (flashMemoryDensity + 1) / CHAR_BIT;
+	else
+	{
+		const auto n = flashMemoryDensity & ~(1 << 31);
+		if (n < 32 || n >= sizeof(basicFlashParameters.size) * CHAR_BIT)
+			return {ENOTSUP, {}};
+		basicFlashParameters.size = 1 << n;
+	}
+
+	if (extractBitField<0, 22, 1>(basicFlashParameterTable) != 0)
+	{
+		basicFlashParameters.fastRead114.instruction = extractBitField<2, 24, 8>(basicFlashParameterTable);
+		basicFlashParameters.fastRead114.dummyCycles = extractBitField<2, 16, 5>(basicFlashParameterTable);
+		basicFlashParameters.fastRead114.modeCycles = extractBitField<2, 21, 3>(basicFlashParameterTable);
+	}
+	if (extractBitField<0, 21, 1>(basicFlashParameterTable) != 0)
+	{
+		basicFlashParameters.fastRead144.instruction = extractBitField<2, 8, 8>(basicFlashParameterTable);
+		basicFlashParameters.fastRead144.dummyCycles = extractBitField<2, 0, 5>(basicFlashParameterTable);
+		basicFlashParameters.fastRead144.modeCycles = extractBitField<2, 5, 3>(basicFlashParameterTable);
+	}
+
+	basicFlashParameters.eraseInstructions[0] = extractBitField<7, 8, 8>(basicFlashParameterTable);
+	basicFlashParameters.eraseInstructions[1] = extractBitField<7, 24, 8>(basicFlashParameterTable);
+	basicFlashParameters.eraseInstructions[2] = extractBitField<8, 8, 8>(basicFlashParameterTable);
+	basicFlashParameters.eraseInstructions[3] = extractBitField<8, 24, 8>(basicFlashParameterTable);
+
+	const uint8_t eraseSizes[BasicFlashParameters::maxEraseTypes]
+	{
+			extractBitField<7, 0, 8>(basicFlashParameterTable),
+			extractBitField<7, 16, 8>(basicFlashParameterTable),
+			extractBitField<8, 0, 8>(basicFlashParameterTable),
+			extractBitField<8, 16, 8>(basicFlashParameterTable),
+	};
+	for (size_t i {}; i < BasicFlashParameters::maxEraseTypes; ++i)
+		if (eraseSizes[i] != 0)
+		{
+			if (eraseSizes[i] >= sizeof(basicFlashParameters.eraseSizes[i]) * CHAR_BIT)
+				return {ENOTSUP, {}};
+			basicFlashParameters.eraseSizes[i] = 1 << eraseSizes[i];
+		}
+
+	if (revision <= 0x0100)
+	{
+		basicFlashParameters.quadEnableRequirements = QuadEnableRequirements::unknown;
+		return {{}, basicFlashParameters};
+	}
+
+	// JESD216A (revision 1.5) and above - first 16 DWORDs
+
+	const auto typicalEraseTimeDecoder =
+			[](const uint8_t count, const uint8_t units)
+			{
+				const auto decodedUnits = std::chrono::milliseconds{units == 0 ? 1 :
+						units == 1 ? 16 :
+						units == 2 ? 128 : 1000};
+				return (count + 1) * decodedUnits;
+			};
+
+	const auto maximumEraseTimeMultiplierCount = extractBitField<9, 0, 4>(basicFlashParameterTable);
+	const auto maximumEraseTimeMultiplier = 2 * (maximumEraseTimeMultiplierCount + 1);
+	const uint8_t typicalEraseTimeCounts[BasicFlashParameters::maxEraseTypes]
+	{
+			extractBitField<9, 4, 5>(basicFlashParameterTable),
+			extractBitField<9, 11, 5>(basicFlashParameterTable),
+			extractBitField<9, 18, 5>(basicFlashParameterTable),
+			extractBitField<9, 25, 5>(basicFlashParameterTable),
+	};
+	const uint8_t typicalEraseTimeUnits[BasicFlashParameters::maxEraseTypes]
+	{
+			extractBitField<9, 9, 2>(basicFlashParameterTable),
+			extractBitField<9, 16, 2>(basicFlashParameterTable),
+			extractBitField<9, 23, 2>(basicFlashParameterTable),
+			extractBitField<9, 30, 2>(basicFlashParameterTable),
+	};
+	for (size_t i {}; i < BasicFlashParameters::maxEraseTypes; ++i)
+		if (basicFlashParameters.eraseSizes[i] != 0)
+		{
+			const auto typicalEraseTime = typicalEraseTimeDecoder(typicalEraseTimeCounts[i], typicalEraseTimeUnits[i]);
+			basicFlashParameters.maximumEraseTimesMs[i] = typicalEraseTime.count() * maximumEraseTimeMultiplier;
+		}
+
+	const auto pageSize = extractBitField<10, 4, 4>(basicFlashParameterTable);
+	basicFlashParameters.pageSize = 1 << pageSize;
+
+	const auto typicalChipEraseTimeCount = extractBitField<10, 24, 5>(basicFlashParameterTable);
+	const auto typicalChipEraseTimeUnits = extractBitField<10, 29, 2>(basicFlashParameterTable);
+	const auto typicalChipEraseTime = (typicalChipEraseTimeCount + 1) * std::chrono::milliseconds{
+			typicalChipEraseTimeUnits == 0 ? 16 :
+			typicalChipEraseTimeUnits == 1 ? 256 :
+			typicalChipEraseTimeUnits == 2 ? 4000 : 64000};
+	basicFlashParameters.maximumChipEraseTimeMs = typicalChipEraseTime.count() * maximumEraseTimeMultiplier;
+
+	const auto quadEnableRequirements = extractBitField<14, 20, 3>(basicFlashParameterTable);
+	basicFlashParameters.quadEnableRequirements = quadEnableRequirements < 7 ?
+			static_cast<QuadEnableRequirements>(quadEnableRequirements) : QuadEnableRequirements::unknown;
+
+	basicFlashParameters.softwareResetFlags =
+			static_cast<SoftwareResetFlags>(extractBitField<15, 8, 6>(basicFlashParameterTable));
+
+	return {{}, basicFlashParameters};
+};
+
+/**
+ * \brief Parses Sector Map Table.
+ *
+ * \param [in] commandExecutor is a reference to object used to execute commands
+ * \param [in] header is a reference to Sector Map parameter header
+ *
+ * \return pair with return code (0 on success, error code otherwise) and parsed sector map; error codes:
+ * - ENOTSUP - Sector Map Table is invalid and cannot be parsed;
+ * - error codes returned by CommandExecutor::executeReadCommand();
+ * - error codes returned by executeRsfdp();
+ */
+
+std::pair<int, SectorMap> parseSectorMapTable(CommandExecutor& commandExecutor, const ParameterHeader& header)
+{
+	auto address = header.getTablePointer();
+	const auto addressEnd = address + header.getTableLength() * sizeof(Dword);
+	uint8_t selectedConfigurationId {};
+
+	auto reader =
+			[&address, addressEnd, &commandExecutor](void* const buffer, const size_t size) -> int
+			{
+				if (address >= addressEnd)
+					return ENOTSUP;
+				const auto ret = executeRsfdp(commandExecutor, address, buffer, size);
+				address += size;
+				return ret;
+			};
+
+	while (address < addressEnd)
+	{
+		SectorMapDescriptor::RawData rawSectorMapDescriptor;
+		{
+			const auto ret = reader(rawSectorMapDescriptor.data(), sizeof(rawSectorMapDescriptor));
+			if (ret != 0)
+				return {ret, {}};
+		}
+		SectorMapDescriptor sectorMapDescriptor {rawSectorMapDescriptor};
+
+		if (sectorMapDescriptor.getType() == 0)	// configuration detection command descriptor
+		{
+			const auto configurationDetectionCommandDescriptor =
+					sectorMapDescriptor.getConfigurationDetectionCommandDescriptor();
+
+			const auto readLatency = configurationDetectionCommandDescriptor.getReadLatency();
+			if (readLatency != 0 && readLatency != CHAR_BIT)
+				return {ENOTSUP, {}};
+
+			Dword commandAddress;
+			{
+				const auto ret = reader(&commandAddress, sizeof(commandAddress));
+				if (ret != 0)
+					return {ret, {}};
+			}
+
+			const auto instruction = configurationDetectionCommandDescriptor.getInstruction();
+			const auto addressLength = configurationDetectionCommandDescriptor.getAddressLength();
+			const auto decodedAddressLength = addressLength == 0 ? 0 :
+					addressLength == 2 ? 4 : 3;
+
+			uint8_t byte;
+			{
+				const auto ret = commandExecutor.executeReadCommand(instruction, commandAddress, decodedAddressLength,
+						readLatency, &byte, sizeof(byte));
+				if (ret != 0)
+					return {ret, {}};
+			}
+			const auto readDataMask = configurationDetectionCommandDescriptor.getReadDataMask();
+			const auto bit = (byte & readDataMask) != 0;
+			selectedConfigurationId = selectedConfigurationId << 1 | bit;
+		}
+		else	// configuration map descriptor
+		{
+			const auto configurationMapDescriptorHeader = sectorMapDescriptor.getConfigurationMapDescriptorHeader();
+
+			const uint8_t configurationId = configurationMapDescriptorHeader.getConfigurationId();
+			const auto regionCount = configurationMapDescriptorHeader.getRegionCount() + 1u;
+			if (configurationId != selectedConfigurationId)
+			{
+				address += regionCount * sizeof(Region::RawData);
+				continue;
+			}
+
+			SectorMap sectorMap;
+			if (regionCount > sectorMap.maxRegionCount)
+				return {ENOTSUP, {}};
+
+			for (size_t i {}; i < regionCount; ++i)
+			{
+				Region::RawData rawRegion;
+				{
+					const auto ret = reader(rawRegion.data(), sizeof(rawRegion));
+					if (ret != 0)
+						return {ret, {}};
+				}
+
+				Region region {rawRegion};
+				sectorMap.sizes[i] = (static_cast<uint64_t>(region.getSize()) + 1) * 256;
+				sectorMap.eraseTypes[i] = region.getEraseTypes();
+			}
+
+			sectorMap.regionCount = regionCount;
+			return {{}, sectorMap};
+		}
+	}
+
+	return {ENOTSUP, {}};
+}
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void SerialFlashDiscoverableParameters::clear()
+{
+	basicFlashParameters_ = {};
+	sectorMap_ = {};
+	commonEraseIndex_ = {};
+}
+
+size_t SerialFlashDiscoverableParameters::getEraseBlockSize() const
+{
+	assert(commonEraseIndex_ < BasicFlashParameters::maxEraseTypes);
+	return basicFlashParameters_.eraseSizes[commonEraseIndex_];
+}
+
+int SerialFlashDiscoverableParameters::parse(CommandExecutor& commandExecutor)
+{
+	ParameterHeader sectorMapParameterHeader;
+
+	{
+		uint8_t numberOfParameterHeaders;
+		{
+			int ret;
+			SfdpHeader sfdpHeader;
+			std::tie(ret, sfdpHeader) = readSfdpHeader(commandExecutor);
+			if (ret != 0)
+				return ret;
+			if (sfdpHeader.getSignature() != SfdpHeader::expectedSignature)
+				return ENOTSUP;
+			if ((sfdpHeader.getRevisionNumber() & 0xff00) != 0x0100 || sfdpHeader.getNumberOfParameterHeaders() == 255)
+				return ENOTSUP;
+
+			numberOfParameterHeaders = sfdpHeader.getNumberOfParameterHeaders() + 1;
+		}
+
+		ParameterHeader basicFlashParameterHeader;
+		{
+			int ret;
+			std::tie(ret, basicFlashParameterHeader, sectorMapParameterHeader) =
+					readParameterHeaders(commandExecutor, numberOfParameterHeaders);
+			if (ret != 0)
+				return ret;
+		}
+		{
+			int ret;
+			std::tie(ret, basicFlashParameters_) = parseBasicFlashParameterTable(commandExecutor,
+					basicFlashParameterHeader);
+			if (ret != 0)
+				return ret;
+		}
+
+		if (basicFlashParameters_.size > 1 << (3 * CHAR_BIT))	/// \todo add support for 4-byte addressing
+			return ENOTSUP;
+		if ((basicFlashParameters_.addressFlags & AddressFlags::_3) == AddressFlags{})	// as above
+			return ENOTSUP;
+		if (basicFlashParameters_.softwareResetFlags == SoftwareResetFlags{})	/// \todo handle unknown soft reset
+			return ENOTSUP;
+
+		if ((basicFlashParameters_.softwareResetFlags & SoftwareResetFlags::_0xf0) != SoftwareResetFlags{})
+		{
+			const auto ret = commandExecutor.executeCommand(0xf0, {}, {});
+			if (ret != 0)
+				return ret;
+		}
+		else if ((basicFlashParameters_.softwareResetFlags & SoftwareResetFlags::_0x66_0x99) != SoftwareResetFlags{})
+		{
+			{
+				const auto ret = commandExecutor.executeCommand(0x66, {}, {});
+				if (ret != 0)
+					return ret;
+			}
+			{
+				const auto ret = commandExecutor.executeCommand(0x99, {}, {});
+				if (ret != 0)
+					return ret;
+			}
+		}
+	}
+
+	{
+		const auto deadline = TickClock::now() + std::chrono::milliseconds{100};
+		while (1)
+		{
+			int ret;
+			SfdpHeader sfdpHeader {};
+			std::tie(ret, sfdpHeader) = readSfdpHeader(commandExecutor);
+			if (ret != 0)
+				return ret;
+			if (sfdpHeader.getSignature() == SfdpHeader::expectedSignature)
+				break;
+			if (deadline <= TickClock::now())
+				return ETIMEDOUT;
+
+			ThisThread::sleepFor({});
+		}
+	}
+
+	{
+		int ret;
+		std::tie(ret, sectorMap_) = parseSectorMapTable(commandExecutor, sectorMapParameterHeader);
+		if (ret != 0)
+			return ret;
+	}
+
+	uint8_t commonEraseTypes {0xf};
+	for (size_t i {}; i < sectorMap_.regionCount; ++i)
+		commonEraseTypes &= sectorMap_.eraseTypes[i];
+
+	if (commonEraseTypes == 0)
+		return ENOTSUP;
+
+	size_t commonEraseSize {SIZE_MAX};
+	for (size_t i {}; i < BasicFlashParameters::maxEraseTypes; ++i)
+	{
+		if ((commonEraseTypes & (1 << i)) == 0)
+			continue;
+		if (basicFlashParameters_.eraseSizes[i] == 0)
+			return ENOTSUP;
+		if (commonEraseSize > basicFlashParameters_.eraseSizes[i])
+		{
+			commonEraseSize = basicFlashParameters_.eraseSizes[i];
+			commonEraseIndex_ = i;
+		}
+	}
+
+	return {};
+}
+
+uint8_t SerialFlashDiscoverableParameters::selectEraseType(const uint64_t address, const uint64_t size) const
+{
+	// without sector map all erase types are supported in the whole address space
+	uint8_t eraseTypes {0xf};
+	uint64_t regionEnd {basicFlashParameters_.size};
+	{
+		uint64_t regionBegin {};
+		for (size_t i {}; i < sectorMap_.regionCount; ++i)
+		{
+			if (address - regionBegin < sectorMap_.sizes[i])
+			{
+				eraseTypes = sectorMap_.eraseTypes[i];
+				regionEnd = regionBegin + sectorMap_.sizes[i];
+				break;
+			}
+
+			regionBegin += sectorMap_.sizes[i];
+		}
+	}
+
+	// erase type with smallest size is supported in each region, so it is always a valid choice
+	auto eraseIndex = commonEraseIndex_;
+	for (uint8_t i {}; i < BasicFlashParameters::maxEraseTypes; ++i)
+	{
+		if ((eraseTypes & (1 << i)) == 0)
+			continue;
+
+		const auto eraseSize = basicFlashParameters_.eraseSizes[i];
+		if (eraseSize <= basicFlashParameters_.eraseSizes[eraseIndex] || address % eraseSize != 0 ||
+				eraseSize > size || address + eraseSize > regionEnd)
+			continue;
+
+		eraseIndex = i;
+	}
+
+	return eraseIndex;
+}
+
+}	// namespace devices
+
+}	// namespace distortos
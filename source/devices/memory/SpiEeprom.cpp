@@ -58,6 +58,9 @@ constexpr uint8_t writeCommand {0x2};
 /// mask of WIP (write in progress) bit in status register
 constexpr uint8_t statusRegisterWip {1 << 0};
 
+/// duration of initial polling of status register without sleeping, typical write finishes in less than that
+constexpr TickClock::duration busyPollingDuration {2};
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | local functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -245,6 +248,17 @@ std::pair<int, size_t> SpiEeprom::eraseOrWritePage(const uint32_t address, const
 	const auto capacity = getSize();
 	assert(address < capacity);
 
+	// prepare transfers while previous write may still be in progress
+	const auto pageSize = getPageSize();
+	const auto pageOffset = address & (pageSize - 1);
+	const auto writeSize = pageOffset + size <= pageSize ? size : pageSize - pageOffset;
+	CommandWithAddressBuffer commandBuffer;
+	const SpiMasterTransfer transfers[]
+	{
+			getCommandWithAddress(capacity, writeCommand, address, commandBuffer),
+			{buffer, nullptr, writeSize},
+	};
+
 	{
 		const auto ret = waitWhileWriteInProgress();
 		if (ret != 0)
@@ -256,16 +270,6 @@ std::pair<int, size_t> SpiEeprom::eraseOrWritePage(const uint32_t address, const
 			return {ret, {}};
 	}
 
-	const auto pageSize = getPageSize();
-
-	const auto pageOffset = address & (pageSize - 1);
-	const auto writeSize = pageOffset + size <= pageSize ? size : pageSize - pageOffset;
-	CommandWithAddressBuffer commandBuffer;
-	const SpiMasterTransfer transfers[]
-	{
-			getCommandWithAddress(capacity, writeCommand, address, commandBuffer),
-			{buffer, nullptr, writeSize},
-	};
 	const auto ret = executeTransaction(SpiMasterTransfersRange{transfers});
 	return {ret, writeSize};
 }
@@ -297,11 +301,18 @@ std::pair<int, uint8_t> SpiEeprom::readStatusRegister() const
 
 int SpiEeprom::waitWhileWriteInProgress()
 {
+	const auto pollingDeadline = TickClock::now() + busyPollingDuration;
 	decltype(isWriteInProgress().first) ret;
 	decltype(isWriteInProgress().second) writeInProgress;
 	while (std::tie(ret, writeInProgress) = isWriteInProgress(), ret == 0 && writeInProgress == true)
 	{
-		const auto sleepForRet = ThisThread::sleepFor(std::chrono::milliseconds{1});
+		if (TickClock::now() < pollingDeadline)
+		{
+			ThisThread::yield();
+			continue;
+		}
+
+		const auto sleepForRet = ThisThread::sleepFor({});
 		if (sleepForRet != 0)
 			return sleepForRet;
 	}
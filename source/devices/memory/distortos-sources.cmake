@@ -8,10 +8,14 @@
 #
 
 target_sources(distortos PRIVATE
+		${CMAKE_CURRENT_LIST_DIR}/AsynchronousBlockDevice.cpp
+		${CMAKE_CURRENT_LIST_DIR}/BlockDeviceRequest.cpp
 		${CMAKE_CURRENT_LIST_DIR}/BlockDeviceToMemoryTechnologyDevice.cpp
 		${CMAKE_CURRENT_LIST_DIR}/BufferingBlockDevice.cpp
+		${CMAKE_CURRENT_LIST_DIR}/CachingBlockDevice.cpp
 		${CMAKE_CURRENT_LIST_DIR}/QspiNorFlashSpiBased.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SdCard.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SdCardSpiBased.cpp
+		${CMAKE_CURRENT_LIST_DIR}/SerialFlashDiscoverableParameters.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SpiEeprom.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SynchronousSdMmcCardLowLevel.cpp)
@@ -0,0 +1,64 @@
+/**
+ * \file
+ * \brief BasicTask class implementation
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/BasicTask.hpp"
+
+#include "distortos/BasicTaskRunner.hpp"
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+BasicTask::~BasicTask()
+{
+	cancel();
+}
+
+int BasicTask::activate()
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (node.isLinked() == true)
+		return EBUSY;
+
+	const auto ret = basicTaskRunner_.semaphore_.post();
+	if (ret != 0)
+		return ret;
+
+	basicTaskRunner_.activatedList_.push_back(*this);
+	return 0;
+}
+
+int BasicTask::cancel()
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (node.isLinked() == false)
+		return EALREADY;
+
+	// semaphore's value is not decremented here - BasicTaskRunner::run() ignores spurious wake-ups
+	node.unlink();
+	return 0;
+}
+
+bool BasicTask::isActivated() const
+{
+	const InterruptMaskingLock interruptMaskingLock;
+	return node.isLinked();
+}
+
+}	// namespace distortos
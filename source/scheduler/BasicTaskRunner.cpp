@@ -0,0 +1,53 @@
+/**
+ * \file
+ * \brief BasicTaskRunner class implementation
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/BasicTaskRunner.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+BasicTaskRunner::~BasicTaskRunner()
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	while (activatedList_.empty() == false)
+		activatedList_.pop_front();
+}
+
+void BasicTaskRunner::run()
+{
+	while (1)
+	{
+		semaphore_.wait();
+
+		BasicTask* basicTask {};
+
+		{
+			const InterruptMaskingLock interruptMaskingLock;
+
+			if (activatedList_.empty() == true)	// activation was cancelled?
+				continue;
+
+			basicTask = &activatedList_.front();
+			activatedList_.pop_front();
+		}
+
+		basicTask->run();
+	}
+}
+
+}	// namespace distortos
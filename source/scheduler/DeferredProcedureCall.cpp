@@ -0,0 +1,68 @@
+/**
+ * \file
+ * \brief getDeferredProcedureCallRunner() implementation and thread for deferred procedure calls
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/DeferredProcedureCall.hpp"
+
+#ifdef DISTORTOS_DEFERRED_PROCEDURE_CALLS_ENABLE
+
+#include "distortos/BIND_LOW_LEVEL_INITIALIZER.h"
+#include "distortos/StaticBasicTaskRunner.hpp"
+
+namespace distortos
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// type of runner of deferred procedure calls
+using DeferredProcedureCallRunner = StaticBasicTaskRunner<DISTORTOS_DEFERRED_PROCEDURE_CALL_THREAD_STACK_SIZE>;
+
+/// storage for runner of deferred procedure calls
+std::aligned_storage<sizeof(DeferredProcedureCallRunner), alignof(DeferredProcedureCallRunner)>::type
+		deferredProcedureCallRunnerStorage;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Low-level initializer of runner of deferred procedure calls
+ *
+ * This function is called before constructors for global and static objects via BIND_LOW_LEVEL_INITIALIZER().
+ */
+
+void deferredProcedureCallRunnerLowLevelInitializer()
+{
+	auto& deferredProcedureCallRunner =
+			*new (&deferredProcedureCallRunnerStorage) DeferredProcedureCallRunner {deferredProcedureCallPriority};
+	deferredProcedureCallRunner.start();
+}
+
+BIND_LOW_LEVEL_INITIALIZER(25, deferredProcedureCallRunnerLowLevelInitializer);
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+BasicTaskRunner& getDeferredProcedureCallRunner()
+{
+	return reinterpret_cast<DeferredProcedureCallRunner&>(deferredProcedureCallRunnerStorage);
+}
+
+}	// namespace distortos
+
+#endif	// def DISTORTOS_DEFERRED_PROCEDURE_CALLS_ENABLE
@@ -296,6 +296,25 @@ void Scheduler::unblock(const ThreadList::iterator iterator, const UnblockReason
 	maybeRequestContextSwitch();
 }
 
+void Scheduler::unblockAll(ThreadList& container, const UnblockReason unblockReason)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	// unblock hooks must be executed when the threads are already removed from their container
+	ThreadList unblockedList;
+	unblockedList.swap(container);
+
+	for (auto& threadControlBlock : unblockedList)
+	{
+		threadControlBlock.setList(&runnableList_);
+		threadControlBlock.setState(ThreadState::runnable);
+		threadControlBlock.unblockHook(unblockReason);
+	}
+
+	runnableList_.merge(unblockedList);
+	maybeRequestContextSwitch();
+}
+
 void Scheduler::yield()
 {
 	const InterruptMaskingLock interruptMaskingLock;
@@ -329,10 +348,11 @@ int Scheduler::blockInternal(ThreadList& container, const ThreadList::iterator i
 	if (threadControlBlock.getList() != &runnableList_)
 		return EINVAL;
 
+	// block hook deactivates preemption threshold, so it must be called before the thread is inserted into sorted list
+	threadControlBlock.blockHook(unblockFunctor);
 	container.splice(iterator);
 	threadControlBlock.setList(&container);
 	threadControlBlock.setState(state);
-	threadControlBlock.blockHook(unblockFunctor);
 
 	return 0;
 }
@@ -63,6 +63,7 @@ ThreadControlBlock::ThreadControlBlock(internal::Stack&& stack, const uint8_t pr
 				unblockFunctor_{},
 				roundRobinQuantum_{},
 				schedulingPolicy_{schedulingPolicy},
+				preemptionThreshold_{},
 				state_{ThreadState::created}
 {
 	_REENT_INIT_PTR(&reent_);
@@ -86,6 +87,7 @@ ThreadControlBlock::ThreadControlBlock(internal::Stack&& stack, const uint8_t pr
 				unblockFunctor_{},
 				roundRobinQuantum_{},
 				schedulingPolicy_{schedulingPolicy},
+				preemptionThreshold_{},
 				state_{ThreadState::created}
 {
 	_REENT_INIT_PTR(&reent_);
@@ -141,6 +143,28 @@ void ThreadControlBlock::setPriority(const uint8_t priority, const bool alwaysBe
 		priorityInheritanceMutexControlBlock_->getOwner()->updateBoostedPriority();
 }
 
+void ThreadControlBlock::setPreemptionThreshold(const uint8_t preemptionThreshold)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	preemptionThreshold_ = preemptionThreshold;
+
+	if (state_ != ThreadState::runnable ||
+			(activePreemptionThreshold_ == 0 && &getScheduler().getCurrentThreadControlBlock() != this))
+		return;
+
+	const auto oldEffectivePriority = getEffectivePriority();
+	activePreemptionThreshold_ = preemptionThreshold;
+	const auto newEffectivePriority = getEffectivePriority();
+
+	if (oldEffectivePriority == newEffectivePriority)
+		return;
+
+	const auto loweringBefore = newEffectivePriority < oldEffectivePriority;
+
+	reposition(loweringBefore);
+}
+
 void ThreadControlBlock::setSchedulingPolicy(const SchedulingPolicy schedulingPolicy)
 {
 	const InterruptMaskingLock interruptMaskingLock;
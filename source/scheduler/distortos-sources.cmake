@@ -8,6 +8,9 @@
 #
 
 target_sources(distortos PRIVATE
+		${CMAKE_CURRENT_LIST_DIR}/BasicTask.cpp
+		${CMAKE_CURRENT_LIST_DIR}/BasicTaskRunner.cpp
+		${CMAKE_CURRENT_LIST_DIR}/DeferredProcedureCall.cpp
 		${CMAKE_CURRENT_LIST_DIR}/DynamicSoftwareTimer.cpp
 		${CMAKE_CURRENT_LIST_DIR}/forceContextSwitch.cpp
 		${CMAKE_CURRENT_LIST_DIR}/getScheduler.cpp
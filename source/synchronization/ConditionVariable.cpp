@@ -30,8 +30,7 @@ void ConditionVariable::notifyAll()
 {
 	const InterruptMaskingLock interruptMaskingLock;
 
-	while (blockedList_.empty() == false)
-		internal::getScheduler().unblock(blockedList_.begin());
+	internal::getScheduler().unblockAll(blockedList_);
 }
 
 void ConditionVariable::notifyOne()
@@ -107,6 +107,16 @@ SignalSet DynamicThread::getPendingSignalSet() const
 
 #endif	// DISTORTOS_SIGNALS_ENABLE == 1
 
+uint8_t DynamicThread::getPreemptionThreshold() const
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (detachableThread_ == nullptr)
+		return {};
+
+	return detachableThread_->getPreemptionThreshold();
+}
+
 uint8_t DynamicThread::getPriority() const
 {
 	const InterruptMaskingLock interruptMaskingLock;
@@ -183,6 +193,16 @@ int DynamicThread::queueSignal(const uint8_t signalNumber, const sigval value)
 
 #endif	// DISTORTOS_SIGNALS_ENABLE == 1
 
+void DynamicThread::setPreemptionThreshold(const uint8_t preemptionThreshold)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (detachableThread_ == nullptr)
+		return;
+
+	detachableThread_->setPreemptionThreshold(preemptionThreshold);
+}
+
 void DynamicThread::setPriority(const uint8_t priority, const bool alwaysBehind)
 {
 	const InterruptMaskingLock interruptMaskingLock;
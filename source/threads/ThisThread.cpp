@@ -70,6 +70,13 @@ ThreadIdentifier getIdentifier()
 	return {threadControlBlock, threadControlBlock.getSequenceNumber()};
 }
 
+uint8_t getPreemptionThreshold()
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return internal::getScheduler().getCurrentThreadControlBlock().getPreemptionThreshold();
+}
+
 uint8_t getPriority()
 {
 	CHECK_FUNCTION_CONTEXT();
@@ -94,6 +101,13 @@ size_t getStackSize()
 	return get().getStackSize();
 }
 
+void setPreemptionThreshold(const uint8_t preemptionThreshold)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	internal::getScheduler().getCurrentThreadControlBlock().setPreemptionThreshold(preemptionThreshold);
+}
+
 void setPriority(const uint8_t priority, const bool alwaysBehind)
 {
 	CHECK_FUNCTION_CONTEXT();
@@ -86,6 +86,11 @@ SignalSet ThreadCommon::getPendingSignalSet() const
 
 #endif	// DISTORTOS_SIGNALS_ENABLE == 1
 
+uint8_t ThreadCommon::getPreemptionThreshold() const
+{
+	return getThreadControlBlock().getPreemptionThreshold();
+}
+
 uint8_t ThreadCommon::getPriority() const
 {
 	return getThreadControlBlock().getPriority();
@@ -137,6 +142,11 @@ int ThreadCommon::queueSignal(const uint8_t signalNumber, const sigval value)
 
 #endif	// DISTORTOS_SIGNALS_ENABLE == 1
 
+void ThreadCommon::setPreemptionThreshold(const uint8_t preemptionThreshold)
+{
+	getThreadControlBlock().setPreemptionThreshold(preemptionThreshold);
+}
+
 void ThreadCommon::setPriority(const uint8_t priority, const bool alwaysBehind)
 {
 	getThreadControlBlock().setPriority(priority, alwaysBehind);
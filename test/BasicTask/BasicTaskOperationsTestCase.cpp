@@ -0,0 +1,194 @@
+/**
+ * \file
+ * \brief BasicTaskOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "BasicTaskOperationsTestCase.hpp"
+
+#include "SequenceAsserter.hpp"
+#include "waitForNextTick.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/StaticBasicTask.hpp"
+#include "distortos/StaticBasicTaskRunner.hpp"
+#include "distortos/StaticSoftwareTimer.hpp"
+
+#include <array>
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// TestBasicTask is a basic task which marks a sequence point when executed
+class TestBasicTask : public BasicTask
+{
+public:
+
+	/**
+	 * \brief TestBasicTask's constructor
+	 *
+	 * \param [in] basicTaskRunner is a reference to BasicTaskRunner which will execute this basic task
+	 * \param [in] sequenceAsserter is a reference to SequenceAsserter shared by all basic tasks
+	 * \param [in] sequencePoint is the sequence point of this basic task
+	 */
+
+	constexpr TestBasicTask(BasicTaskRunner& basicTaskRunner, SequenceAsserter& sequenceAsserter,
+			const unsigned int sequencePoint) :
+					BasicTask{basicTaskRunner},
+					sequenceAsserter_{sequenceAsserter},
+					sequencePoint_{sequencePoint}
+	{
+
+	}
+
+private:
+
+	/**
+	 * \brief Marks sequence point.
+	 */
+
+	void run() override
+	{
+		sequenceAsserter_.sequencePoint(sequencePoint_);
+	}
+
+	/// reference to SequenceAsserter shared by all basic tasks
+	SequenceAsserter& sequenceAsserter_;
+
+	/// sequence point of this basic task
+	unsigned int sequencePoint_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of stack of basic task runner, bytes
+constexpr size_t runnerStackSize {512};
+
+/// priority of basic task runner - higher than priority of main test thread
+constexpr uint8_t runnerPriority {UINT8_MAX};
+
+/// number of basic tasks used in test
+constexpr size_t totalBasicTasks {8};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// basic task runner used in test, started once and reused in all following runs of the test case
+StaticBasicTaskRunner<runnerStackSize> runner {runnerPriority};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool BasicTaskOperationsTestCase::run_() const
+{
+	if (runner.getThread().getState() == ThreadState::created && runner.start() != 0)
+		return false;
+
+	{
+		SequenceAsserter sequenceAsserter;
+		std::array<TestBasicTask, totalBasicTasks> basicTasks
+		{{
+				{runner, sequenceAsserter, 7},
+				{runner, sequenceAsserter, 6},
+				{runner, sequenceAsserter, 5},
+				{runner, sequenceAsserter, 4},
+				{runner, sequenceAsserter, 3},
+				{runner, sequenceAsserter, 2},
+				{runner, sequenceAsserter, 1},
+				{runner, sequenceAsserter, 0},
+		}};
+
+		{
+			const InterruptMaskingLock interruptMaskingLock;
+
+			// activate in reverse order - basic tasks must be executed in the order of activation
+			for (auto iterator = basicTasks.rbegin(); iterator != basicTasks.rend(); ++iterator)
+				if (iterator->activate() != 0)
+					return false;
+
+			for (auto& basicTask : basicTasks)
+				if (basicTask.isActivated() != true || basicTask.activate() != EBUSY)
+					return false;
+
+			if (sequenceAsserter.assertSequence(0) == false)
+				return false;
+		}
+
+		// runner has higher priority, so all basic tasks must be executed immediately after interrupts are unmasked
+		if (sequenceAsserter.assertSequence(totalBasicTasks) == false)
+			return false;
+
+		for (const auto& basicTask : basicTasks)
+			if (basicTask.isActivated() != false)
+				return false;
+	}
+
+	{
+		SequenceAsserter sequenceAsserter;
+		TestBasicTask cancelledBasicTask {runner, sequenceAsserter, 1};
+		TestBasicTask basicTask {runner, sequenceAsserter, 0};
+
+		{
+			const InterruptMaskingLock interruptMaskingLock;
+
+			if (cancelledBasicTask.activate() != 0 || basicTask.activate() != 0)
+				return false;
+
+			if (cancelledBasicTask.cancel() != 0 || cancelledBasicTask.cancel() != EALREADY)
+				return false;
+		}
+
+		if (sequenceAsserter.assertSequence(1) == false)
+			return false;
+	}
+
+	{
+		SequenceAsserter sequenceAsserter;
+		TestBasicTask basicTask {runner, sequenceAsserter, 0};
+		auto softwareTimer = makeStaticSoftwareTimer(&BasicTask::activate, std::ref(basicTask));
+
+		waitForNextTick();
+
+		softwareTimer.start(TickClock::duration{});
+
+		if (sequenceAsserter.assertSequence(0) == false)
+			return false;
+
+		while (softwareTimer.isRunning() == true)
+		{
+
+		}
+
+		if (sequenceAsserter.assertSequence(1) == false)
+			return false;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
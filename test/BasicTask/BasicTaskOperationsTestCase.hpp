@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief BasicTaskOperationsTestCase class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_BASICTASK_BASICTASKOPERATIONSTESTCASE_HPP_
+#define TEST_BASICTASK_BASICTASKOPERATIONSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests various basic task operations.
+ *
+ * Activates several basic tasks (from thread and from software timer) assigned to one runner, asserting that they are
+ * executed in the order of activation. Tests repeated activation and cancellation of activated basic task.
+ */
+
+class BasicTaskOperationsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_BASICTASK_BASICTASKOPERATIONSTESTCASE_HPP_
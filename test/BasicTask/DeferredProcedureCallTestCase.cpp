@@ -0,0 +1,76 @@
+/**
+ * \file
+ * \brief DeferredProcedureCallTestCase class implementation
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "DeferredProcedureCallTestCase.hpp"
+
+#include "distortos/DeferredProcedureCall.hpp"
+
+#ifdef DISTORTOS_DEFERRED_PROCEDURE_CALLS_ENABLE
+
+#include "SequenceAsserter.hpp"
+#include "waitForNextTick.hpp"
+
+#include "distortos/architecture/isInInterruptContext.hpp"
+
+#include "distortos/StaticSoftwareTimer.hpp"
+
+#endif	// def DISTORTOS_DEFERRED_PROCEDURE_CALLS_ENABLE
+
+namespace distortos
+{
+
+namespace test
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool DeferredProcedureCallTestCase::run_() const
+{
+#ifdef DISTORTOS_DEFERRED_PROCEDURE_CALLS_ENABLE
+
+	SequenceAsserter sequenceAsserter;
+	bool interruptContext {true};
+	auto deferredProcedureCall = makeDeferredProcedureCall(
+			[&sequenceAsserter, &interruptContext]()
+			{
+				interruptContext = architecture::isInInterruptContext();
+				sequenceAsserter.sequencePoint(1);
+			});
+	auto softwareTimer = makeStaticSoftwareTimer(
+			[&sequenceAsserter, &deferredProcedureCall]()
+			{
+				sequenceAsserter.sequencePoint(0);
+				deferredProcedureCall.activate();
+			});
+
+	waitForNextTick();
+
+	softwareTimer.start(TickClock::duration{});
+
+	while (softwareTimer.isRunning() == true)
+	{
+
+	}
+
+	// deferred procedure call must have been executed before main test thread was resumed
+	if (sequenceAsserter.assertSequence(2) == false || interruptContext != false)
+		return false;
+
+#endif	// def DISTORTOS_DEFERRED_PROCEDURE_CALLS_ENABLE
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief DeferredProcedureCallTestCase class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_BASICTASK_DEFERREDPROCEDURECALLTESTCASE_HPP_
+#define TEST_BASICTASK_DEFERREDPROCEDURECALLTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests deferred procedure calls.
+ *
+ * Activates deferred procedure call from software timer (interrupt context), asserting that it is executed before the
+ * main test thread is resumed. When support for deferred procedure calls is disabled, this test case does nothing.
+ */
+
+class DeferredProcedureCallTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_BASICTASK_DEFERREDPROCEDURECALLTESTCASE_HPP_
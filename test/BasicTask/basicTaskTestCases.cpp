@@ -0,0 +1,55 @@
+/**
+ * \file
+ * \brief basicTaskTestCases object definition
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "basicTaskTestCases.hpp"
+
+#include "BasicTaskOperationsTestCase.hpp"
+#include "DeferredProcedureCallTestCase.hpp"
+
+#include "TestCaseGroup.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// BasicTaskOperationsTestCase instance
+const BasicTaskOperationsTestCase operationsTestCase;
+
+/// DeferredProcedureCallTestCase instance
+const DeferredProcedureCallTestCase deferredProcedureCallTestCase;
+
+/// array with references to TestCase objects related to basic tasks
+const TestCaseGroup::Range::value_type basicTaskTestCases_[]
+{
+		TestCaseGroup::Range::value_type{operationsTestCase},
+		TestCaseGroup::Range::value_type{deferredProcedureCallTestCase},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const TestCaseGroup basicTaskTestCases {TestCaseGroup::Range{basicTaskTestCases_}};
+
+}	// namespace test
+
+}	// namespace distortos
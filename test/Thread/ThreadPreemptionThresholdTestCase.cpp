@@ -0,0 +1,125 @@
+/**
+ * \file
+ * \brief ThreadPreemptionThresholdTestCase class implementation
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "ThreadPreemptionThresholdTestCase.hpp"
+
+#include "SequenceAsserter.hpp"
+
+#include "distortos/DynamicThread.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <malloc.h>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {512};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Test thread
+ *
+ * Just marks the sequence point in SequenceAsserter.
+ *
+ * \param [in] sequenceAsserter is a reference to SequenceAsserter shared object
+ * \param [in] sequencePoint is the sequence point of this instance
+ */
+
+void thread(SequenceAsserter& sequenceAsserter, const unsigned int sequencePoint)
+{
+	sequenceAsserter.sequencePoint(sequencePoint);
+}
+
+/**
+ * \brief Makes and starts test thread
+ *
+ * \param [in] priority is the thread's priority
+ * \param [in] sequenceAsserter is a reference to SequenceAsserter shared object
+ * \param [in] sequencePoint is the sequence point of this instance
+ *
+ * \return constructed and started DynamicThread object
+ */
+
+DynamicThread makeAndStartTestThread(const uint8_t priority, SequenceAsserter& sequenceAsserter,
+		const unsigned int sequencePoint)
+{
+	return makeAndStartDynamicThread({testThreadStackSize, priority}, thread, std::ref(sequenceAsserter),
+			sequencePoint);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool ThreadPreemptionThresholdTestCase::run_() const
+{
+	const auto allocatedMemory = mallinfo().uordblks;
+
+	{
+		// difference required for this whole test to work
+		static_assert(testCasePriority_ <= UINT8_MAX - 3, "Invalid test case priority");
+
+		const auto thisThreadPriority = ThisThread::getPriority();
+		const decltype(thisThreadPriority) preemptionThreshold = thisThreadPriority + 2;
+
+		SequenceAsserter sequenceAsserter;
+
+		ThisThread::setPreemptionThreshold(preemptionThreshold);
+		const auto result1 = ThisThread::getPreemptionThreshold() == preemptionThreshold &&
+				ThisThread::getEffectivePriority() == preemptionThreshold;
+
+		// priority below preemption threshold - must not preempt current thread
+		auto lowPriorityThread = makeAndStartTestThread(thisThreadPriority + 1, sequenceAsserter, 1);
+		// priority above preemption threshold - must preempt current thread
+		auto highPriorityThread = makeAndStartTestThread(preemptionThreshold + 1, sequenceAsserter, 0);
+
+		// preemption threshold is still in effect after current thread was preempted
+		const auto result2 = sequenceAsserter.assertSequence(1);
+
+		// blocking deactivates preemption threshold, it is activated again when current thread is switched to
+		lowPriorityThread.join();
+		highPriorityThread.join();
+		const auto result3 = sequenceAsserter.assertSequence(2) &&
+				ThisThread::getEffectivePriority() == preemptionThreshold;
+
+		ThisThread::setPreemptionThreshold({});
+		const auto result4 = ThisThread::getPreemptionThreshold() == 0 &&
+				ThisThread::getEffectivePriority() == thisThreadPriority;
+
+		if (result1 == false || result2 == false || result3 == false || result4 == false)
+			return false;
+	}
+
+	if (mallinfo().uordblks != allocatedMemory)	// dynamic memory must be deallocated after each test phase
+		return false;
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
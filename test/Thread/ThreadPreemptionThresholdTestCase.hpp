@@ -0,0 +1,64 @@
+/**
+ * \file
+ * \brief ThreadPreemptionThresholdTestCase class header
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_THREAD_THREADPREEMPTIONTHRESHOLDTESTCASE_HPP_
+#define TEST_THREAD_THREADPREEMPTIONTHRESHOLDTESTCASE_HPP_
+
+#include "PrioritizedTestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests preemption threshold of thread.
+ *
+ * Raises preemption threshold of main test thread and starts two threads - one with priority below the threshold
+ * (which must not preempt main test thread) and one with priority above the threshold (which must preempt it). Then
+ * checks that blocking of main test thread allows the first thread to run and that the threshold is restored when main
+ * test thread is switched to again.
+ */
+
+class ThreadPreemptionThresholdTestCase : public PrioritizedTestCase
+{
+	/// priority at which this test case should be executed
+	constexpr static uint8_t testCasePriority_ {UINT8_MAX / 2};
+
+public:
+
+	/**
+	 * \brief ThreadPreemptionThresholdTestCase's constructor
+	 */
+
+	constexpr ThreadPreemptionThresholdTestCase() :
+			PrioritizedTestCase{testCasePriority_}
+	{
+
+	}
+
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_THREAD_THREADPREEMPTIONTHRESHOLDTESTCASE_HPP_
@@ -10,6 +10,7 @@
 target_sources(distortosTest PRIVATE
 		${CMAKE_CURRENT_LIST_DIR}/ThreadFunctionTypesTestCase.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ThreadOperationsTestCase.cpp
+		${CMAKE_CURRENT_LIST_DIR}/ThreadPreemptionThresholdTestCase.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ThreadPriorityChangeTestCase.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ThreadPriorityTestCase.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ThreadSchedulingPolicyTestCase.cpp
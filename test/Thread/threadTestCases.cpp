@@ -18,6 +18,7 @@
 #include "ThreadSleepUntilTestCase.hpp"
 #include "ThreadSchedulingPolicyTestCase.hpp"
 #include "ThreadPriorityChangeTestCase.hpp"
+#include "ThreadPreemptionThresholdTestCase.hpp"
 
 #include "TestCaseGroup.hpp"
 
@@ -55,6 +56,9 @@ const ThreadSchedulingPolicyTestCase schedulingPolicyTestCase;
 /// ThreadPriorityChangeTestCase instance
 const ThreadPriorityChangeTestCase priorityChangeTestCase;
 
+/// ThreadPreemptionThresholdTestCase instance
+const ThreadPreemptionThresholdTestCase preemptionThresholdTestCase;
+
 /// array with references to TestCase objects related to threads
 const TestCaseGroup::Range::value_type threadTestCases_[]
 {
@@ -65,6 +69,7 @@ const TestCaseGroup::Range::value_type threadTestCases_[]
 		TestCaseGroup::Range::value_type{sleepUntilTestCase},
 		TestCaseGroup::Range::value_type{schedulingPolicyTestCase},
 		TestCaseGroup::Range::value_type{priorityChangeTestCase},
+		TestCaseGroup::Range::value_type{preemptionThresholdTestCase},
 };
 
 }	// namespace
@@ -13,6 +13,7 @@
 
 #include "Thread/threadTestCases.hpp"
 #include "SoftwareTimer/softwareTimerTestCases.hpp"
+#include "BasicTask/basicTaskTestCases.hpp"
 #include "Semaphore/semaphoreTestCases.hpp"
 #include "Mutex/mutexTestCases.hpp"
 #include "ConditionVariable/conditionVariableTestCases.hpp"
@@ -41,6 +42,7 @@ const TestCaseGroup::Range::value_type testCases_[]
 {
 		TestCaseGroup::Range::value_type{threadTestCases},
 		TestCaseGroup::Range::value_type{softwareTimerTestCases},
+		TestCaseGroup::Range::value_type{basicTaskTestCases},
 		TestCaseGroup::Range::value_type{semaphoreTestCases},
 		TestCaseGroup::Range::value_type{mutexTestCases},
 		TestCaseGroup::Range::value_type{conditionVariableTestCases},
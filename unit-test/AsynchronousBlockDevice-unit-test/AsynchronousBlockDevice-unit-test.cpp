@@ -0,0 +1,194 @@
+/**
+ * \file
+ * \brief AsynchronousBlockDevice test cases
+ *
+ * This test checks whether AsynchronousBlockDevice queues and executes asynchronous requests properly and in correct
+ * order, and whether all other operations are forwarded to associated block device.
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "unit-test-common.hpp"
+
+#include "distortos/devices/memory/AsynchronousBlockDevice.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+using trompeloeil::_;
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+class BlockDevice : public distortos::devices::BlockDevice
+{
+public:
+
+	MAKE_MOCK0(close, int());
+	MAKE_MOCK2(discard, int(uint64_t, uint64_t));
+	MAKE_MOCK2(erase, int(uint64_t, uint64_t));
+	MAKE_CONST_MOCK0(getBlockSize, size_t());
+	MAKE_CONST_MOCK0(getSize, uint64_t());
+	MAKE_MOCK0(lock, void());
+	MAKE_MOCK0(open, int());
+	MAKE_MOCK3(read, int(uint64_t, void*, size_t));
+	MAKE_MOCK0(synchronize, int());
+	MAKE_MOCK0(unlock, void());
+	MAKE_MOCK3(write, int(uint64_t, const void*, size_t));
+};
+
+class BlockDeviceRequest : public distortos::devices::BlockDeviceRequest
+{
+public:
+
+	using distortos::devices::BlockDeviceRequest::BlockDeviceRequest;
+
+	MAKE_MOCK1(requestCompleteEvent, void(int), override);
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global test cases
++---------------------------------------------------------------------------------------------------------------------*/
+
+TEST_CASE("Testing forwarding of operations", "[forwarding]")
+{
+	BlockDevice blockDeviceMock;
+	distortos::mock::Mutex mutexMock {distortos::mock::Mutex::UnitTestTag{}};
+	trompeloeil::sequence sequence {};
+
+	ALLOW_CALL(mutexMock, lock()).RETURN(0);
+	ALLOW_CALL(mutexMock, unlock()).RETURN(0);
+
+	distortos::devices::AsynchronousBlockDevice asynchronousBlockDevice {blockDeviceMock};
+
+	uint8_t readBuffer[16];
+	const uint8_t writeBuffer[16] {};
+
+	REQUIRE_CALL(blockDeviceMock, open()).IN_SEQUENCE(sequence).RETURN(0x6a82a98e);
+	REQUIRE(asynchronousBlockDevice.open() == 0x6a82a98e);
+	// locking is not forwarded to associated block device
+	REQUIRE_CALL(mutexMock, lock()).IN_SEQUENCE(sequence).RETURN(0);
+	asynchronousBlockDevice.lock();
+	REQUIRE_CALL(blockDeviceMock, getBlockSize()).IN_SEQUENCE(sequence).RETURN(0x4b9d3c21);
+	REQUIRE(asynchronousBlockDevice.getBlockSize() == 0x4b9d3c21);
+	REQUIRE_CALL(blockDeviceMock, getSize()).IN_SEQUENCE(sequence).RETURN(0x3d6b3a2c8f51b9e7);
+	REQUIRE(asynchronousBlockDevice.getSize() == 0x3d6b3a2c8f51b9e7);
+	REQUIRE_CALL(blockDeviceMock, read(0x9e4c2a7f01b3d5e8, readBuffer, sizeof(readBuffer))).IN_SEQUENCE(sequence)
+			.RETURN(0x1cd0e5b7);
+	REQUIRE(asynchronousBlockDevice.read(0x9e4c2a7f01b3d5e8, readBuffer, sizeof(readBuffer)) == 0x1cd0e5b7);
+	REQUIRE_CALL(blockDeviceMock, write(0x58f2b4e19c0d7a36, writeBuffer, sizeof(writeBuffer))).IN_SEQUENCE(sequence)
+			.RETURN(0x72a1f04d);
+	REQUIRE(asynchronousBlockDevice.write(0x58f2b4e19c0d7a36, writeBuffer, sizeof(writeBuffer)) == 0x72a1f04d);
+	REQUIRE_CALL(blockDeviceMock, erase(0x0c6e3f98a5d2b147, 0x7b3e91c0f4a2d856)).IN_SEQUENCE(sequence)
+			.RETURN(0x2f8c61d9);
+	REQUIRE(asynchronousBlockDevice.erase(0x0c6e3f98a5d2b147, 0x7b3e91c0f4a2d856) == 0x2f8c61d9);
+	REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0x5ae70b13);
+	REQUIRE(asynchronousBlockDevice.synchronize() == 0x5ae70b13);
+	REQUIRE_CALL(mutexMock, unlock()).IN_SEQUENCE(sequence).RETURN(0);
+	asynchronousBlockDevice.unlock();
+	REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0x64b8d2f7);
+	REQUIRE(asynchronousBlockDevice.close() == 0x64b8d2f7);
+}
+
+TEST_CASE("Testing asynchronous requests", "[requests]")
+{
+	BlockDevice blockDeviceMock;
+	distortos::InterruptMaskingLock::Proxy interruptMaskingLockProxyMock {};
+	distortos::mock::Mutex mutexMock {distortos::mock::Mutex::UnitTestTag{}};
+	distortos::mock::Semaphore semaphoreMock {};
+	trompeloeil::sequence sequence {};
+
+	ALLOW_CALL(interruptMaskingLockProxyMock, construct());
+	ALLOW_CALL(interruptMaskingLockProxyMock, destruct());
+
+	distortos::devices::AsynchronousBlockDevice asynchronousBlockDevice {blockDeviceMock};
+
+	constexpr uint64_t readAddress {0x4b2e9f1c7d30a856};
+	uint8_t readBuffer[32];
+	constexpr uint64_t writeAddress {0x1f6d04c8b3a9e527};
+	const uint8_t writeBuffer[64] {};
+
+	distortos::Semaphore readSemaphore {0};
+	distortos::devices::BlockDeviceRequest readRequest {readAddress, readBuffer, sizeof(readBuffer), &readSemaphore};
+	BlockDeviceRequest writeRequest {writeAddress, writeBuffer, sizeof(writeBuffer)};
+
+	REQUIRE(readRequest.isPending() == false);
+	REQUIRE(readRequest.isWriteRequest() == false);
+	REQUIRE(writeRequest.isPending() == false);
+	REQUIRE(writeRequest.isWriteRequest() == true);
+
+	SECTION("Requests should be executed in the order of submission")
+	{
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(asynchronousBlockDevice.submitRequest(readRequest) == 0);
+		REQUIRE(readRequest.isPending() == true);
+		REQUIRE(readRequest.getResult() == EINPROGRESS);
+
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(asynchronousBlockDevice.submitRequest(writeRequest) == 0);
+		REQUIRE(writeRequest.isPending() == true);
+
+		// pending request cannot be submitted again
+		REQUIRE(asynchronousBlockDevice.submitRequest(readRequest) == EBUSY);
+		REQUIRE(asynchronousBlockDevice.submitRequest(writeRequest) == EBUSY);
+
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, read(readAddress, readBuffer, sizeof(readBuffer))).IN_SEQUENCE(sequence)
+				.RETURN(0);
+		// "request complete" event of read request posts its semaphore
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		asynchronousBlockDevice.executeNextRequest();
+		REQUIRE(readRequest.isPending() == false);
+		REQUIRE(readRequest.getResult() == 0);
+		REQUIRE(writeRequest.isPending() == true);
+
+		// interrupted wait should be repeated
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(EINTR);
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, write(writeAddress, writeBuffer, sizeof(writeBuffer))).IN_SEQUENCE(sequence)
+				.RETURN(EIO);
+		REQUIRE_CALL(writeRequest, requestCompleteEvent(EIO)).IN_SEQUENCE(sequence)
+				.LR_WITH(writeRequest.isPending() == false);
+		asynchronousBlockDevice.executeNextRequest();
+		REQUIRE(writeRequest.isPending() == false);
+		REQUIRE(writeRequest.getResult() == EIO);
+
+		// finished request can be submitted again
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(asynchronousBlockDevice.submitRequest(writeRequest) == 0);
+		REQUIRE(writeRequest.getResult() == EINPROGRESS);
+
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, write(writeAddress, writeBuffer, sizeof(writeBuffer))).IN_SEQUENCE(sequence)
+				.RETURN(0);
+		REQUIRE_CALL(writeRequest, requestCompleteEvent(0)).IN_SEQUENCE(sequence);
+		asynchronousBlockDevice.executeNextRequest();
+		REQUIRE(writeRequest.getResult() == 0);
+	}
+	SECTION("Default implementation of submitRequest() should execute the request synchronously")
+	{
+		REQUIRE_CALL(blockDeviceMock, write(writeAddress, writeBuffer, sizeof(writeBuffer))).IN_SEQUENCE(sequence)
+				.RETURN(ENOSPC);
+		REQUIRE_CALL(writeRequest, requestCompleteEvent(ENOSPC)).IN_SEQUENCE(sequence)
+				.LR_WITH(writeRequest.isPending() == false);
+		REQUIRE(blockDeviceMock.submitRequest(writeRequest) == 0);
+		REQUIRE(writeRequest.isPending() == false);
+		REQUIRE(writeRequest.getResult() == ENOSPC);
+
+		REQUIRE_CALL(blockDeviceMock, read(readAddress, readBuffer, sizeof(readBuffer))).IN_SEQUENCE(sequence)
+				.RETURN(0);
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(blockDeviceMock.submitRequest(readRequest) == 0);
+		REQUIRE(readRequest.isPending() == false);
+		REQUIRE(readRequest.getResult() == 0);
+	}
+}
@@ -30,6 +30,7 @@ class BlockDevice : public distortos::devices::BlockDevice
 public:
 
 	MAKE_MOCK0(close, int());
+	MAKE_MOCK2(discard, int(uint64_t, uint64_t));
 	MAKE_MOCK2(erase, int(uint64_t, uint64_t));
 	MAKE_CONST_MOCK0(getBlockSize, size_t());
 	MAKE_CONST_MOCK0(getSize, uint64_t());
@@ -152,11 +153,11 @@ TEST_CASE("Testing open() & close()", "[open/close]")
 		REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 		REQUIRE(bd2Mtd.close() == 0);
 
-		SECTION("Block device erase error should propagate error code to caller and close the device anyway")
+		SECTION("Block device discard error should propagate error code to caller and close the device anyway")
 		{
 			REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
 			constexpr int ret {0x591eb333};
-			REQUIRE_CALL(blockDeviceMock, erase(address, size)).IN_SEQUENCE(sequence).RETURN(ret);
+			REQUIRE_CALL(blockDeviceMock, discard(address, size)).IN_SEQUENCE(sequence).RETURN(ret);
 			REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0x65f8cf9c);
 			REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 			REQUIRE(bd2Mtd.close() == ret);
@@ -165,7 +166,7 @@ TEST_CASE("Testing open() & close()", "[open/close]")
 		{
 			REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
 			constexpr int ret {0x3fa5c9b0};
-			REQUIRE_CALL(blockDeviceMock, erase(address, size)).IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE_CALL(blockDeviceMock, discard(address, size)).IN_SEQUENCE(sequence).RETURN(0);
 			REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(ret);
 			REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 			REQUIRE(bd2Mtd.close() == ret);
@@ -173,7 +174,7 @@ TEST_CASE("Testing open() & close()", "[open/close]")
 		SECTION("Testing successful close")
 		{
 			REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
-			REQUIRE_CALL(blockDeviceMock, erase(address, size)).IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE_CALL(blockDeviceMock, discard(address, size)).IN_SEQUENCE(sequence).RETURN(0);
 			REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0);
 			REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 			REQUIRE(bd2Mtd.close() == 0);
@@ -284,7 +285,7 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 					SECTION("Synchronize should flush any pending erase")
 					{
 						REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
-						REQUIRE_CALL(blockDeviceMock, erase(steps[step].mergedAddress,
+						REQUIRE_CALL(blockDeviceMock, discard(steps[step].mergedAddress,
 								steps[step].mergedSize)).IN_SEQUENCE(sequence).RETURN(0);
 						REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
 						REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
@@ -298,13 +299,13 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 						REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
 						REQUIRE_CALL(blockDeviceMock, getBlockSize()).IN_SEQUENCE(sequence).RETURN(blockSize);
 						REQUIRE_CALL(blockDeviceMock, getSize()).IN_SEQUENCE(sequence).RETURN(deviceSize);
-						REQUIRE_CALL(blockDeviceMock, erase(steps[step].mergedAddress,
+						REQUIRE_CALL(blockDeviceMock, discard(steps[step].mergedAddress,
 								steps[step].mergedSize)).IN_SEQUENCE(sequence).RETURN(0);
 						REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 						REQUIRE(bd2Mtd.erase(address, size) == 0);
 
 						REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
-						REQUIRE_CALL(blockDeviceMock, erase(address, size)).IN_SEQUENCE(sequence).RETURN(0);
+						REQUIRE_CALL(blockDeviceMock, discard(address, size)).IN_SEQUENCE(sequence).RETURN(0);
 						REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
 						REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 						REQUIRE(bd2Mtd.synchronize() == 0);
@@ -362,8 +363,9 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 
 						if (steps[i].erasedSize0 != 0)
 						{
-							expectations.emplace_back(NAMED_REQUIRE_CALL(blockDeviceMock, erase(steps[i].erasedAddress0,
-									steps[i].erasedSize0)).IN_SEQUENCE(sequence).RETURN(0));
+							expectations.emplace_back(NAMED_REQUIRE_CALL(blockDeviceMock,
+									discard(steps[i].erasedAddress0, steps[i].erasedSize0)).IN_SEQUENCE(sequence)
+									.RETURN(0));
 						}
 
 						REQUIRE_CALL(blockDeviceMock, write(steps[i].writeAddress, buffer,
@@ -375,7 +377,7 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 					if (steps[step].erasedSize1 != 0)
 					{
 						REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
-						REQUIRE_CALL(blockDeviceMock, erase(steps[step].erasedAddress1,
+						REQUIRE_CALL(blockDeviceMock, discard(steps[step].erasedAddress1,
 								steps[step].erasedSize1)).IN_SEQUENCE(sequence).RETURN(0);
 						REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
 						REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
@@ -434,8 +436,9 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 
 						if (steps[i].erasedSize0 != 0)
 						{
-							expectations.emplace_back(NAMED_REQUIRE_CALL(blockDeviceMock, erase(steps[i].erasedAddress0,
-									steps[i].erasedSize0)).IN_SEQUENCE(sequence).RETURN(0));
+							expectations.emplace_back(NAMED_REQUIRE_CALL(blockDeviceMock,
+									discard(steps[i].erasedAddress0, steps[i].erasedSize0)).IN_SEQUENCE(sequence)
+									.RETURN(0));
 						}
 
 						REQUIRE_CALL(blockDeviceMock,
@@ -447,7 +450,7 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 					if (steps[step].erasedSize1 != 0)
 					{
 						REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
-						REQUIRE_CALL(blockDeviceMock, erase(steps[step].erasedAddress1,
+						REQUIRE_CALL(blockDeviceMock, discard(steps[step].erasedAddress1,
 								steps[step].erasedSize1)).IN_SEQUENCE(sequence).RETURN(0);
 						REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
 						REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
@@ -456,7 +459,7 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 				}
 			}
 		}
-		SECTION("Block device erase error should propagate error code to caller")
+		SECTION("Block device discard error should propagate error code to caller")
 		{
 			constexpr uint64_t address {0x6db03e9f7b1b51aa};
 			constexpr uint64_t size {0x70733f10};
@@ -471,7 +474,7 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 			{
 				REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
 				constexpr int ret {0x4ce2b62c};
-				REQUIRE_CALL(blockDeviceMock, erase(address, size)).IN_SEQUENCE(sequence).RETURN(ret);
+				REQUIRE_CALL(blockDeviceMock, discard(address, size)).IN_SEQUENCE(sequence).RETURN(ret);
 				REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 				REQUIRE(bd2Mtd.synchronize() == ret);
 			}
@@ -481,7 +484,7 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 				REQUIRE_CALL(blockDeviceMock, getBlockSize()).IN_SEQUENCE(sequence).RETURN(blockSize);
 				REQUIRE_CALL(blockDeviceMock, getSize()).IN_SEQUENCE(sequence).RETURN(deviceSize);
 				constexpr int ret {0x7ad1c3b0};
-				REQUIRE_CALL(blockDeviceMock, erase(address, size)).IN_SEQUENCE(sequence).RETURN(ret);
+				REQUIRE_CALL(blockDeviceMock, discard(address, size)).IN_SEQUENCE(sequence).RETURN(ret);
 				REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 				REQUIRE(bd2Mtd.erase(address + size + blockSize, size) == ret);
 			}
@@ -491,7 +494,7 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 				REQUIRE_CALL(blockDeviceMock, getBlockSize()).IN_SEQUENCE(sequence).RETURN(blockSize);
 				REQUIRE_CALL(blockDeviceMock, getSize()).IN_SEQUENCE(sequence).RETURN(deviceSize);
 				constexpr int ret {0x61e1b3e5};
-				REQUIRE_CALL(blockDeviceMock, erase(address, blockSize)).IN_SEQUENCE(sequence).RETURN(ret);
+				REQUIRE_CALL(blockDeviceMock, discard(address, blockSize)).IN_SEQUENCE(sequence).RETURN(ret);
 				REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 				REQUIRE(bd2Mtd.program(address + blockSize, buffer, size - 2 * blockSize) == ret);
 			}
@@ -501,13 +504,13 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 				REQUIRE_CALL(blockDeviceMock, getBlockSize()).IN_SEQUENCE(sequence).RETURN(blockSize);
 				REQUIRE_CALL(blockDeviceMock, getSize()).IN_SEQUENCE(sequence).RETURN(deviceSize);
 				constexpr int ret {0x2250ef2c};
-				REQUIRE_CALL(blockDeviceMock, erase(address, size - blockSize)).IN_SEQUENCE(sequence).RETURN(ret);
+				REQUIRE_CALL(blockDeviceMock, discard(address, size - blockSize)).IN_SEQUENCE(sequence).RETURN(ret);
 				REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 				REQUIRE(bd2Mtd.read(address + blockSize, buffer, size - 2 * blockSize) == ret);
 			}
 
 			REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
-			REQUIRE_CALL(blockDeviceMock, erase(address, size)).IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE_CALL(blockDeviceMock, discard(address, size)).IN_SEQUENCE(sequence).RETURN(0);
 			REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
 			REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 			REQUIRE(bd2Mtd.synchronize() == 0);
@@ -526,7 +529,7 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 			REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
 			REQUIRE_CALL(blockDeviceMock, getBlockSize()).IN_SEQUENCE(sequence).RETURN(blockSize);
 			REQUIRE_CALL(blockDeviceMock, getSize()).IN_SEQUENCE(sequence).RETURN(deviceSize);
-			REQUIRE_CALL(blockDeviceMock, erase(address, blockSize)).IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE_CALL(blockDeviceMock, discard(address, blockSize)).IN_SEQUENCE(sequence).RETURN(0);
 			constexpr int ret {0x44645a96};
 			REQUIRE_CALL(blockDeviceMock,
 					write(address + blockSize, buffer, size - 2 * blockSize)).IN_SEQUENCE(sequence).RETURN(ret);
@@ -534,7 +537,8 @@ TEST_CASE("Testing erase(), program() & read()", "[erase/program/read]")
 			REQUIRE(bd2Mtd.program(address + blockSize, buffer, size - 2 * blockSize) == ret);
 
 			REQUIRE_CALL(blockDeviceMock, lock()).IN_SEQUENCE(sequence);
-			REQUIRE_CALL(blockDeviceMock, erase(address + blockSize, size - blockSize)).IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE_CALL(blockDeviceMock, discard(address + blockSize, size - blockSize)).IN_SEQUENCE(sequence)
+					.RETURN(0);
 			REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
 			REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 			REQUIRE(bd2Mtd.synchronize() == 0);
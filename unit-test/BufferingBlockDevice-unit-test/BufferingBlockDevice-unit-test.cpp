@@ -31,6 +31,7 @@ class BlockDevice : public distortos::devices::BlockDevice
 public:
 
 	MAKE_MOCK0(close, int());
+	MAKE_MOCK2(discard, int(uint64_t, uint64_t));
 	MAKE_MOCK2(erase, int(uint64_t, uint64_t));
 	MAKE_CONST_MOCK0(getBlockSize, size_t());
 	MAKE_CONST_MOCK0(getSize, uint64_t());
@@ -2220,3 +2221,193 @@ TEST_CASE("Testing synchronize()", "[synchronize]")
 	REQUIRE_CALL(blockDeviceMock, unlock()).IN_SEQUENCE(sequence);
 	REQUIRE(bufferingBlockDevice.close() == 0);
 }
+
+TEST_CASE("Testing read-ahead", "[read-ahead]")
+{
+	BlockDevice blockDeviceMock;
+	distortos::mock::Semaphore semaphoreMock {};
+	uint8_t readBuffer[blockSize * 8] __attribute__ ((aligned(alignment))) {};
+	uint8_t readAheadBuffer[blockSize * 8] __attribute__ ((aligned(alignment))) {};
+	uint8_t writeBuffer[blockSize * 8] __attribute__ ((aligned(alignment))) {};
+	trompeloeil::sequence sequence {};
+
+	constexpr auto readBufferSize = sizeof(readBuffer);
+	constexpr auto writeBufferSize = sizeof(writeBuffer);
+
+	ALLOW_CALL(blockDeviceMock, lock());
+	ALLOW_CALL(blockDeviceMock, unlock());
+	ALLOW_CALL(blockDeviceMock, getBlockSize()).RETURN(blockSize);
+	ALLOW_CALL(blockDeviceMock, getSize()).RETURN(deviceSize);
+
+	distortos::devices::BufferingBlockDevice bufferingBlockDevice {blockDeviceMock, readBuffer, readAheadBuffer,
+			readBufferSize, writeBuffer, nullptr, writeBufferSize};
+
+	REQUIRE_CALL(blockDeviceMock, open()).IN_SEQUENCE(sequence).RETURN(0);
+	REQUIRE(bufferingBlockDevice.open() == 0);
+
+	constexpr uint64_t address {0x1d6b8e35 * blockSize};
+	uint8_t buffer[blockSize];
+
+	// first read is not sequential
+	REQUIRE_CALL(blockDeviceMock, read(address, readBuffer, readBufferSize)).IN_SEQUENCE(sequence)
+			.SIDE_EFFECT(memcpy(_2, randomData + _1 - address, _3)).RETURN(0);
+	REQUIRE(bufferingBlockDevice.read(address, buffer, sizeof(buffer)) == 0);
+	REQUIRE(memcmp(buffer, randomData, sizeof(buffer)) == 0);
+
+	// read which continues right after the end of read buffer should request the next window
+	REQUIRE_CALL(blockDeviceMock, read(address + readBufferSize, readBuffer, readBufferSize)).IN_SEQUENCE(sequence)
+			.SIDE_EFFECT(memcpy(_2, randomData + _1 - address, _3)).RETURN(0);
+	REQUIRE_CALL(blockDeviceMock, read(address + 2 * readBufferSize, readAheadBuffer, readBufferSize))
+			.IN_SEQUENCE(sequence).SIDE_EFFECT(memcpy(_2, randomData + _1 - address, _3)).RETURN(0);
+	REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+	REQUIRE(bufferingBlockDevice.read(address + readBufferSize, buffer, sizeof(buffer)) == 0);
+	REQUIRE(memcmp(buffer, randomData + readBufferSize, sizeof(buffer)) == 0);
+
+	SECTION("Read from read-ahead window should swap the buffers and request the next window")
+	{
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, read(address + 3 * readBufferSize, readBuffer, readBufferSize))
+				.IN_SEQUENCE(sequence).SIDE_EFFECT(memcpy(_2, randomData + _1 - address, _3)).RETURN(0);
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.read(address + 2 * readBufferSize + blockSize, buffer, sizeof(buffer)) == 0);
+		REQUIRE(memcmp(buffer, randomData + 2 * readBufferSize + blockSize, sizeof(buffer)) == 0);
+
+		// random read should discard read-ahead window and should not request the next one
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, read(address + blockSize, readAheadBuffer, readBufferSize))
+				.IN_SEQUENCE(sequence).SIDE_EFFECT(memcpy(_2, randomData + _1 - address, _3)).RETURN(0);
+		REQUIRE(bufferingBlockDevice.read(address + blockSize, buffer, sizeof(buffer)) == 0);
+		REQUIRE(memcmp(buffer, randomData + blockSize, sizeof(buffer)) == 0);
+
+		REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.close() == 0);
+	}
+	SECTION("Erase of read-ahead window should discard it")
+	{
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, erase(address + 2 * readBufferSize, blockSize)).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.erase(address + 2 * readBufferSize, blockSize) == 0);
+
+		REQUIRE_CALL(blockDeviceMock, read(address + 2 * readBufferSize, readBuffer, readBufferSize))
+				.IN_SEQUENCE(sequence).SIDE_EFFECT(memcpy(_2, randomData + _1 - address, _3)).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, read(address + 3 * readBufferSize, readAheadBuffer, readBufferSize))
+				.IN_SEQUENCE(sequence).SIDE_EFFECT(memcpy(_2, randomData + _1 - address, _3)).RETURN(0);
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.read(address + 2 * readBufferSize, buffer, sizeof(buffer)) == 0);
+		REQUIRE(memcmp(buffer, randomData + 2 * readBufferSize, sizeof(buffer)) == 0);
+
+		// last close should collect pending read-ahead
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.close() == 0);
+	}
+	SECTION("Failed read-ahead should be repeated as a regular read")
+	{
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, read(address + 3 * readBufferSize, readBuffer, readBufferSize))
+				.IN_SEQUENCE(sequence).RETURN(0x37c1e5a9);
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.read(address + 2 * readBufferSize, buffer, sizeof(buffer)) == 0);
+		REQUIRE(memcmp(buffer, randomData + 2 * readBufferSize, sizeof(buffer)) == 0);
+
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, read(address + 3 * readBufferSize, readAheadBuffer, readBufferSize))
+				.IN_SEQUENCE(sequence).SIDE_EFFECT(memcpy(_2, randomData + _1 - address, _3)).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, read(address + 4 * readBufferSize, readBuffer, readBufferSize))
+				.IN_SEQUENCE(sequence).SIDE_EFFECT(memcpy(_2, randomData + _1 - address, _3)).RETURN(0);
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.read(address + 3 * readBufferSize, buffer, sizeof(buffer)) == 0);
+		REQUIRE(memcmp(buffer, randomData + 3 * readBufferSize, sizeof(buffer)) == 0);
+
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.close() == 0);
+	}
+}
+
+TEST_CASE("Testing write-back", "[write-back]")
+{
+	BlockDevice blockDeviceMock;
+	distortos::mock::Semaphore semaphoreMock {};
+	uint8_t readBuffer[blockSize * 8] __attribute__ ((aligned(alignment))) {};
+	uint8_t writeBuffer[blockSize * 8] __attribute__ ((aligned(alignment))) {};
+	uint8_t flushBuffer[blockSize * 8] __attribute__ ((aligned(alignment))) {};
+	trompeloeil::sequence sequence {};
+
+	constexpr auto readBufferSize = sizeof(readBuffer);
+	constexpr auto writeBufferSize = sizeof(writeBuffer);
+
+	ALLOW_CALL(blockDeviceMock, lock());
+	ALLOW_CALL(blockDeviceMock, unlock());
+	ALLOW_CALL(blockDeviceMock, getBlockSize()).RETURN(blockSize);
+	ALLOW_CALL(blockDeviceMock, getSize()).RETURN(deviceSize);
+
+	distortos::devices::BufferingBlockDevice bufferingBlockDevice {blockDeviceMock, readBuffer, nullptr, readBufferSize,
+			writeBuffer, flushBuffer, writeBufferSize};
+
+	REQUIRE_CALL(blockDeviceMock, open()).IN_SEQUENCE(sequence).RETURN(0);
+	REQUIRE(bufferingBlockDevice.open() == 0);
+
+	constexpr uint64_t address {0x4f2a6c19 * blockSize};
+	constexpr uint64_t otherAddress {address + 16 * blockSize};
+	constexpr size_t size {3 * blockSize};
+
+	REQUIRE(bufferingBlockDevice.write(address, randomData, size) == 0);
+
+	// non-contiguous write should swap the buffers and submit a write of previous data
+	REQUIRE_CALL(blockDeviceMock, write(address, writeBuffer, size)).WITH(memcmp(_2, randomData, _3) == 0)
+			.IN_SEQUENCE(sequence).RETURN(0);
+	REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+	REQUIRE(bufferingBlockDevice.write(otherAddress, randomData + size, blockSize) == 0);
+
+	SECTION("synchronize() should wait for all buffered data")
+	{
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, write(otherAddress, flushBuffer, blockSize))
+				.WITH(memcmp(_2, randomData + size, _3) == 0).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.synchronize() == 0);
+
+		REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.close() == 0);
+	}
+	SECTION("Read of data which is being written should wait for the write")
+	{
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, read(address, readBuffer, readBufferSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(memcpy(_2, randomData + _1 - address, _3)).RETURN(0);
+		uint8_t buffer[blockSize];
+		REQUIRE(bufferingBlockDevice.read(address, buffer, sizeof(buffer)) == 0);
+		REQUIRE(memcmp(buffer, randomData, sizeof(buffer)) == 0);
+
+		REQUIRE_CALL(blockDeviceMock, write(otherAddress, flushBuffer, blockSize))
+				.WITH(memcmp(_2, randomData + size, _3) == 0).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.close() == 0);
+	}
+	SECTION("Error of background write should be reported and the data should be written again")
+	{
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, erase(address, blockSize)).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.erase(address, blockSize) == 0);
+
+		// the first write was finished, so this one goes to the other buffer
+		REQUIRE_CALL(blockDeviceMock, write(otherAddress, flushBuffer, blockSize))
+				.WITH(memcmp(_2, randomData + size, _3) == 0).IN_SEQUENCE(sequence).RETURN(0x1b9e6d42);
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.synchronize() == 0x1b9e6d42);
+
+		REQUIRE_CALL(blockDeviceMock, write(otherAddress, flushBuffer, blockSize))
+				.WITH(memcmp(_2, randomData + size, _3) == 0).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.synchronize() == 0);
+
+		REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(bufferingBlockDevice.close() == 0);
+	}
+}
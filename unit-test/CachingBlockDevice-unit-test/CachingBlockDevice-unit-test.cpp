@@ -0,0 +1,418 @@
+/**
+ * \file
+ * \brief CachingBlockDevice test cases
+ *
+ * This test checks whether CachingBlockDevice perform all operations properly and in correct order, whether
+ * replacement of entries of cache follows LRU order and whether pinned regions are kept in cache.
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "unit-test-common.hpp"
+
+#include "distortos/devices/memory/CachingBlockDevice.hpp"
+
+using trompeloeil::_;
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+class BlockDevice : public distortos::devices::BlockDevice
+{
+public:
+
+	MAKE_MOCK0(close, int());
+	MAKE_MOCK2(discard, int(uint64_t, uint64_t));
+	MAKE_MOCK2(erase, int(uint64_t, uint64_t));
+	MAKE_CONST_MOCK0(getBlockSize, size_t());
+	MAKE_CONST_MOCK0(getSize, uint64_t());
+	MAKE_MOCK0(lock, void());
+	MAKE_MOCK0(open, int());
+	MAKE_MOCK3(read, int(uint64_t, void*, size_t));
+	MAKE_MOCK0(synchronize, int());
+	MAKE_MOCK0(unlock, void());
+	MAKE_MOCK3(write, int(uint64_t, const void*, size_t));
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t alignment {DISTORTOS_BLOCKDEVICE_BUFFER_ALIGNMENT};
+constexpr size_t blockSize {8};
+constexpr size_t entriesCount {2};
+constexpr uint64_t deviceSize {UINT64_MAX};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Fills buffer with data depending on the address, emulating contents of device.
+ *
+ * \param [in] address is the address of data
+ * \param [out] buffer is the buffer which will be filled
+ * \param [in] size is the size of \a buffer, bytes
+ */
+
+void fill(const uint64_t address, void* const buffer, const size_t size)
+{
+	for (size_t i {}; i < size; ++i)
+		static_cast<uint8_t*>(buffer)[i] = (address + i) * 0x9d;
+}
+
+/**
+ * \brief Checks whether buffer holds data filled with fill().
+ *
+ * \param [in] address is the address of data
+ * \param [in] buffer is the buffer which will be checked
+ * \param [in] size is the size of \a buffer, bytes
+ *
+ * \return true if \a buffer holds data filled with fill(), false otherwise
+ */
+
+bool check(const uint64_t address, const void* const buffer, const size_t size)
+{
+	for (size_t i {}; i < size; ++i)
+		if (static_cast<const uint8_t*>(buffer)[i] != static_cast<uint8_t>((address + i) * 0x9d))
+			return false;
+
+	return true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global test cases
++---------------------------------------------------------------------------------------------------------------------*/
+
+TEST_CASE("Testing open() & close()", "[open/close]")
+{
+	BlockDevice blockDeviceMock;
+	uint8_t buffer[blockSize * entriesCount] __attribute__ ((aligned(alignment))) {};
+	distortos::devices::CachingBlockDevice::Entry entries[entriesCount];
+	trompeloeil::sequence sequence {};
+
+	ALLOW_CALL(blockDeviceMock, lock());
+	ALLOW_CALL(blockDeviceMock, unlock());
+	ALLOW_CALL(blockDeviceMock, getSize()).RETURN(deviceSize);
+
+	distortos::devices::CachingBlockDevice cachingBlockDevice {blockDeviceMock, buffer, entries, entriesCount};
+
+	SECTION("Block device open error should propagate error code to caller")
+	{
+		constexpr int ret {0x1a4c9e27};
+		REQUIRE_CALL(blockDeviceMock, open()).IN_SEQUENCE(sequence).RETURN(ret);
+		REQUIRE(cachingBlockDevice.open() == ret);
+	}
+	SECTION("Last close of the device should write back all modified entries in the order of addresses")
+	{
+		REQUIRE_CALL(blockDeviceMock, open()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, getBlockSize()).IN_SEQUENCE(sequence).RETURN(blockSize);
+		REQUIRE(cachingBlockDevice.open() == 0);
+		REQUIRE(cachingBlockDevice.open() == 0);
+
+		constexpr uint64_t address {0x3b61a05d * blockSize};
+		uint8_t data[blockSize];
+		fill(address + blockSize, data, sizeof(data));
+		REQUIRE(cachingBlockDevice.write(address + blockSize, data, sizeof(data)) == 0);
+		fill(address, data, sizeof(data));
+		REQUIRE(cachingBlockDevice.write(address, data, sizeof(data)) == 0);
+
+		// not the last close
+		REQUIRE(cachingBlockDevice.close() == 0);
+
+		SECTION("Block device write error should propagate error code to caller and close the device anyway")
+		{
+			constexpr int ret {0x0d7e5f31};
+			REQUIRE_CALL(blockDeviceMock, write(address, _, blockSize)).WITH(check(_1, _2, _3) == true)
+					.IN_SEQUENCE(sequence).RETURN(ret);
+			REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0x51c8e4a2);
+			REQUIRE(cachingBlockDevice.close() == ret);
+		}
+		SECTION("Block device close error should propagate error code to caller")
+		{
+			REQUIRE_CALL(blockDeviceMock, write(address, _, blockSize)).WITH(check(_1, _2, _3) == true)
+					.IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE_CALL(blockDeviceMock, write(address + blockSize, _, blockSize)).WITH(check(_1, _2, _3) == true)
+					.IN_SEQUENCE(sequence).RETURN(0);
+			constexpr int ret {0x6f3927b8};
+			REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(ret);
+			REQUIRE(cachingBlockDevice.close() == ret);
+		}
+	}
+}
+
+TEST_CASE("Testing read()", "[read]")
+{
+	BlockDevice blockDeviceMock;
+	uint8_t buffer[blockSize * entriesCount] __attribute__ ((aligned(alignment))) {};
+	distortos::devices::CachingBlockDevice::Entry entries[entriesCount];
+	trompeloeil::sequence sequence {};
+
+	ALLOW_CALL(blockDeviceMock, lock());
+	ALLOW_CALL(blockDeviceMock, unlock());
+	ALLOW_CALL(blockDeviceMock, getSize()).RETURN(deviceSize);
+
+	distortos::devices::CachingBlockDevice cachingBlockDevice {blockDeviceMock, buffer, entries, entriesCount};
+
+	REQUIRE_CALL(blockDeviceMock, open()).IN_SEQUENCE(sequence).RETURN(0);
+	REQUIRE_CALL(blockDeviceMock, getBlockSize()).IN_SEQUENCE(sequence).RETURN(blockSize);
+	REQUIRE(cachingBlockDevice.open() == 0);
+
+	constexpr uint64_t address {0x2c48e1f7 * blockSize};
+	uint8_t data[blockSize * 4 + 1] __attribute__ ((aligned(alignment)));
+
+	SECTION("Reading zero bytes should succeed")
+	{
+		REQUIRE(cachingBlockDevice.read(address, data, {}) == 0);
+	}
+	SECTION("Block device read error should propagate error code to caller")
+	{
+		constexpr int ret {0x47e0b9c3};
+		REQUIRE_CALL(blockDeviceMock, read(address, buffer, blockSize)).IN_SEQUENCE(sequence).RETURN(ret);
+		REQUIRE(cachingBlockDevice.read(address, data, blockSize) == ret);
+
+		// failed read must not leave invalid data in cache
+		REQUIRE_CALL(blockDeviceMock, read(address, buffer, blockSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE(cachingBlockDevice.read(address, data, blockSize) == 0);
+		REQUIRE(check(address, data, blockSize) == true);
+	}
+	SECTION("Cached block should be read without accessing block device")
+	{
+		REQUIRE_CALL(blockDeviceMock, read(address, buffer, blockSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE(cachingBlockDevice.read(address, data, blockSize) == 0);
+		REQUIRE(check(address, data, blockSize) == true);
+
+		memset(data, 0, sizeof(data));
+		REQUIRE(cachingBlockDevice.read(address, data + 1, blockSize) == 0);
+		REQUIRE(check(address, data + 1, blockSize) == true);
+	}
+	SECTION("Run of uncached blocks should bypass the cache if the buffer is aligned")
+	{
+		REQUIRE_CALL(blockDeviceMock, read(address + blockSize, buffer, blockSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE(cachingBlockDevice.read(address + blockSize, data, blockSize) == 0);
+
+		// cached block splits the read into two runs - the first one has a single block, so it is cached
+		REQUIRE_CALL(blockDeviceMock, read(address, buffer + blockSize, blockSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, read(address + 2 * blockSize, data + 2 * blockSize, 2 * blockSize))
+				.IN_SEQUENCE(sequence).SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE(cachingBlockDevice.read(address, data, 4 * blockSize) == 0);
+		REQUIRE(check(address, data, 4 * blockSize) == true);
+	}
+	SECTION("Run of uncached blocks should pass through the cache if the buffer is not aligned")
+	{
+		REQUIRE_CALL(blockDeviceMock, read(address, buffer, blockSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, read(address + blockSize, buffer + blockSize, blockSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE(cachingBlockDevice.read(address, data + 1, 2 * blockSize) == 0);
+		REQUIRE(check(address, data + 1, 2 * blockSize) == true);
+	}
+
+	REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0);
+	REQUIRE(cachingBlockDevice.close() == 0);
+}
+
+TEST_CASE("Testing write()", "[write]")
+{
+	BlockDevice blockDeviceMock;
+	uint8_t buffer[blockSize * entriesCount] __attribute__ ((aligned(alignment))) {};
+	distortos::devices::CachingBlockDevice::Entry entries[entriesCount];
+	trompeloeil::sequence sequence {};
+
+	ALLOW_CALL(blockDeviceMock, lock());
+	ALLOW_CALL(blockDeviceMock, unlock());
+	ALLOW_CALL(blockDeviceMock, getSize()).RETURN(deviceSize);
+
+	distortos::devices::CachingBlockDevice cachingBlockDevice {blockDeviceMock, buffer, entries, entriesCount};
+
+	REQUIRE_CALL(blockDeviceMock, open()).IN_SEQUENCE(sequence).RETURN(0);
+	REQUIRE_CALL(blockDeviceMock, getBlockSize()).IN_SEQUENCE(sequence).RETURN(blockSize);
+	REQUIRE(cachingBlockDevice.open() == 0);
+
+	constexpr uint64_t address {0x57a3c90e * blockSize};
+	uint8_t data[blockSize * 4 + 1] __attribute__ ((aligned(alignment)));
+
+	SECTION("Single block should be written to cache without reading it first")
+	{
+		fill(address, data + 1, blockSize);
+		REQUIRE(cachingBlockDevice.write(address, data + 1, blockSize) == 0);
+
+		// written block should be read from cache
+		memset(data, 0, sizeof(data));
+		REQUIRE(cachingBlockDevice.read(address, data, blockSize) == 0);
+		REQUIRE(check(address, data, blockSize) == true);
+
+		SECTION("Block device write error should propagate error code to caller")
+		{
+			constexpr int ret {0x3e9d0a56};
+			REQUIRE_CALL(blockDeviceMock, write(address, buffer, blockSize)).IN_SEQUENCE(sequence).RETURN(ret);
+			REQUIRE(cachingBlockDevice.synchronize() == ret);
+
+			// entry which was not written back is still modified
+			REQUIRE_CALL(blockDeviceMock, write(address, buffer, blockSize)).WITH(check(_1, _2, _3) == true)
+					.IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE(cachingBlockDevice.synchronize() == 0);
+		}
+		SECTION("Block device synchronize error should propagate error code to caller")
+		{
+			REQUIRE_CALL(blockDeviceMock, write(address, buffer, blockSize)).WITH(check(_1, _2, _3) == true)
+					.IN_SEQUENCE(sequence).RETURN(0);
+			constexpr int ret {0x78b1f2c4};
+			REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(ret);
+			REQUIRE(cachingBlockDevice.synchronize() == ret);
+
+			// entry was written back, so it's not modified any more
+			REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE(cachingBlockDevice.synchronize() == 0);
+		}
+	}
+	SECTION("Run of uncached blocks should bypass the cache if the buffer is aligned")
+	{
+		fill(address, data, 3 * blockSize);
+		REQUIRE_CALL(blockDeviceMock, write(address, data, 3 * blockSize)).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(cachingBlockDevice.write(address, data, 3 * blockSize) == 0);
+
+		REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(cachingBlockDevice.synchronize() == 0);
+	}
+	SECTION("Modified entry should be written back when it is evicted")
+	{
+		for (size_t block {}; block < entriesCount; ++block)
+		{
+			fill(address + block * blockSize, data, blockSize);
+			REQUIRE(cachingBlockDevice.write(address + block * blockSize, data, blockSize) == 0);
+		}
+
+		REQUIRE_CALL(blockDeviceMock, write(address, buffer, blockSize)).WITH(check(_1, _2, _3) == true)
+				.IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, read(address + entriesCount * blockSize, buffer, blockSize))
+				.IN_SEQUENCE(sequence).SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE(cachingBlockDevice.read(address + entriesCount * blockSize, data, blockSize) == 0);
+
+		REQUIRE_CALL(blockDeviceMock, write(address + blockSize, buffer + blockSize, blockSize))
+				.WITH(check(_1, _2, _3) == true).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(blockDeviceMock, synchronize()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE(cachingBlockDevice.synchronize() == 0);
+	}
+
+	REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0);
+	REQUIRE(cachingBlockDevice.close() == 0);
+}
+
+TEST_CASE("Testing replacement of entries", "[replacement]")
+{
+	BlockDevice blockDeviceMock;
+	uint8_t buffer[blockSize * entriesCount] __attribute__ ((aligned(alignment))) {};
+	distortos::devices::CachingBlockDevice::Entry entries[entriesCount];
+	trompeloeil::sequence sequence {};
+
+	ALLOW_CALL(blockDeviceMock, lock());
+	ALLOW_CALL(blockDeviceMock, unlock());
+	ALLOW_CALL(blockDeviceMock, getSize()).RETURN(deviceSize);
+
+	distortos::devices::CachingBlockDevice cachingBlockDevice {blockDeviceMock, buffer, entries, entriesCount};
+
+	REQUIRE_CALL(blockDeviceMock, open()).IN_SEQUENCE(sequence).RETURN(0);
+	REQUIRE_CALL(blockDeviceMock, getBlockSize()).IN_SEQUENCE(sequence).RETURN(blockSize);
+	REQUIRE(cachingBlockDevice.open() == 0);
+
+	constexpr uint64_t address0 {0x1e8a4d73 * blockSize};
+	constexpr uint64_t address1 {0x6b05f92c * blockSize};
+	constexpr uint64_t address2 {0x0f3c7ae1 * blockSize};
+	uint8_t data[blockSize];
+
+	REQUIRE_CALL(blockDeviceMock, read(address0, buffer, blockSize)).IN_SEQUENCE(sequence)
+			.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+	REQUIRE(cachingBlockDevice.read(address0, data, sizeof(data)) == 0);
+	REQUIRE_CALL(blockDeviceMock, read(address1, buffer + blockSize, blockSize)).IN_SEQUENCE(sequence)
+			.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+	REQUIRE(cachingBlockDevice.read(address1, data, sizeof(data)) == 0);
+
+	SECTION("Least recently used entry should be evicted")
+	{
+		REQUIRE(cachingBlockDevice.read(address0, data, sizeof(data)) == 0);
+
+		REQUIRE_CALL(blockDeviceMock, read(address2, buffer + blockSize, blockSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE(cachingBlockDevice.read(address2, data, sizeof(data)) == 0);
+		REQUIRE(check(address2, data, sizeof(data)) == true);
+
+		REQUIRE(cachingBlockDevice.read(address0, data, sizeof(data)) == 0);
+		REQUIRE(check(address0, data, sizeof(data)) == true);
+	}
+	SECTION("Entry from pinned region should be evicted only if all entries are pinned")
+	{
+		REQUIRE(cachingBlockDevice.pin(address0, blockSize) == 0);
+
+		REQUIRE_CALL(blockDeviceMock, read(address2, buffer + blockSize, blockSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE(cachingBlockDevice.read(address2, data, sizeof(data)) == 0);
+
+		REQUIRE(cachingBlockDevice.read(address0, data, sizeof(data)) == 0);
+		REQUIRE(check(address0, data, sizeof(data)) == true);
+
+		REQUIRE(cachingBlockDevice.pin(address2 - blockSize, 2 * blockSize) == 0);
+
+		REQUIRE_CALL(blockDeviceMock, read(address1, buffer + blockSize, blockSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE(cachingBlockDevice.read(address1, data, sizeof(data)) == 0);
+
+		REQUIRE(cachingBlockDevice.unpin(address2, 2 * blockSize) == EINVAL);
+		REQUIRE(cachingBlockDevice.unpin(address2 - blockSize, 2 * blockSize) == 0);
+		REQUIRE(cachingBlockDevice.unpin(address0, blockSize) == 0);
+		REQUIRE(cachingBlockDevice.unpin(address0, blockSize) == EINVAL);
+	}
+	SECTION("Pinning more than max number of regions should fail")
+	{
+		for (size_t i {}; i < distortos::devices::CachingBlockDevice::maxPinnedRegions; ++i)
+			REQUIRE(cachingBlockDevice.pin(address0 + i * blockSize, blockSize) == 0);
+		REQUIRE(cachingBlockDevice.pin(address2, blockSize) == ENOSPC);
+
+		REQUIRE(cachingBlockDevice.unpin(address0 + blockSize, blockSize) == 0);
+		REQUIRE(cachingBlockDevice.pin(address2, blockSize) == 0);
+	}
+	SECTION("Erased blocks should be dropped from cache")
+	{
+		REQUIRE(cachingBlockDevice.write(address0, data, sizeof(data)) == 0);
+
+		constexpr int ret {0x2d96b4e8};
+		REQUIRE_CALL(blockDeviceMock, erase(address0, blockSize)).IN_SEQUENCE(sequence).RETURN(ret);
+		REQUIRE(cachingBlockDevice.erase(address0, blockSize) == ret);
+
+		REQUIRE_CALL(blockDeviceMock, read(address0, _, blockSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE(cachingBlockDevice.read(address0, data, sizeof(data)) == 0);
+		REQUIRE(check(address0, data, sizeof(data)) == true);
+	}
+	SECTION("Discarded blocks should be dropped from cache")
+	{
+		REQUIRE(cachingBlockDevice.write(address0, data, sizeof(data)) == 0);
+
+		constexpr int ret {0x5f0c27a1};
+		REQUIRE_CALL(blockDeviceMock, discard(address0, blockSize)).IN_SEQUENCE(sequence).RETURN(ret);
+		REQUIRE(cachingBlockDevice.discard(address0, blockSize) == ret);
+
+		REQUIRE_CALL(blockDeviceMock, read(address0, _, blockSize)).IN_SEQUENCE(sequence)
+				.SIDE_EFFECT(fill(_1, _2, _3)).RETURN(0);
+		REQUIRE(cachingBlockDevice.read(address0, data, sizeof(data)) == 0);
+		REQUIRE(check(address0, data, sizeof(data)) == true);
+	}
+
+	REQUIRE_CALL(blockDeviceMock, close()).IN_SEQUENCE(sequence).RETURN(0);
+	REQUIRE(cachingBlockDevice.close() == 0);
+}
@@ -37,6 +37,7 @@ class BlockDevice : public distortos::devices::BlockDevice
 public:
 
 	MAKE_MOCK0(close, int());
+	MAKE_MOCK2(discard, int(uint64_t, uint64_t));
 	MAKE_MOCK2(erase, int(uint64_t, uint64_t));
 	MAKE_CONST_MOCK0(getBlockSize, size_t());
 	MAKE_CONST_MOCK0(getSize, uint64_t());
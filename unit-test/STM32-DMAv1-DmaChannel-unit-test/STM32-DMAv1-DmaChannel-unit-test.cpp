@@ -32,6 +32,7 @@ class DmaChannelFunctor : public distortos::chip::DmaChannelFunctor
 {
 public:
 
+	MAKE_MOCK0(halfTransferEvent, void());
 	MAKE_MOCK0(transferCompleteEvent, void());
 	MAKE_MOCK1(transferErrorEvent, void(size_t));
 };
@@ -156,14 +157,16 @@ TEST_CASE("Testing transfer configuration", "[configuration]")
 	{
 		const Flags flagsArray[]
 		{
-			Flags::transferCompleteInterruptDisable | Flags::peripheralToMemory | Flags::peripheralFixed |
-					Flags::memoryFixed | Flags::lowPriority,
-			Flags::transferCompleteInterruptEnable | Flags::memoryToPeripheral | Flags::peripheralIncrement |
-					Flags::memoryIncrement | Flags::mediumPriority,
-			Flags::transferCompleteInterruptDisable | Flags::peripheralToMemory | Flags::peripheralFixed |
-					Flags::memoryFixed | Flags::highPriority,
-			Flags::transferCompleteInterruptEnable | Flags::memoryToPeripheral | Flags::peripheralIncrement |
-					Flags::memoryIncrement | Flags::veryHighPriority,
+			Flags::transferCompleteInterruptDisable | Flags::halfTransferInterruptDisable | Flags::peripheralToMemory |
+					Flags::circularModeDisable | Flags::peripheralFixed | Flags::memoryFixed | Flags::lowPriority,
+			Flags::transferCompleteInterruptEnable | Flags::halfTransferInterruptEnable | Flags::memoryToPeripheral |
+					Flags::circularModeEnable | Flags::peripheralIncrement | Flags::memoryIncrement |
+					Flags::mediumPriority,
+			Flags::transferCompleteInterruptDisable | Flags::halfTransferInterruptEnable | Flags::peripheralToMemory |
+					Flags::circularModeDisable | Flags::peripheralFixed | Flags::memoryFixed | Flags::highPriority,
+			Flags::transferCompleteInterruptEnable | Flags::halfTransferInterruptDisable | Flags::memoryToPeripheral |
+					Flags::circularModeEnable | Flags::peripheralIncrement | Flags::memoryIncrement |
+					Flags::veryHighPriority,
 		};
 		const Flags peripheralDataSizes[]
 		{
@@ -250,7 +253,7 @@ TEST_CASE("Testing transfers", "[transfers]")
 	SECTION("Testing interruptHandler()")
 	{
 		{
-			const auto isr = UINT32_MAX & ~((DMA_ISR_TEIF1 | DMA_ISR_TCIF1) << channelShift);
+			const auto isr = UINT32_MAX & ~((DMA_ISR_TEIF1 | DMA_ISR_HTIF1 | DMA_ISR_TCIF1) << channelShift);
 			REQUIRE_CALL(peripheralMock, readIsr()).IN_SEQUENCE(sequence).RETURN(isr);
 			channel.interruptHandler();
 		}
@@ -261,58 +264,73 @@ TEST_CASE("Testing transfers", "[transfers]")
 					true,
 			};
 			for (const auto teif : falseTrue)
-				for (const auto tcif : falseTrue)
-				{
-					if (teif == false && tcif == false)
-						continue;
-
-					const auto isr = UINT32_MAX & ~((DMA_ISR_TEIF1 | DMA_ISR_TCIF1) << channelShift) |
-							teif << (DMA_ISR_TEIF1_Pos + channelShift) |
-							tcif << (DMA_ISR_TCIF1_Pos + channelShift);
-					REQUIRE_CALL(peripheralMock, readIsr()).IN_SEQUENCE(sequence).RETURN(isr);
-					const auto ccr = UINT32_MAX & ~(DMA_CCR_TEIE | DMA_CCR_TCIE) |
-							!teif << DMA_CCR_TEIE_Pos |
-							!tcif << DMA_CCR_TCIE_Pos;
-					REQUIRE_CALL(channelPeripheralMock, readCcr()).IN_SEQUENCE(sequence).RETURN(ccr);
-					channel.interruptHandler();
-				}
+				for (const auto htif : falseTrue)
+					for (const auto tcif : falseTrue)
+					{
+						if (teif == false && htif == false && tcif == false)
+							continue;
+
+						const auto isr = UINT32_MAX &
+								~((DMA_ISR_TEIF1 | DMA_ISR_HTIF1 | DMA_ISR_TCIF1) << channelShift) |
+								teif << (DMA_ISR_TEIF1_Pos + channelShift) |
+								htif << (DMA_ISR_HTIF1_Pos + channelShift) |
+								tcif << (DMA_ISR_TCIF1_Pos + channelShift);
+						REQUIRE_CALL(peripheralMock, readIsr()).IN_SEQUENCE(sequence).RETURN(isr);
+						const auto ccr = UINT32_MAX & ~(DMA_CCR_TEIE | DMA_CCR_HTIE | DMA_CCR_TCIE) |
+								!teif << DMA_CCR_TEIE_Pos |
+								!htif << DMA_CCR_HTIE_Pos |
+								!tcif << DMA_CCR_TCIE_Pos;
+						REQUIRE_CALL(channelPeripheralMock, readCcr()).IN_SEQUENCE(sequence).RETURN(ccr);
+						channel.interruptHandler();
+					}
 
 			for (const auto teif : falseTrue)
-				for (const auto tcif : falseTrue)
-					for (const auto teie : falseTrue)
-						for (const auto tcie : falseTrue)
-						{
-							if ((teif && teie) == false && (tcif && tcie) == false)
-								continue;
-
-							const auto isr = UINT32_MAX & ~((DMA_ISR_TEIF1 | DMA_ISR_TCIF1) << channelShift) |
-									teif << (DMA_ISR_TEIF1_Pos + channelShift) |
-									tcif << (DMA_ISR_TCIF1_Pos + channelShift);
-							REQUIRE_CALL(peripheralMock, readIsr()).IN_SEQUENCE(sequence).RETURN(isr);
-							const auto ccr = UINT32_MAX & ~(DMA_CCR_TEIE | DMA_CCR_TCIE) |
-									teie << DMA_CCR_TEIE_Pos |
-									tcie << DMA_CCR_TCIE_Pos;
-							REQUIRE_CALL(channelPeripheralMock, readCcr()).IN_SEQUENCE(sequence).RETURN(ccr);
-							const uint32_t ifcr = (teif && teie) << (DMA_IFCR_CTEIF1_Pos + channelShift) |
-									(tcif && tcie) << (DMA_IFCR_CTCIF1_Pos + channelShift);
-							REQUIRE_CALL(peripheralMock, writeIfcr(ifcr)).IN_SEQUENCE(sequence);
-
-							if ((teif && teie) == true)
-							{
-								constexpr uint16_t transactionsLeft {0x6e95};
-								expectations.emplace_back(NAMED_REQUIRE_CALL(channelPeripheralMock,
-										readCndtr()).IN_SEQUENCE(sequence).RETURN(transactionsLeft));
-								expectations.emplace_back(NAMED_REQUIRE_CALL(functorMock,
-										transferErrorEvent(transactionsLeft)).IN_SEQUENCE(sequence));
-							}
-							if ((tcif && tcie) == true)
-							{
-								expectations.emplace_back(NAMED_REQUIRE_CALL(functorMock,
-										transferCompleteEvent()).IN_SEQUENCE(sequence));
-							}
-
-							channel.interruptHandler();
-						}
+				for (const auto htif : falseTrue)
+					for (const auto tcif : falseTrue)
+						for (const auto teie : falseTrue)
+							for (const auto htie : falseTrue)
+								for (const auto tcie : falseTrue)
+								{
+									if ((teif && teie) == false && (htif && htie) == false && (tcif && tcie) == false)
+										continue;
+
+									const auto isr = UINT32_MAX &
+											~((DMA_ISR_TEIF1 | DMA_ISR_HTIF1 | DMA_ISR_TCIF1) << channelShift) |
+											teif << (DMA_ISR_TEIF1_Pos + channelShift) |
+											htif << (DMA_ISR_HTIF1_Pos + channelShift) |
+											tcif << (DMA_ISR_TCIF1_Pos + channelShift);
+									REQUIRE_CALL(peripheralMock, readIsr()).IN_SEQUENCE(sequence).RETURN(isr);
+									const auto ccr = UINT32_MAX & ~(DMA_CCR_TEIE | DMA_CCR_HTIE | DMA_CCR_TCIE) |
+											teie << DMA_CCR_TEIE_Pos |
+											htie << DMA_CCR_HTIE_Pos |
+											tcie << DMA_CCR_TCIE_Pos;
+									REQUIRE_CALL(channelPeripheralMock, readCcr()).IN_SEQUENCE(sequence).RETURN(ccr);
+									const uint32_t ifcr = (teif && teie) << (DMA_IFCR_CTEIF1_Pos + channelShift) |
+											(htif && htie) << (DMA_IFCR_CHTIF1_Pos + channelShift) |
+											(tcif && tcie) << (DMA_IFCR_CTCIF1_Pos + channelShift);
+									REQUIRE_CALL(peripheralMock, writeIfcr(ifcr)).IN_SEQUENCE(sequence);
+
+									if ((teif && teie) == true)
+									{
+										constexpr uint16_t transactionsLeft {0x6e95};
+										expectations.emplace_back(NAMED_REQUIRE_CALL(channelPeripheralMock,
+												readCndtr()).IN_SEQUENCE(sequence).RETURN(transactionsLeft));
+										expectations.emplace_back(NAMED_REQUIRE_CALL(functorMock,
+												transferErrorEvent(transactionsLeft)).IN_SEQUENCE(sequence));
+									}
+									if ((htif && htie) == true)
+									{
+										expectations.emplace_back(NAMED_REQUIRE_CALL(functorMock,
+												halfTransferEvent()).IN_SEQUENCE(sequence));
+									}
+									if ((tcif && tcie) == true)
+									{
+										expectations.emplace_back(NAMED_REQUIRE_CALL(functorMock,
+												transferCompleteEvent()).IN_SEQUENCE(sequence));
+									}
+
+									channel.interruptHandler();
+								}
 		}
 	}
 
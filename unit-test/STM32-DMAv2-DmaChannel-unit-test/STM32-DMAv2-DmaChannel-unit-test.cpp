@@ -32,6 +32,7 @@ class DmaChannelFunctor : public distortos::chip::DmaChannelFunctor
 {
 public:
 
+	MAKE_MOCK0(halfTransferEvent, void());
 	MAKE_MOCK0(transferCompleteEvent, void());
 	MAKE_MOCK1(transferErrorEvent, void(size_t));
 };
@@ -144,13 +145,17 @@ TEST_CASE("Testing transfer configuration", "[configuration]")
 	{
 		const Flags flagsArray[]
 		{
-			Flags::transferCompleteInterruptDisable | Flags::dmaFlowController | Flags::peripheralToMemory |
-					Flags::peripheralFixed | Flags::memoryFixed | Flags::lowPriority,
-			Flags::transferCompleteInterruptEnable | Flags::peripheralFlowController | Flags::memoryToPeripheral |
+			Flags::halfTransferInterruptDisable | Flags::transferCompleteInterruptDisable | Flags::dmaFlowController |
+					Flags::peripheralToMemory | Flags::circularModeDisable | Flags::peripheralFixed |
+					Flags::memoryFixed | Flags::lowPriority,
+			Flags::halfTransferInterruptEnable | Flags::transferCompleteInterruptEnable |
+					Flags::peripheralFlowController | Flags::memoryToPeripheral | Flags::circularModeEnable |
 					Flags::peripheralIncrement | Flags::memoryIncrement | Flags::mediumPriority,
-			Flags::transferCompleteInterruptDisable | Flags::dmaFlowController | Flags::peripheralToMemory |
-					Flags::peripheralFixed | Flags::memoryFixed | Flags::highPriority,
-			Flags::transferCompleteInterruptEnable | Flags::peripheralFlowController | Flags::memoryToPeripheral |
+			Flags::halfTransferInterruptEnable | Flags::transferCompleteInterruptDisable | Flags::dmaFlowController |
+					Flags::peripheralToMemory | Flags::circularModeDisable | Flags::peripheralFixed |
+					Flags::memoryFixed | Flags::highPriority,
+			Flags::halfTransferInterruptDisable | Flags::transferCompleteInterruptEnable |
+					Flags::peripheralFlowController | Flags::memoryToPeripheral | Flags::circularModeEnable |
 					Flags::peripheralIncrement | Flags::memoryIncrement | Flags::veryHighPriority,
 		};
 		const Flags peripheralDataSizes[]
@@ -211,6 +216,39 @@ TEST_CASE("Testing transfer configuration", "[configuration]")
 								flags | peripheralDataSize | memoryBurstDataSize | peripheralBurstSize);
 					}
 	}
+	SECTION("Trying to use valid configuration in double-buffer mode should succeed")
+	{
+		const Flags flagsArray[]
+		{
+			Flags::halfTransferInterruptDisable | Flags::transferCompleteInterruptEnable | Flags::peripheralToMemory |
+					Flags::peripheralFixed | Flags::memoryIncrement | Flags::dataSize1 | Flags::lowPriority,
+			Flags::halfTransferInterruptEnable | Flags::transferCompleteInterruptEnable | Flags::memoryToPeripheral |
+					Flags::peripheralFixed | Flags::memoryIncrement | Flags::dataSize2 | Flags::burstSize4 |
+					Flags::veryHighPriority,
+		};
+		for (const auto flags : flagsArray)
+		{
+			constexpr uintptr_t memoryAddress0 {0x5c4e3a40};
+			constexpr uintptr_t memoryAddress1 {0x3fa86b80};
+			constexpr uintptr_t peripheralAddress {0x8e0d1c60};
+			constexpr uint16_t transactions {0x6a1f};
+
+			REQUIRE_CALL(channelPeripheralMock, readCr()).IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE_CALL(channelPeripheralMock, writeNdtr(transactions)).IN_SEQUENCE(sequence);
+			REQUIRE_CALL(channelPeripheralMock, writePar(peripheralAddress)).IN_SEQUENCE(sequence);
+			REQUIRE_CALL(channelPeripheralMock, writeM0ar(memoryAddress0)).IN_SEQUENCE(sequence);
+			REQUIRE_CALL(channelPeripheralMock, writeM1ar(memoryAddress1)).IN_SEQUENCE(sequence);
+			const auto fcr = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH;
+			REQUIRE_CALL(channelPeripheralMock, writeFcr(fcr)).IN_SEQUENCE(sequence);
+			const auto cr = request1 << DMA_SxCR_CHSEL_Pos |
+					static_cast<uint32_t>(flags) |
+					DMA_SxCR_DBM |
+					DMA_SxCR_TEIE |
+					DMA_SxCR_EN;
+			REQUIRE_CALL(channelPeripheralMock, writeCr(cr)).IN_SEQUENCE(sequence);
+			handle.startTransfer(memoryAddress0, memoryAddress1, peripheralAddress, transactions, flags);
+		}
+	}
 
 	REQUIRE_CALL(channelPeripheralMock, readCr()).IN_SEQUENCE(sequence).RETURN(0);
 	handle.release();
@@ -261,9 +299,34 @@ TEST_CASE("Testing transfers", "[transfers]")
 		handle.stopTransfer();
 	}
 
-	SECTION("Testing interruptHandler() - both TCIF and TEIF flags cleared")
+	SECTION("Testing getCurrentMemory()")
 	{
-		const auto isr = UINT32_MAX & ~((DMA_LISR_TCIF0 | DMA_LISR_TEIF0) << channelShift);
+		for (const auto currentMemory : {0, 1})
+		{
+			const auto cr = UINT32_MAX & ~DMA_SxCR_CT | currentMemory << DMA_SxCR_CT_Pos;
+			REQUIRE_CALL(channelPeripheralMock, readCr()).IN_SEQUENCE(sequence).RETURN(cr);
+			REQUIRE(handle.getCurrentMemory() == currentMemory);
+		}
+	}
+	SECTION("Testing setMemoryAddress()")
+	{
+		for (const auto currentMemory : {0, 1})
+		{
+			constexpr uintptr_t memoryAddress {0x7b1e9d20};
+			const auto cr = UINT32_MAX & ~DMA_SxCR_CT | currentMemory << DMA_SxCR_CT_Pos;
+			REQUIRE_CALL(channelPeripheralMock, readCr()).IN_SEQUENCE(sequence).RETURN(cr);
+			if (currentMemory == 0)
+				expectations.emplace_back(NAMED_REQUIRE_CALL(channelPeripheralMock,
+						writeM1ar(memoryAddress)).IN_SEQUENCE(sequence));
+			else
+				expectations.emplace_back(NAMED_REQUIRE_CALL(channelPeripheralMock,
+						writeM0ar(memoryAddress)).IN_SEQUENCE(sequence));
+			handle.setMemoryAddress(!currentMemory, memoryAddress);
+		}
+	}
+	SECTION("Testing interruptHandler() - TCIF, HTIF and TEIF flags cleared")
+	{
+		const auto isr = UINT32_MAX & ~((DMA_LISR_TCIF0 | DMA_LISR_HTIF0 | DMA_LISR_TEIF0) << channelShift);
 		if (channelId <= 3)
 			expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
 					readLisr()).IN_SEQUENCE(sequence).RETURN(isr));
@@ -277,85 +340,102 @@ TEST_CASE("Testing transfers", "[transfers]")
 			false,
 			true,
 	};
-	SECTION("Testing interruptHandler() - TCIF and/or TEIF flags set but corresponding interrupts disabled")
+	SECTION("Testing interruptHandler() - TCIF, HTIF and/or TEIF flags set but corresponding interrupts disabled")
 	{
 		for (const auto tcif : falseTrue)
-			for (const auto teif : falseTrue)
-			{
-				if (tcif == false && teif == false)
-					continue;
-
-				const auto isr = UINT32_MAX & ~((DMA_LISR_TCIF0 | DMA_LISR_TEIF0) << channelShift) |
-						tcif << (DMA_LISR_TCIF0_Pos + channelShift) |
-						teif << (DMA_LISR_TEIF0_Pos + channelShift);
-				if (channelId <= 3)
-					expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
-							readLisr()).IN_SEQUENCE(sequence).RETURN(isr));
-				else
-					expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
-							readHisr()).IN_SEQUENCE(sequence).RETURN(isr));
-				const auto cr = UINT32_MAX & ~(DMA_SxCR_TCIE | DMA_SxCR_TEIE) |
-						!tcif << DMA_SxCR_TCIE_Pos |
-						!teif << DMA_SxCR_TEIE_Pos;
-				REQUIRE_CALL(channelPeripheralMock, readCr()).IN_SEQUENCE(sequence).RETURN(cr);
-				channel.interruptHandler();
-			}
+			for (const auto htif : falseTrue)
+				for (const auto teif : falseTrue)
+				{
+					if (tcif == false && htif == false && teif == false)
+						continue;
+
+					const auto isr = UINT32_MAX &
+							~((DMA_LISR_TCIF0 | DMA_LISR_HTIF0 | DMA_LISR_TEIF0) << channelShift) |
+							tcif << (DMA_LISR_TCIF0_Pos + channelShift) |
+							htif << (DMA_LISR_HTIF0_Pos + channelShift) |
+							teif << (DMA_LISR_TEIF0_Pos + channelShift);
+					if (channelId <= 3)
+						expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
+								readLisr()).IN_SEQUENCE(sequence).RETURN(isr));
+					else
+						expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
+								readHisr()).IN_SEQUENCE(sequence).RETURN(isr));
+					const auto cr = UINT32_MAX & ~(DMA_SxCR_TCIE | DMA_SxCR_HTIE | DMA_SxCR_TEIE) |
+							!tcif << DMA_SxCR_TCIE_Pos |
+							!htif << DMA_SxCR_HTIE_Pos |
+							!teif << DMA_SxCR_TEIE_Pos;
+					REQUIRE_CALL(channelPeripheralMock, readCr()).IN_SEQUENCE(sequence).RETURN(cr);
+					channel.interruptHandler();
+				}
 	}
-	SECTION("Testing interruptHandler() - TCIF and/or TEIF flags set and corresponding interrupts enabled")
+	SECTION("Testing interruptHandler() - TCIF, HTIF and/or TEIF flags set and corresponding interrupts enabled")
 	{
 		for (const auto tcif : falseTrue)
-			for (const auto teif : falseTrue)
-				for (const auto tcie : falseTrue)
-					for (const auto teie : falseTrue)
-					{
-						if ((tcif && tcie) == false && (teif && teie) == false)
-							continue;
-
-						DYNAMIC_SECTION("Testing interruptHandler() - "
-								"TCIF flag " << (tcif == false ? "cleared" : "set") <<
-								", TEIF flag " << (teif == false ? "cleared" : "set") <<
-								", TC interrupt " << (tcie == false ? "disabled" : "enabled") <<
-								" and TE interrupt " << (teie == false ? "disabled" : "enabled"))
-						{
-							const auto isr = UINT32_MAX & ~((DMA_LISR_TCIF0 | DMA_LISR_TEIF0) << channelShift) |
-									tcif << (DMA_LISR_TCIF0_Pos + channelShift) |
-									teif << (DMA_LISR_TEIF0_Pos + channelShift);
-							if (channelId <= 3)
-								expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
-										readLisr()).IN_SEQUENCE(sequence).RETURN(isr));
-							else
-								expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
-										readHisr()).IN_SEQUENCE(sequence).RETURN(isr));
-							const auto cr = UINT32_MAX & ~(DMA_SxCR_TCIE | DMA_SxCR_TEIE) |
-									tcie << DMA_SxCR_TCIE_Pos |
-									teie << DMA_SxCR_TEIE_Pos;
-							REQUIRE_CALL(channelPeripheralMock, readCr()).IN_SEQUENCE(sequence).RETURN(cr);
-							const uint32_t ifcr = (tcif && tcie) << (DMA_LIFCR_CTCIF0_Pos + channelShift) |
-									(teif && teie) << (DMA_LIFCR_CTEIF0_Pos + channelShift);
-							if (channelId <= 3)
-								expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
-										writeLifcr(ifcr)).IN_SEQUENCE(sequence));
-							else
-								expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
-										writeHifcr(ifcr)).IN_SEQUENCE(sequence));
-
-							if ((tcif && tcie) == true)
-							{
-								expectations.emplace_back(NAMED_REQUIRE_CALL(functorMock,
-										transferCompleteEvent()).IN_SEQUENCE(sequence));
-							}
-							if ((teif && teie) == true)
+			for (const auto htif : falseTrue)
+				for (const auto teif : falseTrue)
+					for (const auto tcie : falseTrue)
+						for (const auto htie : falseTrue)
+							for (const auto teie : falseTrue)
 							{
-								constexpr uint16_t transactionsLeft {0xba61};
-								expectations.emplace_back(NAMED_REQUIRE_CALL(channelPeripheralMock,
-										readNdtr()).IN_SEQUENCE(sequence).RETURN(transactionsLeft));
-								expectations.emplace_back(NAMED_REQUIRE_CALL(functorMock,
-										transferErrorEvent(transactionsLeft)).IN_SEQUENCE(sequence));
+								if ((tcif && tcie) == false && (htif && htie) == false && (teif && teie) == false)
+									continue;
+
+								DYNAMIC_SECTION("Testing interruptHandler() - "
+										"TCIF flag " << (tcif == false ? "cleared" : "set") <<
+										", HTIF flag " << (htif == false ? "cleared" : "set") <<
+										", TEIF flag " << (teif == false ? "cleared" : "set") <<
+										", TC interrupt " << (tcie == false ? "disabled" : "enabled") <<
+										", HT interrupt " << (htie == false ? "disabled" : "enabled") <<
+										" and TE interrupt " << (teie == false ? "disabled" : "enabled"))
+								{
+									const auto isr = UINT32_MAX &
+											~((DMA_LISR_TCIF0 | DMA_LISR_HTIF0 | DMA_LISR_TEIF0) << channelShift) |
+											tcif << (DMA_LISR_TCIF0_Pos + channelShift) |
+											htif << (DMA_LISR_HTIF0_Pos + channelShift) |
+											teif << (DMA_LISR_TEIF0_Pos + channelShift);
+									if (channelId <= 3)
+										expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
+												readLisr()).IN_SEQUENCE(sequence).RETURN(isr));
+									else
+										expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
+												readHisr()).IN_SEQUENCE(sequence).RETURN(isr));
+									const auto cr = UINT32_MAX & ~(DMA_SxCR_TCIE | DMA_SxCR_HTIE | DMA_SxCR_TEIE) |
+											tcie << DMA_SxCR_TCIE_Pos |
+											htie << DMA_SxCR_HTIE_Pos |
+											teie << DMA_SxCR_TEIE_Pos;
+									REQUIRE_CALL(channelPeripheralMock, readCr()).IN_SEQUENCE(sequence).RETURN(cr);
+									const uint32_t ifcr = (tcif && tcie) << (DMA_LIFCR_CTCIF0_Pos + channelShift) |
+											(htif && htie) << (DMA_LIFCR_CHTIF0_Pos + channelShift) |
+											(teif && teie) << (DMA_LIFCR_CTEIF0_Pos + channelShift);
+									if (channelId <= 3)
+										expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
+												writeLifcr(ifcr)).IN_SEQUENCE(sequence));
+									else
+										expectations.emplace_back(NAMED_REQUIRE_CALL(peripheralMock,
+												writeHifcr(ifcr)).IN_SEQUENCE(sequence));
+
+									if ((htif && htie) == true)
+									{
+										expectations.emplace_back(NAMED_REQUIRE_CALL(functorMock,
+												halfTransferEvent()).IN_SEQUENCE(sequence));
+									}
+									if ((tcif && tcie) == true)
+									{
+										expectations.emplace_back(NAMED_REQUIRE_CALL(functorMock,
+												transferCompleteEvent()).IN_SEQUENCE(sequence));
+									}
+									if ((teif && teie) == true)
+									{
+										constexpr uint16_t transactionsLeft {0xba61};
+										expectations.emplace_back(NAMED_REQUIRE_CALL(channelPeripheralMock,
+												readNdtr()).IN_SEQUENCE(sequence).RETURN(transactionsLeft));
+										expectations.emplace_back(NAMED_REQUIRE_CALL(functorMock,
+												transferErrorEvent(transactionsLeft)).IN_SEQUENCE(sequence));
+									}
+
+									channel.interruptHandler();
+								}
 							}
-
-							channel.interruptHandler();
-						}
-					}
 	}
 
 	REQUIRE_CALL(channelPeripheralMock, readCr()).IN_SEQUENCE(sequence).RETURN(0);
@@ -0,0 +1,173 @@
+/**
+ * \file
+ * \brief STM32 DMAv2's DmaMemcpy test cases
+ *
+ * This test checks whether STM32 DMAv2's DmaMemcpy performs all DMA operations properly and in correct order.
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/chip/DmaChannel.hpp"
+#include "distortos/chip/DmaMemcpy.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/Semaphore.hpp"
+
+#include <cstring>
+
+using trompeloeil::_;
+using Flags = distortos::chip::DmaChannel::Flags;
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t threshold {64};
+constexpr auto commonFlags = Flags::transferCompleteInterruptEnable | Flags::memoryToMemory |
+		Flags::peripheralIncrement | Flags::memoryIncrement | Flags::lowPriority;
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global test cases
++---------------------------------------------------------------------------------------------------------------------*/
+
+TEST_CASE("Testing copies done by the CPU", "[cpu]")
+{
+	distortos::chip::DmaChannel dmaChannelMock {};
+	distortos::InterruptMaskingLock::Proxy interruptMaskingLockProxyMock {};
+	distortos::mock::Semaphore semaphoreMock {};
+
+	ALLOW_CALL(interruptMaskingLockProxyMock, construct());
+	ALLOW_CALL(interruptMaskingLockProxyMock, destruct());
+
+	distortos::chip::DmaMemcpy dmaMemcpy {dmaChannelMock, threshold};
+
+	uint8_t source[threshold];
+	for (size_t i {}; i < sizeof(source); ++i)
+		source[i] = i * 3 + 1;
+	uint8_t destination[sizeof(source)] {};
+
+	SECTION("Copy smaller than threshold should be done with memcpy()")
+	{
+		REQUIRE(dmaMemcpy.copy(destination, source, threshold - 1) == 0);
+		REQUIRE(memcmp(destination, source, threshold - 1) == 0);
+		REQUIRE(destination[threshold - 1] == 0);
+	}
+	SECTION("Copy for which DMA channel cannot be reserved should be done with memcpy()")
+	{
+		REQUIRE_CALL(dmaChannelMock, reserve(0, _)).RETURN(EBUSY);
+		REQUIRE(dmaMemcpy.copy(destination, source, sizeof(source)) == 0);
+		REQUIRE(memcmp(destination, source, sizeof(source)) == 0);
+	}
+	SECTION("Asynchronous copy smaller than threshold should be done with memcpy()")
+	{
+		REQUIRE(dmaMemcpy.startCopy(destination, source, threshold - 1) == 0);
+		REQUIRE(memcmp(destination, source, threshold - 1) == 0);
+		REQUIRE(dmaMemcpy.startCopy(destination, source, threshold - 1) == EBUSY);
+		REQUIRE(dmaMemcpy.waitForCompletion() == 0);
+	}
+}
+
+TEST_CASE("Testing copies done by DMA", "[dma]")
+{
+	distortos::chip::DmaChannel dmaChannelMock {};
+	distortos::InterruptMaskingLock::Proxy interruptMaskingLockProxyMock {};
+	distortos::mock::Semaphore semaphoreMock {};
+	trompeloeil::sequence sequence {};
+
+	ALLOW_CALL(interruptMaskingLockProxyMock, construct());
+	ALLOW_CALL(interruptMaskingLockProxyMock, destruct());
+
+	distortos::chip::DmaMemcpy dmaMemcpy {dmaChannelMock, threshold};
+	distortos::chip::DmaChannelFunctor* functor {};
+
+	SECTION("Data size should be selected according to alignment of addresses and size")
+	{
+		const struct
+		{
+			uintptr_t destination;
+			uintptr_t source;
+			size_t size;
+			Flags dataSizeFlags;
+			size_t transactions;
+		} configurations[]
+		{
+				{0x20000000, 0x20001000, 0x100, Flags::dataSize4, 0x40},
+				{0x20000002, 0x20001000, 0x100, Flags::dataSize2, 0x80},
+				{0x20000000, 0x20001002, 0x100, Flags::dataSize2, 0x80},
+				{0x20000000, 0x20001000, 0x102, Flags::dataSize2, 0x81},
+				{0x20000001, 0x20001000, 0x100, Flags::dataSize1, 0x100},
+				{0x20000000, 0x20001000, 0x101, Flags::dataSize1, 0x101},
+		};
+		for (auto& configuration : configurations)
+		{
+			DYNAMIC_SECTION("destination: " << configuration.destination << ", source: " << configuration.source <<
+					", size: " << configuration.size)
+			{
+				REQUIRE_CALL(dmaChannelMock, reserve(0, _)).IN_SEQUENCE(sequence).LR_SIDE_EFFECT(functor = &_2)
+						.RETURN(0);
+				REQUIRE_CALL(dmaChannelMock, startTransfer(configuration.destination, configuration.source,
+						configuration.transactions, configuration.dataSizeFlags | commonFlags)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).LR_SIDE_EFFECT(
+						functor->transferCompleteEvent()).RETURN(0);
+				REQUIRE_CALL(dmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+				REQUIRE_CALL(dmaChannelMock, release()).IN_SEQUENCE(sequence);
+				REQUIRE(dmaMemcpy.copy(reinterpret_cast<void*>(configuration.destination),
+						reinterpret_cast<const void*>(configuration.source), configuration.size) == 0);
+			}
+		}
+	}
+	SECTION("Large copy should be split into chunks")
+	{
+		constexpr uintptr_t destination {0x20000001};
+		constexpr uintptr_t source {0x20100000};
+		constexpr size_t size {UINT16_MAX + 0x1234};
+
+		REQUIRE_CALL(dmaChannelMock, reserve(0, _)).IN_SEQUENCE(sequence).LR_SIDE_EFFECT(functor = &_2).RETURN(0);
+		REQUIRE_CALL(dmaChannelMock, startTransfer(destination, source, UINT16_MAX, Flags::dataSize1 | commonFlags))
+				.IN_SEQUENCE(sequence);
+		REQUIRE(dmaMemcpy.startCopy(reinterpret_cast<void*>(destination), reinterpret_cast<const void*>(source),
+				size) == 0);
+
+		REQUIRE(dmaMemcpy.startCopy(reinterpret_cast<void*>(destination), reinterpret_cast<const void*>(source),
+				size) == EBUSY);
+
+		REQUIRE_CALL(dmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+		REQUIRE_CALL(dmaChannelMock, startTransfer(destination + UINT16_MAX, source + UINT16_MAX, 0x1234u,
+				Flags::dataSize1 | commonFlags)).IN_SEQUENCE(sequence);
+		functor->transferCompleteEvent();
+
+		// copy finished before waitForCompletion() - no waiting and no notification
+		REQUIRE_CALL(dmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+		functor->transferCompleteEvent();
+
+		REQUIRE_CALL(dmaChannelMock, release()).IN_SEQUENCE(sequence);
+		REQUIRE(dmaMemcpy.waitForCompletion() == 0);
+	}
+	SECTION("Transfer error should be reported with EIO")
+	{
+		constexpr uintptr_t destination {0x20000000};
+		constexpr uintptr_t source {0x20001000};
+		constexpr size_t size {0x1000};
+
+		REQUIRE_CALL(dmaChannelMock, reserve(0, _)).IN_SEQUENCE(sequence).LR_SIDE_EFFECT(functor = &_2).RETURN(0);
+		REQUIRE_CALL(dmaChannelMock, startTransfer(destination, source, size / 4, Flags::dataSize4 | commonFlags))
+				.IN_SEQUENCE(sequence);
+		REQUIRE_CALL(semaphoreMock, wait()).IN_SEQUENCE(sequence).LR_SIDE_EFFECT(
+				functor->transferErrorEvent(0x123)).RETURN(0);
+		REQUIRE_CALL(dmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+		REQUIRE_CALL(semaphoreMock, post()).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(dmaChannelMock, release()).IN_SEQUENCE(sequence);
+		REQUIRE(dmaMemcpy.copy(reinterpret_cast<void*>(destination), reinterpret_cast<const void*>(source), size) ==
+				EIO);
+	}
+}
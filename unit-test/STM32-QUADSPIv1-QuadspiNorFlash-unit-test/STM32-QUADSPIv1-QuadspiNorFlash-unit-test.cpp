@@ -0,0 +1,750 @@
+/**
+ * \file
+ * \brief STM32 QUADSPIv1's QuadspiNorFlash test cases
+ *
+ * This test checks whether STM32 QUADSPIv1's QuadspiNorFlash executes proper commands on a simulated QSPI NOR flash
+ * and whether it handles all h/w events properly.
+ *
+ * \author Copyright (C) 2020 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/chip/DmaChannel.hpp"
+#include "distortos/chip/QuadspiNorFlash.hpp"
+#include "distortos/chip/STM32-QUADSPIv1-QuadspiPeripheral.hpp"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <cstring>
+
+using trompeloeil::_;
+using Flags = distortos::chip::DmaChannel::Flags;
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+constexpr uint8_t dmaRequest {0x5b};
+constexpr uintptr_t drAddress {0x7a7ea520};
+constexpr uint32_t peripheralFrequency {216000000};
+constexpr size_t flashSize {64 * 1024};
+constexpr size_t pageSize {256};
+
+/// CR value after open() with default clock frequency (50 MHz) - 216 MHz / (4 + 1) = 43.2 MHz
+constexpr uint32_t openedCr {4 << QUADSPI_CR_PRESCALER_Pos | QUADSPI_CR_SSHIFT | QUADSPI_CR_EN};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// simulated QSPI NOR flash with 4 kB and 64 kB erase types, connected to simulated QUADSPI and DMA channel
+class Simulator
+{
+public:
+
+	/// "Quad Enable Requirements" value from SFDP used by the simulated flash
+	constexpr static uint8_t qerStatusRegister1Bit6 {2};
+
+	/**
+	 * \brief Simulator's constructor
+	 *
+	 * \param [in] quadEnableRequirements is the value of "Quad Enable Requirements" bit field in SFDP
+	 */
+
+	explicit Simulator(const uint8_t quadEnableRequirements = qerStatusRegister1Bit6) :
+			memory{},
+			instructions{},
+			peripheralMock{},
+			dmaChannelMock{},
+			semaphoreMock{},
+			tickClockMock{},
+			flash{},
+			ar{},
+			ccr{},
+			cr{},
+			dcr{},
+			dlr{},
+			pir{},
+			psmar{},
+			psmkr{},
+			sr{},
+			abortCount{},
+			statusRegister1{},
+			stuck{},
+			transferError{},
+			expectations_{},
+			sfdp_{},
+			dmaChannelFunctor_{},
+			dmaFlags_{},
+			dmaMemoryAddress_{},
+			dmaTransactions_{},
+			semaphoreValue_{},
+			autoPolling_{},
+			resetEnabled_{}
+	{
+		memory.fill(0xff);
+		buildSfdp(quadEnableRequirements);
+
+		expectations_.emplace_back(NAMED_ALLOW_CALL(mutexMock, lock()).RETURN(0));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(mutexMock, unlock()).RETURN(0));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(tickClockMock, nowMock())
+				.RETURN(distortos::TickClock::time_point{}));
+
+		expectations_.emplace_back(NAMED_ALLOW_CALL(semaphoreMock, post()).LR_SIDE_EFFECT(++semaphoreValue_).RETURN(0));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(semaphoreMock, wait())
+				.LR_WITH(semaphoreValue_ != 0).LR_SIDE_EFFECT(--semaphoreValue_).RETURN(0));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(semaphoreMock, tryWait()).LR_RETURN(tryWaitImplementation(EAGAIN)));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(semaphoreMock, tryWaitUntil(_))
+				.LR_RETURN(tryWaitImplementation(ETIMEDOUT)));
+
+		expectations_.emplace_back(NAMED_ALLOW_CALL(dmaChannelMock, reserve(dmaRequest, _))
+				.LR_SIDE_EFFECT(dmaChannelFunctor_ = &_2).RETURN(0));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(dmaChannelMock, release()));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(dmaChannelMock, startTransfer(_, drAddress, _, _))
+				.LR_SIDE_EFFECT(dmaMemoryAddress_ = _1).LR_SIDE_EFFECT(dmaTransactions_ = _3)
+				.LR_SIDE_EFFECT(dmaFlags_ = _4));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(dmaChannelMock, stopTransfer()));
+
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, getDrAddress()).RETURN(drAddress));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, getMemoryMappedBase())
+				.LR_RETURN(reinterpret_cast<uintptr_t>(memory.data())));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, getPeripheralFrequency())
+				.RETURN(peripheralFrequency));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, readCr()).LR_RETURN(cr));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, readDcr()).LR_RETURN(dcr));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, readSr()).LR_RETURN(sr));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, writeAbr(UINT32_MAX)));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, writeAr(_)).LR_SIDE_EFFECT(writeAr(_1)));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, writeCcr(_)).LR_SIDE_EFFECT(writeCcr(_1)));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, writeCr(_)).LR_SIDE_EFFECT(writeCr(_1)));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, writeDcr(_)).LR_SIDE_EFFECT(dcr = _1));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, writeDlr(_)).LR_SIDE_EFFECT(dlr = _1));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, writeFcr(_)).LR_SIDE_EFFECT(sr &= ~_1));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, writePir(_)).LR_SIDE_EFFECT(pir = _1));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, writePsmar(_)).LR_SIDE_EFFECT(psmar = _1));
+		expectations_.emplace_back(NAMED_ALLOW_CALL(peripheralMock, writePsmkr(_)).LR_SIDE_EFFECT(psmkr = _1));
+	}
+
+	/**
+	 * \return instruction of read command in CCR
+	 */
+
+	uint8_t getCcrInstruction() const
+	{
+		return ccr & QUADSPI_CCR_INSTRUCTION;
+	}
+
+	/// contents of simulated flash
+	std::array<uint8_t, flashSize> memory;
+
+	/// all instructions executed by simulated flash
+	std::vector<uint8_t> instructions;
+
+	/// mocks of distortos objects
+	distortos::mock::Mutex mutexMock {distortos::mock::Mutex::UnitTestTag{}};
+	distortos::chip::QuadspiPeripheral peripheralMock;
+	distortos::chip::DmaChannel dmaChannelMock;
+	distortos::mock::Semaphore semaphoreMock;
+	distortos::TickClock tickClockMock;
+
+	/// driver under test, must be set before first transaction
+	distortos::chip::QuadspiNorFlash* flash;
+
+	/// simulated registers of QUADSPI
+	uint32_t ar;
+	uint32_t ccr;
+	uint32_t cr;
+	uint32_t dcr;
+	uint32_t dlr;
+	uint32_t pir;
+	uint32_t psmar;
+	uint32_t psmkr;
+	uint32_t sr;
+
+	/// number of aborts requested by driver
+	size_t abortCount;
+
+	/// status register 1 of simulated flash
+	uint8_t statusRegister1;
+
+	/// true if write operations of simulated flash never finish
+	bool stuck;
+
+	/// true if next transaction should fail with transfer error
+	bool transferError;
+
+private:
+
+	/**
+	 * \brief Builds SFDP of simulated flash.
+	 *
+	 * \param [in] quadEnableRequirements is the value of "Quad Enable Requirements" bit field in SFDP
+	 */
+
+	void buildSfdp(const uint8_t quadEnableRequirements)
+	{
+		const uint32_t dwords[]
+		{
+				// SFDP header - signature, revision 1.6, 2 parameter headers
+				0x50444653,
+				0xff010106,
+				// basic flash parameter header - revision 1.6, 16 DWORDs at 0x20
+				0x10010600,
+				0xff000020,
+				// sector map parameter header - revision 1.6, 2 DWORDs at 0x60
+				0x02010681,
+				0xff000060,
+				0xffffffff,
+				0xffffffff,
+				// basic flash parameter table - 1-1-4 and 1-4-4 fast reads, 3-byte addressing
+				1 << 22 | 1 << 21 | 0x20 << 8 | 1 << 0,
+				flashSize * CHAR_BIT - 1,
+				// 1-1-4 - 0x6b, 8 dummy clocks, 0 mode clocks; 1-4-4 - 0xeb, 4 dummy clocks, 2 mode clocks
+				0x6bu << 24 | 0 << 21 | 8 << 16 | 0xeb << 8 | 2 << 5 | 4 << 0,
+				0,
+				0,
+				0,
+				0,
+				// erase type 1 - 4 kB with 0x20, erase type 2 - 64 kB with 0xd8
+				0xd8u << 24 | 16 << 16 | 0x20 << 8 | 12 << 0,
+				0,
+				// typical erase times - type 1: 3 x 16 ms, type 2: 4 x 128 ms, multiplier 2
+				2 << 16 | 3 << 11 | 1 << 9 | 2 << 4 | 0 << 0,
+				// typical chip erase time - 2 x 4 s, page size - 256 bytes
+				2u << 29 | 1 << 24 | 8 << 4,
+				0,
+				0,
+				0,
+				static_cast<uint32_t>(quadEnableRequirements) << 20,
+				// software reset with 0x66 & 0x99
+				0x10 << 8,
+				// sector map - single configuration with single region, erase types 1 and 2
+				0x00000003,
+				(flashSize / 256 - 1) << 8 | 0b0011,
+		};
+		static_assert(sizeof(dwords) <= sizeof(sfdp_), "SFDP doesn't fit in the buffer!");
+		memcpy(sfdp_.data(), dwords, sizeof(dwords));
+	}
+
+	/**
+	 * \brief Executes command which was set up in simulated QUADSPI.
+	 */
+
+	void execute()
+	{
+		const uint8_t instruction = ccr & QUADSPI_CCR_INSTRUCTION;
+		instructions.push_back(instruction);
+
+		if (transferError == true)
+		{
+			transferError = {};
+			sr |= QUADSPI_SR_TEF;
+			if ((cr & QUADSPI_CR_TEIE) != 0)
+				flash->interruptHandler();
+			return;
+		}
+
+		const auto size = (ccr & QUADSPI_CCR_DMODE) != 0 ? dlr + 1 : 0;
+		if (size != 0)
+		{
+			REQUIRE((cr & QUADSPI_CR_DMAEN) != 0);
+			REQUIRE(dmaTransactions_ == size);
+		}
+
+		const auto read = (ccr & QUADSPI_CCR_FMODE) == QUADSPI_CCR_FMODE_0;
+		if (read == true)
+		{
+			const auto buffer = reinterpret_cast<uint8_t*>(dmaMemoryAddress_);
+			for (size_t i {}; i < size; ++i)
+				buffer[i] = readByte(instruction, ar + i);
+
+			REQUIRE((dmaFlags_ & Flags::transferCompleteInterruptEnable) == Flags::transferCompleteInterruptEnable);
+			REQUIRE(dmaChannelFunctor_ != nullptr);
+			dmaChannelFunctor_->transferCompleteEvent();
+			return;
+		}
+
+		write(instruction, reinterpret_cast<const uint8_t*>(dmaMemoryAddress_), size);
+		sr |= QUADSPI_SR_TCF;
+		REQUIRE((cr & QUADSPI_CR_TCIE) != 0);
+		flash->interruptHandler();
+	}
+
+	/**
+	 * \brief Finishes current write operation of simulated flash.
+	 */
+
+	void finishWrite()
+	{
+		statusRegister1 &= ~0b11;
+	}
+
+	/**
+	 * \brief Reads byte from simulated flash.
+	 *
+	 * \param [in] instruction is the read instruction
+	 * \param [in] address is the address of byte
+	 *
+	 * \return byte read from simulated flash
+	 */
+
+	uint8_t readByte(const uint8_t instruction, const uint32_t address) const
+	{
+		if (instruction == 0x5a)
+		{
+			REQUIRE((ccr & QUADSPI_CCR_DCYC) >> QUADSPI_CCR_DCYC_Pos == 8);
+			return address < sfdp_.size() ? sfdp_[address] : 0xff;
+		}
+		if (instruction == 0x05)
+			return statusRegister1;
+
+		REQUIRE((statusRegister1 & 1) == 0);
+		REQUIRE(address < memory.size());
+		return memory[address];
+	}
+
+	/**
+	 * \brief Implementation of Semaphore::tryWait() and Semaphore::tryWaitUntil().
+	 *
+	 * \param [in] errorCode is the error code returned when semaphore is not available
+	 *
+	 * \return 0 if semaphore was available, \a errorCode otherwise
+	 */
+
+	int tryWaitImplementation(const int errorCode)
+	{
+		if (semaphoreValue_ == 0)
+			return errorCode;
+
+		--semaphoreValue_;
+		return 0;
+	}
+
+	/**
+	 * \brief Executes write command on simulated flash.
+	 *
+	 * \param [in] instruction is the write instruction
+	 * \param [in] buffer is the buffer with written data
+	 * \param [in] size is the size of \a buffer
+	 */
+
+	void write(const uint8_t instruction, const uint8_t* const buffer, const size_t size)
+	{
+		if (instruction == 0x06)
+		{
+			statusRegister1 |= 0b10;
+			return;
+		}
+		if (instruction == 0x66)
+		{
+			resetEnabled_ = true;
+			return;
+		}
+		if (instruction == 0x99)
+		{
+			REQUIRE(resetEnabled_ == true);
+			resetEnabled_ = {};
+			statusRegister1 &= 0x40;
+			return;
+		}
+
+		// all other instructions require write enable and start write operation
+		REQUIRE((statusRegister1 & 0b11) == 0b10);
+		REQUIRE((ccr & QUADSPI_CCR_DMODE) == (size != 0 ? QUADSPI_CCR_DMODE_0 : 0));
+
+		if (instruction == 0x01)
+		{
+			REQUIRE(size == 1);
+			statusRegister1 = (buffer[0] & 0xfc) | 0b10;
+		}
+		else if (instruction == 0x02)
+		{
+			REQUIRE(size <= pageSize);
+			REQUIRE(ar / pageSize == (ar + size - 1) / pageSize);
+			for (size_t i {}; i < size; ++i)
+				memory[ar + i] &= buffer[i];
+		}
+		else if (instruction == 0x20 || instruction == 0xd8)
+		{
+			const size_t eraseSize = instruction == 0x20 ? 4096 : 65536;
+			REQUIRE(ar % eraseSize == 0);
+			memset(memory.data() + ar, 0xff, eraseSize);
+		}
+		else if (instruction == 0xc7)
+			memory.fill(0xff);
+		else
+			FAIL("Unexpected write instruction " << static_cast<int>(instruction));
+
+		statusRegister1 |= 1;
+	}
+
+	/**
+	 * \brief Writes AR register of simulated QUADSPI.
+	 *
+	 * \param [in] value is the value written to AR register
+	 */
+
+	void writeAr(const uint32_t value)
+	{
+		ar = value;
+		if ((ccr & QUADSPI_CCR_FMODE) != QUADSPI_CCR_FMODE && (ccr & QUADSPI_CCR_ADMODE) != 0)
+			execute();
+	}
+
+	/**
+	 * \brief Writes CCR register of simulated QUADSPI.
+	 *
+	 * \param [in] value is the value written to CCR register
+	 */
+
+	void writeCcr(const uint32_t value)
+	{
+		ccr = value;
+		const auto fmode = ccr & QUADSPI_CCR_FMODE;
+		if (fmode == QUADSPI_CCR_FMODE)	// memory-mapped mode
+			return;
+
+		if (fmode == QUADSPI_CCR_FMODE_1)	// automatic status polling mode
+		{
+			REQUIRE((ccr & QUADSPI_CCR_INSTRUCTION) == 0x05);
+			REQUIRE((cr & QUADSPI_CR_APMS) != 0);
+			REQUIRE(dlr == 0);
+			instructions.push_back(0x05);
+			if (stuck == false)
+				finishWrite();
+			if ((statusRegister1 & psmkr) != psmar)
+			{
+				autoPolling_ = true;
+				return;
+			}
+
+			sr |= QUADSPI_SR_SMF;
+			REQUIRE((cr & QUADSPI_CR_SMIE) != 0);
+			flash->interruptHandler();
+			return;
+		}
+
+		if ((ccr & QUADSPI_CCR_ADMODE) == 0)
+			execute();
+	}
+
+	/**
+	 * \brief Writes CR register of simulated QUADSPI.
+	 *
+	 * \param [in] value is the value written to CR register
+	 */
+
+	void writeCr(const uint32_t value)
+	{
+		if ((value & QUADSPI_CR_ABORT) != 0)
+		{
+			++abortCount;
+			autoPolling_ = {};
+			ccr = {};
+		}
+
+		cr = value & ~QUADSPI_CR_ABORT;
+	}
+
+	/// expectations of simulated h/w
+	std::vector<std::unique_ptr<trompeloeil::expectation>> expectations_;
+
+	/// SFDP of simulated flash
+	std::array<uint8_t, 0x68> sfdp_;
+
+	/// functor of DMA channel
+	distortos::chip::DmaChannelFunctor* dmaChannelFunctor_;
+
+	/// flags of current DMA transfer
+	Flags dmaFlags_;
+
+	/// memory address of current DMA transfer
+	uintptr_t dmaMemoryAddress_;
+
+	/// number of transactions of current DMA transfer
+	size_t dmaTransactions_;
+
+	/// value of semaphore
+	unsigned int semaphoreValue_;
+
+	/// true if automatic status polling is in progress
+	bool autoPolling_;
+
+	/// true if software reset was enabled
+	bool resetEnabled_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Fills buffer with pattern.
+ *
+ * \param [out] buffer is the buffer which will be filled
+ * \param [in] size is the size of \a buffer
+ * \param [in] seed is the seed of pattern
+ */
+
+void fillPattern(uint8_t* const buffer, const size_t size, const uint8_t seed)
+{
+	for (size_t i {}; i < size; ++i)
+		buffer[i] = seed + i * 7 + (i >> 8);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global test cases
++---------------------------------------------------------------------------------------------------------------------*/
+
+TEST_CASE("Testing open() & close()", "[open/close]")
+{
+	Simulator simulator {};
+	distortos::chip::QuadspiNorFlash flash {simulator.peripheralMock, simulator.dmaChannelMock, dmaRequest};
+	simulator.flash = &flash;
+
+	SECTION("Opening when DMA channel is busy should fail with EBUSY")
+	{
+		REQUIRE_CALL(simulator.dmaChannelMock, reserve(dmaRequest, _)).RETURN(EBUSY);
+		REQUIRE(flash.open() == EBUSY);
+		REQUIRE(simulator.instructions.empty() == true);
+		REQUIRE(simulator.cr == 0);
+	}
+	SECTION("Opening should configure QUADSPI, parse SFDP and enable quad mode")
+	{
+		REQUIRE(flash.open() == 0);
+
+		REQUIRE(simulator.cr == openedCr);
+		// 16-bit address space, chip select high for 3 cycles
+		REQUIRE(simulator.dcr == (15 << QUADSPI_DCR_FSIZE_Pos | 2 << QUADSPI_DCR_CSHT_Pos));
+		REQUIRE(simulator.psmkr == 1);
+		REQUIRE(simulator.psmar == 0);
+		REQUIRE(simulator.pir == 432);
+		REQUIRE(flash.getSize() == flashSize);
+		REQUIRE(flash.getEraseBlockSize() == 4096);
+		REQUIRE(flash.getProgramBlockSize() == 1);
+		REQUIRE(flash.getReadBlockSize() == 1);
+		// quad enable bit set with "write status register" preceded by "write enable"
+		REQUIRE((simulator.statusRegister1 & 0x40) != 0);
+		const std::vector<uint8_t> expectedTail {0x05, 0x06, 0x01, 0x05, 0x05};
+		REQUIRE(simulator.instructions.size() > expectedTail.size());
+		REQUIRE(std::equal(expectedTail.begin(), expectedTail.end(),
+				simulator.instructions.end() - expectedTail.size()));
+
+		// second open should not touch the hardware
+		simulator.instructions.clear();
+		REQUIRE(flash.open() == 0);
+		REQUIRE(flash.close() == 0);
+		REQUIRE(simulator.instructions.empty() == true);
+
+		REQUIRE_CALL(simulator.dmaChannelMock, release());
+		REQUIRE(flash.close() == 0);
+		REQUIRE(simulator.cr == 0);
+		REQUIRE(simulator.dcr == 0);
+	}
+	SECTION("Transfer error during opening should abort the transaction and fail with EIO")
+	{
+		simulator.transferError = true;
+		REQUIRE_CALL(simulator.dmaChannelMock, release());
+		REQUIRE(flash.open() == EIO);
+		REQUIRE(simulator.abortCount == 1);
+		REQUIRE(simulator.cr == 0);
+	}
+}
+
+TEST_CASE("Testing read()", "[read]")
+{
+	SECTION("Reading with 1-4-4 fast read should succeed")
+	{
+		Simulator simulator {};
+		distortos::chip::QuadspiNorFlash flash {simulator.peripheralMock, simulator.dmaChannelMock, dmaRequest};
+		simulator.flash = &flash;
+		REQUIRE(flash.open() == 0);
+
+		fillPattern(simulator.memory.data(), simulator.memory.size(), 0x35);
+
+		std::array<uint8_t, flashSize> buffer {};
+		SECTION("Reading whole device should be split into multiple transactions")
+		{
+			simulator.instructions.clear();
+			REQUIRE(flash.read(0, buffer.data(), buffer.size()) == 0);
+			REQUIRE(buffer == simulator.memory);
+			const std::vector<uint8_t> expectedInstructions {0x05, 0xeb, 0xeb};
+			REQUIRE(simulator.instructions == expectedInstructions);
+		}
+		SECTION("Reading part of device should succeed")
+		{
+			REQUIRE(flash.read(0x1234, buffer.data(), 0x567) == 0);
+			REQUIRE(memcmp(buffer.data(), simulator.memory.data() + 0x1234, 0x567) == 0);
+		}
+
+		// 1-4-4 read with mode clocks sent as single alternate byte on 4 lines and 4 dummy clocks
+		REQUIRE(simulator.getCcrInstruction() == 0xeb);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_ADMODE) == QUADSPI_CCR_ADMODE);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_ADSIZE) == QUADSPI_CCR_ADSIZE_1);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_ABMODE) == QUADSPI_CCR_ABMODE);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_ABSIZE) == 0);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_DCYC) == 4 << QUADSPI_CCR_DCYC_Pos);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_DMODE) == QUADSPI_CCR_DMODE);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_FMODE) == QUADSPI_CCR_FMODE_0);
+
+		REQUIRE(flash.close() == 0);
+	}
+	SECTION("Reading when quad mode cannot be enabled should use 1-1-1 fast read")
+	{
+		Simulator simulator {7};
+		distortos::chip::QuadspiNorFlash flash {simulator.peripheralMock, simulator.dmaChannelMock, dmaRequest};
+		simulator.flash = &flash;
+		REQUIRE(flash.open() == 0);
+		REQUIRE((simulator.statusRegister1 & 0x40) == 0);
+
+		fillPattern(simulator.memory.data(), simulator.memory.size(), 0x9a);
+
+		std::array<uint8_t, 0x100> buffer {};
+		REQUIRE(flash.read(0x4321, buffer.data(), buffer.size()) == 0);
+		REQUIRE(memcmp(buffer.data(), simulator.memory.data() + 0x4321, buffer.size()) == 0);
+
+		REQUIRE(simulator.getCcrInstruction() == 0x0b);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_ADMODE) == QUADSPI_CCR_ADMODE_0);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_ABMODE) == 0);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_DCYC) == 8 << QUADSPI_CCR_DCYC_Pos);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_DMODE) == QUADSPI_CCR_DMODE_0);
+
+		REQUIRE(flash.close() == 0);
+	}
+	SECTION("Transfer error during read should abort the transaction and fail with EIO")
+	{
+		Simulator simulator {};
+		distortos::chip::QuadspiNorFlash flash {simulator.peripheralMock, simulator.dmaChannelMock, dmaRequest};
+		simulator.flash = &flash;
+		REQUIRE(flash.open() == 0);
+
+		uint8_t buffer[16];
+		REQUIRE(flash.read(0x100, buffer, sizeof(buffer)) == 0);
+		simulator.transferError = true;
+		// status register read before actual read fails
+		REQUIRE(flash.read(0x100, buffer, sizeof(buffer)) == EIO);
+		REQUIRE(simulator.abortCount == 1);
+		REQUIRE((simulator.cr & (QUADSPI_CR_TEIE | QUADSPI_CR_TCIE | QUADSPI_CR_DMAEN)) == 0);
+
+		REQUIRE(flash.close() == 0);
+	}
+}
+
+TEST_CASE("Testing program() & erase()", "[program/erase]")
+{
+	Simulator simulator {};
+	distortos::chip::QuadspiNorFlash flash {simulator.peripheralMock, simulator.dmaChannelMock, dmaRequest};
+	simulator.flash = &flash;
+	REQUIRE(flash.open() == 0);
+
+	SECTION("Programming should be split into pages, each preceded by write enable and followed by polling")
+	{
+		std::array<uint8_t, pageSize + 10> buffer;
+		fillPattern(buffer.data(), buffer.size(), 0x42);
+		simulator.instructions.clear();
+		REQUIRE(flash.program(0x1000 + pageSize - 5, buffer.data(), buffer.size()) == 0);
+		REQUIRE(flash.synchronize() == 0);
+		REQUIRE(memcmp(simulator.memory.data() + 0x1000 + pageSize - 5, buffer.data(), buffer.size()) == 0);
+		// first status read is the fast check of WIP bit, the next one is automatic status polling
+		const std::vector<uint8_t> expectedInstructions
+		{
+				0x05, 0x06, 0x02,
+				0x05, 0x05, 0x06, 0x02,
+				0x05, 0x05, 0x06, 0x02,
+				0x05, 0x05,
+		};
+		REQUIRE(simulator.instructions == expectedInstructions);
+		REQUIRE((simulator.cr & QUADSPI_CR_APMS) == 0);
+		REQUIRE(simulator.abortCount == 0);
+	}
+	SECTION("Erasing should use largest fitting erase type")
+	{
+		simulator.memory.fill(0);
+		simulator.instructions.clear();
+		REQUIRE(flash.erase(0x3000, 0x1000) == 0);
+		REQUIRE(flash.synchronize() == 0);
+		const std::vector<uint8_t> expectedInstructions {0x05, 0x06, 0x20, 0x05, 0x05};
+		REQUIRE(simulator.instructions == expectedInstructions);
+		REQUIRE(std::all_of(simulator.memory.begin() + 0x3000, simulator.memory.begin() + 0x4000,
+				[](const uint8_t byte)
+				{
+					return byte == 0xff;
+				}) == true);
+		REQUIRE(simulator.memory[0x2fff] == 0);
+		REQUIRE(simulator.memory[0x4000] == 0);
+	}
+	SECTION("Erasing whole device should use chip erase")
+	{
+		simulator.memory.fill(0);
+		simulator.instructions.clear();
+		REQUIRE(flash.erase(0, flashSize) == 0);
+		REQUIRE(flash.synchronize() == 0);
+		const std::vector<uint8_t> expectedInstructions {0x05, 0x06, 0xc7, 0x05, 0x05};
+		REQUIRE(simulator.instructions == expectedInstructions);
+		REQUIRE(std::all_of(simulator.memory.begin(), simulator.memory.end(),
+				[](const uint8_t byte)
+				{
+					return byte == 0xff;
+				}) == true);
+	}
+	SECTION("Operation which never finishes should time-out and abort automatic status polling")
+	{
+		simulator.stuck = true;
+		REQUIRE(flash.erase(0x3000, 0x1000) == 0);
+		REQUIRE(flash.synchronize() == ETIMEDOUT);
+		REQUIRE(simulator.abortCount == 1);
+		REQUIRE((simulator.cr & (QUADSPI_CR_APMS | QUADSPI_CR_SMIE | QUADSPI_CR_TEIE)) == 0);
+		simulator.stuck = false;
+	}
+
+	REQUIRE(flash.close() == 0);
+}
+
+TEST_CASE("Testing memory-mapped mode", "[memory-mapped]")
+{
+	Simulator simulator {};
+	distortos::chip::QuadspiNorFlash flash {simulator.peripheralMock, simulator.dmaChannelMock, dmaRequest};
+	simulator.flash = &flash;
+	REQUIRE(flash.open() == 0);
+
+	uint8_t buffer[pageSize];
+	fillPattern(buffer, sizeof(buffer), 0x17);
+	REQUIRE(flash.program(0x2000, buffer, sizeof(buffer)) == 0);
+
+	REQUIRE(flash.enableMemoryMappedMode() == 0);
+	REQUIRE(simulator.getCcrInstruction() == 0xeb);
+	REQUIRE((simulator.ccr & QUADSPI_CCR_FMODE) == QUADSPI_CCR_FMODE);
+	REQUIRE(flash.getMemoryMappedAddress() == simulator.memory.data());
+
+	// reads in memory-mapped mode don't execute any commands
+	simulator.instructions.clear();
+	uint8_t readBuffer[pageSize] {};
+	REQUIRE(flash.read(0x2000, readBuffer, sizeof(readBuffer)) == 0);
+	REQUIRE(memcmp(readBuffer, buffer, sizeof(buffer)) == 0);
+	REQUIRE(flash.synchronize() == 0);
+	REQUIRE(simulator.instructions.empty() == true);
+
+	SECTION("Disabling memory-mapped mode should abort it")
+	{
+		flash.disableMemoryMappedMode();
+		REQUIRE(simulator.abortCount == 1);
+		REQUIRE((simulator.ccr & QUADSPI_CCR_FMODE) == 0);
+		REQUIRE(flash.close() == 0);
+	}
+	SECTION("Closing should disable memory-mapped mode")
+	{
+		REQUIRE(flash.close() == 0);
+		REQUIRE(simulator.abortCount == 1);
+	}
+}
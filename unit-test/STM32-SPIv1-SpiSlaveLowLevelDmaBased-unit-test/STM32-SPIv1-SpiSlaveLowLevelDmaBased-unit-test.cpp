@@ -0,0 +1,229 @@
+/**
+ * \file
+ * \brief STM32 SPIv1's SpiSlaveLowLevelDmaBased test cases
+ *
+ * This test checks whether STM32 SPIv1's SpiSlaveLowLevelDmaBased performs all h/w operations properly and in correct
+ * order.
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/chip/DmaChannel.hpp"
+#include "distortos/chip/SpiSlaveLowLevelDmaBased.hpp"
+#include "distortos/chip/STM32-SPIv1.hpp"
+#include "distortos/chip/STM32-SPIv1-SpiPeripheral.hpp"
+
+#include "distortos/devices/communication/SpiSlaveBase.hpp"
+
+#include <cstring>
+
+using trompeloeil::_;
+using Flags = distortos::chip::DmaChannel::Flags;
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+class SpiSlave : public distortos::devices::SpiSlaveBase
+{
+public:
+
+	MAKE_MOCK3(frameCompleteEvent, void(const void*, void*, size_t));
+	MAKE_MOCK0(transferErrorEvent, void());
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+constexpr uintptr_t drAddress {0xe0105554};
+constexpr uint8_t rxDmaRequest {0xb9};
+constexpr uint8_t txDmaRequest {0x0c};
+constexpr size_t bufferSize {24};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global test cases
++---------------------------------------------------------------------------------------------------------------------*/
+
+TEST_CASE("Testing start() with invalid arguments", "[start]")
+{
+	SpiSlave slaveMock {};
+	distortos::chip::SpiPeripheral peripheralMock {};
+	distortos::chip::DmaChannel rxDmaChannelMock {};
+	distortos::chip::DmaChannel txDmaChannelMock {};
+
+	distortos::chip::SpiSlaveLowLevelDmaBased spi {peripheralMock, rxDmaChannelMock, rxDmaRequest, txDmaChannelMock,
+			txDmaRequest};
+
+	uint8_t readBuffer[bufferSize] {};
+
+	SECTION("Stopping stopped driver should fail with EBADF")
+	{
+		REQUIRE(spi.stop() == EBADF);
+	}
+	SECTION("Starting with null read buffer should fail with EINVAL")
+	{
+		REQUIRE(spi.start(slaveMock, nullptr, nullptr, bufferSize, {}, 8, {}) == EINVAL);
+	}
+	SECTION("Starting with zero size should fail with EINVAL")
+	{
+		REQUIRE(spi.start(slaveMock, readBuffer, nullptr, 0, {}, 8, {}) == EINVAL);
+	}
+	SECTION("Starting with size not divisible by two frames should fail with EINVAL")
+	{
+		REQUIRE(spi.start(slaveMock, readBuffer, nullptr, 7, {}, 8, {}) == EINVAL);
+		REQUIRE(spi.start(slaveMock, readBuffer, nullptr, 6, {}, 16, {}) == EINVAL);
+	}
+	SECTION("Starting with too large size should fail with EINVAL")
+	{
+		REQUIRE(spi.start(slaveMock, readBuffer, nullptr, UINT16_MAX + 1, {}, 8, {}) == EINVAL);
+	}
+	SECTION("Starting with invalid word length should fail with EINVAL")
+	{
+		REQUIRE(spi.start(slaveMock, readBuffer, nullptr, bufferSize, {}, 7, {}) == EINVAL);
+		REQUIRE(spi.start(slaveMock, readBuffer, nullptr, bufferSize, {}, 9, {}) == EINVAL);
+	}
+	SECTION("Starting when RX DMA channel is busy should fail with EBUSY")
+	{
+		trompeloeil::sequence sequence {};
+		REQUIRE_CALL(rxDmaChannelMock, reserve(rxDmaRequest, _)).IN_SEQUENCE(sequence).RETURN(EBUSY);
+		REQUIRE(spi.start(slaveMock, readBuffer, nullptr, bufferSize, {}, 8, {}) == EBUSY);
+	}
+	SECTION("Starting when TX DMA channel is busy should fail with EBUSY")
+	{
+		trompeloeil::sequence sequence {};
+		REQUIRE_CALL(rxDmaChannelMock, reserve(rxDmaRequest, _)).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(txDmaChannelMock, reserve(txDmaRequest, _)).IN_SEQUENCE(sequence).RETURN(EBUSY);
+		REQUIRE_CALL(rxDmaChannelMock, release()).IN_SEQUENCE(sequence);
+		REQUIRE(spi.start(slaveMock, readBuffer, nullptr, bufferSize, {}, 8, {}) == EBUSY);
+	}
+}
+
+TEST_CASE("Testing circular transfers", "[transfers]")
+{
+	SpiSlave slaveMock {};
+	distortos::chip::SpiPeripheral peripheralMock {};
+	distortos::chip::DmaChannel rxDmaChannelMock {};
+	distortos::chip::DmaChannel txDmaChannelMock {};
+	trompeloeil::sequence sequence {};
+
+	distortos::chip::SpiSlaveLowLevelDmaBased spi {peripheralMock, rxDmaChannelMock, rxDmaRequest, txDmaChannelMock,
+			txDmaRequest};
+
+	distortos::chip::DmaChannelFunctor* rxDmaChannelFunctor {};
+	distortos::chip::DmaChannelFunctor* txDmaChannelFunctor {};
+
+	const struct
+	{
+		distortos::devices::SpiMode mode;
+		uint8_t wordLength;
+		bool lsbFirst;
+		uint32_t cr1;
+	} configurations[]
+	{
+			{distortos::devices::SpiMode::_0, 8, false, {}},
+			{distortos::devices::SpiMode::_1, 8, true, SPI_CR1_LSBFIRST | SPI_CR1_CPHA},
+			{distortos::devices::SpiMode::_2, 16, false, SPI_CR1_DFF | SPI_CR1_CPOL},
+			{distortos::devices::SpiMode::_3, 16, true, SPI_CR1_DFF | SPI_CR1_LSBFIRST | SPI_CR1_CPOL | SPI_CR1_CPHA},
+	};
+	for (const auto& configuration : configurations)
+	{
+		uint8_t readBuffer[bufferSize] {};
+		uint8_t writeBuffer[bufferSize] {};
+		void* const writeBuffers[]
+		{
+				nullptr,
+				writeBuffer,
+		};
+		for (const auto wb : writeBuffers)
+			DYNAMIC_SECTION("Testing " << static_cast<int>(configuration.wordLength) << "-bit transfers in mode " <<
+					static_cast<int>(configuration.mode) << ", " << (wb != nullptr ? "non-" : "") <<
+					"null write buffer")
+			{
+				const auto wordLength = configuration.wordLength;
+				const auto dataSize = wordLength / 8u;
+				const auto commonDmaFlags = Flags::circularModeEnable | Flags::peripheralFixed |
+						(dataSize == 1 ? Flags::dataSize1 : Flags::dataSize2);
+				constexpr uint32_t cr2 {SPI_CR2_RXDMAEN};
+
+				REQUIRE_CALL(rxDmaChannelMock, reserve(rxDmaRequest, _)).IN_SEQUENCE(sequence)
+						.LR_SIDE_EFFECT(rxDmaChannelFunctor = &_2).RETURN(0);
+				REQUIRE_CALL(txDmaChannelMock, reserve(txDmaRequest, _)).IN_SEQUENCE(sequence)
+						.LR_SIDE_EFFECT(txDmaChannelFunctor = &_2).RETURN(0);
+				REQUIRE_CALL(peripheralMock, writeCr1(configuration.cr1)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(peripheralMock, writeCr2(cr2)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(peripheralMock, getDrAddress()).IN_SEQUENCE(sequence).RETURN(drAddress);
+				const auto rxDmaFlags = commonDmaFlags | Flags::halfTransferInterruptEnable |
+						Flags::transferCompleteInterruptEnable | Flags::peripheralToMemory | Flags::memoryIncrement |
+						Flags::veryHighPriority;
+				REQUIRE_CALL(rxDmaChannelMock, startTransfer(reinterpret_cast<uintptr_t>(readBuffer), drAddress,
+						bufferSize / dataSize, rxDmaFlags)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(peripheralMock, getDrAddress()).IN_SEQUENCE(sequence).RETURN(drAddress);
+				const auto txDmaFlags = commonDmaFlags | Flags::transferCompleteInterruptDisable |
+						Flags::memoryToPeripheral | (wb != nullptr ? Flags::memoryIncrement : Flags::memoryFixed) |
+						Flags::lowPriority;
+				const auto txAddressMatcher = [dataSize, wb](const uintptr_t address)
+						{
+							constexpr uint16_t dummyData {};
+							return wb != nullptr ? address == reinterpret_cast<uintptr_t>(wb) :
+									memcmp(reinterpret_cast<const void*>(address), &dummyData, dataSize) == 0;
+						};
+				REQUIRE_CALL(txDmaChannelMock, startTransfer(_, drAddress, bufferSize / dataSize, txDmaFlags))
+						.WITH(txAddressMatcher(_1)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(peripheralMock, writeCr2(cr2 | SPI_CR2_TXDMAEN)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(peripheralMock, writeCr1(configuration.cr1 | SPI_CR1_SPE)).IN_SEQUENCE(sequence);
+				REQUIRE(spi.start(slaveMock, readBuffer, wb, bufferSize, configuration.mode, wordLength,
+						configuration.lsbFirst) == 0);
+
+				// starting started driver should fail with EBADF
+				REQUIRE(spi.start(slaveMock, readBuffer, wb, bufferSize, configuration.mode, wordLength,
+						configuration.lsbFirst) == EBADF);
+
+				const auto secondWriteFrame = wb != nullptr ? writeBuffer + bufferSize / 2 : nullptr;
+
+				SECTION("Each half of buffers should be reported as a frame")
+				{
+					for (size_t i {}; i < 3; ++i)
+					{
+						REQUIRE_CALL(slaveMock, frameCompleteEvent(readBuffer, wb, bufferSize / 2))
+								.IN_SEQUENCE(sequence);
+						rxDmaChannelFunctor->halfTransferEvent();
+						REQUIRE_CALL(slaveMock, frameCompleteEvent(readBuffer + bufferSize / 2, secondWriteFrame,
+								bufferSize / 2)).IN_SEQUENCE(sequence);
+						rxDmaChannelFunctor->transferCompleteEvent();
+					}
+				}
+				SECTION("Testing DMA RX error")
+				{
+					REQUIRE_CALL(txDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+					REQUIRE_CALL(rxDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+					REQUIRE_CALL(slaveMock, transferErrorEvent()).IN_SEQUENCE(sequence);
+					rxDmaChannelFunctor->transferErrorEvent(1);
+				}
+				SECTION("Testing DMA TX error")
+				{
+					REQUIRE_CALL(txDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+					REQUIRE_CALL(rxDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+					REQUIRE_CALL(slaveMock, transferErrorEvent()).IN_SEQUENCE(sequence);
+					txDmaChannelFunctor->transferErrorEvent(1);
+				}
+
+				REQUIRE_CALL(txDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, release()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(txDmaChannelMock, release()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(peripheralMock, writeCr1(0u)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(peripheralMock, writeCr2(0u)).IN_SEQUENCE(sequence);
+				REQUIRE(spi.stop() == 0);
+			}
+	}
+}
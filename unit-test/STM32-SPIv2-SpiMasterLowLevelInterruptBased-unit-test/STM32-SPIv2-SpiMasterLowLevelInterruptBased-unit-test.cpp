@@ -120,6 +120,9 @@ TEST_CASE("Testing configure()", "[configure]")
 					spi.configure(mode, clockFrequency, wordLength, lsbFirst, {});
 				}
 
+	// configuration identical to the current one should not reconfigure SPI peripheral
+	spi.configure(modes[3], clockFrequencies[3], wordLengths[3], lsbFirsts[1], 0x8e21);
+
 	{
 		REQUIRE_CALL(peripheralMock, writeCr1(0u)).IN_SEQUENCE(sequence);
 		REQUIRE_CALL(peripheralMock, writeCr2(0u)).IN_SEQUENCE(sequence);
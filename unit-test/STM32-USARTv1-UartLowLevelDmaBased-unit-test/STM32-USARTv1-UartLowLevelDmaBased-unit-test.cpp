@@ -0,0 +1,451 @@
+/**
+ * \file
+ * \brief STM32 USARTv1's UartLowLevelDmaBased test cases
+ *
+ * This test checks whether STM32 USARTv1's UartLowLevelDmaBased performs all h/w operations properly and in correct
+ * order.
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/chip/DmaChannel.hpp"
+#include "distortos/chip/STM32-USARTv1-UartPeripheral.hpp"
+#include "distortos/chip/UartLowLevelDmaBased.hpp"
+
+#include "distortos/devices/communication/UartBase.hpp"
+
+using trompeloeil::_;
+using Flags = distortos::chip::DmaChannel::Flags;
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+class Uart : public distortos::devices::UartBase
+{
+public:
+
+	MAKE_MOCK1(readCompleteEvent, void(size_t), override);
+	MAKE_MOCK1(receiveErrorEvent, void(ErrorSet), override);
+	MAKE_MOCK0(transmitCompleteEvent, void(), override);
+	MAKE_MOCK0(transmitStartEvent, void(), override);
+	MAKE_MOCK1(writeCompleteEvent, void(size_t), override);
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+constexpr uintptr_t drAddress {0x40011004};
+constexpr uint32_t peripheralFrequency {84000000};
+constexpr uint32_t baudRate {115200};
+constexpr uint32_t divider {(peripheralFrequency + baudRate / 2) / baudRate};
+constexpr uint32_t brr {divider / 16 << USART_BRR_DIV_Mantissa_Pos | divider % 16 << USART_BRR_DIV_Fraction_Pos};
+constexpr uint32_t cr1 {USART_CR1_RE | USART_CR1_TE | USART_CR1_UE | USART_CR1_PEIE};
+constexpr uint32_t cr3 {USART_CR3_DMAT | USART_CR3_DMAR | USART_CR3_EIE};
+constexpr uint8_t rxDmaRequest {0x4a};
+constexpr uint8_t txDmaRequest {0xb5};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Starts tested driver with 8N1 or 9N1 format, capturing DMA channel functors.
+ *
+ * \param [in] uart is a reference to tested driver
+ * \param [in] uartMock is a reference to mock of UartBase
+ * \param [in] peripheralMock is a reference to mock of UartPeripheral
+ * \param [in] rxDmaChannelMock is a reference to mock of DMA channel used for reception
+ * \param [in] txDmaChannelMock is a reference to mock of DMA channel used for transmission
+ * \param [in] characterLength is the character length, bits, 8 or 9
+ * \param [out] rxDmaChannelFunctor is a reference to pointer to which functor of RX DMA channel will be written
+ * \param [out] txDmaChannelFunctor is a reference to pointer to which functor of TX DMA channel will be written
+ */
+
+void start(distortos::chip::UartLowLevelDmaBased& uart, Uart& uartMock,
+		distortos::chip::UartPeripheral& peripheralMock, distortos::chip::DmaChannel& rxDmaChannelMock,
+		distortos::chip::DmaChannel& txDmaChannelMock, const uint8_t characterLength,
+		distortos::chip::DmaChannelFunctor*& rxDmaChannelFunctor,
+		distortos::chip::DmaChannelFunctor*& txDmaChannelFunctor)
+{
+	trompeloeil::sequence sequence {};
+	REQUIRE_CALL(peripheralMock, getPeripheralFrequency()).IN_SEQUENCE(sequence).RETURN(peripheralFrequency);
+	REQUIRE_CALL(rxDmaChannelMock,
+			reserve(rxDmaRequest, _)).IN_SEQUENCE(sequence).LR_SIDE_EFFECT(rxDmaChannelFunctor = &_2).RETURN(0);
+	REQUIRE_CALL(txDmaChannelMock,
+			reserve(txDmaRequest, _)).IN_SEQUENCE(sequence).LR_SIDE_EFFECT(txDmaChannelFunctor = &_2).RETURN(0);
+	REQUIRE_CALL(peripheralMock, writeBrr(brr)).IN_SEQUENCE(sequence);
+	REQUIRE_CALL(peripheralMock, writeCr3(cr3)).IN_SEQUENCE(sequence);
+	REQUIRE_CALL(peripheralMock, writeCr2(0u)).IN_SEQUENCE(sequence);
+	REQUIRE_CALL(peripheralMock, writeCr1(cr1 | (characterLength == 9) << USART_CR1_M_Pos)).IN_SEQUENCE(sequence);
+	REQUIRE(uart.start(uartMock, baudRate, characterLength, distortos::devices::UartParity::none, false, false) ==
+			std::make_pair(0, peripheralFrequency / divider));
+}
+
+/**
+ * \brief Stops tested driver.
+ *
+ * \param [in] uart is a reference to tested driver
+ * \param [in] peripheralMock is a reference to mock of UartPeripheral
+ * \param [in] rxDmaChannelMock is a reference to mock of DMA channel used for reception
+ * \param [in] txDmaChannelMock is a reference to mock of DMA channel used for transmission
+ */
+
+void stop(distortos::chip::UartLowLevelDmaBased& uart, distortos::chip::UartPeripheral& peripheralMock,
+		distortos::chip::DmaChannel& rxDmaChannelMock, distortos::chip::DmaChannel& txDmaChannelMock)
+{
+	trompeloeil::sequence sequence {};
+	REQUIRE_CALL(rxDmaChannelMock, release()).IN_SEQUENCE(sequence);
+	REQUIRE_CALL(txDmaChannelMock, release()).IN_SEQUENCE(sequence);
+	REQUIRE_CALL(peripheralMock, writeCr1(0u)).IN_SEQUENCE(sequence);
+	REQUIRE_CALL(peripheralMock, writeCr2(0u)).IN_SEQUENCE(sequence);
+	REQUIRE_CALL(peripheralMock, writeCr3(0u)).IN_SEQUENCE(sequence);
+	REQUIRE(uart.stop() == 0);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global test cases
++---------------------------------------------------------------------------------------------------------------------*/
+
+TEST_CASE("Testing start() & stop() interactions", "[start/stop]")
+{
+	Uart uartMock {};
+	distortos::chip::UartPeripheral peripheralMock {};
+	distortos::chip::DmaChannel rxDmaChannelMock {};
+	distortos::chip::DmaChannel txDmaChannelMock {};
+	trompeloeil::sequence sequence {};
+
+	distortos::chip::UartLowLevelDmaBased uart {peripheralMock, rxDmaChannelMock, rxDmaRequest, txDmaChannelMock,
+			txDmaRequest};
+
+	SECTION("Stopping stopped driver should fail with EBADF")
+	{
+		REQUIRE(uart.stop() == EBADF);
+	}
+	SECTION("Starting stopped driver with invalid baud rate should fail with EINVAL")
+	{
+		REQUIRE_CALL(peripheralMock, getPeripheralFrequency()).IN_SEQUENCE(sequence).RETURN(peripheralFrequency);
+		REQUIRE(uart.start(uartMock, peripheralFrequency, 8, distortos::devices::UartParity::none, false,
+				false).first == EINVAL);
+	}
+	SECTION("Starting stopped driver with invalid format should fail with EINVAL")
+	{
+		const std::pair<uint8_t, distortos::devices::UartParity> formats[]
+		{
+				{7, distortos::devices::UartParity::none},
+				{9, distortos::devices::UartParity::even},
+				{9, distortos::devices::UartParity::odd},
+		};
+		for (const auto& format : formats)
+		{
+			REQUIRE_CALL(peripheralMock, getPeripheralFrequency()).IN_SEQUENCE(sequence).RETURN(peripheralFrequency);
+			REQUIRE(uart.start(uartMock, baudRate, format.first, format.second, false, false).first == EINVAL);
+		}
+	}
+	SECTION("Starting stopped driver when RX DMA channel is busy should fail with EBUSY")
+	{
+		REQUIRE_CALL(peripheralMock, getPeripheralFrequency()).IN_SEQUENCE(sequence).RETURN(peripheralFrequency);
+		REQUIRE_CALL(rxDmaChannelMock, reserve(rxDmaRequest, _)).IN_SEQUENCE(sequence).RETURN(EBUSY);
+		REQUIRE(uart.start(uartMock, baudRate, 8, distortos::devices::UartParity::none, false, false).first ==
+				EBUSY);
+	}
+	SECTION("Starting stopped driver when TX DMA channel is busy should fail with EBUSY")
+	{
+		REQUIRE_CALL(peripheralMock, getPeripheralFrequency()).IN_SEQUENCE(sequence).RETURN(peripheralFrequency);
+		REQUIRE_CALL(rxDmaChannelMock, reserve(rxDmaRequest, _)).IN_SEQUENCE(sequence).RETURN(0);
+		REQUIRE_CALL(txDmaChannelMock, reserve(txDmaRequest, _)).IN_SEQUENCE(sequence).RETURN(EBUSY);
+		REQUIRE_CALL(rxDmaChannelMock, release()).IN_SEQUENCE(sequence);
+		REQUIRE(uart.start(uartMock, baudRate, 8, distortos::devices::UartParity::none, false, false).first ==
+				EBUSY);
+	}
+	SECTION("Starting stopped driver should succeed")
+	{
+		const std::pair<uint8_t, distortos::devices::UartParity> formats[]
+		{
+				{7, distortos::devices::UartParity::even},
+				{7, distortos::devices::UartParity::odd},
+				{8, distortos::devices::UartParity::none},
+				{8, distortos::devices::UartParity::even},
+				{8, distortos::devices::UartParity::odd},
+				{9, distortos::devices::UartParity::none},
+		};
+		for (const auto& format : formats)
+			for (const auto _2StopBits : {false, true})
+				for (const auto hardwareFlowControl : {false, true})
+				{
+					const auto characterLength = format.first;
+					const auto parity = format.second;
+					REQUIRE_CALL(peripheralMock, getPeripheralFrequency()).IN_SEQUENCE(sequence)
+							.RETURN(peripheralFrequency);
+					REQUIRE_CALL(rxDmaChannelMock, reserve(rxDmaRequest, _)).IN_SEQUENCE(sequence).RETURN(0);
+					REQUIRE_CALL(txDmaChannelMock, reserve(txDmaRequest, _)).IN_SEQUENCE(sequence).RETURN(0);
+					REQUIRE_CALL(peripheralMock, writeBrr(brr)).IN_SEQUENCE(sequence);
+					REQUIRE_CALL(peripheralMock, writeCr3(cr3 |
+							(hardwareFlowControl == true ? USART_CR3_CTSE | USART_CR3_RTSE : 0)))
+							.IN_SEQUENCE(sequence);
+					REQUIRE_CALL(peripheralMock, writeCr2(_2StopBits == true ? USART_CR2_STOP_1 : 0))
+							.IN_SEQUENCE(sequence);
+					const auto parityEnabled = parity != distortos::devices::UartParity::none;
+					REQUIRE_CALL(peripheralMock, writeCr1(cr1 |
+							(characterLength + parityEnabled == 9 ? USART_CR1_M : 0) |
+							(parityEnabled == true ? USART_CR1_PCE : 0) |
+							(parity == distortos::devices::UartParity::odd ? USART_CR1_PS : 0)))
+							.IN_SEQUENCE(sequence);
+					REQUIRE(uart.start(uartMock, baudRate, characterLength, parity, _2StopBits,
+							hardwareFlowControl) == std::make_pair(0, peripheralFrequency / divider));
+
+					// starting started driver should fail with EBADF
+					REQUIRE(uart.start(uartMock, baudRate, characterLength, parity, _2StopBits,
+							hardwareFlowControl).first == EBADF);
+
+					// stopping started driver should succeed
+					stop(uart, peripheralMock, rxDmaChannelMock, txDmaChannelMock);
+				}
+	}
+}
+
+TEST_CASE("Testing read operations", "[read]")
+{
+	Uart uartMock {};
+	distortos::chip::UartPeripheral peripheralMock {};
+	distortos::chip::DmaChannel rxDmaChannelMock {};
+	distortos::chip::DmaChannel txDmaChannelMock {};
+	trompeloeil::sequence sequence {};
+
+	distortos::chip::UartLowLevelDmaBased uart {peripheralMock, rxDmaChannelMock, rxDmaRequest, txDmaChannelMock,
+			txDmaRequest};
+
+	uint8_t buffer[6] {};
+
+	REQUIRE(uart.startRead(buffer, sizeof(buffer)) == EBADF);
+
+	distortos::chip::DmaChannelFunctor* rxDmaChannelFunctor {};
+	distortos::chip::DmaChannelFunctor* txDmaChannelFunctor {};
+
+	for (const uint8_t characterLength : {8, 9})
+		DYNAMIC_SECTION("Testing " << static_cast<int>(characterLength) << "-bit characters")
+		{
+			start(uart, uartMock, peripheralMock, rxDmaChannelMock, txDmaChannelMock, characterLength,
+					rxDmaChannelFunctor, txDmaChannelFunctor);
+
+			REQUIRE(uart.startRead(nullptr, sizeof(buffer)) == EINVAL);
+			REQUIRE(uart.startRead(buffer, 0) == EINVAL);
+			if (characterLength > 8)
+				REQUIRE(uart.startRead(buffer, sizeof(buffer) - 1) == EINVAL);
+
+			// stopping idle read should do nothing
+			REQUIRE(uart.stopRead() == 0);
+
+			const size_t dataSize {characterLength > 8 ? 2u : 1u};
+			const size_t transactions {sizeof(buffer) / dataSize};
+			REQUIRE_CALL(peripheralMock, getDrAddress()).IN_SEQUENCE(sequence).RETURN(drAddress);
+			REQUIRE_CALL(rxDmaChannelMock, startTransfer(reinterpret_cast<uintptr_t>(buffer), drAddress,
+					transactions, (dataSize == 1 ? Flags::dataSize1 : Flags::dataSize2) |
+					Flags::transferCompleteInterruptEnable | Flags::peripheralToMemory | Flags::peripheralFixed |
+					Flags::memoryIncrement | Flags::veryHighPriority)).IN_SEQUENCE(sequence);
+			REQUIRE_CALL(peripheralMock, enableIdleInterrupt(true)).IN_SEQUENCE(sequence);
+			REQUIRE(uart.startRead(buffer, sizeof(buffer)) == 0);
+
+			REQUIRE(uart.startRead(buffer, sizeof(buffer)) == EBUSY);
+			REQUIRE(uart.stop() == EBUSY);
+
+			SECTION("Stopping read should return number of received bytes")
+			{
+				REQUIRE_CALL(peripheralMock, enableIdleInterrupt(false)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, getTransactionsLeft()).IN_SEQUENCE(sequence).RETURN(1);
+				REQUIRE(uart.stopRead() == sizeof(buffer) - dataSize);
+			}
+			SECTION("DMA transfer complete event should finish read")
+			{
+				REQUIRE_CALL(peripheralMock, enableIdleInterrupt(false)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, getTransactionsLeft()).IN_SEQUENCE(sequence).RETURN(0);
+				REQUIRE_CALL(uartMock, readCompleteEvent(sizeof(buffer))).IN_SEQUENCE(sequence);
+				rxDmaChannelFunctor->transferCompleteEvent();
+			}
+			SECTION("DMA transfer error event should finish read")
+			{
+				REQUIRE_CALL(peripheralMock, enableIdleInterrupt(false)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, getTransactionsLeft()).IN_SEQUENCE(sequence).RETURN(transactions);
+				REQUIRE_CALL(uartMock, readCompleteEvent(0u)).IN_SEQUENCE(sequence);
+				rxDmaChannelFunctor->transferErrorEvent(transactions);
+			}
+			SECTION("Idle line without received characters should not finish read")
+			{
+				REQUIRE_CALL(peripheralMock, readSr()).IN_SEQUENCE(sequence).RETURN(USART_SR_IDLE | USART_SR_TC);
+				REQUIRE_CALL(peripheralMock, readCr1()).IN_SEQUENCE(sequence).RETURN(cr1 | USART_CR1_IDLEIE);
+				REQUIRE_CALL(peripheralMock, readDr()).IN_SEQUENCE(sequence).RETURN(0);
+				REQUIRE_CALL(rxDmaChannelMock, getTransactionsLeft()).IN_SEQUENCE(sequence).RETURN(transactions);
+				uart.interruptHandler();
+
+				REQUIRE_CALL(peripheralMock, enableIdleInterrupt(false)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, getTransactionsLeft()).IN_SEQUENCE(sequence).RETURN(transactions);
+				REQUIRE(uart.stopRead() == 0);
+			}
+			SECTION("Idle line after received characters should finish read early")
+			{
+				REQUIRE_CALL(peripheralMock, readSr()).IN_SEQUENCE(sequence).RETURN(USART_SR_IDLE | USART_SR_TC);
+				REQUIRE_CALL(peripheralMock, readCr1()).IN_SEQUENCE(sequence).RETURN(cr1 | USART_CR1_IDLEIE);
+				REQUIRE_CALL(peripheralMock, readDr()).IN_SEQUENCE(sequence).RETURN(0);
+				REQUIRE_CALL(rxDmaChannelMock, getTransactionsLeft()).IN_SEQUENCE(sequence).RETURN(1);
+				REQUIRE_CALL(peripheralMock, enableIdleInterrupt(false)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, getTransactionsLeft()).IN_SEQUENCE(sequence).RETURN(1);
+				REQUIRE_CALL(uartMock, readCompleteEvent(sizeof(buffer) - dataSize)).IN_SEQUENCE(sequence);
+				uart.interruptHandler();
+			}
+			SECTION("Reception error during read should be reported without reading DR")
+			{
+				REQUIRE_CALL(peripheralMock, readSr()).IN_SEQUENCE(sequence).RETURN(USART_SR_PE | USART_SR_ORE);
+				REQUIRE_CALL(peripheralMock, readCr1()).IN_SEQUENCE(sequence).RETURN(cr1 | USART_CR1_IDLEIE);
+				distortos::devices::UartBase::ErrorSet errorSet {};
+				errorSet[distortos::devices::UartBase::overrunError] = true;
+				errorSet[distortos::devices::UartBase::parityError] = true;
+				REQUIRE_CALL(uartMock, receiveErrorEvent(errorSet)).IN_SEQUENCE(sequence);
+				uart.interruptHandler();
+
+				REQUIRE_CALL(peripheralMock, enableIdleInterrupt(false)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(rxDmaChannelMock, getTransactionsLeft()).IN_SEQUENCE(sequence).RETURN(transactions);
+				REQUIRE(uart.stopRead() == 0);
+			}
+
+			stop(uart, peripheralMock, rxDmaChannelMock, txDmaChannelMock);
+		}
+}
+
+TEST_CASE("Testing reception errors without read operation", "[receiveErrorEvent]")
+{
+	Uart uartMock {};
+	distortos::chip::UartPeripheral peripheralMock {};
+	distortos::chip::DmaChannel rxDmaChannelMock {};
+	distortos::chip::DmaChannel txDmaChannelMock {};
+	trompeloeil::sequence sequence {};
+
+	distortos::chip::UartLowLevelDmaBased uart {peripheralMock, rxDmaChannelMock, rxDmaRequest, txDmaChannelMock,
+			txDmaRequest};
+
+	distortos::chip::DmaChannelFunctor* rxDmaChannelFunctor {};
+	distortos::chip::DmaChannelFunctor* txDmaChannelFunctor {};
+	start(uart, uartMock, peripheralMock, rxDmaChannelMock, txDmaChannelMock, 8, rxDmaChannelFunctor,
+			txDmaChannelFunctor);
+
+	const std::pair<uint32_t, distortos::devices::UartBase::ErrorBits> errors[]
+	{
+			{USART_SR_FE, distortos::devices::UartBase::framingError},
+			{USART_SR_NE, distortos::devices::UartBase::noiseError},
+			{USART_SR_ORE, distortos::devices::UartBase::overrunError},
+			{USART_SR_PE, distortos::devices::UartBase::parityError},
+	};
+	for (const auto& error : errors)
+	{
+		REQUIRE_CALL(peripheralMock, readSr()).IN_SEQUENCE(sequence).RETURN(error.first | USART_SR_TC);
+		REQUIRE_CALL(peripheralMock, readCr1()).IN_SEQUENCE(sequence).RETURN(cr1);
+		REQUIRE_CALL(peripheralMock, readDr()).IN_SEQUENCE(sequence).RETURN(0);
+		distortos::devices::UartBase::ErrorSet errorSet {};
+		errorSet[error.second] = true;
+		REQUIRE_CALL(uartMock, receiveErrorEvent(errorSet)).IN_SEQUENCE(sequence);
+		uart.interruptHandler();
+	}
+
+	stop(uart, peripheralMock, rxDmaChannelMock, txDmaChannelMock);
+}
+
+TEST_CASE("Testing write operations", "[write]")
+{
+	Uart uartMock {};
+	distortos::chip::UartPeripheral peripheralMock {};
+	distortos::chip::DmaChannel rxDmaChannelMock {};
+	distortos::chip::DmaChannel txDmaChannelMock {};
+	trompeloeil::sequence sequence {};
+
+	distortos::chip::UartLowLevelDmaBased uart {peripheralMock, rxDmaChannelMock, rxDmaRequest, txDmaChannelMock,
+			txDmaRequest};
+
+	const uint8_t buffer[6] {};
+
+	REQUIRE(uart.startWrite(buffer, sizeof(buffer)) == EBADF);
+
+	distortos::chip::DmaChannelFunctor* rxDmaChannelFunctor {};
+	distortos::chip::DmaChannelFunctor* txDmaChannelFunctor {};
+
+	for (const uint8_t characterLength : {8, 9})
+		for (const auto transmitterIdle : {false, true})
+			DYNAMIC_SECTION("Testing " << static_cast<int>(characterLength) << "-bit characters, " <<
+					(transmitterIdle == true ? "idle" : "active") << " transmitter")
+			{
+				start(uart, uartMock, peripheralMock, rxDmaChannelMock, txDmaChannelMock, characterLength,
+						rxDmaChannelFunctor, txDmaChannelFunctor);
+
+				REQUIRE(uart.startWrite(nullptr, sizeof(buffer)) == EINVAL);
+				REQUIRE(uart.startWrite(buffer, 0) == EINVAL);
+				if (characterLength > 8)
+					REQUIRE(uart.startWrite(buffer, sizeof(buffer) - 1) == EINVAL);
+
+				// stopping idle write should do nothing
+				REQUIRE(uart.stopWrite() == 0);
+
+				const size_t dataSize {characterLength > 8 ? 2u : 1u};
+				const size_t transactions {sizeof(buffer) / dataSize};
+				REQUIRE_CALL(peripheralMock, enableTcInterrupt(false)).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(peripheralMock, readSr()).IN_SEQUENCE(sequence)
+						.RETURN(transmitterIdle == true ? USART_SR_TC : 0);
+				std::unique_ptr<trompeloeil::expectation> transmitStartEvent;
+				if (transmitterIdle == true)
+					transmitStartEvent = NAMED_REQUIRE_CALL(uartMock, transmitStartEvent()).IN_SEQUENCE(sequence);
+				REQUIRE_CALL(peripheralMock, getDrAddress()).IN_SEQUENCE(sequence).RETURN(drAddress);
+				REQUIRE_CALL(txDmaChannelMock, startTransfer(reinterpret_cast<uintptr_t>(buffer), drAddress,
+						transactions, (dataSize == 1 ? Flags::dataSize1 : Flags::dataSize2) |
+						Flags::transferCompleteInterruptEnable | Flags::memoryToPeripheral | Flags::peripheralFixed |
+						Flags::memoryIncrement | Flags::lowPriority)).IN_SEQUENCE(sequence);
+				REQUIRE(uart.startWrite(buffer, sizeof(buffer)) == 0);
+
+				REQUIRE(uart.startWrite(buffer, sizeof(buffer)) == EBUSY);
+				REQUIRE(uart.stop() == EBUSY);
+
+				SECTION("Stopping write should return number of transmitted bytes")
+				{
+					REQUIRE_CALL(txDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+					REQUIRE_CALL(txDmaChannelMock, getTransactionsLeft()).IN_SEQUENCE(sequence).RETURN(1);
+					REQUIRE_CALL(peripheralMock, enableTcInterrupt(true)).IN_SEQUENCE(sequence);
+					REQUIRE(uart.stopWrite() == sizeof(buffer) - dataSize);
+				}
+				SECTION("DMA transfer error event should finish write")
+				{
+					REQUIRE_CALL(txDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+					REQUIRE_CALL(txDmaChannelMock, getTransactionsLeft()).IN_SEQUENCE(sequence).RETURN(transactions);
+					REQUIRE_CALL(peripheralMock, enableTcInterrupt(true)).IN_SEQUENCE(sequence);
+					REQUIRE_CALL(uartMock, writeCompleteEvent(0u)).IN_SEQUENCE(sequence);
+					txDmaChannelFunctor->transferErrorEvent(transactions);
+				}
+				SECTION("DMA transfer complete event should finish write, end of transmission should be reported")
+				{
+					REQUIRE_CALL(txDmaChannelMock, stopTransfer()).IN_SEQUENCE(sequence);
+					REQUIRE_CALL(txDmaChannelMock, getTransactionsLeft()).IN_SEQUENCE(sequence).RETURN(0);
+					REQUIRE_CALL(peripheralMock, enableTcInterrupt(true)).IN_SEQUENCE(sequence);
+					REQUIRE_CALL(uartMock, writeCompleteEvent(sizeof(buffer))).IN_SEQUENCE(sequence);
+					txDmaChannelFunctor->transferCompleteEvent();
+
+					REQUIRE_CALL(peripheralMock, readSr()).IN_SEQUENCE(sequence).RETURN(USART_SR_TC);
+					REQUIRE_CALL(peripheralMock, readCr1()).IN_SEQUENCE(sequence).RETURN(cr1 | USART_CR1_TCIE);
+					REQUIRE_CALL(peripheralMock, enableTcInterrupt(false)).IN_SEQUENCE(sequence);
+					REQUIRE_CALL(uartMock, transmitCompleteEvent()).IN_SEQUENCE(sequence);
+					uart.interruptHandler();
+				}
+
+				stop(uart, peripheralMock, rxDmaChannelMock, txDmaChannelMock);
+			}
+}
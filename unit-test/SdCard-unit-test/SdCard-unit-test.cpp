@@ -646,11 +646,17 @@ TEST_CASE("Testing get*BlockSize()", "[get*BlockSize]")
 							transferMatcher(true, sizeof(buffer), blockSize, writeTimeoutMs)))
 							.LR_WITH(_4.getWriteBuffer() == buffer).IN_SEQUENCE(sequence)
 							.SIDE_EFFECT(copy(cmd24Response, _3)).RETURN(Result::success);
-					REQUIRE_CALL(tickClockMock, nowMock()).IN_SEQUENCE(sequence)
-							.RETURN(distortos::TickClock::time_point{});
 					REQUIRE_CALL(mutexMock, unlock()).IN_SEQUENCE(sequence).RETURN(0);
 
 					REQUIRE(sdCard.write(address, buffer, sizeof(buffer)) == 0);
+
+					SECTION("Testing synchronize() after write() of 1 block - card is already in transfer state")
+					{
+						REQUIRE_CALL(mutexMock, lock()).IN_SEQUENCE(sequence).RETURN(0);
+						REQUIRE_CALL(mutexMock, unlock()).IN_SEQUENCE(sequence).RETURN(0);
+
+						REQUIRE(sdCard.synchronize() == 0);
+					}
 				}
 				SECTION("Testing write() of 5 blocks")
 				{
@@ -1589,3 +1595,181 @@ TEST_CASE("Testing get*BlockSize()", "[get*BlockSize]")
 		}
 	}
 }
+
+TEST_CASE("Testing switching to high speed mode", "[highSpeed]")
+{
+	distortos::mock::Mutex mutexMock {distortos::mock::Mutex::UnitTestTag{}};
+	SdMmcCardLowLevel sdCardLowLevelMock;
+	distortos::devices::mock::SynchronousSdMmcCardLowLevel synchronousSdCardLowLevelMock;
+	distortos::ThisThreadMock thisThreadMock;
+	distortos::TickClock tickClockMock;
+	trompeloeil::sequence sequence {};
+	std::vector<std::unique_ptr<trompeloeil::expectation>> expectations {};
+
+	constexpr uint16_t readTimeoutMs {100};
+
+	const ShortResponse cmd8Response {0x1aa};
+	const ShortResponse cmd55Response0 {0x120};
+	const ShortResponse acmd41Response {0xc0ff8000};
+	const LongResponse cmd2Response {0x4a00f9ea, 0x307cb154, 0x44333247, 0x27504853};
+	const ShortResponse cmd3Response {0x59b40520};
+	const LongResponse cmd9Response {0xa40008c, 0xe7bf7f80, 0x5b590000, 0x400e0032};
+	const ShortResponse cmd7Response {0x700};
+	const ShortResponse cmd55Response {0x920};
+	const ShortResponse acmd6Response {0x920};
+	const ShortResponse cmd6Response {0x900};
+	const ShortResponse acmd13Response {0x920};
+	const ShortResponse cmd13Response {0x900};
+	const std::array<uint8_t, 64> acmd13Transfer
+			{0x80, 0x0, 0x0, 0x0, 0x5, 0x0, 0x0, 0x0, 0x4, 0x0, 0x90, 0x2, 0x0, 0xaa, 0x1f};
+	const uint32_t shiftedRca {cmd3Response[0] & 0xffff0000};
+
+	const auto makeSwitchFunctionStatus = [](const uint16_t maxCurrent, const uint16_t group1Support,
+			const uint8_t group1Selection)
+			{
+				std::array<uint8_t, 64> switchFunctionStatus {};
+				switchFunctionStatus[0] = maxCurrent >> 8;
+				switchFunctionStatus[1] = maxCurrent;
+				switchFunctionStatus[12] = group1Support >> 8;
+				switchFunctionStatus[13] = group1Support;
+				switchFunctionStatus[16] = group1Selection;
+				return switchFunctionStatus;
+			};
+	const auto highSpeedSupported = makeSwitchFunctionStatus(100, 0x8003, 1);
+
+	const struct
+	{
+		const char* description;
+		uint32_t maxClockFrequency;
+		LongResponse cmd9Response;
+		bool checkExpected;
+		Result checkResult;
+		ShortResponse checkResponse;
+		std::array<uint8_t, 64> checkTransfer;
+		bool switchExpected;
+		Result switchResult;
+		ShortResponse switchResponse;
+		std::array<uint8_t, 64> switchTransfer;
+		uint32_t highSpeedClockFrequency;
+	} steps[]
+	{
+			{"high speed mode is selected",
+					50000000, cmd9Response,
+					true, Result::success, cmd6Response, highSpeedSupported,
+					true, Result::success, cmd6Response, highSpeedSupported,
+					50000000},
+			{"clock frequency in high speed mode is limited to 50 MHz",
+					100000000, cmd9Response,
+					true, Result::success, cmd6Response, highSpeedSupported,
+					true, Result::success, cmd6Response, highSpeedSupported,
+					50000000},
+			{"card without switch command class stays in default speed mode",
+					50000000, {0xa40008c, 0xe7bf7f80, 0x1b590000, 0x400e0032},
+					false, {}, {}, {},
+					false, {}, {}, {},
+					{}},
+			{"card without high speed function stays in default speed mode",
+					50000000, cmd9Response,
+					true, Result::success, cmd6Response, makeSwitchFunctionStatus(100, 0x8001, 0),
+					false, {}, {}, {},
+					{}},
+			{"data timeout during check of high speed function is not fatal",
+					50000000, cmd9Response,
+					true, Result::dataTimeout, cmd6Response, {},
+					false, {}, {}, {},
+					{}},
+			{"R1 response error during check of high speed function is not fatal",
+					50000000, cmd9Response,
+					true, Result::success, {0x400900}, highSpeedSupported,
+					false, {}, {}, {},
+					{}},
+			{"failed switch of high speed function is not fatal",
+					50000000, cmd9Response,
+					true, Result::success, cmd6Response, highSpeedSupported,
+					true, Result::success, cmd6Response, makeSwitchFunctionStatus(100, 0x8003, 0xf),
+					{}},
+			{"switch function status with zero max current is not fatal",
+					50000000, cmd9Response,
+					true, Result::success, cmd6Response, highSpeedSupported,
+					true, Result::success, cmd6Response, makeSwitchFunctionStatus(0, 0x8003, 1),
+					{}},
+	};
+	for (auto& step : steps)
+	{
+		DYNAMIC_SECTION("Testing initialization: " << step.description)
+		{
+			distortos::devices::SdCard sdCard {sdCardLowLevelMock, true, step.maxClockFrequency};
+
+			REQUIRE_CALL(mutexMock, lock()).IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock, start()).IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock, configure(BusMode::_1Bit, 400000u)).IN_SEQUENCE(sequence);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(0u, 0u, responseMatcher(0), transferMatcher())).IN_SEQUENCE(sequence)
+					.RETURN(Result::success);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(8u, 0x1aau, responseMatcher(1), transferMatcher())).IN_SEQUENCE(sequence)
+					.SIDE_EFFECT(copy(cmd8Response, _3)).RETURN(Result::success);
+			REQUIRE_CALL(tickClockMock, nowMock()).IN_SEQUENCE(sequence).RETURN(distortos::TickClock::time_point{});
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(55u, 0u, responseMatcher(1), transferMatcher())).IN_SEQUENCE(sequence)
+					.SIDE_EFFECT(copy(cmd55Response0, _3)).RETURN(Result::success);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(41u, 0x50ff8000u, responseMatcher(1), transferMatcher()))
+					.IN_SEQUENCE(sequence).SIDE_EFFECT(copy(acmd41Response, _3))
+					.RETURN(Result::responseCrcMismatch);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(2u, 0u, responseMatcher(4), transferMatcher())).IN_SEQUENCE(sequence)
+					.SIDE_EFFECT(copy(cmd2Response, _3)).RETURN(Result::success);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(3u, 0u, responseMatcher(1), transferMatcher())).IN_SEQUENCE(sequence)
+					.SIDE_EFFECT(copy(cmd3Response, _3)).RETURN(Result::success);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(9u, shiftedRca, responseMatcher(4), transferMatcher())).IN_SEQUENCE(sequence)
+					.SIDE_EFFECT(copy(step.cmd9Response, _3)).RETURN(Result::success);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(7u, shiftedRca, responseMatcher(1), transferMatcher())).IN_SEQUENCE(sequence)
+					.SIDE_EFFECT(copy(cmd7Response, _3)).RETURN(Result::success);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(55u, shiftedRca, responseMatcher(1), transferMatcher()))
+					.IN_SEQUENCE(sequence).SIDE_EFFECT(copy(cmd55Response, _3)).RETURN(Result::success);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(6u, 2u, responseMatcher(1), transferMatcher())).IN_SEQUENCE(sequence)
+					.SIDE_EFFECT(copy(acmd6Response, _3)).RETURN(Result::success);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock, configure(BusMode::_4Bit, 25000000u)).IN_SEQUENCE(sequence);
+			if (step.checkExpected == true)
+				expectations.emplace_back(NAMED_REQUIRE_CALL(synchronousSdCardLowLevelMock,
+						executeTransaction(6u, 0xfffff1u, responseMatcher(1),
+						transferMatcher(false, step.checkTransfer.size(), step.checkTransfer.size(), readTimeoutMs)))
+						.IN_SEQUENCE(sequence).SIDE_EFFECT(copy(step.checkResponse, _3); copy(step.checkTransfer, _4))
+						.RETURN(step.checkResult));
+			if (step.switchExpected == true)
+				expectations.emplace_back(NAMED_REQUIRE_CALL(synchronousSdCardLowLevelMock,
+						executeTransaction(6u, 0x80fffff1u, responseMatcher(1),
+						transferMatcher(false, step.switchTransfer.size(), step.switchTransfer.size(), readTimeoutMs)))
+						.IN_SEQUENCE(sequence).SIDE_EFFECT(copy(step.switchResponse, _3); copy(step.switchTransfer, _4))
+						.RETURN(step.switchResult));
+			if (step.highSpeedClockFrequency != 0)
+				expectations.emplace_back(NAMED_REQUIRE_CALL(synchronousSdCardLowLevelMock,
+						configure(BusMode::_4Bit, step.highSpeedClockFrequency)).IN_SEQUENCE(sequence));
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(55u, shiftedRca, responseMatcher(1), transferMatcher()))
+					.IN_SEQUENCE(sequence).SIDE_EFFECT(copy(cmd55Response, _3)).RETURN(Result::success);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(13u, 0u, responseMatcher(1), transferMatcher(false, sizeof(acmd13Transfer),
+					sizeof(acmd13Transfer), readTimeoutMs))).IN_SEQUENCE(sequence)
+					.SIDE_EFFECT(copy(acmd13Response, _3); copy(acmd13Transfer, _4)).RETURN(Result::success);
+			REQUIRE_CALL(mutexMock, unlock()).IN_SEQUENCE(sequence).RETURN(0);
+
+			REQUIRE(sdCard.open() == 0);
+
+			REQUIRE_CALL(mutexMock, lock()).IN_SEQUENCE(sequence).RETURN(0);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock,
+					executeTransaction(13u, shiftedRca, responseMatcher(1), transferMatcher()))
+					.IN_SEQUENCE(sequence).SIDE_EFFECT(copy(cmd13Response, _3)).RETURN(Result::success);
+			REQUIRE_CALL(synchronousSdCardLowLevelMock, stop()).IN_SEQUENCE(sequence);
+			REQUIRE_CALL(mutexMock, unlock()).IN_SEQUENCE(sequence).RETURN(0);
+
+			REQUIRE(sdCard.close() == 0);
+		}
+	}
+}
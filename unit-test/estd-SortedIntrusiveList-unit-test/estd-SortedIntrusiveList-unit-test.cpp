@@ -0,0 +1,165 @@
+/**
+ * \file
+ * \brief SortedIntrusiveList test cases
+ *
+ * This test checks whether SortedIntrusiveList keeps its elements sorted when they are inserted one by one and when
+ * whole lists are merged.
+ *
+ * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "unit-test-common.hpp"
+
+#include "estd/SortedIntrusiveList.hpp"
+
+#include <vector>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// element of the list
+struct Element
+{
+	/// node for intrusive list
+	estd::IntrusiveListNode node;
+
+	/// value used for sorting
+	int value;
+
+	/// identifier used to check relative order of elements with equal values
+	int identifier;
+};
+
+/// functor which gives descending order of elements on the list
+struct DescendingValue
+{
+	bool operator()(const Element& left, const Element& right) const
+	{
+		return left.value < right.value;
+	}
+};
+
+/// tested list
+using List = estd::SortedIntrusiveList<DescendingValue, Element, &Element::node>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Gets identifiers of all elements on the list.
+ *
+ * \param [in] list is a reference to list from which identifiers will be collected
+ *
+ * \return vector with identifiers of all elements on the list, in order
+ */
+
+std::vector<int> getIdentifiers(const List& list)
+{
+	std::vector<int> identifiers;
+	for (const auto& element : list)
+		identifiers.emplace_back(element.identifier);
+	return identifiers;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global test cases
++---------------------------------------------------------------------------------------------------------------------*/
+
+TEST_CASE("Testing insert()", "[insert]")
+{
+	Element elements[]
+	{
+			{{}, 1, 0},
+			{{}, 3, 1},
+			{{}, 2, 2},
+			{{}, 3, 3},
+			{{}, 1, 4},
+	};
+	List list;
+	for (auto& element : elements)
+		list.insert(element);
+
+	REQUIRE(getIdentifiers(list) == std::vector<int>{1, 3, 2, 0, 4});
+}
+
+TEST_CASE("Testing merge()", "[merge]")
+{
+	List list;
+	List other;
+
+	SECTION("Merging empty list with empty list")
+	{
+		list.merge(other);
+		REQUIRE(list.empty() == true);
+		REQUIRE(other.empty() == true);
+	}
+	SECTION("Merging non-empty list to empty list")
+	{
+		Element elements[]
+		{
+				{{}, 3, 0},
+				{{}, 2, 1},
+				{{}, 2, 2},
+		};
+		for (auto& element : elements)
+			other.insert(element);
+
+		list.merge(other);
+		REQUIRE(getIdentifiers(list) == std::vector<int>{0, 1, 2});
+		REQUIRE(other.empty() == true);
+	}
+	SECTION("Merging empty list to non-empty list")
+	{
+		Element elements[]
+		{
+				{{}, 3, 0},
+				{{}, 2, 1},
+				{{}, 2, 2},
+		};
+		for (auto& element : elements)
+			list.insert(element);
+
+		list.merge(other);
+		REQUIRE(getIdentifiers(list) == std::vector<int>{0, 1, 2});
+		REQUIRE(other.empty() == true);
+	}
+	SECTION("Merging interleaved lists")
+	{
+		Element elements[]
+		{
+				{{}, 5, 0},
+				{{}, 3, 1},
+				{{}, 3, 2},
+				{{}, 1, 3},
+		};
+		Element otherElements[]
+		{
+				{{}, 6, 10},
+				{{}, 3, 11},
+				{{}, 3, 12},
+				{{}, 2, 13},
+				{{}, 0, 14},
+				{{}, 0, 15},
+		};
+		for (auto& element : elements)
+			list.insert(element);
+		for (auto& element : otherElements)
+			other.insert(element);
+
+		// result must be identical to splicing each element separately
+		list.merge(other);
+		REQUIRE(getIdentifiers(list) == std::vector<int>{10, 0, 1, 2, 11, 12, 13, 3, 14, 15});
+		REQUIRE(other.empty() == true);
+	}
+}
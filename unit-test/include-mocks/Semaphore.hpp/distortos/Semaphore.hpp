@@ -96,6 +96,16 @@ public:
 		return mock::Semaphore::getInstance().post();
 	}
 
+	int tryWait()
+	{
+		return mock::Semaphore::getInstance().tryWait();
+	}
+
+	int tryWaitUntil(const TickClock::time_point timePoint)
+	{
+		return mock::Semaphore::getInstance().tryWaitUntil(timePoint);
+	}
+
 	int wait()
 	{
 		return mock::Semaphore::getInstance().wait();
@@ -26,6 +26,9 @@ namespace chip
 
 enum class DmaChannelFlags : uint32_t
 {
+	halfTransferInterruptDisable = 0 << 3,
+	halfTransferInterruptEnable = 1 << 3,
+
 	transferCompleteInterruptDisable = 0 << 4,
 	transferCompleteInterruptEnable = 1 << 4,
 
@@ -38,6 +41,12 @@ enum class DmaChannelFlags : uint32_t
 
 	peripheralToMemory = 0 << 6,
 	memoryToPeripheral = 1 << 6,
+#ifdef DISTORTOS_CHIP_STM32_DMAV2
+	memoryToMemory = 2 << 6,
+#endif	// def DISTORTOS_CHIP_STM32_DMAV2
+
+	circularModeDisable = 0 << 8,
+	circularModeEnable = 1 << 8,
 
 	peripheralFixed = 0 << 9,
 	peripheralIncrement = 1 << 9,
@@ -111,10 +120,19 @@ public:
 
 	using Flags = DmaChannelFlags;
 
+#ifdef DISTORTOS_CHIP_STM32_DMAV2
+	MAKE_CONST_MOCK0(getCurrentMemory, uint8_t());
+#endif	// def DISTORTOS_CHIP_STM32_DMAV2
 	MAKE_CONST_MOCK0(getTransactionsLeft, size_t());
 	MAKE_MOCK0(release, void());
 	MAKE_MOCK2(reserve, int(uint8_t, DmaChannelFunctor&));
+#ifdef DISTORTOS_CHIP_STM32_DMAV2
+	MAKE_CONST_MOCK2(setMemoryAddress, void(uint8_t, uintptr_t));
+#endif	// def DISTORTOS_CHIP_STM32_DMAV2
 	MAKE_CONST_MOCK4(startTransfer, void(uintptr_t, uintptr_t, size_t, Flags));
+#ifdef DISTORTOS_CHIP_STM32_DMAV2
+	MAKE_CONST_MOCK5(startTransfer, void(uintptr_t, uintptr_t, uintptr_t, size_t, Flags));
+#endif	// def DISTORTOS_CHIP_STM32_DMAV2
 	MAKE_CONST_MOCK0(stopTransfer, void());
 };
 
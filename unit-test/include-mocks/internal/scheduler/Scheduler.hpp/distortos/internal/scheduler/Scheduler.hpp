@@ -36,6 +36,8 @@ public:
 	MAKE_CONST_MOCK0(getCurrentThreadControlBlock, ThreadControlBlock&());
 	MAKE_MOCK1(unblock, void(ThreadList::iterator));
 	MAKE_MOCK2(unblock, void(ThreadList::iterator, UnblockReason));
+	MAKE_MOCK1(unblockAll, void(ThreadList&));
+	MAKE_MOCK2(unblockAll, void(ThreadList&, UnblockReason));
 };
 
 }	// namespace internal